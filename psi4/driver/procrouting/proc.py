@@ -2579,9 +2579,11 @@ def run_scf(name, **kwargs):
 
     optstash_scf = proc_util.scf_set_reference_local(name, is_dft=dft_func)
 
-    # See if we're doing TDSCF after, keep JK if so
+    # See if we're doing TDSCF after, keep JK and the collocation cache if so
     if sum(core.get_option("SCF", "TDSCF_STATES")) > 0:
         core.set_local_option("SCF", "SAVE_JK", True)
+        optstash_scf.add_option(['SCF', 'DFT_COLLOCATION_REUSE'])
+        core.set_local_option("SCF", "DFT_COLLOCATION_REUSE", True)
 
     # Alter default algorithm
     if not core.has_global_option_changed('SCF_TYPE'):
@@ -2593,6 +2595,9 @@ def run_scf(name, **kwargs):
     ssuper = scf_wfn.functional()
 
     if ssuper.is_c_hybrid():
+        # The collocation cache is not needed by MP2, release its memory
+        if scf_wfn.V_potential():
+            scf_wfn.V_potential().clear_collocation_cache()
 
         # throw exception for CONV/CD MP2
         if (mp2_type := core.get_global_option("MP2_TYPE")) != "DF":
@@ -2687,6 +2692,11 @@ def run_scf_gradient(name, **kwargs):
     # Bypass the scf call if a reference wavefunction is given
     ref_wfn = kwargs.get('ref_wfn', None)
     if ref_wfn is None:
+        # Let the XC gradient reuse the SCF collocation cache
+        optstash.add_option(['SCF', 'DFT_COLLOCATION_GRADIENT'])
+        optstash.add_option(['SCF', 'DFT_COLLOCATION_REUSE'])
+        core.set_local_option('SCF', 'DFT_COLLOCATION_GRADIENT', True)
+        core.set_local_option('SCF', 'DFT_COLLOCATION_REUSE', True)
         ref_wfn = run_scf(name, **kwargs)
 
     if core.get_option('SCF', 'REFERENCE') in ['ROHF', 'CUHF']:
@@ -2697,6 +2707,8 @@ def run_scf_gradient(name, **kwargs):
         ref_wfn.set_variable("-D Gradient", disp_grad)
 
     grad = core.scfgrad(ref_wfn)
+    if ref_wfn.V_potential():
+        ref_wfn.V_potential().clear_collocation_cache()
 
     ref_wfn.set_gradient(grad)
 
@@ -3153,9 +3165,16 @@ def run_tdscf_energy(name, **kwargs):
         if name is None:
             raise ValidationError("TDSCF: No reference wave function!")
         else:
+            # Let the response Vx builds reuse the SCF collocation cache
+            optstash = p4util.OptionsState(['SCF', 'DFT_COLLOCATION_REUSE'])
+            core.set_local_option('SCF', 'DFT_COLLOCATION_REUSE', True)
             ref_wfn = run_scf(name.strip('td-'), **kwargs)
+            optstash.restore()
 
-    return run_tdscf_excitations(ref_wfn, **kwargs)
+    wfn = run_tdscf_excitations(ref_wfn, **kwargs)
+    if ref_wfn.V_potential():
+        ref_wfn.V_potential().clear_collocation_cache()
+    return wfn
 
 
 def run_scf_property(name, **kwargs):
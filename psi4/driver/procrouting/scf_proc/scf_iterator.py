@@ -140,11 +140,17 @@ def scf_initialize(self):
     # Figure out how large the DFT collocation matrices are
     vbase = self.V_potential()
     if vbase:
+        # Gradients need one more derivative than the potential, up to second derivs
+        self.collocation_deriv_ = vbase.functional().ansatz()
+        if core.get_option("SCF", "DFT_COLLOCATION_GRADIENT"):
+            self.collocation_deriv_ = min(self.collocation_deriv_ + 1, 2)
         collocation_size = vbase.grid().collocation_size()
-        if vbase.functional().ansatz() == 1:
+        if self.collocation_deriv_ == 1:
             collocation_size *= 4  # First derivs
-        elif vbase.functional().ansatz() == 2:
+        elif self.collocation_deriv_ == 2:
             collocation_size *= 10  # Second derivs
+        if core.get_option("SCF", "DFT_COLLOCATION_FP32"):
+            collocation_size //= 2
     else:
         collocation_size = 0
 
@@ -199,7 +205,7 @@ def scf_initialize(self):
         if initialize_jk_obj:
             self.initialize_jk(self.memory_jk_, jk=jk)
         if self.V_potential():
-            self.V_potential().build_collocation_cache(self.memory_collocation_)
+            self.V_potential().build_collocation_cache(self.memory_collocation_, self.collocation_deriv_)
         core.timer_on("HF: Form core H")
         self.form_H()
         core.timer_off("HF: Form core H")
@@ -346,6 +352,14 @@ def scf_iterate(self, e_conv=None, d_conv=None):
     # has early_screening changed from True to False?
     early_screening_disabled = False
 
+    # does the JK algorithm build J/K in single precision for early SCF iterations?
+    mixed_precision = False
+    if core.get_option('SCF', 'MIXED_PRECISION') and hasattr(self.jk(), 'set_mixed_precision'):
+        self.jk().set_mixed_precision(True)
+        mixed_precision = self.jk().get_mixed_precision()
+        if not mixed_precision:
+            core.print_out("  MIXED_PRECISION is not supported by this JK algorithm, ignoring.\n\n")
+
     # SCF iterations!
     SCFE_old = 0.0
     Dnorm = 0.0
@@ -379,6 +393,10 @@ def scf_iterate(self, e_conv=None, d_conv=None):
 
         # Check if special J/K construction algorithms were used
         incfock_performed = hasattr(self.jk(), "do_incfock_iter") and self.jk().do_incfock_iter()
+        if mixed_precision:
+            # the JK object may have fallen back to double precision, e.g. for lack of memory
+            mixed_precision = self.jk().get_mixed_precision()
+        fp32_performed = mixed_precision
         upcm = 0.0
         if core.get_option('SCF', 'PCM'):
             calc_type = core.PCM.CalcType.Total
@@ -527,6 +545,9 @@ def scf_iterate(self, e_conv=None, d_conv=None):
                 if incfock_performed:
                     status.append("INCFOCK")
 
+                if fp32_performed:
+                    status.append("FP32")
+
                 # Reset occupations if necessary
                 if (self.iteration_ == 0) and self.reset_occ_:
                     self.reset_occupation()
@@ -546,6 +567,12 @@ def scf_iterate(self, e_conv=None, d_conv=None):
             self.damping_update(damping_percentage * 0.01)
             status.append("DAMP={}%".format(round(damping_percentage)))
 
+        # single precision is only used until the orbital gradient is small
+        if mixed_precision and not ((self.iteration_ == 0) and self.sad_) and Dnorm < core.get_option(
+                'SCF', 'MIXED_PRECISION_CONVERGENCE'):
+            mixed_precision = False
+            self.jk().set_mixed_precision(False)
+
         if core.has_option_changed("SCF", "ORBITALS_WRITE"):
             filename = core.get_option("SCF", "ORBITALS_WRITE")
             self.to_file(filename)
@@ -580,7 +607,17 @@ def scf_iterate(self, e_conv=None, d_conv=None):
         # Call any postiteration callbacks
         if not ((self.iteration_ == 0) and self.sad_) and _converged(Ediff, Dnorm, e_conv=e_conv, d_conv=d_conv):
 
-            if early_screening:
+            if fp32_performed:
+
+                # converged energies must come from a double-precision Fock build
+                if mixed_precision:
+                    mixed_precision = False
+                    self.jk().set_mixed_precision(False)
+
+                core.print_out("  Energy and wave function converged with single-precision J/K.\n")
+                core.print_out("  Continuing SCF iterations in double precision.\n\n")
+
+            elif early_screening:
 
                 # we've reached convergence with early screning enabled; disable it
                 early_screening = False
@@ -798,7 +835,7 @@ def scf_finalize_energy(self):
 
     # TODO re-enable
     self.finalize()
-    if self.V_potential():
+    if self.V_potential() and not core.get_option("SCF", "DFT_COLLOCATION_REUSE"):
         self.V_potential().clear_collocation_cache()
 
     core.print_out("\nComputation Completed\n")
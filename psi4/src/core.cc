@@ -40,10 +40,12 @@
 
 #include "psi4/cc/cclambda/cclambda.h"
 #include "psi4/cc/ccwave.h"
+#include "psi4/libfock/cubature.h"
 #include "psi4/libmints/matrix.h"
 #include "psi4/libmints/matrix.h"
 #include "psi4/libmints/molecule.h"
 #include "psi4/libmints/pointgrp.h"
+#include "psi4/libmints/twobody.h"
 #include "psi4/libmints/vector.h"
 #include "psi4/libmints/wavefunction.h"
 #include "psi4/libmints/writer_file_prefix.h"
@@ -535,7 +537,11 @@ double py_psi_dummy_integratorxx(SharedWavefunction ref_wfn) {
 }
 #endif
 
-void py_psi_clean() { PSIOManager::shared_object()->psiclean(); }
+void py_psi_clean() {
+    PSIOManager::shared_object()->psiclean();
+    TwoBodyAOInt::clear_sieve_cache();
+    MolecularGrid::clear_cache();
+}
 
 void py_psi_print_options() { Process::environment.options.print(); }
 
@@ -31,6 +31,7 @@
 #include "psi4/libfock/jk.h"
 #include "psi4/libfock/soscf.h"
 #include "psi4/lib3index/denominator.h"
+#include "psi4/lib3index/dfcache.h"
 #include "psi4/lib3index/dftensor.h"
 #include "psi4/lib3index/dfhelper.h"
 #include "psi4/libmints/molecule.h"
@@ -74,6 +75,11 @@ void export_fock(py::module &m) {
         .def("get_omega_alpha", &JK::get_omega_alpha, "Weight for HF exchange term in range-separated DFT")
         .def("set_omega_beta", &JK::set_omega_beta, "Weight for dampened exchange term in range-separated DFT", "beta"_a)
         .def("get_omega_beta", &JK::get_omega_beta, "Weight for dampened exchange term in range-separated DFT")
+        .def("set_mixed_precision", &JK::set_mixed_precision,
+             "Contract in single precision where the algorithm supports it", "mixed_precision"_a)
+        .def("get_mixed_precision", &JK::get_mixed_precision, "Are J/K contracted in single precision?")
+        .def("single_precision_builds", &JK::single_precision_builds,
+             "Number of J/K builds contracted in single precision")
         .def("compute", &JK::compute)
         .def("finalize", &JK::finalize)
         .def("C_clear",
@@ -116,6 +122,10 @@ void export_fock(py::module &m) {
         .def("Imo", &DFTensor::Imo, "doctsring")
         .def("Idfmo", &DFTensor::Idfmo, "doctsring");
 
+    py::class_<DFCache>(m, "DFCache", "Persistent cache of density-fitting metrics and integrals")
+        .def_static("enabled", &DFCache::enabled, "Is caching on, i.e. is DF_CACHE_DIR set?")
+        .def_static("hits", &DFCache::hits, "Number of entries loaded so far by this process");
+
     py::class_<FittingMetric, std::shared_ptr<FittingMetric>>(m, "FittingMetric", "docstring")
         .def(py::init<std::shared_ptr<BasisSet>, bool>())
         .def("get_algorithm", &FittingMetric::get_algorithm, "docstring")
@@ -176,6 +186,12 @@ void export_fock(py::module &m) {
         .def("get_AO_core", &DFHelper::get_AO_core)
         .def("set_MO_core", &DFHelper::set_MO_core)
         .def("get_MO_core", &DFHelper::get_MO_core)
+        .def("set_mixed_precision", &DFHelper::set_mixed_precision)
+        .def("get_mixed_precision", &DFHelper::get_mixed_precision)
+        .def("set_shared_memory", &DFHelper::set_shared_memory)
+        .def("get_shared_memory", &DFHelper::get_shared_memory)
+        .def("shared_memory_attached", &DFHelper::shared_memory_attached,
+             "Did the last AO build attach to integrals another process placed in shared memory?")
         .def("add_space", &DFHelper::add_space)
         .def("initialize", &DFHelper::initialize)
         .def("print_header", &DFHelper::print_header)
@@ -194,7 +210,9 @@ void export_fock(py::module &m) {
         .def("dfh", &MemDFJK::dfh, "Return the DFHelper object.");
 
     py::class_<DirectJK, std::shared_ptr<DirectJK>, JK>(m, "DirectJK", "docstring")
-        .def("do_incfock_iter", &DirectJK::do_incfock_iter, "Was the last Fock build incremental?");
+        .def("do_incfock_iter", &DirectJK::do_incfock_iter, "Was the last Fock build incremental?")
+        .def("am_class_statistics", &DirectJK::am_class_statistics,
+             "Shell quartets, integrals, and seconds spent computing and digesting them per angular momentum class.");
 
     py::class_<CompositeJK, std::shared_ptr<CompositeJK>, JK>(m, "CompositeJK", "docstring")
         .def("do_incfock_iter", &CompositeJK::do_incfock_iter, "Was the last Fock build incremental?")
@@ -37,6 +37,7 @@
 #include "psi4/libmints/numinthelper.h"
 #include "psi4/libdisp/dispersion.h"
 #include "psi4/libfock/v.h"
+#include "psi4/libfock/collocation_cache.h"
 #include "psi4/libfock/points.h"
 #include "psi4/libfock/cubature.h"
 #include "psi4/libmints/basisset.h"
@@ -51,7 +52,10 @@ using namespace pybind11::literals;
 void export_functional(py::module &m) {
     py::class_<Functional, std::shared_ptr<Functional>>(m, "Functional", "docstring")
         .def_static("build_base", &Functional::build_base, "alias"_a, "docstring")
-        .def("compute_functional", &Functional::compute_functional, "docstring")
+        .def("compute_functional",
+             py::overload_cast<const std::map<std::string, SharedVector>&, const std::map<std::string, SharedVector>&,
+                               int, int>(&Functional::compute_functional),
+             "docstring")
         .def("name", &Functional::name, "docstring")
         .def("description", &Functional::description, "docstring")
         .def("citation", &Functional::citation, "docstring")
@@ -125,7 +129,9 @@ void export_functional(py::module &m) {
         .def_static("XC_build", &SuperFunctional::XC_build, "name"_a, "unpolarized"_a, "tweak"_a = py::dict{}, "Builds a SuperFunctional from a XC string.")
         .def("allocate", &SuperFunctional::allocate,
              "Allocates the vectors, should be called after ansatz or npoint changes.")
-        .def("compute_functional", &SuperFunctional::compute_functional,
+        .def("compute_functional",
+             py::overload_cast<const std::map<std::string, SharedVector>&, int, bool>(
+                 &SuperFunctional::compute_functional),
              "vals"_a, "npoints"_a = -1, "singlet"_a = true,
              "Computes the SuperFunctional.")
         .def("x_functional", &SuperFunctional::x_functional, "Returns the desired X Functional.")
@@ -239,6 +245,7 @@ void export_functional(py::module &m) {
         .def("max_points", &MolecularGrid::max_points, "Returns the maximum number of points in a block.")
         .def("max_functions", &MolecularGrid::max_functions, "Returns the maximum number of functions in a block.")
         .def("collocation_size", &MolecularGrid::collocation_size, "Returns the total collocation size of all blocks.")
+        .def_static("clear_cache", &MolecularGrid::clear_cache, "Drops all grids kept by the grid cache.")
         .def("blocks", &MolecularGrid::blocks, "Returns a list of blocks.")
         .def("atomic_blocks", &MolecularGrid::atomic_blocks, "Returns a list of blocks.");
 
@@ -252,6 +259,15 @@ void export_functional(py::module &m) {
             return std::make_shared<DFTGrid>(mol, basis, int_opts, string_opts, Process::environment.options);
         });
 
+    py::class_<CollocationCache, std::shared_ptr<CollocationCache>>(m, "CollocationCache",
+                                                                    "Cached DFT collocation of grid blocks")
+        .def("deriv", &CollocationCache::deriv, "Derivative level of the cached values, -1 if empty.")
+        .def("fp32", &CollocationCache::fp32, "Are the values stored in single precision?")
+        .def("ncached", &CollocationCache::ncached, "Number of cached blocks.")
+        .def("nblocks", &CollocationCache::nblocks, "Number of blocks of the cached grid.")
+        .def("memory", &CollocationCache::memory, "Size of the cached values in bytes.")
+        .def("hits", &CollocationCache::hits, "Number of blocks served from the cache since the last build.");
+
     py::class_<VBase, std::shared_ptr<VBase>>(m, "VBase", "docstring")
         .def_static("build",
                     [](std::shared_ptr<BasisSet> &basis, std::shared_ptr<SuperFunctional> &func, std::string type) {
@@ -266,9 +282,17 @@ void export_functional(py::module &m) {
         .def("get_block", &VBase::get_block, "Returns the requested BlockOPoints.")
         .def("nblocks", &VBase::nblocks, "Total number of blocks.")
         .def("quadrature_values", &VBase::quadrature_values, "Returns the quadrature values.")
-        .def("build_collocation_cache", &VBase::build_collocation_cache,
-             "Constructs a collocation cache to prevent recomputation.")
+        .def("build_collocation_cache", &VBase::build_collocation_cache, "memory"_a, "deriv"_a = -1,
+             "Constructs a collocation cache of at most memory doubles to prevent recomputation. A deriv of -1 caches "
+             "the derivatives the potential needs, a higher deriv lets gradients share the cache.")
         .def("clear_collocation_cache", &VBase::clear_collocation_cache, "Clears the collocation cache.")
+        .def("collocation_cache", &VBase::collocation_cache, "Returns the collocation cache.")
+        .def("function_screening_statistics", &VBase::function_screening_statistics,
+             "Returns the blocks and basis functions integrated by the last V build, and how many of them "
+             "DFT_FUNCTION_SCREENING kept.")
+        .def("vv10_screening_statistics", &VBase::vv10_screening_statistics,
+             "Returns the block pairs integrated by the last VV10 kernel, and how many of them DFT_VV10_SCREENING "
+             "skipped.")
         .def("set_D", &VBase::set_D, "Sets the internal density.")
         .def("Dao", &VBase::set_D, "Returns internal AO density.")
         .def("compute_V", &VBase::compute_V, "doctsring")
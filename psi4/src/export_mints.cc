@@ -1319,7 +1319,10 @@ void export_mints(py::module& m) {
         .def("shell_significant", compute_shell_significant(&TwoBodyAOInt::shell_significant),
              "Determines if the P,Q,R,S shell combination is significant")
         .def("update_density", &TwoBodyAOInt::update_density,
-             "Update density matrix (c1 symmetry) for Density-matrix based integral screening");
+             "Update density matrix (c1 symmetry) for Density-matrix based integral screening")
+        .def_static("sieve_cache_size", &TwoBodyAOInt::sieve_cache_size, "Number of sieves in the shared sieve cache")
+        .def_static("sieve_cache_hits", &TwoBodyAOInt::sieve_cache_hits,
+                    "Number of integral objects that took their sieve from the cache since it was last cleared");
 
     py::class_<Libint2TwoElectronInt, std::shared_ptr<Libint2TwoElectronInt>>(
         m, "TwoElectronInt", pyTwoBodyAOInt, "Computes two-electron repulsion integrals")
@@ -1653,6 +1656,8 @@ void export_mints(py::module& m) {
         .def("addBasis", &ExternalPotential::addBasis, "Add a basis of S auxiliary functions with DF coefficients",
              "basis"_a, "coefs"_a)
         .def("gradient_on_charges", &ExternalPotential::gradient_on_charges, "Get the gradient on the embedded charges")
+        .def("far_field_statistics", &ExternalPotential::far_field_statistics,
+             "Get the near, far and clustered charges summed over the shell-pair blocks of the last potential build")
         .def("clear", &ExternalPotential::clear, "Reset the field to zero (eliminates all entries)")
         .def("computePotentialMatrix", &ExternalPotential::computePotentialMatrix,
              "Compute the external potential matrix in the given basis set", "basis"_a)
@@ -40,5 +40,9 @@ void export_misc(py::module &m) {
     m.def("timer_off", timer_off, "label"_a, "Stop timer with *label*.");
     m.def("tstart", tstart, "Start module-level timer. Only one active at once.");
     m.def("tstop", tstop, "Stop module-level timer. Prints user, system, and total times to outfile.");
+    m.def("thread_timer_trace", thread_timer_trace, "enable"_a,
+          "Start or stop recording every thread-timer interval for :func:`psi4.core.thread_timer_write_trace`.");
+    m.def("thread_timer_write_trace", thread_timer_write_trace, "filename"_a,
+          "Write the recorded thread-timer intervals as a Chrome trace (JSON) timeline, one track per thread.");
     m.def("clean_timers", clean_timers, "Reinitialize timers for independent ``timer.dat`` entries. Vital when earlier independent calc finished improperly.");
 }
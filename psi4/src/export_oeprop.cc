@@ -63,6 +63,8 @@ void export_oeprop(py::module &m) {
         .def("Exvals", &OEProp::Exvals, "The x component of the field (in a.u.) at each grid point")
         .def("Eyvals", &OEProp::Eyvals, "The y component of the field (in a.u.) at each grid point")
         .def("Ezvals", &OEProp::Ezvals, "The z component of the field (in a.u.) at each grid point")
+        .def("compute_esp_over_grid_in_memory", &OEProp::compute_esp_over_grid_in_memory,
+             "Computes ESP on specified grid Nx3 (as SharedMatrix, in input units)", "input_grid"_a)
         .def("set_title", &OEProp::set_title,
              "Title OEProp for print purposes. As a side effect, saves variables as title + propertyname and only that. "
              "Follow up with side names, if the side effect is undesired,", "title"_a)
@@ -34,6 +34,16 @@ using namespace psi;
 namespace py = pybind11;
 using namespace pybind11::literals;
 
+namespace {
+
+py::dict iostats_to_dict(const psio_iostats &stats) {
+    return py::dict("nread"_a = stats.nread, "nwrite"_a = stats.nwrite, "read_bytes"_a = stats.read_bytes,
+                    "write_bytes"_a = stats.write_bytes, "read_time"_a = stats.read_time,
+                    "write_time"_a = stats.write_time, "latency"_a = py::cast(stats.latency));
+}
+
+}  // namespace
+
 void export_psio(py::module &m) {
 
     py::class_<psio_entry, std::shared_ptr<psio_entry>>(m, "psio_entry", "docstring");
@@ -59,6 +69,11 @@ void export_psio(py::module &m) {
         .def("tocscan", &PSIO::tocscan,
              "Seek string in binary file. This export is only good for catching None, as returned success object not "
              "exported.")
+        .def("mmapped", &PSIO::mmapped, "Return 1 if unit is served from memory-mapped volumes", "unit"_a)
+        .def("compressed", &PSIO::compressed, "Return 1 if unit is stored compressed", "unit"_a)
+        .def("print_zip_stats", &PSIO::print_zip_stats,
+             "Print the byte, ratio and timing counters of the compression layer for all compressed units",
+             "out"_a = "outfile")
         .def("getpid", &PSIO::getpid, "Lookup process id")
         .def("set_pid", &PSIO::set_pid, "Set process id", "pid"_a)
         .def_static("shared_object", &PSIO::shared_object, "Return the global shared object")
@@ -93,5 +108,43 @@ void export_psio(py::module &m) {
         .def("get_file_path", &PSIOManager::get_file_path, "Get the path for a specific file number", "fileno"_a)
         .def("set_specific_retention", &PSIOManager::set_specific_retention,
              "Set the specific file number to be retained", "fileno"_a, "retain"_a)
+        .def("set_specific_mmap", &PSIOManager::set_specific_mmap,
+             "Serve the specific file number from memory-mapped volumes the next time it is opened", "fileno"_a,
+             "mmap"_a)
+        .def("get_specific_mmap", &PSIOManager::get_specific_mmap,
+             "Inquire whether a specific file number is to be memory-mapped", "fileno"_a)
+        .def("mmap_opens", &PSIOManager::mmap_opens,
+             "Number of times a specific file number was opened with memory-mapped volumes", "fileno"_a)
+        .def("set_specific_compression", &PSIOManager::set_specific_compression,
+             "Compress the specific file number when it is next created. A positive tolerance selects the lossy "
+             "fixed-precision codec, for files holding nothing but doubles.",
+             "fileno"_a, "compress"_a, "tolerance"_a = 0.0)
+        .def("get_specific_compression", &PSIOManager::get_specific_compression,
+             "Inquire whether a specific file number is to be compressed", "fileno"_a)
+        .def("compressed_opens", &PSIOManager::compressed_opens,
+             "Number of times a specific file number was opened compressed", "fileno"_a)
+        .def("set_telemetry", &PSIOManager::set_telemetry,
+             "Start or stop collecting per-unit and per-entry I/O telemetry (bytes, operations, latency, bandwidth)",
+             "enable"_a)
+        .def_static("telemetry_enabled", &PSIOManager::telemetry_enabled, "Inquire whether I/O telemetry is collected")
+        .def("clear_telemetry", &PSIOManager::clear_telemetry, "Forget all I/O telemetry collected so far")
+        .def("print_telemetry", &PSIOManager::print_telemetry, "Print the I/O telemetry report", "out"_a = "outfile")
+        .def(
+            "telemetry",
+            [](PSIOManager &manager) {
+                py::dict ret;
+                for (const auto &kv : manager.unit_telemetry()) ret[py::int_(kv.first)] = iostats_to_dict(kv.second);
+                return ret;
+            },
+            "Return the I/O telemetry per file number as a dictionary of counters")
+        .def(
+            "entry_telemetry",
+            [](PSIOManager &manager) {
+                py::dict ret;
+                for (const auto &kv : manager.key_telemetry())
+                    ret[py::make_tuple(kv.first.first, kv.first.second)] = iostats_to_dict(kv.second);
+                return ret;
+            },
+            "Return the I/O telemetry per (file number, TOC key) as a dictionary of counters")
         .def("get_default_path", &PSIOManager::get_default_path, "Return the default path");
 }
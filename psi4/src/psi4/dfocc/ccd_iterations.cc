@@ -57,8 +57,7 @@ void DFOCC::ccd_iterations() {
     if (do_diis_ == 1) {
         if (reference_ == "RESTRICTED") {
             Matrix T2("T2", naoccA * navirA, naoccA * navirA);
-            ccsdDiisManager = std::make_shared<DIISManager>(
-                cc_maxdiis_, "CCSD DIIS T Amps", DIISManager::RemovalPolicy::LargestError, DIISManager::StoragePolicy::OnDisk);
+            ccsdDiisManager = make_diis_manager("CCSD DIIS T Amps");
             ccsdDiisManager->set_error_vector_size(T2);
             ccsdDiisManager->set_vector_size(T2);
         }
@@ -67,8 +66,7 @@ void DFOCC::ccd_iterations() {
             Matrix T2BB("T2BB", ntri_anti_ijBB, ntri_anti_abBB);
             Matrix T2AB("T2AB", naoccA * naoccB, navirA * navirB);
 
-            ccsdDiisManager = std::make_shared<DIISManager>(
-                cc_maxdiis_, "CCSD DIIS T Amps", DIISManager::RemovalPolicy::LargestError, DIISManager::StoragePolicy::OnDisk);
+            ccsdDiisManager = make_diis_manager("CCSD DIIS T Amps");
             ccsdDiisManager->set_error_vector_size(T2AA, T2BB, T2AB);
             ccsdDiisManager->set_vector_size(T2AA, T2BB, T2AB);
         }
@@ -57,8 +57,7 @@ void DFOCC::ccd_iterations_low() {
     if (do_diis_ == 1) {
         std::shared_ptr<Matrix> T2(new Matrix("T2", naoccA * navirA, naoccA * navirA));
         if (reference_ == "RESTRICTED") {
-            ccsdDiisManager = std::shared_ptr<DIISManager>(
-                new DIISManager(cc_maxdiis_, "CCSD DIIS T Amps", DIISManager::RemovalPolicy::LargestError, DIISManager::StoragePolicy::OnDisk));
+            ccsdDiisManager = make_diis_manager("CCSD DIIS T Amps");
             ccsdDiisManager->set_error_vector_size(T2.get());
             ccsdDiisManager->set_vector_size(T2.get());
         }
@@ -143,8 +143,7 @@ void DFOCC::ccdl_iterations() {
     if (do_diis_ == 1) {
         if (reference_ == "RESTRICTED") {
             Matrix L2("L2", naoccA * navirA, naoccA * navirA);
-            ccsdlDiisManager = std::make_shared<DIISManager>(
-                cc_maxdiis_, "CCDL DIIS L2 Amps", DIISManager::RemovalPolicy::LargestError, DIISManager::StoragePolicy::OnDisk);
+            ccsdlDiisManager = make_diis_manager("CCDL DIIS L2 Amps");
             ccsdlDiisManager->set_error_vector_size(L2);
             ccsdlDiisManager->set_vector_size(L2);
         }
@@ -153,8 +152,7 @@ void DFOCC::ccdl_iterations() {
             Matrix L2BB("L2BB", ntri_anti_ijBB, ntri_anti_abBB);
             Matrix L2AB("L2AB", naoccA * naoccB, navirA * navirB);
 
-            ccsdlDiisManager = std::make_shared<DIISManager>(
-                    cc_maxdiis_, "CCSDL DIIS L Amps", DIISManager::RemovalPolicy::LargestError, DIISManager::StoragePolicy::OnDisk);
+            ccsdlDiisManager = make_diis_manager("CCSDL DIIS L Amps");
             ccsdlDiisManager->set_error_vector_size(L2AA, L2BB, L2AB);
             ccsdlDiisManager->set_vector_size(L2AA, L2BB, L2AB);
         }
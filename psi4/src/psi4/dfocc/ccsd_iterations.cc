@@ -61,8 +61,7 @@ void DFOCC::ccsd_iterations() {
         if (reference_ == "RESTRICTED") {
             Matrix T2("T2", naoccA * navirA, naoccA * navirA);
             Matrix T1("T1", naoccA, navirA);
-            ccsdDiisManager = std::make_shared<DIISManager>(
-                cc_maxdiis_, "CCSD DIIS T Amps", DIISManager::RemovalPolicy::LargestError, DIISManager::StoragePolicy::OnDisk);
+            ccsdDiisManager = make_diis_manager("CCSD DIIS T Amps");
             ccsdDiisManager->set_error_vector_size(T2, T1);
             ccsdDiisManager->set_vector_size(T2, T1);
         }
@@ -74,8 +73,7 @@ void DFOCC::ccsd_iterations() {
             Matrix T1A("T1A", naoccA, navirA);
             Matrix T1B("T1B", naoccB, navirB);
 
-            ccsdDiisManager = std::make_shared<DIISManager>(
-                cc_maxdiis_, "CCSD DIIS T Amps", DIISManager::RemovalPolicy::LargestError, DIISManager::StoragePolicy::OnDisk);
+            ccsdDiisManager = make_diis_manager("CCSD DIIS T Amps");
             ccsdDiisManager->set_error_vector_size(T2AA, T2BB, T2AB, T1A, T1B);
             ccsdDiisManager->set_vector_size(T2AA, T2BB, T2AB, T1A, T1B);
             //=== END DFUCCSD ===
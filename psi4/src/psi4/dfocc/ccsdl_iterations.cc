@@ -195,8 +195,7 @@ void DFOCC::ccsdl_iterations() {
         if (reference_ == "RESTRICTED") {
             Matrix L2("L2", naoccA * navirA, naoccA * navirA);
             Matrix L1("L1", naoccA, navirA);
-            ccsdlDiisManager = std::make_shared<DIISManager>(
-                cc_maxdiis_, "CCSDL DIIS L Amps", DIISManager::RemovalPolicy::LargestError, DIISManager::StoragePolicy::OnDisk);
+            ccsdlDiisManager = make_diis_manager("CCSDL DIIS L Amps");
             ccsdlDiisManager->set_error_vector_size(L2, L1);
             ccsdlDiisManager->set_vector_size(L2, L1);
         }
@@ -208,8 +207,7 @@ void DFOCC::ccsdl_iterations() {
             Matrix L1A("L1A", naoccA, navirA);
             Matrix L1B("L1B", naoccB, navirB);
 
-            ccsdlDiisManager = std::make_shared<DIISManager>(
-                    cc_maxdiis_, "CCSDL DIIS L Amps", DIISManager::RemovalPolicy::LargestError, DIISManager::StoragePolicy::OnDisk);
+            ccsdlDiisManager = make_diis_manager("CCSDL DIIS L Amps");
             ccsdlDiisManager->set_error_vector_size(L2AA, L2BB, L2AB, L1A, L1B);
             ccsdlDiisManager->set_vector_size(L2AA, L2BB, L2AB, L1A, L1B);
             //=== END DFUCCSD ===
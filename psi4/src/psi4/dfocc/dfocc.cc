@@ -58,6 +58,9 @@ void DFOCC::common_init() {
     num_vecs = options_.get_int("MO_DIIS_NUM_VECS");
     cc_maxdiis_ = options_.get_int("CC_DIIS_MAX_VECS");
     cc_mindiis_ = options_.get_int("CC_DIIS_MIN_VECS");
+    cc_diis_storage_ = (options_.get_str("CC_DIIS_STORAGE") == "CORE") ? DIISManager::StoragePolicy::InCore
+                                                                      : DIISManager::StoragePolicy::OnDisk;
+    cc_diis_fp32_ = options_.get_bool("CC_DIIS_FP32");
     exp_cutoff = options_.get_int("CUTOFF");
     exp_int_cutoff = options_.get_int("INTEGRAL_CUTOFF");
     pcg_maxiter = options_.get_int("PCG_MAXITER");
@@ -254,6 +257,13 @@ void DFOCC::common_init() {
     }  // else if (reference_ == "UNRESTRICTED")
 }  // end common_init
 
+std::shared_ptr<DIISManager> DFOCC::make_diis_manager(const std::string& label) {
+    auto manager =
+        std::make_shared<DIISManager>(cc_maxdiis_, label, DIISManager::RemovalPolicy::LargestError, cc_diis_storage_);
+    manager->set_reduced_precision(cc_diis_fp32_);
+    return manager;
+}
+
 void DFOCC::title() {
     outfile->Printf("\n");
     outfile->Printf(" ============================================================================== \n");
@@ -44,6 +44,8 @@ namespace dfoccwave {
 
 class DFOCC : public Wavefunction {
     void common_init();
+    // DIIS manager with cc_maxdiis_ vectors and the storage chosen by CC_DIIS_STORAGE and CC_DIIS_FP32
+    std::shared_ptr<DIISManager> make_diis_manager(const std::string& label);
 
    public:
     DFOCC(SharedWavefunction ref_wfn, Options &options);
@@ -736,6 +738,8 @@ class DFOCC : public Wavefunction {
     int time4grad;         // If 0 it is not the time for grad, if 1 it is the time for grad
     int cc_maxdiis_;       // MAX Number of vectors used in CC diis
     int cc_mindiis_;       // MIN Number of vectors used in CC diis
+    DIISManager::StoragePolicy cc_diis_storage_;  // Where CC and orbital DIIS vectors are kept
+    bool cc_diis_fp32_;    // Keep DIIS vectors in single precision
     int trans_ab;          // 0 means do not transform, 1 means do transform B(Q, ab)
     int mo_optimized;      // 0 means MOs are not optimized, 1 means Mos are optimized
     int orbs_already_opt;  // 0 false, 1 true
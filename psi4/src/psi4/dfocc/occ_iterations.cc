@@ -117,7 +117,7 @@ void DFOCC::occ_iterations() {
     //fire up DIIS
     if (do_diis_ == 1) {
 //        outfile->Printf("firing up coupled DIIS...\n");
-      orbitalDIIS = std::make_shared<DIISManager>(cc_maxdiis_, "Orbital Optimized DIIS", DIISManager::RemovalPolicy::LargestError, DIISManager::StoragePolicy::OnDisk); //initialize DIIS manager
+      orbitalDIIS = make_diis_manager("Orbital Optimized DIIS"); //initialize DIIS manager
       auto kappa_barA_ = std::make_shared<Vector>("Kappa_barA",nidpA);
       if (reference_ == "RESTRICTED" ) {
         if (wfn_type_ == "DF-OMP2" || wfn_type_ == "DF-OLCCD" ||  wfn_type_ == "DF-OREMP") {
@@ -0,0 +1,185 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2025 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+#include "dfcache.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#ifdef _MSC_VER
+#include <process.h>
+#define SYSTEM_GETPID ::_getpid
+#else
+#include <unistd.h>
+#define SYSTEM_GETPID ::getpid
+#endif
+
+#include "psi4/psi4-dec.h"
+#include "psi4/liboptions/liboptions.h"
+#include "psi4/libmints/basisset.h"
+#include "psi4/libmints/matrix.h"
+#include "psi4/libpsi4util/PsiOutStream.h"
+#include "psi4/libpsi4util/process.h"
+
+namespace psi {
+
+namespace {
+
+const uint64_t dfcache_magic = 0x3145484341434644ULL;  // "DFCACHE1"
+
+/* Two FNV-1a streams with different offset bases, giving a 128-bit key */
+struct DFCacheHasher {
+    uint64_t h1 = 0xcbf29ce484222325ULL;
+    uint64_t h2 = 0x84222325cbf29ce4ULL;
+
+    void add(const void* data, size_t n) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < n; i++) {
+            h1 = (h1 ^ bytes[i]) * 0x100000001b3ULL;
+            h2 = (h2 ^ bytes[i]) * 0x100000001b3ULL;
+            h2 ^= h2 >> 29;
+        }
+    }
+    template <typename T>
+    void add(T value) {
+        add(&value, sizeof(T));
+    }
+    void add(const std::string& str) {
+        add(str.size());
+        add(str.data(), str.size());
+    }
+    void add(std::shared_ptr<BasisSet> basis) {
+        if (!basis) {
+            add(std::string("none"));
+            return;
+        }
+        add(basis->nbf());
+        add(basis->nshell());
+        for (int P = 0; P < basis->nshell(); P++) {
+            const GaussianShell& shell = basis->shell(P);
+            add(shell.am());
+            add(shell.is_pure());
+            add(shell.nprimitive());
+            for (int K = 0; K < shell.nprimitive(); K++) {
+                add(shell.exp(K));
+                add(shell.original_coef(K));
+            }
+            add(shell.center(), 3 * sizeof(double));
+        }
+    }
+    std::string hex() const {
+        char str[33];
+        std::snprintf(str, sizeof(str), "%016llx%016llx", (unsigned long long)h1, (unsigned long long)h2);
+        return str;
+    }
+};
+
+std::string dfcache_path(const std::string& key) { return DFCache::directory() + "/" + key + ".dfc"; }
+
+/// Entries loaded by this process
+std::atomic<size_t> dfcache_hits(0);
+
+}  // namespace
+
+std::string DFCache::directory() {
+    std::string dir = Process::environment.options.get_str("DF_CACHE_DIR");
+    while (dir.size() > 1 && dir.back() == '/') dir.pop_back();
+    return dir;
+}
+
+std::string DFCache::key(const std::string& kind, std::shared_ptr<BasisSet> primary, std::shared_ptr<BasisSet> aux,
+                         const std::vector<double>& params) {
+    DFCacheHasher hasher;
+    hasher.add(kind);
+    hasher.add(primary);
+    hasher.add(aux);
+    // The integrals themselves depend on the engine and its own screening
+    hasher.add(Process::environment.options.get_str("INTEGRAL_PACKAGE"));
+    hasher.add(Process::environment.options.get_double("INTS_TOLERANCE"));
+    hasher.add(params.size());
+    for (double param : params) hasher.add(param);
+    return hasher.hex();
+}
+
+bool DFCache::load(const std::string& key, double* buffer, size_t size) {
+    if (!enabled()) return false;
+    FILE* fh = std::fopen(dfcache_path(key).c_str(), "rb");
+    if (fh == nullptr) return false;
+
+    uint64_t magic = 0, stored_size = 0;
+    char stored_key[32];
+    bool hit = std::fread(&magic, sizeof(magic), 1, fh) == 1 && magic == dfcache_magic &&
+               std::fread(stored_key, sizeof(stored_key), 1, fh) == 1 &&
+               key.size() == sizeof(stored_key) && std::memcmp(stored_key, key.data(), sizeof(stored_key)) == 0 &&
+               std::fread(&stored_size, sizeof(stored_size), 1, fh) == 1 && stored_size == size &&
+               std::fread(buffer, sizeof(double), size, fh) == size;
+    std::fclose(fh);
+
+    if (hit) dfcache_hits++;
+    if (hit && Process::environment.options.get_int("PRINT") > 1)
+        outfile->Printf("  DFCache: loaded %s (%.3f MiB)\n", key.c_str(), size * sizeof(double) / 1048576.0);
+    return hit;
+}
+
+size_t DFCache::hits() { return dfcache_hits; }
+
+void DFCache::store(const std::string& key, const double* buffer, size_t size) {
+    if (!enabled()) return;
+    const std::string path = dfcache_path(key);
+    const std::string tmp = path + ".tmp." + std::to_string(SYSTEM_GETPID());
+
+    FILE* fh = std::fopen(tmp.c_str(), "wb");
+    bool ok = fh != nullptr;
+    if (ok) {
+        const uint64_t magic = dfcache_magic, stored_size = size;
+        ok = std::fwrite(&magic, sizeof(magic), 1, fh) == 1 && std::fwrite(key.data(), 1, key.size(), fh) == key.size() &&
+             std::fwrite(&stored_size, sizeof(stored_size), 1, fh) == 1 &&
+             std::fwrite(buffer, sizeof(double), size, fh) == size;
+        ok = (std::fclose(fh) == 0) && ok;
+        // Readers only ever see complete entries
+        ok = ok && std::rename(tmp.c_str(), path.c_str()) == 0;
+    }
+    if (!ok) {
+        std::remove(tmp.c_str());
+        outfile->Printf("  DFCache: unable to store %s in %s; continuing without it.\n", key.c_str(),
+                        directory().c_str());
+    }
+}
+
+SharedMatrix DFCache::load_matrix(const std::string& key, int rows, int cols) {
+    auto M = std::make_shared<Matrix>(rows, cols);
+    if (!load(key, M->pointer()[0], rows * (size_t)cols)) return nullptr;
+    return M;
+}
+
+void DFCache::store_matrix(const std::string& key, SharedMatrix M) {
+    store(key, M->pointer()[0], M->rowspi()[0] * (size_t)M->colspi()[0]);
+}
+
+}  // namespace psi
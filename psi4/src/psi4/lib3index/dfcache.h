@@ -0,0 +1,100 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2025 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+#ifndef THREE_INDEX_DFCACHE
+#define THREE_INDEX_DFCACHE
+
+#include "psi4/pragma.h"
+#include "psi4/libmints/typedefs.h"
+
+#include <string>
+#include <vector>
+
+namespace psi {
+
+class BasisSet;
+
+/*!
+ * Persistent, content-addressed cache of density-fitting quantities (fitting
+ * metrics and their powers, three-index integrals) shared between
+ * calculations, e.g. the steps of a geometry scan that revisit a geometry or
+ * an SCF followed by DF-MP2 and SAPT on the same system.
+ *
+ * Entries live in the directory given by the DF_CACHE_DIR option; caching is
+ * off while it is empty. Each entry is named by a hash of everything its
+ * values depend on: the kind of quantity, the shells (angular momenta,
+ * exponents, contraction coefficients and centers, hence the geometry) of
+ * the primary and auxiliary basis sets, the integral package and tolerance,
+ * and caller-supplied parameters such as screening thresholds or the metric
+ * power. The key and the entry size are repeated in the file header and
+ * checked on load, so a truncated or foreign file is a miss rather than an
+ * error. Files are written under a temporary name and renamed into
+ * place, so concurrent jobs sharing a directory never read partial entries.
+ */
+class PSI_API DFCache {
+   public:
+    /// The cache directory (the DF_CACHE_DIR option), empty if caching is off
+    static std::string directory();
+    /// Is caching on?
+    static bool enabled() { return !directory().empty(); }
+
+    /*!
+     * Key of a cached quantity
+     * \param kind name of the quantity, e.g. "metric^-0.5"
+     * \param primary primary basis set, or nullptr if the quantity involves only the auxiliary basis
+     * \param aux auxiliary basis set
+     * \param params anything else the values depend on (thresholds, powers, layout flags)
+     */
+    static std::string key(const std::string& kind, std::shared_ptr<BasisSet> primary, std::shared_ptr<BasisSet> aux,
+                           const std::vector<double>& params = {});
+
+    /*!
+     * Fill buffer from the cache
+     * \param key entry, from key()
+     * \param buffer destination of size doubles
+     * \param size number of doubles expected
+     * \return was the entry present and intact?
+     */
+    static bool load(const std::string& key, double* buffer, size_t size);
+    /*!
+     * Store size doubles under key. Failures (e.g. a full disk) are reported
+     * to the output and otherwise ignored; the cache is an optimization.
+     */
+    static void store(const std::string& key, const double* buffer, size_t size);
+    /// Number of entries loaded so far by this process
+    static size_t hits();
+
+    /// Load a rows x cols matrix, or return nullptr on a miss
+    static SharedMatrix load_matrix(const std::string& key, int rows, int cols);
+    /// Store a matrix under key
+    static void store_matrix(const std::string& key, SharedMatrix M);
+};
+
+}  // namespace psi
+
+#endif
@@ -58,6 +58,8 @@
 #include "psi4/libpsio/psio.h"
 #include "psi4/libpsio/aiohandler.h"
 
+#include "dfcache.h"
+#include "dfshm.h"
 #include "dftensor.h"
 
 namespace psi {
@@ -73,7 +75,8 @@ DFHelper::DFHelper(std::shared_ptr<BasisSet> primary, std::shared_ptr<BasisSet>
         // Needed b/c the enough_mem ? mem : disk memory logic is slightly different from the DFHelper memory logic, so one can hit MemDF+Disk_algorithm by accident.
         subalgo_ = "INCORE";
     }
-    
+    shared_memory_ = Process::environment.options.get_bool("DF_SHARED_MEMORY");
+
     nbf_ = primary_->nbf();
     naux_ = aux_->nbf();
     prepare_blocking();
@@ -511,7 +514,14 @@ void DFHelper::prepare_AO_wK() {
     std::vector<std::pair<size_t, size_t>> psteps;
     std::pair<size_t, size_t> plargest = pshell_blocks_for_AO_build(memory_, 0, psteps);
 }
+void DFHelper::set_mixed_precision(bool mixed) {
+    mixed_precision_ = mixed;
+    if (!mixed) Ppq_sp_.reset();
+}
 void DFHelper::prepare_AO_core() {
+    // any single-precision copy belongs to the previous AOs
+    Ppq_sp_.reset();
+
     // get each thread an eri object
     std::shared_ptr<BasisSet> zero = BasisSet::zero_ao_basis_set();
     auto rifactory = std::make_shared<IntegralFactory>(aux_, zero, primary_, primary_);
@@ -531,15 +541,34 @@ void DFHelper::prepare_AO_core() {
     std::vector<std::pair<size_t, size_t>> psteps;
     std::pair<size_t, size_t> plargest = pshell_blocks_for_AO_build(memory_, 1, psteps);
 
-    // allocate final AO vector
-    if (direct_iaQ_) {
-        Ppq_ = std::unique_ptr<double[]>(new double[naux_ * nbf_ * nbf_]);
+    // the finished tensor depends only on the basis sets, the screening, the metric and the layout
+    std::string cache_key = DFCache::key("DFHelper AO", primary_, aux_,
+                                         {cutoff_, mpower_, condition_, (double)direct_iaQ_, (double)direct_});
+    size_t cache_size = (direct_iaQ_ ? naux_ * nbf_ * nbf_ : big_skips_[nbf_]);
+
+    // allocate final AO vector, possibly in shared memory already filled by another process
+    std::shared_ptr<DFSharedTensor> segment;
+    if (shared_memory_) segment = DFSharedTensor::open(cache_key, cache_size);
+    shared_memory_attached_ = segment && !segment->owner();
+    if (segment) {
+        Ppq_ = std::unique_ptr<double[], std::function<void(double*)>>(segment->data(), [segment](double*) {});
+        if (!segment->owner()) {
+            if (print_lvl_ > 0) outfile->Printf("  DFHelper: attached to AO integrals in shared memory.\n\n");
+            if (!direct_iaQ_ && !direct_ && hold_met_) metrics_.clear();
+            return;
+        }
     } else {
-        Ppq_ = std::unique_ptr<double[]>(new double[big_skips_[nbf_]]);
+        Ppq_ = std::unique_ptr<double[]>(new double[cache_size]);
     }
 
     double* ppq = Ppq_.get();
 
+    if (DFCache::load(cache_key, ppq, cache_size)) {
+        if (!direct_iaQ_ && !direct_ && hold_met_) metrics_.clear();
+        if (segment) segment->publish();
+        return;
+    }
+
     // outfile->Printf("\n    ==> Begin AO Blocked Construction <==\n\n");
     if (direct_iaQ_ || direct_) {
         timer_on("DFH: AO Construction");
@@ -584,6 +613,8 @@ void DFHelper::prepare_AO_core() {
         // no more need for metrics
         if (hold_met_) metrics_.clear();
     }
+    DFCache::store(cache_key, ppq, cache_size);
+    if (segment) segment->publish();
     // outfile->Printf("\n    ==> End AO Blocked Construction <==");
 }
 void DFHelper::prepare_AO_wK_core() {
@@ -1432,11 +1463,30 @@ void DFHelper::grab_AO(const size_t start, const size_t stop, double* Mp) {
 }
 void DFHelper::prepare_metric_core() {
     timer_on("DFH: metric construction");
-    FittingMetric J(aux_, true);
-    J.form_fitting_metric();
-    metrics_[1.0] = J.get_metric();
+    metrics_[1.0] = fitting_metric();
     timer_off("DFH: metric construction");
 }
+SharedMatrix DFHelper::fitting_metric() {
+    std::string key = DFCache::key("metric", nullptr, aux_);
+    SharedMatrix metric = DFCache::load_matrix(key, naux_, naux_);
+    if (!metric) {
+        FittingMetric J(aux_, true);
+        J.form_fitting_metric();
+        metric = J.get_metric();
+        DFCache::store_matrix(key, metric);
+    }
+    return metric;
+}
+void DFHelper::metric_power(SharedMatrix metric, double m_pow) {
+    std::string key = DFCache::key("metric power", nullptr, aux_, {m_pow, condition_});
+    SharedMatrix cached = DFCache::load_matrix(key, naux_, naux_);
+    if (cached) {
+        metric->copy(cached);
+    } else {
+        metric->power(m_pow, condition_);
+        DFCache::store_matrix(key, metric);
+    }
+}
 double* DFHelper::metric_prep_core(double m_pow) {
     bool on = false;
     double power;
@@ -1453,7 +1503,7 @@ double* DFHelper::metric_prep_core(double m_pow) {
         if ( fabs(m_pow - 1.0) < 1e-13 ) {
             return J->pointer()[0];
         } else {
-            J->power(power, condition_);
+            metric_power(J, power);
         }
         metrics_[power] = J;
     }
@@ -1461,9 +1511,7 @@ double* DFHelper::metric_prep_core(double m_pow) {
 }
 void DFHelper::prepare_metric() {
     // construct metric
-    FittingMetric J(aux_, true);
-    J.form_fitting_metric();
-    auto metric = J.get_metric();
+    auto metric = fitting_metric();
     auto Mp = metric->pointer()[0];
 
     // create file
@@ -1500,7 +1548,7 @@ std::string DFHelper::compute_metric(double m_pow) {
 
         // get and compute
         get_tensor_(std::get<0>(files_[filename]), metp, 0, naux_ - 1, 0, naux_ - 1);
-        metric->power(m_pow, condition_);
+        metric_power(metric, m_pow);
 
         // make new file
         std::string name = "metric";
@@ -3021,11 +3069,26 @@ void DFHelper::build_JK(std::vector<SharedMatrix> Cleft, std::vector<SharedMatri
     bool store_k = do_K;
     if ( do_wK && wcombine_ ) { do_K = false; } 
 
+    // the single-precision path needs the in-core sparse AOs and room for a float copy of them
+    bool single = mixed_precision_ && AO_core_ && !direct_iaQ_ && !wcombine_;
+    if (single && !Ppq_sp_ && memory_ < required_core_size_ + (big_skips_[nbf_] + 1) / 2) {
+        if (print_lvl_ > 0) {
+            outfile->Printf("  DFHelper: not enough memory for single-precision AOs, J/K stay in double precision.\n\n");
+        }
+        mixed_precision_ = false;
+        single = false;
+    }
+
     // This was an if-else statement. Presumably, we could manage J construction
     //   to more effectively manage memory, so I think that was what was going on.
     if (do_J || do_K) {
         timer_on("DFH: compute_JK()");
-        compute_JK(Cleft, Cright, D, J, K, max_nocc, do_J, do_K, do_wK, lr_symmetric);
+        if (single) {
+            compute_JK_sp(Cleft, Cright, D, J, K, max_nocc, do_J, do_K, lr_symmetric);
+            single_precision_builds_++;
+        } else {
+            compute_JK(Cleft, Cright, D, J, K, max_nocc, do_J, do_K, do_wK, lr_symmetric);
+        }
         timer_off("DFH: compute_JK()");
     }
 
@@ -3437,4 +3500,173 @@ void DFHelper::compute_wK(std::vector<SharedMatrix> Cleft, std::vector<SharedMat
     }
 }
 
+void DFHelper::compute_JK_sp(std::vector<SharedMatrix> Cleft, std::vector<SharedMatrix> Cright,
+                             std::vector<SharedMatrix> D, std::vector<SharedMatrix> J, std::vector<SharedMatrix> K,
+                             size_t max_nocc, bool do_J, bool do_K, bool lr_symmetric) {
+    std::vector<std::pair<size_t, size_t>> Qsteps;
+    std::tuple<size_t, size_t> info = Qshell_blocks_for_JK_build(Qsteps, max_nocc, lr_symmetric);
+    size_t totsb = std::get<1>(info);
+
+    // single-precision AOs, converted once and kept until mixed precision is switched off
+    if (!Ppq_sp_) {
+        timer_on("DFH: FP32 AO copy");
+        size_t size = big_skips_[nbf_];
+        Ppq_sp_ = std::make_unique<float[]>(size);
+        float* sp = Ppq_sp_.get();
+        double* dp = Ppq_.get();
+#pragma omp parallel for simd num_threads(nthreads_) schedule(static)
+        for (size_t i = 0; i < size; i++) {
+            sp[i] = static_cast<float>(dp[i]);
+        }
+        timer_off("DFH: FP32 AO copy");
+    }
+    float* Mp = Ppq_sp_.get();
+
+    std::vector<std::vector<float>> C_buffers(nthreads_);
+#pragma omp parallel num_threads(nthreads_)
+    {
+        int rank = 0;
+#ifdef _OPENMP
+        rank = omp_get_thread_num();
+#endif
+        C_buffers[rank] = std::vector<float>(nbf_ * std::max(max_nocc, nbf_));
+    }
+
+    // same sizing as compute_JK
+    size_t Ktmp_size = (!max_nocc ? totsb * 1 : totsb * max_nocc);
+    Ktmp_size = std::max(Ktmp_size * nbf_, nthreads_ * naux_);
+    Ktmp_size = std::max(Ktmp_size, nbf_ * nbf_);
+    std::vector<float> T1(Ktmp_size);
+    std::vector<float> T2(lr_symmetric ? std::max(nbf_ * nbf_, nthreads_ * naux_) : Ktmp_size);
+    std::vector<float> Kblock(do_K ? nbf_ * nbf_ : 0);
+    float* T1p = T1.data();
+    float* T2p = T2.data();
+
+    // the densities and orbitals only need converting once per build
+    std::vector<std::vector<float>> Dsp, Clsp, Crsp;
+    if (do_J) {
+        for (const auto& Dmat : D) {
+            double* Dp = Dmat->pointer()[0];
+            Dsp.emplace_back(Dp, Dp + nbf_ * nbf_);
+        }
+    }
+    if (do_K) {
+        for (size_t i = 0; i < K.size(); i++) {
+            size_t nocc = Cleft[i]->colspi()[0];
+            double* Clp = (nocc ? Cleft[i]->pointer()[0] : nullptr);
+            double* Crp = (nocc ? Cright[i]->pointer()[0] : nullptr);
+            Clsp.emplace_back(Clp, Clp + nbf_ * nocc);
+            Crsp.emplace_back(Crp, Crp + nbf_ * nocc);
+        }
+    }
+
+    size_t bcount = 0;
+    for (const auto& Qstep : Qsteps) {
+        auto begin = Qshell_aggs_[std::get<0>(Qstep)];
+        auto end = Qshell_aggs_[std::get<1>(Qstep) + 1] - 1;
+        auto block_size = end - begin + 1;
+
+        if (do_J) {
+            timer_on("DFH: compute_J");
+            for (size_t i = 0; i < J.size(); i++) {
+                float* Dp = Dsp[i].data();
+                double* Jp = J[i]->pointer()[0];
+                std::fill(T1p, T1p + nthreads_ * naux_, 0.0f);
+
+#pragma omp parallel for schedule(guided) num_threads(nthreads_)
+                for (size_t k = 0; k < nbf_; k++) {
+                    size_t sp_size = small_skips_[k];
+                    size_t jump = big_skips_[k] + bcount * sp_size;
+
+                    int rank = 0;
+#ifdef _OPENMP
+                    rank = omp_get_thread_num();
+#endif
+                    for (size_t m = 0, sp_count = -1; m < nbf_; m++) {
+                        if (schwarz_fun_index_[k * nbf_ + m]) {
+                            sp_count++;
+                            C_buffers[rank][sp_count] = Dp[nbf_ * k + m];
+                        }
+                    }
+                    // (Qm)(m) -> (Q)
+                    C_SGEMV('N', block_size, sp_size, 1.0f, &Mp[jump], sp_size, &C_buffers[rank][0], 1, 1.0f,
+                            &T1p[rank * naux_], 1);
+                }
+
+                // reduce
+                for (size_t k = 1; k < nthreads_; k++) {
+                    for (size_t l = 0; l < naux_; l++) T1p[l] += T1p[k * naux_ + l];
+                }
+
+// complete pruned J
+#pragma omp parallel for schedule(guided) num_threads(nthreads_)
+                for (size_t k = 0; k < nbf_; k++) {
+                    size_t sp_size = small_skips_[k];
+                    size_t jump = big_skips_[k] + bcount * sp_size;
+                    C_SGEMV('T', block_size, sp_size, 1.0f, &Mp[jump], sp_size, T1p, 1, 0.0f, &T2p[k * nbf_], 1);
+                }
+
+                // unpack from sparse to dense, accumulating in double precision
+                for (size_t k = 0; k < nbf_; k++) {
+                    for (size_t m = 0, count = -1; m < nbf_; m++) {
+                        if (schwarz_fun_index_[k * nbf_ + m]) {
+                            count++;
+                            Jp[k * nbf_ + m] += T2p[k * nbf_ + count];
+                        }
+                    }
+                }
+            }
+            timer_off("DFH: compute_J");
+        }
+
+        if (do_K) {
+            timer_on("DFH: compute_K");
+            for (size_t i = 0; i < K.size(); i++) {
+                size_t nocc = Cleft[i]->colspi()[0];
+                if (!nocc) {
+                    continue;
+                }
+                double* Kp = K[i]->pointer()[0];
+
+                first_transform_pQq_sp(nocc, bcount, block_size, Mp, T1p, Clsp[i].data(), C_buffers);
+                float* Trp = T1p;
+                if (!lr_symmetric) {
+                    first_transform_pQq_sp(nocc, bcount, block_size, Mp, T2p, Crsp[i].data(), C_buffers);
+                    Trp = T2p;
+                }
+
+                C_SGEMM('N', 'T', nbf_, nbf_, nocc * block_size, 1.0f, T1p, nocc * block_size, Trp,
+                        nocc * block_size, 0.0f, Kblock.data(), nbf_);
+                for (size_t mn = 0; mn < nbf_ * nbf_; mn++) Kp[mn] += Kblock[mn];
+            }
+            timer_off("DFH: compute_K");
+        }
+
+        bcount += block_size;
+    }
+}
+void DFHelper::first_transform_pQq_sp(size_t bsize, size_t bcount, size_t block_size, float* Mp, float* Tp,
+                                      float* Bp, std::vector<std::vector<float>>& C_buffers) {
+#pragma omp parallel for schedule(guided) num_threads(nthreads_)
+    for (size_t k = 0; k < nbf_; k++) {
+        size_t sp_size = small_skips_[k];
+        size_t jump = big_skips_[k] + bcount * sp_size;
+
+        int rank = 0;
+#ifdef _OPENMP
+        rank = omp_get_thread_num();
+#endif
+        for (size_t m = 0, sp_count = -1; m < nbf_; m++) {
+            if (schwarz_fun_index_[k * nbf_ + m]) {
+                sp_count++;
+                std::copy(&Bp[m * bsize], &Bp[(m + 1) * bsize], &C_buffers[rank][sp_count * bsize]);
+            }
+        }
+
+        // (Qm)(mb)->(Qb)
+        C_SGEMM('N', 'N', block_size, bsize, sp_size, 1.0f, &Mp[jump], sp_size, &C_buffers[rank][0], bsize, 0.0f,
+                &Tp[k * block_size * bsize], bsize);
+    }
+}
+
 }  // End namespaces
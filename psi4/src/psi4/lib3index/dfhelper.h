@@ -33,6 +33,7 @@
 #include <psi4/libmints/typedefs.h>
 #include "psi4/libpsi4util/exception.h"
 
+#include <functional>
 #include <map>
 #include <list>
 #include <vector>
@@ -126,6 +127,30 @@ class PSI_API DFHelper {
     void set_MO_core(bool core) { MO_core_ = core; }
     bool get_MO_core() { return MO_core_; }
 
+    ///
+    /// Places the in-core AO integrals in a POSIX shared-memory segment,
+    /// which other processes building the same integrals (same basis sets,
+    /// geometry, screening and metric) attach read-only instead of
+    /// recomputing. Defaults to the DF_SHARED_MEMORY option. Ignored for wK.
+    /// @param shared True to share
+    ///
+    void set_shared_memory(bool shared) { shared_memory_ = shared; }
+    bool get_shared_memory() { return shared_memory_; }
+    /// Did the last AO build attach to integrals another process placed in shared memory?
+    bool shared_memory_attached() { return shared_memory_attached_; }
+
+    ///
+    /// Builds J and K from a single-precision copy of the in-core AO
+    /// integrals, halving the memory traffic of the contractions at the cost
+    /// of errors of order 1e-7 relative. Meant for early SCF iterations;
+    /// switching it off frees the copy. Ignored out-of-core and for wK.
+    /// @param mixed True to contract in single precision
+    ///
+    void set_mixed_precision(bool mixed);
+    bool get_mixed_precision() { return mixed_precision_; }
+    /// Number of J/K builds contracted in single precision
+    size_t single_precision_builds() { return single_precision_builds_; }
+
     /// schwarz screening cutoff (defaults to 1e-12)
     void set_schwarz_cutoff(double cutoff) { cutoff_ = cutoff; }
     double get_schwarz_cutoff() { return cutoff_; }
@@ -374,10 +399,17 @@ class PSI_API DFHelper {
     // INCORE forces the in-core subalgorithm (AO_core_ = true)
     // OUT_OF_CORE forces the out-of-core subalgorithm (AO_core_ = false)
     std::string subalgo_ = "AUTO";
+    bool shared_memory_ = false;
+    bool shared_memory_attached_ = false;
+    bool mixed_precision_ = false;
+    size_t single_precision_builds_ = 0;
 
     // => in-core machinery <=
     void AO_core(bool set_AO_core);
-    std::unique_ptr<double[]> Ppq_;
+    // The deleter releases either private memory or a shared-memory segment
+    std::unique_ptr<double[], std::function<void(double*)>> Ppq_;
+    // Single-precision copy of Ppq_ for mixed-precision J/K builds
+    std::unique_ptr<float[]> Ppq_sp_;
     // Maps x -> (P|Q) ^ x.
     std::map<double, SharedMatrix> metrics_;
 
@@ -471,6 +503,10 @@ class PSI_API DFHelper {
     void prepare_metric();
     // Create J and cache it in metrics_.
     void prepare_metric_core();
+    // J, from the DF cache when possible.
+    SharedMatrix fitting_metric();
+    // Raise metric to m_pow in place, from the DF cache when possible.
+    void metric_power(SharedMatrix metric, double m_pow);
     double* metric_prep_core(double m_pow);
     std::string return_metfile(double m_pow);
     std::string compute_metric(double m_pow);
@@ -590,6 +626,14 @@ class PSI_API DFHelper {
     void compute_wK(std::vector<SharedMatrix> Cleft, std::vector<SharedMatrix> Cright, std::vector<SharedMatrix> wK,
                     size_t max_nocc, bool do_J, bool do_K, bool do_wK);
 
+    // => single-precision JK <=
+    // Same contractions as compute_J and compute_K against Ppq_sp_, accumulated into the double J and K
+    void compute_JK_sp(std::vector<SharedMatrix> Cleft, std::vector<SharedMatrix> Cright, std::vector<SharedMatrix> D,
+                       std::vector<SharedMatrix> J, std::vector<SharedMatrix> K, size_t max_nocc, bool do_J, bool do_K,
+                       bool lr_symmetric);
+    void first_transform_pQq_sp(size_t bsize, size_t bcount, size_t block_size, float* Mp, float* Tp, float* Bp,
+                                std::vector<std::vector<float>>& C_buffers);
+
     // => misc <=
     // Utility function to fill double* with zero in parallel
     void fill(double* b, size_t count, double value);
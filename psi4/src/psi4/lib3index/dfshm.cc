@@ -0,0 +1,206 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2025 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+#include "dfshm.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#ifndef _MSC_VER
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace psi {
+
+/*
+ * Lives at the start of the segment, on a page of its own so the tensor can be protected separately.
+ * Attaching and detaching hold an exclusive flock on the segment, so the last detacher's unlink can
+ * not interleave with a late attacher taking a reference.
+ */
+struct DFSharedHeader {
+    uint64_t magic;
+    uint64_t size;
+    char key[32];
+    /// Process that creates and fills the segment
+    int64_t creator;
+    /// 0 while the owner fills the tensor, 1 once published
+    std::atomic<uint32_t> ready;
+    /// 1 once the name has been unlinked; the name may since refer to a newer segment
+    uint32_t unlinked;
+    /// Processes attached
+    int32_t refs;
+};
+
+namespace {
+const uint64_t dfshm_magic = 0x314d485348464444ULL;  // "DDFHSHM1"
+}
+
+DFSharedTensor::DFSharedTensor(const std::string& name, int fd, DFSharedHeader* header, size_t bytes, size_t offset,
+                               bool owner)
+    : name_(name), fd_(fd), header_(header), bytes_(bytes), offset_(offset), owner_(owner) {}
+
+#ifdef _MSC_VER
+
+std::shared_ptr<DFSharedTensor> DFSharedTensor::open(const std::string&, size_t) { return nullptr; }
+DFSharedTensor::~DFSharedTensor() {}
+double* DFSharedTensor::data() const { return nullptr; }
+void DFSharedTensor::publish() {}
+
+#else
+
+namespace {
+
+/// Holds an exclusive flock on a segment descriptor for its lifetime
+class SegmentLock {
+   public:
+    explicit SegmentLock(int fd) : fd_(fd), locked_(::flock(fd, LOCK_EX) == 0) {}
+    ~SegmentLock() {
+        if (locked_) ::flock(fd_, LOCK_UN);
+    }
+    bool locked() const { return locked_; }
+
+   private:
+    int fd_;
+    bool locked_;
+};
+
+/// Was the segment's creator killed before publishing it?
+bool creator_gone(const DFSharedHeader* header) {
+    return header->creator > 0 && ::kill((pid_t)header->creator, 0) != 0 && errno == ESRCH;
+}
+
+}  // namespace
+
+std::shared_ptr<DFSharedTensor> DFSharedTensor::open(const std::string& key, size_t size) {
+    if (key.size() != sizeof(DFSharedHeader::key)) return nullptr;
+    const std::string name = "/psi4.dfh." + key;
+    const size_t offset = std::max<size_t>(::sysconf(_SC_PAGESIZE), sizeof(DFSharedHeader));
+    const size_t bytes = offset + size * sizeof(double);
+
+    // A segment we find unlinked or abandoned is replaced once; after that, compute privately
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        int fd = ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+        if (fd >= 0) {
+            SegmentLock lock(fd);
+            void* map = MAP_FAILED;
+            if (lock.locked() && !::ftruncate(fd, bytes)) {
+                map = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            }
+            if (map == MAP_FAILED) {
+                ::shm_unlink(name.c_str());
+                ::close(fd);
+                return nullptr;
+            }
+            auto* header = new (map) DFSharedHeader;
+            header->size = size;
+            std::memcpy(header->key, key.data(), sizeof(header->key));
+            header->creator = ::getpid();
+            header->ready.store(0);
+            header->unlinked = 0;
+            header->refs = 1;
+            header->magic = dfshm_magic;
+            return std::shared_ptr<DFSharedTensor>(new DFSharedTensor(name, fd, header, bytes, offset, true));
+        }
+        if (errno != EEXIST) return nullptr;
+
+        fd = ::shm_open(name.c_str(), O_RDWR, 0600);
+        if (fd < 0) {
+            if (errno == ENOENT) continue;  // unlinked in between
+            return nullptr;
+        }
+        SegmentLock lock(fd);
+        struct stat st;
+        // a segment that is not yet sized is still being created
+        if (!lock.locked() || ::fstat(fd, &st) || (size_t)st.st_size != bytes) {
+            ::close(fd);
+            return nullptr;
+        }
+        void* map = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (map == MAP_FAILED) {
+            ::close(fd);
+            return nullptr;
+        }
+        auto* header = static_cast<DFSharedHeader*>(map);
+
+        bool valid = header->magic == dfshm_magic && header->size == size &&
+                     !std::memcmp(header->key, key.data(), sizeof(header->key));
+        bool ready = valid && header->ready.load(std::memory_order_acquire);
+        if (valid && !header->unlinked && ready) {
+            header->refs++;
+            ::mprotect(static_cast<char*>(map) + offset, bytes - offset, PROT_READ);
+            return std::shared_ptr<DFSharedTensor>(new DFSharedTensor(name, fd, header, bytes, offset, false));
+        }
+
+        // Reclaim a segment whose creator died before publishing: it would otherwise stay resident and
+        // unready for good, since nobody holds the reference that would unlink it. The creator holds the
+        // lock while writing the header, so a sized segment without our magic was abandoned too.
+        bool uninitialized = header->magic != dfshm_magic;
+        bool retry = !uninitialized && header->unlinked;
+        if (uninitialized || (valid && !header->unlinked && !ready && creator_gone(header))) {
+            header->unlinked = 1;
+            ::shm_unlink(name.c_str());
+            retry = true;
+        }
+        ::munmap(map, bytes);
+        ::close(fd);
+        // still being filled: do not wait
+        if (!retry) return nullptr;
+    }
+    return nullptr;
+}
+
+DFSharedTensor::~DFSharedTensor() {
+    {
+        SegmentLock lock(fd_);
+        if (--header_->refs == 0 && !header_->unlinked) {
+            header_->unlinked = 1;
+            ::shm_unlink(name_.c_str());
+        }
+    }
+    ::munmap(header_, bytes_);
+    ::close(fd_);
+}
+
+double* DFSharedTensor::data() const { return reinterpret_cast<double*>(reinterpret_cast<char*>(header_) + offset_); }
+
+void DFSharedTensor::publish() {
+    header_->ready.store(1, std::memory_order_release);
+    ::mprotect(reinterpret_cast<char*>(header_) + offset_, bytes_ - offset_, PROT_READ);
+}
+
+#endif
+
+}  // namespace psi
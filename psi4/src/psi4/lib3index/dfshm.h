@@ -0,0 +1,90 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2025 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+#ifndef THREE_INDEX_DFSHM
+#define THREE_INDEX_DFSHM
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace psi {
+
+struct DFSharedHeader;
+
+/*!
+ * A read-only DF tensor in a POSIX shared-memory segment, shared by the
+ * Psi4 processes on a node that need the same tensor (fragment jobs,
+ * finite-difference displacements run side by side).
+ *
+ * The segment is named by a DFCache key, so it can only be attached by a
+ * process that would have computed identical values. The first process to
+ * ask for a key creates the segment, fills it and publish()es it; any other
+ * process asking for the same key while the segment exists attaches to it
+ * read-only instead of computing. A process that finds the segment still
+ * being filled (or of another size) does not wait: open() returns nullptr
+ * and the caller builds a private copy as usual. Attachments are reference
+ * counted in the segment under an flock, and the last process to detach
+ * removes it. A segment whose creator died before publishing is reclaimed
+ * by the next process to ask for it, so nothing outlives the batch unless a
+ * process is killed while attached to a published segment.
+ */
+class DFSharedTensor {
+   private:
+    std::string name_;
+    /// Descriptor of the segment, kept open for the flock
+    int fd_;
+    DFSharedHeader* header_;
+    size_t bytes_;
+    size_t offset_;
+    bool owner_;
+
+    DFSharedTensor(const std::string& name, int fd, DFSharedHeader* header, size_t bytes, size_t offset, bool owner);
+
+   public:
+    /*!
+     * Create, or attach to, the segment for key
+     * \param key DFCache key of the tensor
+     * \param size number of doubles
+     * \return the segment, or nullptr if shared memory is unavailable or the segment is not ready
+     */
+    static std::shared_ptr<DFSharedTensor> open(const std::string& key, size_t size);
+    /// Detach; the last process to detach removes the segment
+    ~DFSharedTensor();
+
+    /// The tensor. Writable only by the owner, until publish()
+    double* data() const;
+    /// Did this process create the segment, and so have to fill it?
+    bool owner() const { return owner_; }
+    /// Mark the tensor complete, making it available to other processes and read-only
+    void publish();
+};
+
+}  // namespace psi
+
+#endif
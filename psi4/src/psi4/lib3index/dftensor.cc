@@ -27,6 +27,7 @@
  */
 
 #include "3index.h"
+#include "dfcache.h"
 
 #include "psi4/libqt/qt.h"
 
@@ -130,15 +131,33 @@ void DFTensor::print_header() {
     auxiliary_->print_by_level("outfile", print_);
 }
 void DFTensor::build_metric() {
-    auto met = std::make_shared<FittingMetric>(auxiliary_, true);
-    met->form_eig_inverse(options_.get_double("DF_FITTING_CONDITION"));
-    metric_ = met->get_metric();
+    double condition = options_.get_double("DF_FITTING_CONDITION");
+    std::string key = DFCache::key("metric eig inverse", nullptr, auxiliary_, {condition});
+    metric_ = DFCache::load_matrix(key, naux_, naux_);
+    if (!metric_) {
+        auto met = std::make_shared<FittingMetric>(auxiliary_, true);
+        met->form_eig_inverse(condition);
+        metric_ = met->get_metric();
+        DFCache::store_matrix(key, metric_);
+    }
 
     if (debug_) {
         metric_->print();
     }
 }
 SharedMatrix DFTensor::Qso() {
+    // Build numpy and final matrix shape
+    std::vector<int> nshape{naux_, nbf_, nbf_};
+
+    std::string key =
+        DFCache::key("DFTensor Qso", primary_, auxiliary_, {options_.get_double("DF_FITTING_CONDITION")});
+    SharedMatrix cached = DFCache::load_matrix(key, naux_, nbf_ * nbf_);
+    if (cached) {
+        cached->set_name("Aso");
+        cached->set_numpy_shape(nshape);
+        return cached;
+    }
+
     auto B = std::make_shared<Matrix>("Bso", naux_, nbf_ * nbf_);
     auto A = std::make_shared<Matrix>("Aso", naux_, nbf_ * nbf_);
     double** Ap = A->pointer();
@@ -181,8 +200,7 @@ SharedMatrix DFTensor::Qso() {
         B->print();
         A->print();
     }
-    // Build numpy and final matrix shape
-    std::vector<int> nshape{naux_, nbf_, nbf_};
+    DFCache::store_matrix(key, A);
     A->set_numpy_shape(nshape);
 
     return A;
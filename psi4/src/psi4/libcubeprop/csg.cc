@@ -29,6 +29,7 @@
 #include "csg.h"
 
 #include <algorithm>
+#include <limits>
 #ifdef _OPENMP
 #include <omp.h>
 #endif
@@ -43,6 +44,7 @@
 #include "psi4/libmints/integral.h"
 #include "psi4/libmints/matrix.h"
 #include "psi4/libmints/molecule.h"
+#include "psi4/libmints/mcmurchiedavidson.h"
 #include "psi4/libmints/potential.h"
 #include "psi4/libmints/vector.h"
 #include "psi4/liboptions/liboptions.h"
@@ -52,6 +54,78 @@
 
 namespace psi {
 
+namespace {
+
+/// Position of (t, u, v) in a (L + 1)^3 Hermite table
+inline size_t tuv_index(int L, int t, int u, int v) { return (t * (L + 1) + u) * (L + 1) + v; }
+
+/**
+ * Derivatives of 1 / |R| of a point source, R_tuv = d^t/dX^t d^u/dY^u d^v/dZ^v (1 / |R|) for t + u + v <= L,
+ * through the McMurchie-Davidson recursion over auxiliary orders n. R is laid out as tuv_index(L, t, u, v)
+ * and work must hold (L + 1)^4 values.
+ */
+void point_coulomb_derivatives(int L, double X, double Y, double Z, double* R, double* work) {
+    size_t L1 = L + 1;
+    size_t stride = L1 * L1 * L1;
+    double R2 = X * X + Y * Y + Z * Z;
+    double Rinv2 = 1.0 / R2;
+
+    // R^(n)_000 = (-1)^n (2n - 1)!! / |R|^(2n + 1)
+    double Rn = std::sqrt(Rinv2);
+    for (int n = 0; n <= L; n++) {
+        work[n * stride] = Rn;
+        Rn *= -(2.0 * n + 1.0) * Rinv2;
+    }
+
+    for (int n = L - 1; n >= 0; n--) {
+        double* Rn0 = work + n * stride;
+        double* Rn1 = work + (n + 1) * stride;
+        for (int t = 0; t <= L - n; t++) {
+            for (int u = 0; u <= L - n - t; u++) {
+                for (int v = 0; v <= L - n - t - u; v++) {
+                    if (t + u + v == 0) continue;
+                    double val;
+                    if (t) {
+                        val = X * Rn1[tuv_index(L, t - 1, u, v)];
+                        if (t > 1) val += (t - 1) * Rn1[tuv_index(L, t - 2, u, v)];
+                    } else if (u) {
+                        val = Y * Rn1[tuv_index(L, t, u - 1, v)];
+                        if (u > 1) val += (u - 1) * Rn1[tuv_index(L, t, u - 2, v)];
+                    } else {
+                        val = Z * Rn1[tuv_index(L, t, u, v - 1)];
+                        if (v > 1) val += (v - 1) * Rn1[tuv_index(L, t, u, v - 2)];
+                    }
+                    Rn0[tuv_index(L, t, u, v)] = val;
+                }
+            }
+        }
+    }
+    std::copy(work, work + stride, R);
+}
+
+}  // namespace
+
+/**
+ * The ESP density fitted in the auxiliary basis. Points farther from an atom than the extent of its
+ * auxiliary shells see that atom's fitted density through its Cartesian multipoles up to the highest
+ * angular momentum on the atom, which is exact for Gaussians up to the extent cutoff; nearer points
+ * integrate its shells exactly.
+ */
+struct CubicScalarGrid::ESPExpansion {
+    /// Fitted density coefficients in the auxiliary basis
+    std::shared_ptr<Vector> d;
+    /// Auxiliary shells on each atom
+    std::vector<std::vector<int>> atom_shells;
+    /// Significant extent of the auxiliary shells on each atom
+    std::vector<double> atom_extents;
+    /// Multipole order of each atom, the highest auxiliary angular momentum on it
+    std::vector<int> atom_orders;
+    /// Per atom, -(-1)^(t+u+v) / (t! u! v!) M_tuv, contracted against R_tuv for the far-field potential
+    std::vector<std::vector<double>> atom_coefficients;
+    /// Nuclear charges, scaled by any nuclear weights
+    std::vector<double> Z;
+};
+
 CubicScalarGrid::CubicScalarGrid(std::shared_ptr<BasisSet> primary, Options& options)
     : primary_(primary), mol_(primary->molecule()), options_(options) {
     filepath_ = "";
@@ -61,6 +135,11 @@ CubicScalarGrid::CubicScalarGrid(std::shared_ptr<BasisSet> primary, Options& opt
     z_ = nullptr;
     w_ = nullptr;
 
+    nthreads_ = 1;
+#ifdef _OPENMP
+    nthreads_ = Process::environment.get_n_threads();
+#endif
+
     build_grid();  // Defaults from Options
 }
 CubicScalarGrid::~CubicScalarGrid() {
@@ -158,14 +237,18 @@ void CubicScalarGrid::populate_grid() {
     nxyz_ = std::llround(pow((double)max_points, 1.0 / 3.0));
 
     blocks_.clear();
+    block_offsets_.clear();
+    slab_blocks_.clear();
     size_t offset = 0L;
     for (int istart = 0L; istart <= N_[0]; istart += nxyz_) {
         int ni = (istart + nxyz_ > N_[0] ? (N_[0] + 1) - istart : nxyz_);
+        slab_blocks_.push_back(blocks_.size());
         for (int jstart = 0L; jstart <= N_[1]; jstart += nxyz_) {
             int nj = (jstart + nxyz_ > N_[1] ? (N_[1] + 1) - jstart : nxyz_);
             for (int kstart = 0L; kstart <= N_[2]; kstart += nxyz_) {
                 int nk = (kstart + nxyz_ > N_[2] ? (N_[2] + 1) - kstart : nxyz_);
 
+                block_offsets_.push_back(offset);
                 double* xp = &x_[offset];
                 double* yp = &y_[offset];
                 double* zp = &z_[offset];
@@ -188,6 +271,8 @@ void CubicScalarGrid::populate_grid() {
             }
         }
     }
+    block_offsets_.push_back(offset);
+    slab_blocks_.push_back(blocks_.size());
 
     int max_functions = 0L;
     for (int ind = 0; ind < blocks_.size(); ind++) {
@@ -196,8 +281,11 @@ void CubicScalarGrid::populate_grid() {
                              : blocks_[ind]->functions_local_to_global().size());
     }
 
-    points_ = std::make_shared<RKSFunctions>(primary_, max_points, max_functions);
-    points_->set_ansatz(0);
+    points_.clear();
+    for (int thread = 0; thread < nthreads_; thread++) {
+        points_.push_back(std::make_shared<RKSFunctions>(primary_, max_points, max_functions));
+        points_[thread]->set_ansatz(0);
+    }
 }
 void CubicScalarGrid::print_header() {
     outfile->Printf("  ==> CubicScalarGrid <==\n\n");
@@ -230,31 +318,14 @@ void CubicScalarGrid::write_gen_file(double* v, const std::string& name, const s
     }
 }
 void CubicScalarGrid::write_cube_file(double* v, const std::string& name, const std::string& comment) {
-    // => Reorder the grid <= //
-
-    auto v2 = std::vector<double>(npoints_);
-    size_t offset = 0L;
-    for (int istart = 0L; istart <= N_[0]; istart += nxyz_) {
-        int ni = (istart + nxyz_ > N_[0] ? (N_[0] + 1) - istart : nxyz_);
-        for (int jstart = 0L; jstart <= N_[1]; jstart += nxyz_) {
-            int nj = (jstart + nxyz_ > N_[1] ? (N_[1] + 1) - jstart : nxyz_);
-            for (int kstart = 0L; kstart <= N_[2]; kstart += nxyz_) {
-                int nk = (kstart + nxyz_ > N_[2] ? (N_[2] + 1) - kstart : nxyz_);
-                for (int i = istart; i < istart + ni; i++) {
-                    for (int j = jstart; j < jstart + nj; j++) {
-                        for (int k = kstart; k < kstart + nk; k++) {
-                            size_t index = i * (N_[1] + 1L) * (N_[2] + 1L) + j * (N_[2] + 1L) + k;
-                            v2[index] = v[offset];
-                            offset++;
-                        }
-                    }
-                }
-            }
-        }
+    FILE* fh = open_cube_file(name, comment);
+    size_t nwritten = 0L;
+    for (size_t slab = 0; slab + 1 < slab_blocks_.size(); slab++) {
+        write_cube_slab(fh, &v[block_offsets_[slab_blocks_[slab]]], slab, nwritten);
     }
-
-    // => Drop the grid out <= //
-
+    fclose(fh);
+}
+FILE* CubicScalarGrid::open_cube_file(const std::string& name, const std::string& comment) {
     std::stringstream ss;
     ss << filepath_ << "/" << name << ".cube";
 
@@ -282,28 +353,78 @@ void CubicScalarGrid::write_cube_file(double* v, const std::string& name, const
                 mol_->z(A));
     }
 
+    return fh;
+}
+void CubicScalarGrid::write_cube_slab(FILE* fh, const double* v, size_t slab, size_t& nwritten) {
+    // => Reorder the slab <= //
+
+    // A slab holds whole x planes, so it is contiguous in the (x, y, z) striping of the cube file
+    int istart = slab * nxyz_;
+    int ni = (istart + nxyz_ > N_[0] ? (N_[0] + 1) - istart : nxyz_);
+    size_t plane = (N_[1] + 1L) * (N_[2] + 1L);
+
+    auto v2 = std::vector<double>(ni * plane);
+    size_t offset = 0L;
+    for (int jstart = 0L; jstart <= N_[1]; jstart += nxyz_) {
+        int nj = (jstart + nxyz_ > N_[1] ? (N_[1] + 1) - jstart : nxyz_);
+        for (int kstart = 0L; kstart <= N_[2]; kstart += nxyz_) {
+            int nk = (kstart + nxyz_ > N_[2] ? (N_[2] + 1) - kstart : nxyz_);
+            for (int i = 0; i < ni; i++) {
+                for (int j = jstart; j < jstart + nj; j++) {
+                    for (int k = kstart; k < kstart + nk; k++) {
+                        size_t index = i * plane + j * (N_[2] + 1L) + k;
+                        v2[index] = v[offset];
+                        offset++;
+                    }
+                }
+            }
+        }
+    }
+
+    // => Drop the slab out <= //
+
     // Data, striped (x, y, z)
-    for (size_t ind = 0; ind < npoints_; ind++) {
+    for (size_t ind = 0; ind < v2.size(); ind++, nwritten++) {
         fprintf(fh, "%12.5E ", v2[ind]);
-        if (ind % 6 == 5) fprintf(fh, "\n");
+        if (nwritten % 6 == 5) fprintf(fh, "\n");
+    }
+}
+void CubicScalarGrid::stream_cube_file(const std::string& name, const std::string& comment,
+                                       const std::function<void(double*, size_t, size_t)>& add_blocks) {
+    FILE* fh = open_cube_file(name, comment);
+    std::vector<double> v;
+    size_t nwritten = 0L;
+    for (size_t slab = 0; slab + 1 < slab_blocks_.size(); slab++) {
+        size_t first = slab_blocks_[slab];
+        size_t last = slab_blocks_[slab + 1];
+        v.assign(block_offsets_[last] - block_offsets_[first], 0.0);
+        add_blocks(v.data(), first, last);
+        write_cube_slab(fh, v.data(), slab, nwritten);
     }
-
     fclose(fh);
 }
 void CubicScalarGrid::add_density(double* v, std::shared_ptr<Matrix> D) {
-    points_->set_pointers(D);
-    std::shared_ptr<Vector> rho = points_->point_value("RHO_A");
-    double* rhop = rho->pointer();
-
-    size_t offset = 0L;
-    for (int ind = 0; ind < blocks_.size(); ind++) {
-        points_->compute_points(blocks_[ind]);
+    for (const auto& points : points_) {
+        points->set_pointers(D);
+    }
+    add_density(v, 0, blocks_.size());
+}
+void CubicScalarGrid::add_density(double* v, size_t first, size_t last) {
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads_)
+    for (size_t ind = first; ind < last; ind++) {
+        int thread = 0;
+#ifdef _OPENMP
+        thread = omp_get_thread_num();
+#endif
+        double* rhop = points_[thread]->point_value("RHO_A")->pointer();
+        points_[thread]->compute_points(blocks_[ind]);
         size_t npoints = blocks_[ind]->npoints();
+        size_t offset = block_offsets_[ind] - block_offsets_[first];
         C_DAXPY(npoints, 0.5, rhop, 1, &v[offset], 1);
-        offset += npoints;
     }
 }
-void CubicScalarGrid::add_esp(double* v, std::shared_ptr<Matrix> D, const std::vector<double>& nuc_weights) {
+std::shared_ptr<CubicScalarGrid::ESPExpansion> CubicScalarGrid::build_esp_expansion(
+    std::shared_ptr<Matrix> D, const std::vector<double>& nuc_weights) {
     // => Auxiliary Basis Set <= //
 
     if (!auxiliary_) {
@@ -319,17 +440,12 @@ void CubicScalarGrid::add_esp(double* v, std::shared_ptr<Matrix> D, const std::v
     int naux = auxiliary_->nbf();
     int maxP = auxiliary_->max_function_per_shell();
 
-    int nthreads = 1;
-#ifdef _OPENMP
-    nthreads = Process::environment.get_n_threads();
-#endif
-
-    // => Density Fitting (TODO: Could be sped up) <= //
+    // => Density Fitting <= //
 
     std::shared_ptr<IntegralFactory> Ifact =
         std::make_shared<IntegralFactory>(auxiliary_, BasisSet::zero_ao_basis_set(), primary_, primary_);
     std::vector<std::shared_ptr<TwoBodyAOInt>> ints;
-    for (int thread = 0; thread < nthreads; thread++) {
+    for (int thread = 0; thread < nthreads_; thread++) {
         ints.push_back(std::shared_ptr<TwoBodyAOInt>(Ifact->eri()));
     }
 
@@ -350,7 +466,7 @@ void CubicScalarGrid::add_esp(double* v, std::shared_ptr<Matrix> D, const std::v
         Amn->zero();
 
 // Integrals
-#pragma omp parallel for schedule(dynamic)
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads_)
         for (int task = 0; task < pairs.size(); task++) {
             int thread = 0;
 #ifdef _OPENMP
@@ -419,70 +535,191 @@ void CubicScalarGrid::add_esp(double* v, std::shared_ptr<Matrix> D, const std::v
 
     J->power(-1.0, condition);
 
-    auto d = std::make_shared<Vector>("d", naux);
-    double* dp = d->pointer();
+    auto esp = std::make_shared<ESPExpansion>();
+    esp->d = std::make_shared<Vector>("d", naux);
+    double* dp = esp->d->pointer();
 
     C_DGEMV('N', naux, naux, 1.0, Jp[0], naux, cp, 1, 0.0, dp, 1);
 
-    // c->print();
-    // d->print();
-
     J.reset();
 
-    // => Electronic Part <= //
+    // => Far-Field Multipoles <= //
+
+    int natom = mol_->natom();
+    BasisExtents aux_extents(auxiliary_, options_.get_double("CUBIC_BASIS_TOLERANCE"));
+    double* aux_extentsp = aux_extents.shell_extents()->pointer();
+
+    esp->atom_shells.resize(natom);
+    esp->atom_extents.assign(natom, 0.0);
+    esp->atom_orders.assign(natom, 0);
+    for (int P = 0; P < auxiliary_->nshell(); P++) {
+        int A = auxiliary_->shell_to_center(P);
+        esp->atom_shells[A].push_back(P);
+        esp->atom_extents[A] = std::max(esp->atom_extents[A], aux_extentsp[P]);
+        esp->atom_orders[A] = std::max(esp->atom_orders[A], auxiliary_->shell(P).am());
+    }
+    // Without the far field every atom counts as near to every block
+    if (!options_.get_bool("CUBIC_ESP_FAR_FIELD")) {
+        esp->atom_extents.assign(natom, std::numeric_limits<double>::max());
+    }
+
+    auto Sfact = std::make_shared<IntegralFactory>(auxiliary_, BasisSet::zero_ao_basis_set(), auxiliary_,
+                                                   BasisSet::zero_ao_basis_set());
+    std::unique_ptr<OneBodyAOInt> Sint(Sfact->ao_overlap());
+    std::unique_ptr<OneBodyAOInt> Mint;
+    if (auxiliary_->max_am() > 0) Mint = Sfact->ao_multipoles(auxiliary_->max_am());
+
+    esp->atom_coefficients.resize(natom);
+    std::vector<double> factorial(auxiliary_->max_am() + 1, 1.0);
+    for (int l = 1; l < factorial.size(); l++) factorial[l] = factorial[l - 1] * l;
+
+    for (int A = 0; A < natom; A++) {
+        int L = esp->atom_orders[A];
+        auto& coefs = esp->atom_coefficients[A];
+        coefs.assign((L + 1) * (L + 1) * (L + 1), 0.0);
+        if (Mint) Mint->set_origin(mol_->xyz(A));
+
+        for (int P : esp->atom_shells[A]) {
+            int nP = auxiliary_->shell(P).nfunction();
+            int oP = auxiliary_->shell(P).function_index();
+
+            // Charge
+            Sint->compute_shell(P, 0);
+            coefs[0] -= C_DDOT(nP, &dp[oP], 1, const_cast<double*>(Sint->buffers()[0]), 1);
+
+            // Moments about A up to order L, in the CCA order of MultipoleInt, which carries a factor of -1
+            if (L == 0) continue;
+            Mint->compute_shell(P, 0);
+            int chunk = 0;
+            for (int l = 1; l <= auxiliary_->max_am(); l++) {
+                for (int ii = 0; ii <= l; ii++) {
+                    int t = l - ii;
+                    for (int v = 0; v <= ii; v++, chunk++) {
+                        int u = ii - v;
+                        if (l > L) continue;
+                        double M = -C_DDOT(nP, &dp[oP], 1, const_cast<double*>(Mint->buffers()[chunk]), 1);
+                        double sign = (l % 2 ? 1.0 : -1.0);
+                        coefs[tuv_index(L, t, u, v)] += sign * M / (factorial[t] * factorial[u] * factorial[v]);
+                    }
+                }
+            }
+        }
+    }
+
+    // => Nuclear Charges <= //
+
+    esp->Z.resize(natom);
+    for (int A = 0; A < natom; A++) {
+        esp->Z[A] = mol_->Z(A) * (nuc_weights.size() ? nuc_weights[A] : 1.0);
+    }
+
+    return esp;
+}
+void CubicScalarGrid::add_esp(double* v, std::shared_ptr<Matrix> D, const std::vector<double>& nuc_weights) {
+    auto esp = build_esp_expansion(D, nuc_weights);
+    add_esp(v, *esp, 0, blocks_.size());
+}
+void CubicScalarGrid::add_esp(double* v, const ESPExpansion& esp, size_t first, size_t last) {
+    int natom = mol_->natom();
+    int maxL = auxiliary_->max_am();
+    size_t maxL1 = maxL + 1;
+    double* dp = esp.d->pointer();
 
     std::shared_ptr<IntegralFactory> Vfact = std::make_shared<IntegralFactory>(
         auxiliary_, BasisSet::zero_ao_basis_set(), auxiliary_, BasisSet::zero_ao_basis_set());
-    std::vector<std::shared_ptr<Matrix>> VtempT;
     std::vector<std::shared_ptr<PotentialInt>> VintT;
-    for (int thread = 0; thread < nthreads; thread++) {
-        VtempT.push_back(std::make_shared<Matrix>("Vtemp", naux, 1));
+    std::vector<std::vector<double>> RT, workT;
+    for (int thread = 0; thread < nthreads_; thread++) {
         VintT.push_back(std::shared_ptr<PotentialInt>(static_cast<PotentialInt*>(Vfact->ao_potential().release())));
+        RT.push_back(std::vector<double>(maxL1 * maxL1 * maxL1));
+        workT.push_back(std::vector<double>(maxL1 * maxL1 * maxL1 * maxL1));
     }
 
-#pragma omp parallel for schedule(dynamic)
-    for (int P = 0; P < npoints_; P++) {
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads_)
+    for (size_t ind = first; ind < last; ind++) {
         // Thread info
         int thread = 0;
 #ifdef _OPENMP
         thread = omp_get_thread_num();
 #endif
-        double** VtempTp = VtempT[thread]->pointer();
+        auto& Vint = VintT[thread];
+        double* R = RT[thread].data();
+        double* work = workT[thread].data();
+
+        const auto& block = blocks_[ind];
+        size_t npoints = block->npoints();
+        double* x = block->x();
+        double* y = block->y();
+        double* z = block->z();
+        double* vp = &v[block_offsets_[ind] - block_offsets_[first]];
+
+        // => Screening <= //
+
+        // Atoms whose auxiliary shells reach the block are integrated exactly, the rest by multipoles
+        Vector3 center = block->center();
+        std::vector<int> near_shells;
+        std::vector<int> far_atoms;
+        for (int A = 0; A < natom; A++) {
+            if (center.distance(mol_->xyz(A)) - block->radius() > esp.atom_extents[A]) {
+                far_atoms.push_back(A);
+            } else {
+                near_shells.insert(near_shells.end(), esp.atom_shells[A].begin(), esp.atom_shells[A].end());
+            }
+        }
 
-        // Integrals
-        VtempT[thread]->zero();
-        VintT[thread]->set_charge_field({{1.0, {x_[P], y_[P], z_[P]}}});
-        VintT[thread]->compute(VtempT[thread]);
+        for (size_t P = 0; P < npoints; P++) {
+            double val = 0.0;
 
-        // Contraction
-        v[P] += C_DDOT(naux, dp, 1, VtempTp[0], 1);  // Potential integrals are negative definite already
-    }
+            // => Electronic Part, Near Field <= //
 
-    // => Nuclear Part <= //
+            if (near_shells.size()) {
+                Vint->set_charge_field({{1.0, {x[P], y[P], z[P]}}});
+                for (int Q : near_shells) {
+                    int nQ = auxiliary_->shell(Q).nfunction();
+                    int oQ = auxiliary_->shell(Q).function_index();
+                    Vint->compute_shell(Q, 0);
+                    // Potential integrals are negative definite already
+                    val += C_DDOT(nQ, &dp[oQ], 1, const_cast<double*>(Vint->buffers()[0]), 1);
+                }
+            }
 
-    for (int A = 0; A < mol_->natom(); A++) {
-        double Z = mol_->Z(A) * (nuc_weights.size() ? nuc_weights[A] : 1.0);
-        double x = mol_->x(A);
-        double y = mol_->y(A);
-        double z = mol_->z(A);
-        for (int P = 0; P < npoints_; P++) {
-            double R = sqrt((x - x_[P]) * (x - x_[P]) + (y - y_[P]) * (y - y_[P]) + (z - z_[P]) * (z - z_[P]));
-            v[P] += (R >= 1.0E-15 ? Z / R : 0.0);
+            // => Electronic Part, Far Field <= //
+
+            for (int A : far_atoms) {
+                int L = esp.atom_orders[A];
+                const auto& coefs = esp.atom_coefficients[A];
+                point_coulomb_derivatives(L, x[P] - mol_->x(A), y[P] - mol_->y(A), z[P] - mol_->z(A), R, work);
+                val += C_DDOT(coefs.size(), const_cast<double*>(coefs.data()), 1, R, 1);
+            }
+
+            // => Nuclear Part <= //
+
+            for (int A = 0; A < natom; A++) {
+                double dx = mol_->x(A) - x[P];
+                double dy = mol_->y(A) - y[P];
+                double dz = mol_->z(A) - z[P];
+                double RA = std::sqrt(dx * dx + dy * dy + dz * dz);
+                val += (RA >= 1.0E-15 ? esp.Z[A] / RA : 0.0);
+            }
+
+            vp[P] += val;
         }
     }
 }
 void CubicScalarGrid::add_basis_functions(double** v, const std::vector<int>& indices) {
-    std::shared_ptr<Matrix> phi = points_->basis_value("PHI");
-    double** phip = phi->pointer();
-
-    size_t offset = 0L;
-    for (int ind = 0; ind < blocks_.size(); ind++) {
-        points_->compute_functions(blocks_[ind]);
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads_)
+    for (size_t ind = 0; ind < blocks_.size(); ind++) {
+        int thread = 0;
+#ifdef _OPENMP
+        thread = omp_get_thread_num();
+#endif
+        double** phip = points_[thread]->basis_value("PHI")->pointer();
+        points_[thread]->compute_functions(blocks_[ind]);
 
         size_t npoints = blocks_[ind]->npoints();
+        size_t offset = block_offsets_[ind];
         const std::vector<int>& function_map = blocks_[ind]->functions_local_to_global();
-        int nlocal = function_map.size();
-        int nglobal = points_->max_functions();
+        int nglobal = points_[thread]->max_functions();
 
         for (int ind1 = 0; ind1 < indices.size(); ind1++) {
             for (int ind2 = 0; ind2 < function_map.size(); ind2++) {
@@ -491,44 +728,56 @@ void CubicScalarGrid::add_basis_functions(double** v, const std::vector<int>& in
                 }
             }
         }
-
-        offset += npoints;
     }
 }
 void CubicScalarGrid::add_orbitals(double** v, std::shared_ptr<Matrix> C) {
     int na = C->colspi()[0];
 
-    points_->set_Cs(C);
-    std::shared_ptr<Matrix> psi = points_->orbital_value("PSI_A");
-    double** psip = psi->pointer();
+    for (const auto& points : points_) {
+        points->set_Cs(C);
+    }
 
-    size_t offset = 0L;
-    for (int ind = 0; ind < blocks_.size(); ind++) {
-        points_->compute_orbitals(blocks_[ind]);
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads_)
+    for (size_t ind = 0; ind < blocks_.size(); ind++) {
+        int thread = 0;
+#ifdef _OPENMP
+        thread = omp_get_thread_num();
+#endif
+        double** psip = points_[thread]->orbital_value("PSI_A")->pointer();
+        points_[thread]->compute_orbitals(blocks_[ind]);
 
         size_t npoints = blocks_[ind]->npoints();
+        size_t offset = block_offsets_[ind];
         for (int a = 0; a < na; a++) {
             C_DAXPY(npoints, 1.0, psip[a], 1, &v[a][offset], 1);
         }
-
-        offset += npoints;
     }
 }
 void CubicScalarGrid::add_LOL(double* v, std::shared_ptr<Matrix> D) {
-    points_->set_ansatz(2);
-    points_->set_pointers(D);
-
-    std::shared_ptr<Vector> rho = points_->point_value("RHO_A");
-    std::shared_ptr<Vector> tau = points_->point_value("TAU_A");
-    double* rhop = rho->pointer();
-    double* taup = tau->pointer();
-
+    for (const auto& points : points_) {
+        points->set_ansatz(2);
+        points->set_pointers(D);
+    }
+    add_LOL(v, 0, blocks_.size());
+    for (const auto& points : points_) {
+        points->set_ansatz(0);
+    }
+}
+void CubicScalarGrid::add_LOL(double* v, size_t first, size_t last) {
     double C = 3.0 / 5.0 * pow(6.0 * M_PI * M_PI, 2.0 / 3.0);
 
-    size_t offset = 0L;
-    for (int ind = 0; ind < blocks_.size(); ind++) {
-        points_->compute_points(blocks_[ind]);
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads_)
+    for (size_t ind = first; ind < last; ind++) {
+        int thread = 0;
+#ifdef _OPENMP
+        thread = omp_get_thread_num();
+#endif
+        double* rhop = points_[thread]->point_value("RHO_A")->pointer();
+        double* taup = points_[thread]->point_value("TAU_A")->pointer();
+        points_[thread]->compute_points(blocks_[ind]);
+
         size_t npoints = blocks_[ind]->npoints();
+        size_t offset = block_offsets_[ind] - block_offsets_[first];
         for (int P = 0; P < npoints; P++) {
             double tau_LSDA = C * pow(0.5 * rhop[P], 5.0 / 3.0);
             double tau_EX = taup[P];
@@ -536,28 +785,34 @@ void CubicScalarGrid::add_LOL(double* v, std::shared_ptr<Matrix> D) {
             double v2 = (std::fabs(tau_EX / tau_LSDA) < 1.0E-15 ? 1.0 : t / (1.0 + t));
             v[P + offset] += v2;
         }
-        offset += npoints;
     }
-
-    points_->set_ansatz(0);
 }
 void CubicScalarGrid::add_ELF(double* v, std::shared_ptr<Matrix> D) {
-    points_->set_ansatz(2);
-    points_->set_pointers(D);
-
-    std::shared_ptr<Vector> rho = points_->point_value("RHO_A");
-    std::shared_ptr<Vector> gam = points_->point_value("GAMMA_AA");
-    std::shared_ptr<Vector> tau = points_->point_value("TAU_A");
-    double* rhop = rho->pointer();
-    double* gamp = gam->pointer();
-    double* taup = tau->pointer();
-
+    for (const auto& points : points_) {
+        points->set_ansatz(2);
+        points->set_pointers(D);
+    }
+    add_ELF(v, 0, blocks_.size());
+    for (const auto& points : points_) {
+        points->set_ansatz(0);
+    }
+}
+void CubicScalarGrid::add_ELF(double* v, size_t first, size_t last) {
     double C = 3.0 / 5.0 * pow(6.0 * M_PI * M_PI, 2.0 / 3.0);
 
-    size_t offset = 0L;
-    for (int ind = 0; ind < blocks_.size(); ind++) {
-        points_->compute_points(blocks_[ind]);
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads_)
+    for (size_t ind = first; ind < last; ind++) {
+        int thread = 0;
+#ifdef _OPENMP
+        thread = omp_get_thread_num();
+#endif
+        double* rhop = points_[thread]->point_value("RHO_A")->pointer();
+        double* gamp = points_[thread]->point_value("GAMMA_AA")->pointer();
+        double* taup = points_[thread]->point_value("TAU_A")->pointer();
+        points_[thread]->compute_points(blocks_[ind]);
+
         size_t npoints = blocks_[ind]->npoints();
+        size_t offset = block_offsets_[ind] - block_offsets_[first];
         for (int P = 0; P < npoints; P++) {
             double tau_LSDA = C * pow(0.5 * rhop[P], 5.0 / 3.0);
             double tau_EX = taup[P];
@@ -567,10 +822,7 @@ void CubicScalarGrid::add_ELF(double* v, std::shared_ptr<Matrix> D) {
             double v2 = (std::fabs(D_LSDA / D_EX) < 1.0E-15 ? 0.0 : 1.0 / (1.0 + B * B));
             v[P + offset] += v2;
         }
-        offset += npoints;
     }
-
-    points_->set_ansatz(0);
 }
 void CubicScalarGrid::compute_density(std::shared_ptr<Matrix> D, const std::string& name, const std::string& type) {
     auto v = std::vector<double>(npoints_, 0);
@@ -586,9 +838,11 @@ void CubicScalarGrid::compute_density(std::shared_ptr<Matrix> D, const std::stri
 }
 void CubicScalarGrid::compute_esp(std::shared_ptr<Matrix> D, const std::vector<double>& w, const std::string& name,
                                   const std::string& type) {
-    auto v = std::vector<double>(npoints_, 0);
-    add_esp(v.data(), D, w);
-    write_gen_file(v.data(), name, type, " [Eh/e]");
+    if (type != "CUBE") {
+        throw PSIEXCEPTION("CubicScalarGrid: Unrecognized output file type");
+    }
+    auto esp = build_esp_expansion(D, w);
+    stream_cube_file(name, " [Eh/e]", [&](double* v, size_t first, size_t last) { add_esp(v, *esp, first, last); });
 }
 void CubicScalarGrid::compute_basis_functions(const std::vector<int>& indices, const std::string& name,
                                               const std::string& type) {
@@ -655,14 +909,30 @@ void CubicScalarGrid::compute_difference(std::shared_ptr<Matrix> C, const std::v
     write_gen_file(&vp[0], label, type, comment.str());
 }
 void CubicScalarGrid::compute_LOL(std::shared_ptr<Matrix> D, const std::string& name, const std::string& type) {
-    auto v = std::vector<double>(npoints_, 0);
-    add_LOL(v.data(), D);
-    write_gen_file(v.data(), name, type);
+    if (type != "CUBE") {
+        throw PSIEXCEPTION("CubicScalarGrid: Unrecognized output file type");
+    }
+    for (const auto& points : points_) {
+        points->set_ansatz(2);
+        points->set_pointers(D);
+    }
+    stream_cube_file(name, "", [&](double* v, size_t first, size_t last) { add_LOL(v, first, last); });
+    for (const auto& points : points_) {
+        points->set_ansatz(0);
+    }
 }
 void CubicScalarGrid::compute_ELF(std::shared_ptr<Matrix> D, const std::string& name, const std::string& type) {
-    auto v = std::vector<double>(npoints_, 0);
-    add_ELF(v.data(), D);
-    write_gen_file(v.data(), name, type);
+    if (type != "CUBE") {
+        throw PSIEXCEPTION("CubicScalarGrid: Unrecognized output file type");
+    }
+    for (const auto& points : points_) {
+        points->set_ansatz(2);
+        points->set_pointers(D);
+    }
+    stream_cube_file(name, "", [&](double* v, size_t first, size_t last) { add_ELF(v, first, last); });
+    for (const auto& points : points_) {
+        points->set_ansatz(0);
+    }
 }
 std::pair<double, double> CubicScalarGrid::compute_isocontour_range(double* v2, double exponent) {
     double cumulative_threshold = options_.get_double("CUBEPROP_ISOCONTOUR_THRESHOLD");
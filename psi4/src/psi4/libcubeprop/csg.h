@@ -30,6 +30,8 @@
 #define _psi_src_lib_libcubeprop_csg_h_
 
 #include <array>
+#include <cstdio>
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
@@ -87,16 +89,45 @@ class CubicScalarGrid {
 
     /// Vector of blocks
     std::vector<std::shared_ptr<BlockOPoints> > blocks_;
+    /// Offset of each block in the fast ordering, followed by npoints_
+    std::vector<size_t> block_offsets_;
+    /// First block of each slab of nxyz_ x planes, followed by the number of blocks
+    std::vector<size_t> slab_blocks_;
     /// Points to basis extents, built internally
     std::shared_ptr<BasisExtents> extents_;
-    /// RKS points object
-    std::shared_ptr<RKSFunctions> points_;
+    /// Number of threads blocks are evaluated on
+    int nthreads_;
+    /// RKS points objects, one per thread
+    std::vector<std::shared_ptr<RKSFunctions> > points_;
 
     // => Helper Routines <= //
 
     /// Setup grid from info in N_, D_, O_
     void populate_grid();
 
+    /// Fitted ESP density, stored as exact near-field data and far-field multipoles per atom
+    struct ESPExpansion;
+    /// Fit D in the auxiliary basis and expand the fitted density about each atom
+    std::shared_ptr<ESPExpansion> build_esp_expansion(std::shared_ptr<Matrix> D, const std::vector<double>& nuc_weights);
+
+    // => Block-Range Scalar Fields (v starts at the first block) <= //
+
+    void add_density(double* v, size_t first, size_t last);
+    void add_esp(double* v, const ESPExpansion& esp, size_t first, size_t last);
+    void add_LOL(double* v, size_t first, size_t last);
+    void add_ELF(double* v, size_t first, size_t last);
+
+    // => Streaming Cube Writer <= //
+
+    /// Open filepath/name.cube and write its header
+    FILE* open_cube_file(const std::string& name, const std::string& comment);
+    /// Write one slab of v (in fast ordering, starting at the slab's first block) in cube order
+    void write_cube_slab(FILE* fh, const double* v, size_t slab, size_t& nwritten);
+    /// Evaluate a field one slab at a time and write it to filepath/name.cube, without holding the whole field.
+    /// add_blocks(v, first, last) adds the field of blocks [first, last) to v.
+    void stream_cube_file(const std::string& name, const std::string& comment,
+                          const std::function<void(double*, size_t, size_t)>& add_blocks);
+
    public:
     // => Constructors <= //
 
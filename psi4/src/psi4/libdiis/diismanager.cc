@@ -28,10 +28,254 @@
 
 #include "diismanager.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <limits>
+
+#include "psi4/psifiles.h"
+#include "psi4/libdpd/dpd.h"
+#include "psi4/libpsio/aiohandler.h"
+#include "psi4/libpsio/psio.h"
+#include "psi4/libpsio/psio.hpp"
+#include "psi4/libqt/qt.h"
+#include "psi4/libpsi4util/exception.h"
+
 using namespace psi;
 
 namespace psi {
 
+namespace {
+
+/// Number of elements of each stored quantity that are read back at a time
+constexpr size_t stream_block = 131072;
+
+}  // namespace
+
+size_t diis_size(const Matrix& x) {
+    size_t size = 0;
+    for (int h = 0; h < x.nirrep(); h++) size += (size_t)x.rowspi()[h] * x.colspi()[h ^ x.symmetry()];
+    return size;
+}
+
+size_t diis_size(const Vector& x) { return x.dimpi().sum(); }
+
+size_t diis_size(const dpdbuf4& x) {
+    size_t size = 0;
+    for (int h = 0; h < x.params->nirreps; h++)
+        size += (size_t)x.params->rowtot[h] * x.params->coltot[h ^ x.file.my_irrep];
+    return size;
+}
+
+size_t diis_size(const dpdfile2& x) {
+    size_t size = 0;
+    for (int h = 0; h < x.params->nirreps; h++)
+        size += (size_t)x.params->rowtot[h] * x.params->coltot[h ^ x.my_irrep];
+    return size;
+}
+
+double* diis_gather(const Matrix& x, double* buffer) {
+    for (int h = 0; h < x.nirrep(); h++) {
+        size_t size = (size_t)x.rowspi()[h] * x.colspi()[h ^ x.symmetry()];
+        if (size) ::memcpy(buffer, x.pointer(h)[0], sizeof(double) * size);
+        buffer += size;
+    }
+    return buffer;
+}
+
+double* diis_gather(const Vector& x, double* buffer) {
+    for (int h = 0; h < x.nirrep(); h++) {
+        size_t size = x.dimpi()[h];
+        if (size) ::memcpy(buffer, x.pointer(h), sizeof(double) * size);
+        buffer += size;
+    }
+    return buffer;
+}
+
+double* diis_gather(dpdbuf4& x, double* buffer) { return diis_gather(Matrix(&x), buffer); }
+
+double* diis_gather(dpdfile2& x, double* buffer) { return diis_gather(Matrix(&x), buffer); }
+
+const double* diis_scatter(const double* buffer, Matrix& x) {
+    for (int h = 0; h < x.nirrep(); h++) {
+        size_t size = (size_t)x.rowspi()[h] * x.colspi()[h ^ x.symmetry()];
+        if (size) ::memcpy(x.pointer(h)[0], buffer, sizeof(double) * size);
+        buffer += size;
+    }
+    return buffer;
+}
+
+const double* diis_scatter(const double* buffer, Vector& x) {
+    for (int h = 0; h < x.nirrep(); h++) {
+        size_t size = x.dimpi()[h];
+        if (size) ::memcpy(x.pointer(h), buffer, sizeof(double) * size);
+        buffer += size;
+    }
+    return buffer;
+}
+
+const double* diis_scatter(const double* buffer, dpdbuf4& x) {
+    Matrix temp(&x);
+    buffer = diis_scatter(buffer, temp);
+    x.zero();
+    x.axpy_matrix(temp, 1.0);
+    return buffer;
+}
+
+const double* diis_scatter(const double* buffer, dpdfile2& x) {
+    Matrix temp(&x);
+    buffer = diis_scatter(buffer, temp);
+    x.zero();
+    x.axpy_matrix(temp, 1.0);
+    return buffer;
+}
+
+/**
+ * Keeps the error vectors and vectors of all slots, in core or in
+ * PSIF_LIBDIIS, in double or single precision, and streams them back
+ * in blocks of stream_block elements.
+ */
+class DIISManager::Storage {
+   public:
+    enum class Part { Error = 0, Vector = 1 };
+    using BlockFunction = std::function<void(size_t start, size_t length, const std::vector<const double*>& blocks)>;
+
+    Storage(const std::string& label, bool on_disk, bool reduced) : label_(label), on_disk_(on_disk), reduced_(reduced) {
+        if (on_disk_) {
+            psio_ = PSIO::shared_object();
+            open();
+        }
+    }
+
+    ~Storage() {
+        aio_.reset();
+        if (opened_ && psio_->open_check(PSIF_LIBDIIS)) psio_->close(PSIF_LIBDIIS, 1);
+    }
+
+    /// Store the n elements of data as the given part of a slot
+    void write(int slot, Part part, const double* data, size_t n) {
+        if (on_disk_) {
+            open();
+            std::string key = entry_key(slot, part);
+            if (reduced_) {
+                std::vector<float> temp(data, data + n);
+                psio_->write_entry(PSIF_LIBDIIS, key.c_str(), (char*)temp.data(), sizeof(float) * n);
+            } else {
+                psio_->write_entry(PSIF_LIBDIIS, key.c_str(), (char*)data, sizeof(double) * n);
+            }
+        } else if (reduced_) {
+            auto& stored = single_[(int)part];
+            if (stored.size() <= (size_t)slot) stored.resize(slot + 1);
+            stored[slot].assign(data, data + n);
+        } else {
+            auto& stored = double_[(int)part];
+            if (stored.size() <= (size_t)slot) stored.resize(slot + 1);
+            stored[slot].assign(data, data + n);
+        }
+    }
+
+    /**
+     * Call fn(start, length, blocks) for consecutive blocks of the n elements
+     * of the given part of the slots, where blocks[i] points to elements
+     * [start, start + length) of slots[i]. On disk, the next block is read
+     * while fn works on the current one.
+     */
+    void stream(const std::vector<int>& slots, Part part, size_t n, const BlockFunction& fn) {
+        size_t nslot = slots.size();
+        if (nslot == 0 || n == 0) return;
+        std::vector<const double*> blocks(nslot);
+
+        // In core, double precision: hand out the stored data directly
+        if (!on_disk_ && !reduced_) {
+            for (size_t start = 0; start < n; start += stream_block) {
+                for (size_t i = 0; i < nslot; i++) blocks[i] = double_[(int)part][slots[i]].data() + start;
+                fn(start, std::min(stream_block, n - start), blocks);
+            }
+            return;
+        }
+
+        size_t block = std::min(stream_block, n);
+        std::vector<double> converted(reduced_ ? nslot * block : 0);
+
+        if (!on_disk_) {
+            for (size_t start = 0; start < n; start += block) {
+                size_t length = std::min(block, n - start);
+                for (size_t i = 0; i < nslot; i++) {
+                    const float* src = single_[(int)part][slots[i]].data() + start;
+                    std::copy(src, src + length, converted.begin() + i * block);
+                    blocks[i] = converted.data() + i * block;
+                }
+                fn(start, length, blocks);
+            }
+            return;
+        }
+
+        // On disk: two staging buffers, one being read while the other is used
+        open();
+        if (!aio_) aio_ = std::make_shared<AIOHandler>(psio_);
+        size_t element = reduced_ ? sizeof(float) : sizeof(double);
+        std::vector<char> staging[2] = {std::vector<char>(nslot * block * element),
+                                        std::vector<char>(nslot * block * element)};
+        std::vector<size_t> jobs[2] = {std::vector<size_t>(nslot), std::vector<size_t>(nslot)};
+        std::vector<std::string> keys(nslot);
+        for (size_t i = 0; i < nslot; i++) keys[i] = entry_key(slots[i], part);
+
+        auto request = [&](int buffer, size_t start) {
+            size_t length = std::min(block, n - start);
+            psio_address end;
+            for (size_t i = 0; i < nslot; i++) {
+                jobs[buffer][i] = aio_->read(PSIF_LIBDIIS, keys[i].c_str(), staging[buffer].data() + i * block * element,
+                                             length * element, psio_get_address(PSIO_ZERO, start * element), &end);
+            }
+        };
+
+        request(0, 0);
+        int buffer = 0;
+        for (size_t start = 0; start < n; start += block, buffer ^= 1) {
+            size_t length = std::min(block, n - start);
+            if (start + block < n) request(buffer ^ 1, start + block);
+            for (size_t job : jobs[buffer]) aio_->wait_for_job(job);
+            for (size_t i = 0; i < nslot; i++) {
+                char* data = staging[buffer].data() + i * block * element;
+                if (reduced_) {
+                    const float* src = reinterpret_cast<const float*>(data);
+                    std::copy(src, src + length, converted.begin() + i * block);
+                    blocks[i] = converted.data() + i * block;
+                } else {
+                    blocks[i] = reinterpret_cast<const double*>(data);
+                }
+            }
+            fn(start, length, blocks);
+        }
+    }
+
+   protected:
+    /// Open PSIF_LIBDIIS unless it is open already, e.g., by another DIISManager
+    void open() {
+        if (!psio_->open_check(PSIF_LIBDIIS)) {
+            psio_->open(PSIF_LIBDIIS, PSIO_OPEN_OLD);
+            opened_ = true;
+        }
+    }
+
+    std::string entry_key(int slot, Part part) const {
+        return label_ + ": " + (part == Part::Error ? "error" : "vector") + " Entry " + std::to_string(slot);
+    }
+
+    std::string label_;
+    bool on_disk_;
+    bool reduced_;
+    /// In-core storage, indexed by part and slot
+    std::vector<std::vector<double>> double_[2];
+    std::vector<std::vector<float>> single_[2];
+    /// On-disk storage
+    std::shared_ptr<PSIO> psio_;
+    std::shared_ptr<AIOHandler> aio_;
+    /// Did this object open PSIF_LIBDIIS, and so has to close it?
+    bool opened_ = false;
+};
+
 /**
  *
  * @param maxSubspaceSize Maximum number of vectors allowed in the subspace
@@ -40,33 +284,180 @@ namespace psi {
  * @param storagePolicy: How to store the DIIS vectors
  */
 DIISManager::DIISManager(int maxSubspaceSize, const std::string &label, RemovalPolicy removalPolicy,
-                         StoragePolicy storagePolicy) {
-    auto diis_file = py::module_::import("psi4").attr("driver").attr("diis");
-    py::object pyRemovalPolicy, pyStoragePolicy;
-    if (removalPolicy == RemovalPolicy::LargestError) {
-        pyRemovalPolicy = diis_file.attr("RemovalPolicy").attr("LargestError");
-    } else {
-        pyRemovalPolicy = diis_file.attr("RemovalPolicy").attr("OldestAdded");
+                         StoragePolicy storagePolicy)
+    : max_subspace_size_(maxSubspaceSize),
+      label_(label),
+      removal_policy_(removalPolicy),
+      storage_policy_(storagePolicy) {
+    reset_subspace();
+}
+
+DIISManager::DIISManager() {}
+
+DIISManager::DIISManager(DIISManager &&) noexcept = default;
+
+DIISManager &DIISManager::operator=(DIISManager &&) noexcept = default;
+
+DIISManager::~DIISManager() {}
+
+size_t DIISManager::error_size() const {
+    size_t size = 0;
+    for (size_t n : error_sizes_) size += n;
+    return size;
+}
+
+size_t DIISManager::vector_size() const {
+    size_t size = 0;
+    for (size_t n : vector_sizes_) size += n;
+    return size;
+}
+
+void DIISManager::check_sizes(const std::vector<size_t> &sizes, bool entry) const {
+    std::vector<size_t> expected = entry ? error_sizes_ : vector_sizes_;
+    if (entry) expected.insert(expected.end(), vector_sizes_.begin(), vector_sizes_.end());
+    if (sizes != expected) {
+        throw PSIEXCEPTION("DIISManager (" + label_ + "): the " + (entry ? "entry" : "vector") +
+                           " does not match the sizes given to set_error_vector_size/set_vector_size.");
+    }
+}
+
+int DIISManager::subspace_size() { return nstored_; }
+
+void DIISManager::set_reduced_precision(bool reduced) {
+    if (reduced == reduced_precision_) return;
+    reduced_precision_ = reduced;
+    reset_subspace();
+}
+
+void DIISManager::reset_subspace() {
+    iter_num_ = -1;
+    nstored_ = 0;
+    B_.assign((size_t)max_subspace_size_ * max_subspace_size_, 0.0);
+    storage_.reset();
+    if (max_subspace_size_ > 0) {
+        storage_ = std::make_unique<Storage>(label_, storage_policy_ == StoragePolicy::OnDisk, reduced_precision_);
     }
-    if (storagePolicy == StoragePolicy::InCore) {
-        pyStoragePolicy = diis_file.attr("StoragePolicy").attr("InCore");
+}
+
+void DIISManager::store_entry(const double *error, const double *vector) {
+    iter_num_++;
+
+    // Choose the slot, and the entries the new error vector has to be dotted with
+    int slot;
+    if (nstored_ >= max_subspace_size_) {
+        if (removal_policy_ == RemovalPolicy::OldestAdded) {
+            slot = iter_num_ % max_subspace_size_;
+        } else {
+            slot = 0;
+            for (int i = 1; i < nstored_; i++) {
+                if (B_[i * max_subspace_size_ + i] > B_[slot * max_subspace_size_ + slot]) slot = i;
+            }
+        }
     } else {
-        pyStoragePolicy = diis_file.attr("StoragePolicy").attr("OnDisk");
+        slot = nstored_;
+    }
+    std::vector<int> others;
+    for (int i = 0; i < nstored_; i++) {
+        if (i != slot) others.push_back(i);
+    }
+
+    // Only the row of the new entry changes
+    size_t nerror = error_size();
+
+    // Single-precision entries: take the whole row, diagonal included, from the error vector as stored
+    std::vector<double> rounded;
+    if (reduced_precision_) {
+        rounded.resize(nerror);
+        for (size_t i = 0; i < nerror; i++) rounded[i] = (float)error[i];
+        error = rounded.data();
+    }
+    std::vector<double> dots(others.size(), 0.0);
+    storage_->stream(others, Storage::Part::Error, nerror,
+                     [&](size_t start, size_t length, const std::vector<const double *> &blocks) {
+                         for (size_t i = 0; i < others.size(); i++) {
+                             dots[i] += C_DDOT(length, error + start, 1, blocks[i], 1);
+                         }
+                     });
+    for (size_t i = 0; i < others.size(); i++) {
+        B_[slot * max_subspace_size_ + others[i]] = dots[i];
+        B_[others[i] * max_subspace_size_ + slot] = dots[i];
     }
-    pydiis = diis_file.attr("DIIS")(maxSubspaceSize, label, pyRemovalPolicy, pyStoragePolicy);
+    B_[slot * max_subspace_size_ + slot] = C_DDOT(nerror, error, 1, error, 1);
+
+    storage_->write(slot, Storage::Part::Error, error, nerror);
+    storage_->write(slot, Storage::Part::Vector, vector, vector_size());
+    nstored_ = std::max(nstored_, slot + 1);
 }
 
-int DIISManager::subspace_size() { return py::len(pydiis.attr("stored_vectors")); }
+std::vector<double> DIISManager::coefficients() const {
+    int n = nstored_;
+    int dim = n + 1;
 
-void DIISManager::delete_diis_file() {
-    pydiis.attr("delete_diis_file")();
+    // The B matrix bordered by -1, solving B c = r with r = (0, ..., 0, -1)
+    std::vector<double> B(dim * dim, -1.0);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) B[i * dim + j] = B_[i * max_subspace_size_ + j];
+    }
+    B[dim * dim - 1] = 0.0;
+    std::vector<double> rhs(dim, 0.0);
+    rhs[n] = -1.0;
+
+    // Trick to improve numerical conditioning.
+    // Instead of solving B c = r, we solve D B D^-1 D c = D r, using
+    // D r = r. D is the diagonals ^ -1/2 matrix.
+    std::vector<double> diagonals(dim, 1.0);
+    bool positive = true;
+    for (int i = 0; i < n; i++) {
+        diagonals[i] = B[i * dim + i];
+        positive = positive && diagonals[i] > 0.0;
+    }
+    if (positive) {
+        for (double &d : diagonals) d = 1.0 / std::sqrt(d);
+    } else {
+        std::fill(diagonals.begin(), diagonals.end(), 1.0);
+    }
+    for (int i = 0; i < dim; i++) {
+        for (int j = 0; j < dim; j++) B[i * dim + j] *= diagonals[i] * diagonals[j];
+    }
+
+    // Minimum-norm least-squares solution, as the system may be singular
+    std::vector<double> s(dim);
+    int rank;
+    double lwork_query;
+    C_DGELSS(dim, dim, 1, B.data(), dim, rhs.data(), dim, s.data(), -1.0, &rank, &lwork_query, -1);
+    std::vector<double> work((size_t)lwork_query);
+    double rcond = std::numeric_limits<double>::epsilon() * dim;
+    int info = C_DGELSS(dim, dim, 1, B.data(), dim, rhs.data(), dim, s.data(), rcond, &rank, work.data(), work.size());
+    if (info != 0) {
+        throw PSIEXCEPTION("DIISManager (" + label_ + "): DGELSS failed with info " + std::to_string(info) + ".");
+    }
+
+    std::vector<double> coefficients(n);
+    for (int i = 0; i < n; i++) coefficients[i] = rhs[i] * diagonals[i];
+    return coefficients;
 }
 
-void DIISManager::reset_subspace() {
-    pydiis.attr("reset_subspace")();
+bool DIISManager::extrapolate_vector(std::vector<double> &result) {
+    result.assign(vector_size(), 0.0);
+    if (nstored_ == 0) return true;
+
+    std::vector<double> c = coefficients();
+    std::vector<int> slots(nstored_);
+    for (int i = 0; i < nstored_; i++) slots[i] = i;
+
+    storage_->stream(slots, Storage::Part::Vector, result.size(),
+                     [&](size_t start, size_t length, const std::vector<const double *> &blocks) {
+                         for (size_t i = 0; i < slots.size(); i++) {
+                             C_DAXPY(length, c[i], blocks[i], 1, result.data() + start, 1);
+                         }
+                     });
+    return true;
 }
 
-DIISManager::~DIISManager() {
+void DIISManager::delete_diis_file() {
+    auto psio = PSIO::shared_object();
+    if (!psio->open_check(PSIF_LIBDIIS)) psio->open(PSIF_LIBDIIS, PSIO_OPEN_OLD);
+    psio->close(PSIF_LIBDIIS, 0);
 }
 
 }  // namespace psi
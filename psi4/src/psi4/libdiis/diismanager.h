@@ -29,20 +29,73 @@
 #ifndef _PSI_SRC_LIB_LIBDIIS_DIISMANAGER_H_
 #define _PSI_SRC_LIB_LIBDIIS_DIISMANAGER_H_
 
+#include <memory>
+#include <string>
 #include <vector>
-#include <map>
 
 #include "psi4/pragma.h"
 #include "psi4/libmints/matrix.h"
-
-#include "psi4/pybind11.h"
+#include "psi4/libmints/vector.h"
 
 namespace psi {
 
-class PSIO;
+struct dpdbuf4;
+struct dpdfile2;
+
+/**
+ * Conversion of the quantities DIISManager accepts to and from one flat
+ * array of doubles. The elements are ordered irrep by irrep, row-major
+ * within each block. diis_gather writes the elements of x starting at
+ * buffer, diis_scatter overwrites x with the elements starting at buffer;
+ * both return the position just past those elements.
+ */
+PSI_API size_t diis_size(const Matrix& x);
+PSI_API size_t diis_size(const Vector& x);
+PSI_API size_t diis_size(const dpdbuf4& x);
+PSI_API size_t diis_size(const dpdfile2& x);
+PSI_API double* diis_gather(const Matrix& x, double* buffer);
+PSI_API double* diis_gather(const Vector& x, double* buffer);
+PSI_API double* diis_gather(dpdbuf4& x, double* buffer);
+PSI_API double* diis_gather(dpdfile2& x, double* buffer);
+PSI_API const double* diis_scatter(const double* buffer, Matrix& x);
+PSI_API const double* diis_scatter(const double* buffer, Vector& x);
+PSI_API const double* diis_scatter(const double* buffer, dpdbuf4& x);
+PSI_API const double* diis_scatter(const double* buffer, dpdfile2& x);
+
+template <typename T>
+size_t diis_size(T* x) {
+    return diis_size(*x);
+}
+template <typename T>
+size_t diis_size(const std::shared_ptr<T>& x) {
+    return diis_size(*x);
+}
+template <typename T>
+double* diis_gather(T* x, double* buffer) {
+    return diis_gather(*x, buffer);
+}
+template <typename T>
+double* diis_gather(const std::shared_ptr<T>& x, double* buffer) {
+    return diis_gather(*x, buffer);
+}
+template <typename T>
+const double* diis_scatter(const double* buffer, T* x) {
+    return diis_scatter(buffer, *x);
+}
+template <typename T>
+const double* diis_scatter(const double* buffer, const std::shared_ptr<T>& x) {
+    return diis_scatter(buffer, *x);
+}
 
 /**
    @brief The DIISManager class handles DIIS extrapolations.
+
+   Each entry consists of an error vector and the vector to be extrapolated,
+   each of which may be made up of several Matrix, Vector, dpdbuf4 or dpdfile2
+   objects. The B matrix of error vector overlaps is kept between iterations,
+   so adding an entry only computes the overlaps of the new error vector.
+   Stored entries are read back in blocks, with the next block read from
+   disk while the current one is used.
  */
 
 class PSI_API DIISManager {
@@ -64,28 +117,47 @@ class PSI_API DIISManager {
     enum class RemovalPolicy { LargestError, OldestAdded };
 
     DIISManager(int maxSubspaceSize, const std::string& label, RemovalPolicy = RemovalPolicy::LargestError, StoragePolicy = StoragePolicy::OnDisk);
-    DIISManager() {}
+    DIISManager();
+    DIISManager(DIISManager&&) noexcept;
+    DIISManager& operator=(DIISManager&&) noexcept;
     ~DIISManager();
 
-    // Variadic templates to interface with Python.
-    // If you're new to variadics, these allow multiple arguments.
-    // MUST be implemented in header.
-    template <typename ... types>
-    void set_error_vector_size(types ... arrays) {
-        pydiis.attr("set_error_vector_size")(arrays...);
+    /// Set the components of the error vector; the arguments only provide the dimensions
+    template <typename... types>
+    void set_error_vector_size(types&&... arrays) {
+        error_sizes_ = {diis_size(arrays)...};
     }
-    template <typename ... types>
-    void set_vector_size(types... arrays) {
-        pydiis.attr("set_vector_size")(arrays...);
+    /// Set the components of the vector to be extrapolated; the arguments only provide the dimensions
+    template <typename... types>
+    void set_vector_size(types&&... arrays) {
+        vector_sizes_ = {diis_size(arrays)...};
     }
+    /**
+     * Overwrite the arguments, the components of the vector, with the
+     * extrapolated vector. An empty subspace extrapolates to zero.
+     */
     template <typename... types>
-    bool extrapolate(types... arrays) {
-        return py::len(pydiis.attr("extrapolate")(arrays...));
+    bool extrapolate(types&&... arrays) {
+        check_sizes({diis_size(arrays)...}, false);
+        std::vector<double> result;
+        if (!extrapolate_vector(result)) return false;
+        const double* ptr = result.data();
+        ((ptr = diis_scatter(ptr, arrays)), ...);
+        return true;
     }
-    template <typename ... types>
-    bool add_entry(types... arrays) {
-        auto success = pydiis.attr("add_entry")(arrays...);
-        return success.template cast<bool>();
+    /**
+     * Add an entry to the subspace. The arguments are the components of
+     * the error vector followed by those of the vector.
+     */
+    template <typename... types>
+    bool add_entry(types&&... arrays) {
+        if (max_subspace_size_ == 0) return false;
+        check_sizes({diis_size(arrays)...}, true);
+        std::vector<double> entry(error_size() + vector_size());
+        double* ptr = entry.data();
+        ((ptr = diis_gather(arrays, ptr)), ...);
+        store_entry(entry.data(), entry.data() + error_size());
+        return true;
     }
 
     void delete_diis_file();
@@ -94,10 +166,47 @@ class PSI_API DIISManager {
     /// The number of vectors currently in the subspace
     int subspace_size();
 
-  protected:
-
-    py::object pydiis;
+    /**
+     * Keep stored entries in single precision, halving their memory or disk
+     * footprint. The B matrix and the extrapolation are still accumulated in
+     * double precision. Changing this empties the subspace.
+     */
+    void set_reduced_precision(bool reduced);
+    bool reduced_precision() const { return reduced_precision_; }
 
+  protected:
+    class Storage;
+
+    /// Number of doubles in an error vector
+    size_t error_size() const;
+    /// Number of doubles in a vector
+    size_t vector_size() const;
+    /// Throw unless the given component sizes match the error vector and vector (entry) or the vector alone
+    void check_sizes(const std::vector<size_t>& sizes, bool entry) const;
+    /// Add an entry, given as flat arrays, and update the B matrix
+    void store_entry(const double* error, const double* vector);
+    /// The extrapolation coefficients of the stored entries, indexed by slot
+    std::vector<double> coefficients() const;
+    /// Form the extrapolated vector as a flat array
+    bool extrapolate_vector(std::vector<double>& result);
+
+    int max_subspace_size_ = 0;
+    std::string label_;
+    RemovalPolicy removal_policy_ = RemovalPolicy::LargestError;
+    StoragePolicy storage_policy_ = StoragePolicy::InCore;
+    bool reduced_precision_ = false;
+
+    /// Sizes of the components of the error vector and the vector
+    std::vector<size_t> error_sizes_;
+    std::vector<size_t> vector_sizes_;
+    /// Number of entries added since the last reset, minus one
+    int iter_num_ = -1;
+    /// Number of occupied slots
+    int nstored_ = 0;
+    /// Error vector overlaps between slots, max_subspace_size_ x max_subspace_size_
+    std::vector<double> B_;
+    /// Where the entries are kept
+    std::unique_ptr<Storage> storage_;
 };
 
 }  // namespace psi
@@ -28,6 +28,7 @@
 
 #include "jk.h"
 #include "SplitJK.h"
+#include "task_scheduler.h"
 #include "psi4/libqt/qt.h"
 #include "psi4/libfock/cubature.h"
 #include "psi4/libfock/points.h"
@@ -398,15 +399,22 @@ void COSK::build_G_component(std::vector<std::shared_ptr<Matrix>>& D, std::vecto
 
     timer_on("Grid Loop");
 
-    // The primary COSK loop over blocks of grid points
-#pragma omp parallel for schedule(dynamic) num_threads(nthreads_) reduction(+ : int_shells_total, int_shells_computed)
-    for (size_t bi = 0; bi < grid->blocks().size(); bi++) {
-
-        int rank = 0;
-#ifdef _OPENMP
-        rank = omp_get_thread_num();
-#endif
+    // Cost model: grid points times the ESP shell pairs (TAU|NU) reachable from the block's shells
+    std::vector<double> shell_pair_cost(nshell, 0.0);
+    for (size_t TAU = 0; TAU < nshell; TAU++) {
+        for (size_t NU : shell_extent_map[TAU]) shell_pair_cost[TAU] += TaskScheduler::shell_cost(primary_->shell(NU));
+        shell_pair_cost[TAU] *= TaskScheduler::shell_cost(primary_->shell(TAU));
+    }
+    auto task_cost = [&](size_t bi) {
+        double cost = 0.0;
+        for (int TAU : grid->blocks()[bi]->shells_local_to_global()) cost += shell_pair_cost[TAU];
+        return grid->blocks()[bi]->npoints() * cost;
+    };
+    std::vector<size_t> thread_shells_total(nthreads_, 0L);
+    std::vector<size_t> thread_shells_computed(nthreads_, 0L);
 
+    // The primary COSK loop over blocks of grid points
+    scheduler(nthreads_).run(grid->blocks().size(), task_cost, [&](size_t bi, int rank) {
         // grid points in this block
         auto block = grid->blocks()[bi];
         int npoints_block = block->npoints();
@@ -648,7 +656,7 @@ void COSK::build_G_component(std::vector<std::shared_ptr<Matrix>>& D, std::vecto
                 if (symm && TAU > NU) continue;
 
                 // benchmarking
-                int_shells_total += npoints_block;
+                thread_shells_total[rank] += npoints_block;
 
                 // can we screen the whole block over K_uv = (X_ug (A_vtg (F_tg)) upper bound?
                 double k_bound = X_block_max * esp_boundp[NU][TAU] * F_block_gmaxp[TAU];
@@ -674,7 +682,7 @@ void COSK::build_G_component(std::vector<std::shared_ptr<Matrix>>& D, std::vecto
                     int_computers[rank]->compute_shell(NU, TAU);
 
                     // benchmarking
-                    int_shells_computed++;
+                    thread_shells_computed[rank]++;
 
                     // contract A_nu_tau with F_tau to get contribution to G_nu
                     // symmetry permitting, also contract A_nu_tau with F_nu to get contribution to G_tau
@@ -715,14 +723,17 @@ void COSK::build_G_component(std::vector<std::shared_ptr<Matrix>>& D, std::vecto
                 }
             }
         }
-
+    });
+    for (int thread = 0; thread < nthreads_; thread++) {
+        int_shells_total += thread_shells_total[thread];
+        int_shells_computed += thread_shells_computed[thread];
     }
 
     timer_off("Grid Loop");
 
     // Reduce per-thread contributions
     for(size_t jki = 0; jki < njk; jki++) {
-        for (size_t thread = 0; thread < nthreads_; thread++) {
+        for (int thread = 0; thread < nthreads_; thread++) {
             K[jki]->add(KT[jki][thread]);
         }
         if (lr_symmetric_) {
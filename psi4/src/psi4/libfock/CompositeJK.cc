@@ -355,7 +355,12 @@ void CompositeJK::compute_JK() {
     if (initial_iteration_) initial_iteration_ = false;
 }
 
-void CompositeJK::postiterations() {}
+void CompositeJK::postiterations() {
+    if (bench_ || debug_) {
+        if (j_algo_) j_algo_->print_task_timings();
+        if (k_algo_) k_algo_->print_task_timings();
+    }
+}
 
 // => Method-specific knobs go here <= //
 
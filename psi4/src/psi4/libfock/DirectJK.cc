@@ -35,6 +35,7 @@
 #include "psi4/psifiles.h"
 #include "psi4/libiwl/iwl.hpp"
 #include "jk.h"
+#include "task_scheduler.h"
 #include "psi4/libmints/matrix.h"
 #include "psi4/libmints/basisset.h"
 #include "psi4/libmints/molecule.h"
@@ -45,6 +46,7 @@
 #include "psi4/liboptions/liboptions.h"
 
 #include <algorithm>
+#include <chrono>
 #include <limits>
 #include <sstream>
 #include <unordered_set>
@@ -92,6 +94,11 @@ void DirectJK::common_init() {
         throw PSIEXCEPTION("Invalid input for option INCFOCK_FULL_FOCK_EVERY (<= 0)");
     }
 
+    batch_quartets_ = options_.get_int("DIRECTJK_BATCH_QUARTETS");
+    if (batch_quartets_ <= 0) {
+        throw PSIEXCEPTION("Invalid input for option DIRECTJK_BATCH_QUARTETS (<= 0)");
+    }
+
     // other options
     auto screening_type = options_.get_str("SCREENING");
     density_screening_ = screening_type == "DENSITY";
@@ -120,6 +127,7 @@ void DirectJK::print_header() const {
         outfile->Printf("    Screening Type:    %11s\n", screen_type.c_str());
         outfile->Printf("    Screening Cutoff:  %11.0E\n", cutoff_);
         outfile->Printf("    Incremental Fock:  %11s\n", incfock_ ? "Yes" : "No");
+        outfile->Printf("    Quartet Batch:     %11d\n", batch_quartets_);
         outfile->Printf("\n");
     }
 }
@@ -389,7 +397,34 @@ void DirectJK::compute_JK() {
 
     if (initial_iteration_) initial_iteration_ = false;
 }
-void DirectJK::postiterations() {}
+void DirectJK::postiterations() {
+    if (scheduler_ && (bench_ || debug_)) scheduler_->print_timings();
+    if (bench_ || debug_) print_am_class_statistics();
+}
+
+std::map<std::string, std::tuple<size_t, size_t, double, double>> DirectJK::am_class_statistics() const {
+    std::map<std::string, std::tuple<size_t, size_t, double, double>> stats;
+    for (const auto& [am, entry] : am_class_stats_) {
+        std::string label = {'(', amtypes[am[0]], amtypes[am[1]], '|', amtypes[am[2]], amtypes[am[3]], ')'};
+        stats[label] = std::make_tuple(entry.quartets, entry.integrals, entry.compute_time, entry.digest_time);
+    }
+    return stats;
+}
+
+void DirectJK::print_am_class_statistics() const {
+    outfile->Printf("  ==> DirectJK: Angular Momentum Classes <==\n\n");
+    outfile->Printf("    %8s %14s %16s %12s %12s\n", "Class", "Quartets", "Integrals", "ERI [s]", "Digest [s]");
+    double compute_sum = 0.0;
+    double digest_sum = 0.0;
+    for (const auto& [label, entry] : am_class_statistics()) {
+        const auto& [quartets, integrals, compute_time, digest_time] = entry;
+        outfile->Printf("    %8s %14zu %16zu %12.3f %12.3f\n", label.c_str(), quartets, integrals, compute_time,
+                        digest_time);
+        compute_sum += compute_time;
+        digest_sum += digest_time;
+    }
+    outfile->Printf("    %8s %14s %16s %12.3f %12.3f\n\n", "Total", "", "", compute_sum, digest_sum);
+}
 
 void DirectJK::build_JK_matrices(std::vector<std::shared_ptr<TwoBodyAOInt>>& ints, const std::vector<SharedMatrix>& D,
                         std::vector<SharedMatrix>& J, std::vector<SharedMatrix>& K) {
@@ -534,8 +569,47 @@ void DirectJK::build_JK_matrices(std::vector<std::shared_ptr<TwoBodyAOInt>>& int
 
 // ==> Master Task Loop <== //
 
-#pragma omp parallel for num_threads(nthread) schedule(dynamic) reduction(+ : computed_shells)
-    for (size_t task = 0L; task < ntask_pair2; task++) {
+    // Cost model: an atomic block costs the sum of its shell costs,
+    // a task the product of its four blocks
+    std::vector<double> block_cost(ntask, 0.0);
+    for (size_t task = 0; task < ntask; task++) {
+        for (int P2 = task_starts[task]; P2 < task_starts[task + 1]; P2++) {
+            block_cost[task] += TaskScheduler::shell_cost(primary_->shell(task_shells[P2]));
+        }
+    }
+    auto task_cost = [&](size_t task) {
+        const auto& PQ = task_pairs[task / ntask_pair];
+        const auto& RS = task_pairs[task % ntask_pair];
+        if (RS.first > PQ.first) return 0.0;
+        return block_cost[PQ.first] * block_cost[PQ.second] * block_cost[RS.first] * block_cost[RS.second];
+    };
+    std::vector<size_t> thread_computed_shells(nthread, 0L);
+
+    // Per thread: the significant quartets of a task, as task-local shell indices tagged with
+    // their angular momentum class, the batch being computed, and the per-class work done
+    std::vector<std::vector<std::pair<std::array<int, 4>, std::array<int, 4>>>> thread_quartets(nthread);
+    std::vector<std::vector<std::array<int, 4>>> thread_batch(nthread);
+    std::vector<std::map<std::array<int, 4>, AMClassStatistics>> thread_am_stats(nthread);
+    std::vector<std::vector<double>> thread_J_scratch(nthread);
+    size_t max_batch = batch_quartets_;
+
+    // Permutational degeneracy of a canonical quartet
+    auto quartet_prefactor = [](const std::array<int, 4>& quartet) {
+        const auto& [P, Q, R, S] = quartet;
+        double prefactor = 1.0;
+        if (P == Q) prefactor *= 0.5;
+        if (R == S) prefactor *= 0.5;
+        if (P == R && Q == S) prefactor *= 0.5;
+        return prefactor;
+    };
+
+    static const size_t eri_timer = timer_key("DirectJK: ERI Batch");
+    static const size_t digest_timer = timer_key("DirectJK: Digest");
+
+    if (!scheduler_ || scheduler_->nthread() != nthread) {
+        scheduler_ = std::make_shared<TaskScheduler>(name(), nthread);
+    }
+    scheduler_->run(ntask_pair2, task_cost, [&](size_t task, int thread) {
         size_t task1 = task / ntask_pair;
         size_t task2 = task % ntask_pair;
 
@@ -549,7 +623,7 @@ void DirectJK::build_JK_matrices(std::vector<std::shared_ptr<TwoBodyAOInt>>& int
         // This is an artifact that multiple shells on each task allow
         // for for the Ptask's index to possibly trump any RStask pair,
         // regardless of Qtask's index
-        if (Rtask > Ptask) continue;
+        if (Rtask > Ptask) return;
 
         // printf("Task: %2d %2d %2d %2d\n", Ptask, Qtask, Rtask, Stask);
 
@@ -568,14 +642,10 @@ void DirectJK::build_JK_matrices(std::vector<std::shared_ptr<TwoBodyAOInt>>& int
         int dRsize = task_offsets[R2start + nRtask] - task_offsets[R2start];
         int dSsize = task_offsets[S2start + nStask] - task_offsets[S2start];
 
-        int thread = 0;
-#ifdef _OPENMP
-        thread = omp_get_thread_num();
-#endif
-
-        // => Master shell quartet loops <= //
+        // => Significant shell quartets, binned by angular momentum class <= //
 
-        bool touched = false;
+        auto& quartets = thread_quartets[thread];
+        quartets.clear();
         for (int P2 = P2start; P2 < P2start + nPtask; P2++) {
             for (int Q2 = Q2start; Q2 < Q2start + nQtask; Q2++) {
                 if (Q2 > P2) continue;
@@ -591,142 +661,242 @@ void DirectJK::build_JK_matrices(std::vector<std::shared_ptr<TwoBodyAOInt>>& int
                         if (!ints[0]->shell_pair_significant(R, S)) continue;
                         if (!ints[0]->shell_significant(P, Q, R, S)) continue;
 
-                        // printf("Quartet: %2d %2d %2d %2d\n", P, Q, R, S);
-                        // if (thread == 0) timer_on("JK: Ints");
-                        if (ints[thread]->compute_shell(P, Q, R, S) == 0)
-                            continue;  // No integrals in this shell quartet
-                        computed_shells++;
-                        // if (thread == 0) timer_off("JK: Ints");
+                        std::array<int, 4> am = {primary_->shell(P).am(), primary_->shell(Q).am(),
+                                                 primary_->shell(R).am(), primary_->shell(S).am()};
+                        quartets.push_back({am, {P2, Q2, R2, S2}});
+                    }
+                }
+            }
+        }
+        if (quartets.empty()) return;
+        std::stable_sort(quartets.begin(), quartets.end(),
+                         [](const auto& a, const auto& b) { return a.first < b.first; });
 
-                        const double* buffer = ints[thread]->buffer();
+        // => Batched integrals and digestion <= //
 
-                        int Psize = primary_->shell(P).nfunction();
-                        int Qsize = primary_->shell(Q).nfunction();
-                        int Rsize = primary_->shell(R).nfunction();
-                        int Ssize = primary_->shell(S).nfunction();
+        bool touched = false;
+        auto& batch = thread_batch[thread];
+        for (size_t begin = 0, end = 0; begin < quartets.size(); begin = end) {
+            const auto& am = quartets[begin].first;
+            while (end < quartets.size() && quartets[end].first == am && end - begin < max_batch) end++;
+
+            batch.clear();
+            for (size_t i = begin; i < end; i++) {
+                const auto& [P2, Q2, R2, S2] = quartets[i].second;
+                batch.push_back({task_shells[P2], task_shells[Q2], task_shells[R2], task_shells[S2]});
+            }
 
-                        int Poff = primary_->shell(P).function_index();
-                        int Qoff = primary_->shell(Q).function_index();
-                        int Roff = primary_->shell(R).function_index();
-                        int Soff = primary_->shell(S).function_index();
+            auto compute_start = std::chrono::steady_clock::now();
+            thread_timer_on(eri_timer);
+            size_t nints = ints[thread]->compute_shell_batch(batch);
+            thread_timer_off(eri_timer);
+            auto compute_end = std::chrono::steady_clock::now();
+            const double* batch_buffer = ints[thread]->batch_buffer();
+            const auto& batch_offsets = ints[thread]->batch_offsets();
+
+            size_t computed = 0;
+            for (size_t i = 0; i < batch.size(); i++) {
+                if (batch_offsets[i + 1] > batch_offsets[i]) computed++;
+            }
+            thread_computed_shells[thread] += computed;
+
+            thread_timer_on(digest_timer);
+            if (computed) {
+                // Shells of one angular momentum have one size within the basis
+                int Psize = primary_->shell(batch[0][0]).nfunction();
+                int Qsize = primary_->shell(batch[0][1]).nfunction();
+                int Rsize = primary_->shell(batch[0][2]).nfunction();
+                int Ssize = primary_->shell(batch[0][3]).nfunction();
+
+                for (size_t ind = 0; ind < D.size(); ind++) {
+                    double** Dp = D[ind]->pointer();
+                    double** JTp;
+                    if (build_J) JTp = JT[thread][ind]->pointer();
+                    double** KTp;
+                    if (build_K) KTp = KT[thread][ind]->pointer();
+
+                    if (!touched) {
+                        if (build_J) {
+                            ::memset((void*)JTp[0L * max_task], '\0', dPsize * dQsize * sizeof(double));
+                            ::memset((void*)JTp[1L * max_task], '\0', dRsize * dSsize * sizeof(double));
+                        }
 
-                        int Poff2 = task_offsets[P2] - task_offsets[P2start];
-                        int Qoff2 = task_offsets[Q2] - task_offsets[Q2start];
-                        int Roff2 = task_offsets[R2] - task_offsets[R2start];
-                        int Soff2 = task_offsets[S2] - task_offsets[S2start];
+                        if (build_K) {
+                            ::memset((void*)KTp[0L * max_task], '\0', dPsize * dRsize * sizeof(double));
+                            ::memset((void*)KTp[1L * max_task], '\0', dPsize * dSsize * sizeof(double));
+                            ::memset((void*)KTp[2L * max_task], '\0', dQsize * dRsize * sizeof(double));
+                            ::memset((void*)KTp[3L * max_task], '\0', dQsize * dSsize * sizeof(double));
+                            if (!lr_symmetric_) {
+                                ::memset((void*)KTp[4L * max_task], '\0', dRsize * dPsize * sizeof(double));
+                                ::memset((void*)KTp[5L * max_task], '\0', dSsize * dPsize * sizeof(double));
+                                ::memset((void*)KTp[6L * max_task], '\0', dRsize * dQsize * sizeof(double));
+                                ::memset((void*)KTp[7L * max_task], '\0', dSsize * dQsize * sizeof(double));
+                            }
+                        }
+                    }
 
-                        // if (thread == 0) timer_on("JK: GEMV");
-                        for (size_t ind = 0; ind < D.size(); ind++) {
-                            double** Dp = D[ind]->pointer();
-                            double** JTp; 
-                            if (build_J) JTp = JT[thread][ind]->pointer();
-                            double** KTp;
-                            if (build_K) KTp = KT[thread][ind]->pointer();
-                            const double* buffer2 = buffer;
-
-                            if (!touched) {
-                                if (build_J) {
-                                    ::memset((void*)JTp[0L * max_task], '\0', dPsize * dQsize * sizeof(double));
-                                    ::memset((void*)JTp[1L * max_task], '\0', dRsize * dSsize * sizeof(double));
-                                }
+                    // Intermediate Contraction Pointers
+                    double* J1p;
+                    double* J2p;
+                    double* K1p;
+                    double* K2p;
+                    double* K3p;
+                    double* K4p;
+                    double* K5p;
+                    double* K6p;
+                    double* K7p;
+                    double* K8p;
+
+                    if (build_J) {
+                        J1p = JTp[0L * max_task];
+                        J2p = JTp[1L * max_task];
+                    }
 
-                                if (build_K) {
-                                    ::memset((void*)KTp[0L * max_task], '\0', dPsize * dRsize * sizeof(double));
-                                    ::memset((void*)KTp[1L * max_task], '\0', dPsize * dSsize * sizeof(double));
-                                    ::memset((void*)KTp[2L * max_task], '\0', dQsize * dRsize * sizeof(double));
-                                    ::memset((void*)KTp[3L * max_task], '\0', dQsize * dSsize * sizeof(double));
-                                    if (!lr_symmetric_) {
-                                        ::memset((void*)KTp[4L * max_task], '\0', dRsize * dPsize * sizeof(double));
-                                        ::memset((void*)KTp[5L * max_task], '\0', dSsize * dPsize * sizeof(double));
-                                        ::memset((void*)KTp[6L * max_task], '\0', dRsize * dQsize * sizeof(double));
-                                        ::memset((void*)KTp[7L * max_task], '\0', dSsize * dQsize * sizeof(double));
-                                    }
-                                }
-                            }
+                    if (build_K) {
+                        K1p = KTp[0L * max_task];
+                        K2p = KTp[1L * max_task];
+                        K3p = KTp[2L * max_task];
+                        K4p = KTp[3L * max_task];
+                        if (!lr_symmetric_) {
+                            K5p = KTp[4L * max_task];
+                            K6p = KTp[5L * max_task];
+                            K7p = KTp[6L * max_task];
+                            K8p = KTp[7L * max_task];
+                        }
+                    }
 
-                            // Intermediate Contraction Pointers
-                            double* J1p;
-                            double* J2p;
-                            double* K1p;
-                            double* K2p;
-                            double* K3p;
-                            double* K4p;
-                            double* K5p;
-                            double* K6p;
-                            double* K7p;
-                            double* K8p;
-
-                            if (build_J) {
-                                J1p = JTp[0L * max_task];
-                                J2p = JTp[1L * max_task];
+                    if (build_J) {
+                        // Gather the symmetrized density blocks of the whole batch, each scaled by its quartet's
+                        // degeneracy, then contract every (PQ|RS) block with them from both sides by DGEMV
+                        int PQsize = Psize * Qsize;
+                        int RSsize = Rsize * Ssize;
+                        auto& scratch = thread_J_scratch[thread];
+                        scratch.resize(2 * computed * (PQsize + RSsize));
+                        double* Dpq = scratch.data();
+                        double* Drs = Dpq + computed * PQsize;
+                        double* Jpq = Drs + computed * RSsize;
+                        double* Jrs = Jpq + computed * PQsize;
+
+                        for (size_t i = 0, c = 0; i < batch.size(); i++) {
+                            if (batch_offsets[i + 1] == batch_offsets[i]) continue;
+
+                            const auto& [P, Q, R, S] = batch[i];
+                            int Poff = primary_->shell(P).function_index();
+                            int Qoff = primary_->shell(Q).function_index();
+                            int Roff = primary_->shell(R).function_index();
+                            int Soff = primary_->shell(S).function_index();
+                            double prefactor = quartet_prefactor(batch[i]);
+
+                            double* Dpqc = Dpq + c * PQsize;
+                            for (int p = 0; p < Psize; p++) {
+                                for (int q = 0; q < Qsize; q++) {
+                                    *Dpqc++ = prefactor * (Dp[p + Poff][q + Qoff] + Dp[q + Qoff][p + Poff]);
+                                }
                             }
-
-                            if (build_K) {
-                                K1p = KTp[0L * max_task];
-                                K2p = KTp[1L * max_task];
-                                K3p = KTp[2L * max_task];
-                                K4p = KTp[3L * max_task];
-                                if (!lr_symmetric_) {
-                                    K5p = KTp[4L * max_task];
-                                    K6p = KTp[5L * max_task];
-                                    K7p = KTp[6L * max_task];
-                                    K8p = KTp[7L * max_task];
+                            double* Drsc = Drs + c * RSsize;
+                            for (int r = 0; r < Rsize; r++) {
+                                for (int s = 0; s < Ssize; s++) {
+                                    *Drsc++ = prefactor * (Dp[r + Roff][s + Soff] + Dp[s + Soff][r + Roff]);
                                 }
                             }
 
-                            double prefactor = 1.0;
-                            if (P == Q) prefactor *= 0.5;
-                            if (R == S) prefactor *= 0.5;
-                            if (P == R && Q == S) prefactor *= 0.5;
+                            double* buffer2 = const_cast<double*>(batch_buffer + batch_offsets[i]);
+                            C_DGEMV('N', PQsize, RSsize, 1.0, buffer2, RSsize, Drs + c * RSsize, 1, 0.0,
+                                    Jpq + c * PQsize, 1);
+                            C_DGEMV('T', PQsize, RSsize, 1.0, buffer2, RSsize, Dpq + c * PQsize, 1, 0.0,
+                                    Jrs + c * RSsize, 1);
+                            c++;
+                        }
+
+                        for (size_t i = 0, c = 0; i < batch.size(); i++) {
+                            if (batch_offsets[i + 1] == batch_offsets[i]) continue;
 
+                            const auto& [P2, Q2, R2, S2] = quartets[begin + i].second;
+                            int Poff2 = task_offsets[P2] - task_offsets[P2start];
+                            int Qoff2 = task_offsets[Q2] - task_offsets[Q2start];
+                            int Roff2 = task_offsets[R2] - task_offsets[R2start];
+                            int Soff2 = task_offsets[S2] - task_offsets[S2start];
+
+                            const double* Jpqc = Jpq + c * PQsize;
                             for (int p = 0; p < Psize; p++) {
                                 for (int q = 0; q < Qsize; q++) {
-                                    for (int r = 0; r < Rsize; r++) {
-                                        for (int s = 0; s < Ssize; s++) {
-                                            if (build_J) {
-                                                J1p[(p + Poff2) * dQsize + q + Qoff2] +=
-                                                    prefactor * (Dp[r + Roff][s + Soff] + Dp[s + Soff][r + Roff]) *
-                                                    (*buffer2);
-                                                J2p[(r + Roff2) * dSsize + s + Soff2] +=
-                                                    prefactor * (Dp[p + Poff][q + Qoff] + Dp[q + Qoff][p + Poff]) *
-                                                    (*buffer2);
-                                            }
-                                            
-                                            if (build_K) {
-                                                K1p[(p + Poff2) * dRsize + r + Roff2] +=
-                                                    prefactor * (Dp[q + Qoff][s + Soff]) * (*buffer2);
-                                                K2p[(p + Poff2) * dSsize + s + Soff2] +=
-                                                    prefactor * (Dp[q + Qoff][r + Roff]) * (*buffer2);
-                                                K3p[(q + Qoff2) * dRsize + r + Roff2] +=
-                                                    prefactor * (Dp[p + Poff][s + Soff]) * (*buffer2);
-                                                K4p[(q + Qoff2) * dSsize + s + Soff2] +=
-                                                    prefactor * (Dp[p + Poff][r + Roff]) * (*buffer2);
-                                                if (!lr_symmetric_) {
-                                                    K5p[(r + Roff2) * dPsize + p + Poff2] +=
-                                                        prefactor * (Dp[s + Soff][q + Qoff]) * (*buffer2);
-                                                    K6p[(s + Soff2) * dPsize + p + Poff2] +=
-                                                        prefactor * (Dp[r + Roff][q + Qoff]) * (*buffer2);
-                                                    K7p[(r + Roff2) * dQsize + q + Qoff2] +=
-                                                        prefactor * (Dp[s + Soff][p + Poff]) * (*buffer2);
-                                                    K8p[(s + Soff2) * dQsize + q + Qoff2] +=
-                                                        prefactor * (Dp[r + Roff][p + Poff]) * (*buffer2);
-                                                }
-                                            }
-                                            
-                                            buffer2++;
+                                    J1p[(p + Poff2) * dQsize + q + Qoff2] += *Jpqc++;
+                                }
+                            }
+                            const double* Jrsc = Jrs + c * RSsize;
+                            for (int r = 0; r < Rsize; r++) {
+                                for (int s = 0; s < Ssize; s++) {
+                                    J2p[(r + Roff2) * dSsize + s + Soff2] += *Jrsc++;
+                                }
+                            }
+                            c++;
+                        }
+                    }
+
+                    // Each exchange term pairs a different two indices of the quartet with the density, so K
+                    // stays an element loop over the contiguous batch buffer
+                    for (size_t i = 0; build_K && i < batch.size(); i++) {
+                        if (batch_offsets[i + 1] == batch_offsets[i]) continue;  // No integrals in this shell quartet
+
+                        const auto& [P, Q, R, S] = batch[i];
+                        const auto& [P2, Q2, R2, S2] = quartets[begin + i].second;
+                        const double* buffer2 = batch_buffer + batch_offsets[i];
+
+                        int Poff = primary_->shell(P).function_index();
+                        int Qoff = primary_->shell(Q).function_index();
+                        int Roff = primary_->shell(R).function_index();
+                        int Soff = primary_->shell(S).function_index();
+
+                        int Poff2 = task_offsets[P2] - task_offsets[P2start];
+                        int Qoff2 = task_offsets[Q2] - task_offsets[Q2start];
+                        int Roff2 = task_offsets[R2] - task_offsets[R2start];
+                        int Soff2 = task_offsets[S2] - task_offsets[S2start];
+
+                        double prefactor = quartet_prefactor(batch[i]);
+
+                        for (int p = 0; p < Psize; p++) {
+                            for (int q = 0; q < Qsize; q++) {
+                                for (int r = 0; r < Rsize; r++) {
+                                    for (int s = 0; s < Ssize; s++) {
+                                        K1p[(p + Poff2) * dRsize + r + Roff2] +=
+                                            prefactor * (Dp[q + Qoff][s + Soff]) * (*buffer2);
+                                        K2p[(p + Poff2) * dSsize + s + Soff2] +=
+                                            prefactor * (Dp[q + Qoff][r + Roff]) * (*buffer2);
+                                        K3p[(q + Qoff2) * dRsize + r + Roff2] +=
+                                            prefactor * (Dp[p + Poff][s + Soff]) * (*buffer2);
+                                        K4p[(q + Qoff2) * dSsize + s + Soff2] +=
+                                            prefactor * (Dp[p + Poff][r + Roff]) * (*buffer2);
+                                        if (!lr_symmetric_) {
+                                            K5p[(r + Roff2) * dPsize + p + Poff2] +=
+                                                prefactor * (Dp[s + Soff][q + Qoff]) * (*buffer2);
+                                            K6p[(s + Soff2) * dPsize + p + Poff2] +=
+                                                prefactor * (Dp[r + Roff][q + Qoff]) * (*buffer2);
+                                            K7p[(r + Roff2) * dQsize + q + Qoff2] +=
+                                                prefactor * (Dp[s + Soff][p + Poff]) * (*buffer2);
+                                            K8p[(s + Soff2) * dQsize + q + Qoff2] +=
+                                                prefactor * (Dp[r + Roff][p + Poff]) * (*buffer2);
                                         }
+
+                                        buffer2++;
                                     }
                                 }
                             }
                         }
-                        touched = true;
-                        // if (thread == 0) timer_off("JK: GEMV");
                     }
                 }
+                touched = true;
             }
+            thread_timer_off(digest_timer);
+            auto digest_end = std::chrono::steady_clock::now();
+
+            auto& stats = thread_am_stats[thread][am];
+            stats.quartets += computed;
+            stats.integrals += nints;
+            stats.compute_time += std::chrono::duration<double>(compute_end - compute_start).count();
+            stats.digest_time += std::chrono::duration<double>(digest_end - compute_end).count();
         }  // End Shell Quartets
 
-        if (!touched) continue;
+        if (!touched) return;
 
         // => Stripe out <= //
         if (build_J) {
@@ -938,7 +1108,17 @@ void DirectJK::build_JK_matrices(std::vector<std::shared_ptr<TwoBodyAOInt>>& int
         }  // End stripe out
         // if (thread == 0) timer_off("JK: Atomic");
 
-    }  // End master task list
+    });  // End master task list
+    for (size_t shells : thread_computed_shells) computed_shells += shells;
+    for (const auto& stats : thread_am_stats) {
+        for (const auto& [am, entry] : stats) {
+            auto& total = am_class_stats_[am];
+            total.quartets += entry.quartets;
+            total.integrals += entry.integrals;
+            total.compute_time += entry.compute_time;
+            total.digest_time += entry.digest_time;
+        }
+    }
 
     for (auto& Jmat : J) {
         Jmat->hermitivitize();
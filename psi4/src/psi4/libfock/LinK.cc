@@ -28,6 +28,7 @@
 
 #include "jk.h"
 #include "SplitJK.h"
+#include "task_scheduler.h"
 #include "psi4/libqt/qt.h"
 #include "psi4/libfock/cubature.h"
 #include "psi4/libfock/points.h"
@@ -263,8 +264,22 @@ void LinK::build_G_component(std::vector<std::shared_ptr<Matrix>>& D, std::vecto
 
     // ==> Integral Formation Loop <== //
 
-#pragma omp parallel for num_threads(nthread) schedule(dynamic) reduction(+ : computed_shells)
-    for (size_t ipair = 0L; ipair < natom_pair; ipair++) { // O(N) shell-pairs in asymptotic limit
+    // Cost model: shell-pair costs weighted by the number of significant kets
+    auto task_cost = [&](size_t ipair) {
+        int Patom = atom_pairs[ipair].first;
+        int Qatom = atom_pairs[ipair].second;
+        double cost = 0.0;
+        for (int P = shell_endpoints_for_atom[Patom]; P < shell_endpoints_for_atom[Patom + 1]; P++) {
+            for (int Q = shell_endpoints_for_atom[Qatom]; Q < shell_endpoints_for_atom[Qatom + 1]; Q++) {
+                cost += TaskScheduler::shell_cost(primary_->shell(P)) * TaskScheduler::shell_cost(primary_->shell(Q)) *
+                        (significant_kets[P].size() + significant_kets[Q].size());
+            }
+        }
+        return cost;
+    };
+    std::vector<size_t> thread_computed_shells(nthread, 0L);
+
+    scheduler(nthread).run(natom_pair, task_cost, [&](size_t ipair, int thread) { // O(N) shell-pairs in asymptotic limit
         int Patom = atom_pairs[ipair].first;
         int Qatom = atom_pairs[ipair].second;
 
@@ -280,11 +295,6 @@ void LinK::build_G_component(std::vector<std::shared_ptr<Matrix>>& D, std::vecto
         int nPbasis = basis_endpoints_for_shell[Pstart + nPshell] - basis_endpoints_for_shell[Pstart];
         int nQbasis = basis_endpoints_for_shell[Qstart + nQshell] - basis_endpoints_for_shell[Qstart];
 
-        int thread = 0;
-#ifdef _OPENMP
-        thread = omp_get_thread_num();
-#endif
-
         // Keep track of contraction indices for stripeout (Towards end of this function)
         std::vector<std::unordered_set<int>> P_stripeout_list(nPshell);
         std::vector<std::unordered_set<int>> Q_stripeout_list(nQshell);
@@ -353,7 +363,7 @@ void LinK::build_G_component(std::vector<std::shared_ptr<Matrix>>& D, std::vecto
 
                     if (eri_computers[thread]->compute_shell(P, Q, R, S) == 0)
                         continue;
-                    computed_shells++;
+                    thread_computed_shells[thread]++;
 
                     const double* buffer = eri_computers[thread]->buffer();
 
@@ -425,7 +435,7 @@ void LinK::build_G_component(std::vector<std::shared_ptr<Matrix>>& D, std::vecto
 
         // => Master shell quartet loops <= //
 
-        if (!touched) continue;
+        if (!touched) return;
 
         // => Stripe out (Writing to K matrix) <= //
         for (auto& KTmat : KT[thread]) {
@@ -487,7 +497,8 @@ void LinK::build_G_component(std::vector<std::shared_ptr<Matrix>>& D, std::vecto
 
         }  // End stripe out
 
-    }  // End master task list
+    });  // End master task list
+    for (size_t shells : thread_computed_shells) computed_shells += shells;
 
     for (auto& Kmat : K) {
         Kmat->hermitivitize();
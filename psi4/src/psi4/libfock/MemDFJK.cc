@@ -152,6 +152,9 @@ void MemDFJK::set_wcombine(bool wcombine) {
         dfh_->set_wcombine(wcombine); 
     }
 }
+void MemDFJK::set_mixed_precision(bool mixed_precision) { dfh_->set_mixed_precision(mixed_precision); }
+bool MemDFJK::get_mixed_precision() const { return dfh_->get_mixed_precision() && dfh_->get_AO_core(); }
+size_t MemDFJK::single_precision_builds() const { return dfh_->single_precision_builds(); }
 void MemDFJK::set_cutoff(double cutoff) { 
     cutoff_ = cutoff;
     if (dfh_) {
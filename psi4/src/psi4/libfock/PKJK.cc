@@ -111,6 +111,8 @@ void PKJK::preiterations() {
 
     // PK files are written at this point. We are done.
     timer_off("Total PK formation time");
+
+    if (bench_ || debug_) PKmanager_->print_task_timings();
 }
 
 void PKJK::compute_JK() {
@@ -28,6 +28,7 @@
 
 #include "PKmanagers.h"
 #include "PK_workers.h"
+#include "task_scheduler.h"
 
 #include "psi4/psi4-dec.h"
 #include "psi4/psifiles.h"
@@ -44,6 +45,8 @@
 #include "psi4/libpsio/aiohandler.h"
 #include "psi4/libpsi4util/PsiOutStream.h"
 
+#include <numeric>
+
 #ifdef _OPENMP
 #include <omp.h>
 #include "psi4/libpsi4util/process.h"
@@ -210,6 +213,10 @@ PKManager::PKManager(std::shared_ptr<BasisSet> primary, size_t memory, Options&
 #endif
 }
 
+void PKManager::print_task_timings() const {
+    if (scheduler_) scheduler_->print_timings();
+}
+
 SharedPKWrkr PKManager::get_buffer() {
     int thread = 0;
 #ifdef _OPENMP
@@ -1091,16 +1098,25 @@ void PKMgrYoshimine::compute_integrals(bool wK) {
     // Loop over significant shell pairs from TwoBodyAOInt
     const auto& sh_pairs = tb[0]->shell_pairs();
     size_t npairs = sh_pairs.size();
+
+    // Cost model: pair i is paired with all pairs j <= i
+    std::vector<double> pair_cost(npairs);
+    for (size_t i = 0; i < npairs; ++i) {
+        pair_cost[i] = TaskScheduler::shell_cost(primary()->shell(sh_pairs[i].first)) *
+                       TaskScheduler::shell_cost(primary()->shell(sh_pairs[i].second));
+    }
+    std::vector<double> pair_cost_sum(npairs);
+    std::partial_sum(pair_cost.begin(), pair_cost.end(), pair_cost_sum.begin());
+    auto task_cost = [&](size_t i) { return pair_cost[i] * pair_cost_sum[i]; };
+    if (!scheduler_ || scheduler_->nthread() != nthreads()) {
+        scheduler_ = std::make_shared<TaskScheduler>("PK", nthreads());
+    }
+
     // We avoid having one more branch in the loop by moving it outside
     if (!wK) {
-#pragma omp parallel for schedule(dynamic) num_threads(nthreads())
-        for (size_t i = 0; i < npairs; ++i) {
+        scheduler_->run(npairs, task_cost, [&](size_t i, int thread) {
             int PP = sh_pairs[i].first;
             int QQ = sh_pairs[i].second;
-            int thread = 0;
-#ifdef _OPENMP
-            thread = omp_get_thread_num();
-#endif
 
             for (size_t j = 0; j <= i; ++j) {
                 int RR = sh_pairs[j].first;
@@ -1127,19 +1143,14 @@ void PKMgrYoshimine::compute_integrals(bool wK) {
                     integrals_buffering(tb[thread]->buffer(), P, Q, R, S);
                 }
             }
-        }  // end of parallelized loop
+        });  // end of parallelized loop
 
         // We write all remaining buffers to disk.
         write();
     } else {
-#pragma omp parallel for schedule(dynamic) num_threads(nthreads())
-        for (size_t i = 0; i < npairs; ++i) {
+        scheduler_->run(npairs, task_cost, [&](size_t i, int thread) {
             int PP = sh_pairs[i].first;
             int QQ = sh_pairs[i].second;
-            int thread = 0;
-#ifdef _OPENMP
-            thread = omp_get_thread_num();
-#endif
 
             for (size_t j = 0; j <= i; ++j) {
                 int RR = sh_pairs[j].first;
@@ -1166,7 +1177,7 @@ void PKMgrYoshimine::compute_integrals(bool wK) {
                     integrals_buffering_wK(tb[thread]->buffer(), P, Q, R, S);
                 }
             }
-        }  // end of parallelized loop
+        });  // end of parallelized loop
 
         // We write all remaining buffers to disk.
         write_wK();
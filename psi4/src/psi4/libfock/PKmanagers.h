@@ -41,6 +41,7 @@ class Options;
 class AIOHandler;
 class BasisSet;
 class TwoBodyAOInt;
+class TaskScheduler;
 
 namespace pk {
 
@@ -138,6 +139,9 @@ class PKManager {
     void set_omega(double omega_in) { omega_ = omega_in; }
 
    protected:
+    /// Load-balances the integral tasks and keeps per-thread timings
+    std::shared_ptr<TaskScheduler> scheduler_;
+
     /// Setter objects for internal data
     void fill_buffer(SharedPKWrkr tmp) { iobuffers_.push_back(tmp); }
 
@@ -168,6 +172,8 @@ class PKManager {
 
     /// Accessor that returns buffer corresponding to current thread
     SharedPKWrkr get_buffer();
+    /// Print per-thread busy and idle time of the integral tasks
+    void print_task_timings() const;
     void set_ntasks(size_t tmp) { ntasks_ = tmp; }
 
     /**
@@ -27,6 +27,7 @@
  */
 
 #include "SplitJK.h"
+#include "task_scheduler.h"
 
 #include "psi4/libqt/qt.h"
 #include "psi4/liboptions/liboptions.h"
@@ -56,6 +57,17 @@ SplitJK::SplitJK(std::shared_ptr<BasisSet> primary, Options& options) : primary_
 
 SplitJK::~SplitJK() {}
 
+TaskScheduler& SplitJK::scheduler(int nthread) {
+    if (!scheduler_ || scheduler_->nthread() != nthread) {
+        scheduler_ = std::make_shared<TaskScheduler>(name(), nthread);
+    }
+    return *scheduler_;
+}
+
+void SplitJK::print_task_timings() const {
+    if (scheduler_) scheduler_->print_timings();
+}
+
 size_t SplitJK::num_computed_shells() {
     outfile->Printf("WARNING: SplitJK::num_computed_shells() was called, but benchmarking is disabled for the chosen SplitJK algorithm.");
     outfile->Printf(" Returning 0 as computed shells count.\n");
@@ -66,6 +66,7 @@ class TwoBodyAOInt;
 class Options;
 class PsiOutStream;
 class DFTGrid;
+class TaskScheduler;
 
 /**
  * Class SplitJK
@@ -108,6 +109,11 @@ class PSI_API SplitJK {
     /// Number of ERI shell quartets computed, i.e., not screened out
     size_t num_computed_shells_;
 
+    /// Load-balances the integral tasks and keeps per-thread timings
+    std::shared_ptr<TaskScheduler> scheduler_;
+    /// The scheduler for nthread threads, created on first use
+    TaskScheduler& scheduler(int nthread);
+
    public:
     // => Constructors < = //
     SplitJK(std::shared_ptr<BasisSet> primary, Options& options);
@@ -139,6 +145,12 @@ class PSI_API SplitJK {
     */
     virtual size_t num_computed_shells();
 
+    /**
+    * Print per-thread busy and idle time of the integral tasks,
+    * for algorithms that schedule them through a TaskScheduler
+    */
+    void print_task_timings() const;
+
     /**
     * print name of method
     */
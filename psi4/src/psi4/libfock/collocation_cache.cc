@@ -0,0 +1,263 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2025 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+#include "collocation_cache.h"
+#include "cubature.h"
+#include "points.h"
+
+#include "psi4/libmints/basisset.h"
+#include "psi4/libmints/matrix.h"
+#include "psi4/libpsi4util/exception.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace psi {
+
+namespace {
+
+const char* const component_names[] = {"PHI",    "PHI_X",  "PHI_Y",  "PHI_Z",  "PHI_XX",
+                                       "PHI_XY", "PHI_XZ", "PHI_YY", "PHI_YZ", "PHI_ZZ"};
+
+size_t ncomponents(int deriv) {
+    if (deriv < 0 || deriv > 2) throw PSIEXCEPTION("CollocationCache: Only up to Hessians are currently supported");
+    return (deriv + 1) * (deriv + 2) * (deriv + 3) / 6;
+}
+
+template <typename T>
+void pack(double** values, size_t npoints, const std::vector<int>& functions, T* dest) {
+    const size_t nkept = functions.size();
+    for (size_t p = 0; p < npoints; p++) {
+        const double* row = values[p];
+        T* destp = dest + p * nkept;
+        for (size_t j = 0; j < nkept; j++) {
+            destp[j] = static_cast<T>(row[functions[j]]);
+        }
+    }
+}
+
+template <typename T>
+void unpack(const T* src, size_t npoints, size_t nlocal, const std::vector<int>& functions, double** values) {
+    const size_t nkept = functions.size();
+    for (size_t p = 0; p < npoints; p++) {
+        double* row = values[p];
+        const T* srcp = src + p * nkept;
+        if (nkept == nlocal) {
+            for (size_t j = 0; j < nkept; j++) row[j] = srcp[j];
+        } else {
+            std::fill(row, row + nlocal, 0.0);
+            for (size_t j = 0; j < nkept; j++) row[functions[j]] = srcp[j];
+        }
+    }
+}
+
+}  // namespace
+
+CollocationCache::CollocationCache(bool fp32, double tolerance)
+    : fp32_(fp32), tolerance_(tolerance), deriv_(-1), size_(0), ncached_(0), nblocks_(0), hits_(0) {}
+
+std::vector<std::string> CollocationCache::components(int deriv) {
+    return std::vector<std::string>(component_names, component_names + ncomponents(deriv));
+}
+
+void CollocationCache::clear() {
+    deriv_ = -1;
+    size_ = 0;
+    ncached_ = 0;
+    nblocks_ = 0;
+    std::vector<Entry>().swap(entries_);
+    std::vector<double>().swap(arena64_);
+    std::vector<float>().swap(arena32_);
+}
+
+void CollocationCache::build(const MolecularGrid& grid, std::shared_ptr<BasisSet> primary, int deriv, size_t memory,
+                             int nthread) {
+    clear();
+    hits_ = 0;
+
+    const auto& blocks = grid.blocks();
+    const size_t nblock = blocks.size();
+    const size_t ncomp = ncomponents(deriv);
+    const size_t word = fp32_ ? sizeof(float) : sizeof(double);
+
+    // => Rank the blocks by the cost of recomputing them per stored value <= //
+
+    // Collocation cost grows with the primitives and Cartesian components of each
+    // shell, the stored size with the (pure) functions, so contracted high-AM
+    // blocks are the most profitable to keep
+    std::vector<size_t> dense_size(nblock);
+    std::vector<double> profit(nblock);
+    size_t total_size = 0;
+    for (size_t Q = 0; Q < nblock; Q++) {
+        const auto& block = blocks[Q];
+        double cost = 0.0;
+        for (int P : block->shells_local_to_global()) {
+            const GaussianShell& shell = primary->shell(P);
+            cost += static_cast<double>(shell.nprimitive()) * shell.ncartesian();
+        }
+        dense_size[Q] = block->npoints() * block->local_nbf() * ncomp;
+        profit[Q] = block->local_nbf() ? cost / block->local_nbf() : 0.0;
+        total_size += dense_size[Q];
+    }
+
+    std::vector<size_t> order(nblock);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&profit](size_t a, size_t b) { return profit[a] > profit[b]; });
+
+    // => Allocate the arena <= //
+
+    const size_t capacity = std::min(memory / word, total_size);
+    if (capacity == 0) return;
+    if (fp32_) {
+        arena32_.resize(capacity);
+    } else {
+        arena64_.resize(capacity);
+    }
+    // Blockers may drop empty blocks, so block indices need not be contiguous
+    size_t max_index = 0;
+    for (const auto& block : blocks) max_index = std::max(max_index, block->index());
+    entries_.resize(max_index + 1);
+    nblocks_ = nblock;
+    deriv_ = deriv;
+
+    std::vector<std::shared_ptr<BasisFunctions>> workers;
+    for (int t = 0; t < nthread; t++) {
+        auto worker = std::make_shared<BasisFunctions>(primary, grid.max_points(), grid.max_functions());
+        worker->set_deriv(deriv);
+        workers.push_back(worker);
+    }
+    const auto names = components(deriv);
+
+    // => Fill the arena, most profitable blocks first <= //
+
+    size_t used = 0;
+#pragma omp parallel for schedule(dynamic) num_threads(nthread)
+    for (size_t i = 0; i < nblock; i++) {
+        // Get thread info
+        int rank = 0;
+#ifdef _OPENMP
+        rank = omp_get_thread_num();
+#endif
+        const size_t Q = order[i];
+        const auto& block = blocks[Q];
+
+        // Screening only shrinks a block, so skip the computation if even the dense block would not fit
+        bool fits;
+#pragma omp critical(collocation_cache_arena)
+        fits = used + dense_size[Q] <= capacity;
+        if (!fits) continue;
+
+        auto& worker = workers[rank];
+        worker->compute_functions(block);
+
+        const size_t npoints = block->npoints();
+        const size_t nlocal = block->local_nbf();
+        std::vector<double**> values(ncomp);
+        for (size_t c = 0; c < ncomp; c++) {
+            values[c] = worker->basis_value(names[c])->pointer();
+        }
+
+        // => Function screening <= //
+
+        std::vector<double> fmax(nlocal, 0.0);
+        for (size_t c = 0; c < ncomp; c++) {
+            for (size_t p = 0; p < npoints; p++) {
+                const double* row = values[c][p];
+                for (size_t f = 0; f < nlocal; f++) {
+                    fmax[f] = std::max(fmax[f], std::fabs(row[f]));
+                }
+            }
+        }
+        std::vector<int> functions;
+        for (size_t f = 0; f < nlocal; f++) {
+            if (fmax[f] >= tolerance_) functions.push_back(f);
+        }
+
+        // => Reserve and fill <= //
+
+        const size_t size = ncomp * npoints * functions.size();
+        size_t offset = npos;
+#pragma omp critical(collocation_cache_arena)
+        if (used + size <= capacity) {
+            offset = used;
+            used += size;
+        }
+        if (offset == npos) continue;
+
+        for (size_t c = 0; c < ncomp; c++) {
+            const size_t component_offset = offset + c * npoints * functions.size();
+            if (fp32_) {
+                pack(values[c], npoints, functions, arena32_.data() + component_offset);
+            } else {
+                pack(values[c], npoints, functions, arena64_.data() + component_offset);
+            }
+        }
+
+        Entry& entry = entries_[block->index()];
+        entry.npoints = npoints;
+        entry.nlocal = nlocal;
+        entry.functions = std::move(functions);
+        entry.offset = offset;
+    }
+
+    // The arena was sized for the dense blocks, give back what screening saved
+    if (fp32_) {
+        arena32_.resize(used);
+        arena32_.shrink_to_fit();
+    } else {
+        arena64_.resize(used);
+        arena64_.shrink_to_fit();
+    }
+    size_ = used;
+    ncached_ = std::count_if(entries_.begin(), entries_.end(), [](const Entry& e) { return e.offset != npos; });
+}
+
+bool CollocationCache::expand(size_t block, int deriv, std::map<std::string, SharedMatrix>& basis_values) const {
+    if (!has(block, deriv)) return false;
+
+    const Entry& entry = entries_[block];
+    const size_t stride = entry.npoints * entry.functions.size();
+    const size_t ncomp = ncomponents(deriv);
+    for (size_t c = 0; c < ncomp; c++) {
+        double** valuesp = basis_values[component_names[c]]->pointer();
+        const size_t offset = entry.offset + c * stride;
+        if (fp32_) {
+            unpack(arena32_.data() + offset, entry.npoints, entry.nlocal, entry.functions, valuesp);
+        } else {
+            unpack(arena64_.data() + offset, entry.npoints, entry.nlocal, entry.functions, valuesp);
+        }
+    }
+    hits_++;
+    return true;
+}
+
+}  // namespace psi
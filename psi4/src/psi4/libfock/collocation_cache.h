@@ -0,0 +1,144 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2025 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+#ifndef libfock_collocation_cache_h
+#define libfock_collocation_cache_h
+
+#include "psi4/libmints/typedefs.h"
+#include "psi4/pragma.h"
+
+#include <atomic>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace psi {
+
+class BasisSet;
+class MolecularGrid;
+
+/**
+ * Class CollocationCache
+ *
+ * Stores basis function values (and derivatives) for the blocks of a DFT
+ * grid so the integrators do not recompute them on every call. All blocks
+ * live in one contiguous arena, in FP64 or, optionally, FP32. Within a block
+ * only the functions that reach the screening tolerance at some point are
+ * kept, and the blocks that are most expensive to recompute per stored byte
+ * are cached first until the memory budget is exhausted.
+ *
+ * A cache built at derivative level n serves any PointFunctions that needs
+ * derivative level n or lower, so SCF, response (Vx) and XC gradient
+ * integrations can all share it.
+ */
+class PSI_API CollocationCache {
+   protected:
+    /// A cached block, laid out as [component][point][kept function]
+    struct Entry {
+        /// Offset into the arena, npos if the block is not cached
+        size_t offset = npos;
+        /// Number of points in the block
+        size_t npoints = 0;
+        /// Number of block-local functions
+        size_t nlocal = 0;
+        /// Block-local indices of the kept functions
+        std::vector<int> functions;
+    };
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    /// Store values in single precision?
+    bool fp32_;
+    /// Functions below this magnitude at every point of a block are dropped
+    double tolerance_;
+    /// Derivative level of the stored values, -1 if empty
+    int deriv_;
+    /// Number of values stored in the arena
+    size_t size_;
+    /// Entries, by block index
+    std::vector<Entry> entries_;
+    /// Number of cached blocks
+    size_t ncached_;
+    /// Number of blocks of the cached grid
+    size_t nblocks_;
+    /// Arena used when fp32_ is false
+    std::vector<double> arena64_;
+    /// Arena used when fp32_ is true
+    std::vector<float> arena32_;
+    /// Number of blocks served by expand() since the last build
+    mutable std::atomic<size_t> hits_;
+
+   public:
+    /**
+     * @param fp32 store the values in single precision
+     * @param tolerance drop block-local functions below this magnitude
+     */
+    CollocationCache(bool fp32, double tolerance);
+
+    /**
+     * Compute and store the collocation of the grid's blocks
+     * @param grid grid whose blocks are cached, any previous contents are dropped
+     * @param primary basis set of the integration
+     * @param deriv derivative level to store
+     * @param memory maximum size of the arena, in bytes
+     * @param nthread number of threads
+     */
+    void build(const MolecularGrid& grid, std::shared_ptr<BasisSet> primary, int deriv, size_t memory, int nthread);
+
+    /// Drop all blocks and release the arena
+    void clear();
+
+    /// Can block be served at derivative level deriv?
+    bool has(size_t block, int deriv) const {
+        return deriv <= deriv_ && block < entries_.size() && entries_[block].offset != npos;
+    }
+
+    /**
+     * Copy a cached block into basis_values, the "PHI", "PHI_X", ... matrices of a
+     * BasisFunctions at derivative level deriv, in the layout compute_functions() produces.
+     * @return false, leaving basis_values untouched, if the block cannot be served
+     */
+    bool expand(size_t block, int deriv, std::map<std::string, SharedMatrix>& basis_values) const;
+
+    /// Names of the components stored for derivative level deriv, in arena order
+    static std::vector<std::string> components(int deriv);
+
+    int deriv() const { return deriv_; }
+    bool fp32() const { return fp32_; }
+    double tolerance() const { return tolerance_; }
+    size_t ncached() const { return ncached_; }
+    size_t nblocks() const { return nblocks_; }
+    /// Number of blocks served from the cache since the last build, kept across clear()
+    size_t hits() const { return hits_; }
+    /// Size of the stored values in bytes
+    size_t memory() const { return size_ * (fp32_ ? sizeof(float) : sizeof(double)); }
+};
+
+}  // namespace psi
+
+#endif
@@ -47,6 +47,8 @@
 #include <limits>
 #include <cctype>
 #include <cassert>
+#include <list>
+#include <mutex>
 
 #ifdef _OPENMP
 #include <omp.h>
@@ -3721,6 +3723,156 @@ int RadialPruneMgr::ShellPruning(int ri, int Z, int radial_pts) {
     return LebedevGridMgr::findNPointsByOrder_roundUp(pruned_order);
 }
 
+namespace {
+
+/// Builds byte-exact lookup keys
+class CacheKey {
+    std::string key_;
+
+   public:
+    template <typename T>
+    void add(const T &value) {
+        key_.append(reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+    void add(const std::string &value) {
+        add(value.size());
+        key_.append(value);
+    }
+    void add(const double *values, size_t n) { key_.append(reinterpret_cast<const char *>(values), sizeof(double) * n); }
+    const std::string &str() const { return key_; }
+};
+
+/// The geometry-independent part of an atomic grid
+struct AtomicGridTemplate {
+    std::shared_ptr<RadialGrid> radial;
+    std::vector<std::shared_ptr<SphericalGrid>> spheres;
+    /// Radial nodes and weights
+    std::vector<double> r;
+    std::vector<double> wr;
+    /// Lebedev grid and its size, per radial node
+    std::vector<const MassPoint *> anggrids;
+    std::vector<int> nangpts;
+    /// Atom-centred points in the standard orientation, without nuclear weights
+    std::vector<MassPoint> points;
+};
+
+/// Atomic grid templates, by element and radial/angular options
+std::shared_ptr<const AtomicGridTemplate> atomic_grid_template(int Z, MolecularGrid::MolecularGridOptions const &opt,
+                                                               RadialPruneMgr &prune) {
+    static std::mutex mutex;
+    static std::map<std::string, std::shared_ptr<const AtomicGridTemplate>> templates;
+
+    CacheKey key;
+    key.add(Z);
+    key.add(opt.nradpts);
+    key.add(opt.nangpts);
+    key.add(opt.radscheme);
+    key.add(opt.bs_radius_alpha);
+    key.add(opt.prunefunction);
+    key.add(opt.pruning_alpha);
+    key.add(opt.prunescheme);
+    key.add(opt.prunetype);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto found = templates.find(key.str());
+    if (found != templates.end()) return found->second;
+
+    auto atom_grid = std::make_shared<AtomicGridTemplate>();
+    atom_grid->r.resize(opt.nradpts);
+    atom_grid->wr.resize(opt.nradpts);
+    std::vector<double> &r = atom_grid->r;
+    std::vector<double> &wr = atom_grid->wr;
+    double alpha = GetBSRadius(Z) * opt.bs_radius_alpha;
+    RadialGridMgr::makeRadialGrid(opt.nradpts, RadialGridMgr::MuraKnowlesHack(opt.radscheme, Z), r.data(), wr.data(),
+                                  alpha);
+    atom_grid->radial = RadialGrid::build("Unknown", opt.nradpts, r.data(), wr.data(), alpha, Z);
+
+    for (int i = 0; i < opt.nradpts; i++) {
+        int numAngPts = 0;
+        if (opt.prunetype == "REGION") {
+            if (opt.prunescheme == "TREUTLER") {
+                numAngPts = prune.TreutlerShellPruning(i, Z, opt.nradpts);
+            } else if (opt.prunescheme == "ROBUST") {
+                numAngPts = prune.ShellPruning(i, Z, opt.nradpts);
+            }
+        } else if (opt.prunetype == "FUNCTION" || opt.prunescheme == "NONE") {
+            numAngPts = prune.GetPrunedNumAngPts(r[i] / alpha);
+        }
+        assert(numAngPts > 0);
+        const MassPoint *anggrid = LebedevGridMgr::findGridByNPoints(numAngPts);
+
+        atom_grid->anggrids.push_back(anggrid);
+        atom_grid->nangpts.push_back(numAngPts);
+        atom_grid->spheres.push_back(SphericalGrid::build("Unknown", numAngPts, anggrid));
+        for (int j = 0; j < numAngPts; j++) {
+            atom_grid->points.push_back(
+                {r[i] * anggrid[j].x, r[i] * anggrid[j].y, r[i] * anggrid[j].z, wr[i] * anggrid[j].w});
+        }
+    }
+
+    templates[key.str()] = atom_grid;
+    return atom_grid;
+}
+
+/// Bytes held by the points and blocks of a built grid
+size_t grid_memory(const MolecularGrid &grid) {
+    size_t bytes = 4 * sizeof(double) * grid.npoints();
+    for (const auto &block : grid.blocks()) {
+        bytes += sizeof(BlockOPoints);
+        bytes += sizeof(int) * (block->shells_local_to_global().size() + block->functions_local_to_global().size());
+    }
+    return bytes;
+}
+
+/// Built molecular grids, most recently used first
+class MolecularGridCache {
+    struct Entry {
+        std::string key;
+        std::shared_ptr<const MolecularGrid> grid;
+        size_t bytes;
+    };
+    std::mutex mutex_;
+    std::list<Entry> grids_;
+    /// Bytes held by the grids in grids_
+    size_t bytes_ = 0;
+
+   public:
+    std::shared_ptr<const MolecularGrid> find(const std::string &key) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto it = grids_.begin(); it != grids_.end(); ++it) {
+            if (it->key == key) {
+                grids_.splice(grids_.begin(), grids_, it);
+                return grids_.front().grid;
+            }
+        }
+        return nullptr;
+    }
+    /// Keep grid, dropping the least recently used grids beyond capacity grids or memory bytes
+    void insert(const std::string &key, std::shared_ptr<const MolecularGrid> grid, size_t capacity, size_t memory) {
+        const size_t bytes = grid_memory(*grid);
+        if (bytes > memory) return;
+        std::lock_guard<std::mutex> lock(mutex_);
+        grids_.push_front({key, grid, bytes});
+        bytes_ += bytes;
+        while (grids_.size() > capacity || bytes_ > memory) {
+            bytes_ -= grids_.back().bytes;
+            grids_.pop_back();
+        }
+    }
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        grids_.clear();
+        bytes_ = 0;
+    }
+};
+
+MolecularGridCache &molecular_grid_cache() {
+    static MolecularGridCache cache;
+    return cache;
+}
+
+}  // namespace
+
 void MolecularGrid::buildGridFromOptions(MolecularGridOptions const &opt) {
     options_ = opt;  // Save a copy
     atomic_grids_.clear();
@@ -3756,8 +3908,17 @@ void MolecularGrid::buildGridFromOptions(MolecularGridOptions const &opt) {
         }
     }
 
-// Iterate over atoms
-#pragma omp parallel for schedule(static)
+    // The atom-centred grids depend only on the element, build each once up front
+    std::map<int, std::shared_ptr<const AtomicGridTemplate>> atom_templates;
+    if (opt.namedGrid == -1) {
+        for (int A = 0; A < molecule_->natom(); A++) {
+            int Z = molecule_->true_atomic_number(A);
+            if (!atom_templates.count(Z)) atom_templates[Z] = atomic_grid_template(Z, opt, prune);
+        }
+    }
+
+// Iterate over atoms, the nuclear weights of heavy and light atoms differ a lot in cost
+#pragma omp parallel for schedule(dynamic)
     for (int A = 0; A < molecule_->natom(); A++) {
         int Z = molecule_->true_atomic_number(A);
         double stratmannCutoff = nuc.GetStratmannCutoff(A);
@@ -3770,33 +3931,18 @@ void MolecularGrid::buildGridFromOptions(MolecularGridOptions const &opt) {
 #endif
 
         if (opt.namedGrid == -1) {  // Not using a named grid
-            std::vector<double> r(opt.nradpts), wr(opt.nradpts);
-            double alpha = GetBSRadius(Z) * opt.bs_radius_alpha;
-            RadialGridMgr::makeRadialGrid(opt.nradpts, RadialGridMgr::MuraKnowlesHack(opt.radscheme, Z), r.data(),
-                                          wr.data(), alpha);
+            const AtomicGridTemplate &atom_grid = *atom_templates.at(Z);
 
             // RMP: Want this stuff too
-            radial_grids_[A] = RadialGrid::build("Unknown", opt.nradpts, r.data(), wr.data(), alpha, Z);
-            std::vector<std::shared_ptr<SphericalGrid>> spheres;
-            spherical_grids_[A] = spheres;
-
-            int currentBlockIndex = -1;
-            for (int i = 0; i < opt.nradpts; i++) {
-                int numAngPts = 0;
-                if (opt.prunetype == "REGION") {
-                    if (opt.prunescheme == "TREUTLER") {
-                        numAngPts = prune.TreutlerShellPruning(i, Z, opt.nradpts);
-                    } else if (opt.prunescheme == "ROBUST") {
-                        numAngPts = prune.ShellPruning(i, Z, opt.nradpts);
-                    }
-                } else if (opt.prunetype == "FUNCTION" || opt.prunescheme == "NONE") {
-                    numAngPts = prune.GetPrunedNumAngPts(r[i] / alpha);
-                }
-                assert(numAngPts > 0);
-                const MassPoint *anggrid = LebedevGridMgr::findGridByNPoints(numAngPts);
+            radial_grids_[A] = atom_grid.radial;
+            spherical_grids_[A] = atom_grid.spheres;
 
 #ifdef USING_BrianQC
-                if (brianEnable and brianEnableDFT) {
+            if (brianEnable and brianEnableDFT) {
+                int currentBlockIndex = -1;
+                for (int i = 0; i < opt.nradpts; i++) {
+                    int numAngPts = atom_grid.nangpts[i];
+                    const MassPoint *anggrid = atom_grid.anggrids[i];
                     if (currentBlockIndex == -1 or atomBlocks[A][currentBlockIndex].angularPoints.size() != numAngPts) {
                         atomBlocks[A].push_back(BrianBlock());
                         currentBlockIndex++;
@@ -3808,23 +3954,20 @@ void MolecularGrid::buildGridFromOptions(MolecularGridOptions const &opt) {
                         }
                     }
 
-                    atomBlocks[A][currentBlockIndex].radialPoints.push_back({r[i], wr[i]});
+                    atomBlocks[A][currentBlockIndex].radialPoints.push_back({atom_grid.r[i], atom_grid.wr[i]});
                 }
+            }
 #endif
 
-                // RMP: And this stuff! This whole thing is completely and utterly FUBAR.
-                spherical_grids_[A].push_back(SphericalGrid::build("Unknown", numAngPts, anggrid));
-                for (int j = 0; j < numAngPts; j++) {
-                    MassPoint mp = {r[i] * anggrid[j].x, r[i] * anggrid[j].y, r[i] * anggrid[j].z,
-                                    wr[i] * anggrid[j].w};
-                    mp = std_orientation.MoveIntoPosition(mp, A);
-                    mp.w *= nuc.computeNuclearWeight(mp, A, stratmannCutoff);
+            // Only the position and the nuclear weights depend on the geometry
+            for (const MassPoint &P : atom_grid.points) {
+                MassPoint mp = std_orientation.MoveIntoPosition(P, A);
+                mp.w *= nuc.computeNuclearWeight(mp, A, stratmannCutoff);
 
-                    if (std::abs(mp.w) > weightcut) {
-                        atomic_grids_[A].push_back(mp);
-                    }
-                    assert(!std::isnan(mp.w));
+                if (std::abs(mp.w) > weightcut) {
+                    atomic_grids_[A].push_back(mp);
                 }
+                assert(!std::isnan(mp.w));
             }
         } else {
             assert(opt.namedGrid == 0 || opt.namedGrid == 1);
@@ -4305,12 +4448,8 @@ void DFTGrid::buildGridFromOptions(std::map<std::string, int> int_opts_map,
     double max_radius = full_float_options["DFT_BLOCK_MAX_RADIUS"];
     double epsilon = full_float_options["DFT_BASIS_TOLERANCE"];
     auto extents = std::make_shared<BasisExtents>(primary_, epsilon);
-    timer_on("build grid");
-    MolecularGrid::buildGridFromOptions(opt);
-    timer_off("build grid");
-    timer_on("post-process grid");
-    postProcess(extents, max_points, min_points, max_radius);
-    timer_off("post-process grid");
+    MolecularGrid::buildGridFromOptions(opt, extents, max_points, min_points, max_radius,
+                                        options_.get_int("DFT_GRID_CACHE_SIZE"));
 }
 
 // REFACTOR NOTE: PS grids are not used. Not all possible MolecularGridOptions are being set.
@@ -4352,7 +4491,7 @@ void PseudospectralGrid::buildGridFromOptions() {
 MolecularGrid::MolecularGrid(std::shared_ptr<Molecule> molecule)
     : debug_(0), molecule_(molecule), npoints_(0), max_points_(0), max_functions_(0) {}
 MolecularGrid::~MolecularGrid() {
-    if (npoints_) {
+    if (npoints_ && !shared_grid_) {
         delete[] x_;
         delete[] y_;
         delete[] z_;
@@ -4360,6 +4499,104 @@ MolecularGrid::~MolecularGrid() {
     }
 }
 
+void MolecularGrid::share(std::shared_ptr<const MolecularGrid> grid) {
+    shared_grid_ = grid;
+    options_ = grid->options_;
+    npoints_ = grid->npoints_;
+    max_points_ = grid->max_points_;
+    max_functions_ = grid->max_functions_;
+    collocation_size_ = grid->collocation_size_;
+    x_ = grid->x_;
+    y_ = grid->y_;
+    z_ = grid->z_;
+    w_ = grid->w_;
+    orientation_ = grid->orientation_;
+    radial_grids_ = grid->radial_grids_;
+    spherical_grids_ = grid->spherical_grids_;
+    atomic_grids_ = grid->atomic_grids_;
+    blocks_ = grid->blocks_;
+    atomic_blocks_ = grid->atomic_blocks_;
+    extents_ = grid->extents_;
+    primary_ = grid->primary_;
+}
+
+void MolecularGrid::buildGridFromOptions(MolecularGridOptions const &opt, std::shared_ptr<BasisExtents> extents,
+                                         int max_points, int min_points, double max_radius, size_t cache_size) {
+    // Benchmark output is written while building, so never take those grids from the cache
+    if (cache_size == 0 || opt.bench) {
+        timer_on("build grid");
+        buildGridFromOptions(opt);
+        timer_off("build grid");
+        timer_on("post-process grid");
+        postProcess(extents, max_points, min_points, max_radius);
+        timer_off("post-process grid");
+        return;
+    }
+
+    // => Key: geometry, basis and everything in the options that changes the points or blocks <= //
+    CacheKey key;
+    key.add(molecule_->natom());
+    for (int A = 0; A < molecule_->natom(); A++) {
+        key.add(molecule_->true_atomic_number(A));
+        key.add(molecule_->Z(A));
+        key.add(molecule_->mass(A));
+        Vector3 v = molecule_->xyz(A);
+        key.add(v[0]);
+        key.add(v[1]);
+        key.add(v[2]);
+    }
+    std::shared_ptr<BasisSet> basis = extents->basis();
+    key.add(basis->has_puream());
+    key.add(basis->nshell());
+    for (int P = 0; P < basis->nshell(); P++) {
+        const GaussianShell &shell = basis->shell(P);
+        key.add(shell.ncenter());
+        key.add(shell.am());
+        key.add(shell.is_pure());
+        key.add(shell.nprimitive());
+        key.add(shell.exps(), shell.nprimitive());
+        key.add(shell.coefs(), shell.nprimitive());
+    }
+    key.add(extents->delta());
+    key.add(opt.bs_radius_alpha);
+    key.add(opt.pruning_alpha);
+    key.add(opt.radscheme);
+    key.add(opt.prunefunction);
+    key.add(opt.nucscheme);
+    key.add(opt.namedGrid);
+    key.add(opt.remove_distant_points);
+    key.add(opt.nradpts);
+    key.add(opt.nangpts);
+    key.add(opt.weights_cutoff);
+    key.add(opt.prunescheme);
+    key.add(opt.prunetype);
+    key.add(opt.blockscheme);
+    key.add(max_points);
+    key.add(min_points);
+    key.add(max_radius);
+
+    std::shared_ptr<const MolecularGrid> grid = molecular_grid_cache().find(key.str());
+    if (!grid) {
+        auto built = std::make_shared<MolecularGrid>(molecule_);
+        built->set_debug(debug_);
+        timer_on("build grid");
+        built->buildGridFromOptions(opt);
+        timer_off("build grid");
+        timer_on("post-process grid");
+        built->postProcess(extents, max_points, min_points, max_radius);
+        timer_off("post-process grid");
+        grid = built;
+        // Cached grids outlive their computation, so hold them to a tenth of the memory setting
+        molecular_grid_cache().insert(key.str(), grid, cache_size, Process::environment.get_memory() / 10);
+    }
+    share(grid);
+    // Printing options are not part of the key
+    options_.print = opt.print;
+    options_.debug = opt.debug;
+}
+
+void MolecularGrid::clear_cache() { molecular_grid_cache().clear(); }
+
 void MolecularGrid::block(int max_points, int min_points, double max_radius) {
     std::shared_ptr<GridBlocker> blocker;
     if (options_.blockscheme == "NAIVE") {
@@ -4400,40 +4637,41 @@ void MolecularGrid::block(int max_points, int min_points, double max_radius) {
 void MolecularGrid::remove_distant_points(double Rmax) {
     if (Rmax == std::numeric_limits<double>::max()) return;
 
-    int npoints2 = npoints_;
-    int offset = 0;
-    int point_index = 0;
-    std::vector<std::vector<MassPoint>> temp_grids(molecule_->natom());
-    for (int atom = 0; atom < atomic_grids_.size(); ++atom) {
-        for (int Q = 0; Q < atomic_grids_[atom].size(); ++Q) {
-            auto P = atomic_grids_[atom][Q];
-            Vector3 v = molecule_->xyz(atom);
-            double R = (P.x - v[0]) * (P.x - v[0]) + (P.y - v[1]) * (P.y - v[1]) + (P.z - v[2]) * (P.z - v[2]);
-            for (int A = 0; A < molecule_->natom(); A++) {
-                if (Q == A) continue;
-                v = molecule_->xyz(A);
-                double R2 = (P.x - v[0]) * (P.x - v[0]) + (P.y - v[1]) * (P.y - v[1]) + (P.z - v[2]) * (P.z - v[2]);
-                if (R > R2) {
-                    R = R2;
-                }
+    const int natom = molecule_->natom();
+    std::vector<Vector3> centers(natom);
+    for (int A = 0; A < natom; A++) centers[A] = molecule_->xyz(A);
+    const double Rmax2 = Rmax * Rmax;
+
+    // A point is kept if any atom is within Rmax, its own atom almost always is
+    std::vector<std::vector<MassPoint>> temp_grids(atomic_grids_.size());
+#pragma omp parallel for schedule(dynamic)
+    for (int atom = 0; atom < (int)atomic_grids_.size(); ++atom) {
+        for (const MassPoint &P : atomic_grids_[atom]) {
+            auto distance2 = [&P](const Vector3 &v) {
+                return (P.x - v[0]) * (P.x - v[0]) + (P.y - v[1]) * (P.y - v[1]) + (P.z - v[2]) * (P.z - v[2]);
+            };
+            bool keep = distance2(centers[atom]) <= Rmax2;
+            for (int A = 0; A < natom && !keep; A++) {
+                keep = distance2(centers[A]) <= Rmax2;
             }
-            if (R > Rmax * Rmax) {
-                npoints2--;
-            } else {
-                temp_grids[atom].push_back(P);
-                x_[offset] = x_[point_index];
-                y_[offset] = y_[point_index];
-                z_[offset] = z_[point_index];
-                w_[offset] = w_[point_index];
-                offset++;
-            }
-            ++point_index;
+            if (keep) temp_grids[atom].push_back(P);
         }
     }
-    npoints_ = npoints2;
-    atomic_grids_ = temp_grids;
+
+    int offset = 0;
+    for (const auto &grid_per_atom : temp_grids) {
+        for (const MassPoint &P : grid_per_atom) {
+            x_[offset] = P.x;
+            y_[offset] = P.y;
+            z_[offset] = P.z;
+            w_[offset] = P.w;
+            offset++;
+        }
+    }
+    npoints_ = offset;
+    atomic_grids_ = std::move(temp_grids);
     // free up allocated storage capacity.
-    for (size_t i = 0; i < atomic_grids_.size(); i++){
+    for (size_t i = 0; i < atomic_grids_.size(); i++) {
         atomic_grids_[i].shrink_to_fit();
     }
 }
@@ -4520,6 +4758,21 @@ AtomicGridBlocker::AtomicGridBlocker(const int npoints_ref, double const *x_ref,
       molecule_(molecule),
       atomic_grids_(atomic_grids) {}
 AtomicGridBlocker::~AtomicGridBlocker() {}
+std::vector<std::shared_ptr<BlockOPoints>> GridBlocker::build_blocks(const std::vector<size_t> &indices,
+                                                                    const std::vector<size_t> &offsets,
+                                                                    const std::vector<size_t> &sizes) const {
+    // Finding the significant shells of each block is the expensive part of blocking large systems
+    std::vector<std::shared_ptr<BlockOPoints>> blocks(indices.size());
+#pragma omp parallel for schedule(dynamic)
+    for (size_t A = 0; A < indices.size(); A++) {
+        size_t Q = offsets[A];
+        auto bop = std::make_shared<BlockOPoints>(indices[A], sizes[A], &x_[Q], &y_[Q], &z_[Q], &w_[Q], extents_);
+        // BlockOPoints construction performs additional pruning. Need to test if any points remain.
+        if (bop->local_nbf()) blocks[A] = bop;
+    }
+    return blocks;
+}
+
 void AtomicGridBlocker::block() {
     npoints_ = npoints_ref_;
     max_points_ = tol_max_points_;
@@ -4539,7 +4792,7 @@ void AtomicGridBlocker::block() {
     atomic_blocks_.resize(molecule_->natom());
 
     // naive subdivision
-    blocks_.clear();
+    std::vector<size_t> indices, offsets, sizes, parents;
     size_t block_index = 0;
     size_t point_index = 0;
     for (size_t i = 0; i < atomic_grids_.size(); i++) {
@@ -4553,17 +4806,23 @@ void AtomicGridBlocker::block() {
                 z_[point_index + N] = atomic_grids_[i][Q + N].z;
                 w_[point_index + N] = atomic_grids_[i][Q + N].w;
             }
-            auto bop = std::make_shared<BlockOPoints>(block_index, n, &x_[point_index], &y_[point_index],
-                                                      &z_[point_index], &w_[point_index], extents_);
-            if (bop->local_nbf()) {
-                bop->set_parent_atom(i);
-                blocks_.push_back(bop);
-                atomic_blocks_[i].push_back(bop);
-            }
+            indices.push_back(block_index);
+            offsets.push_back(point_index);
+            sizes.push_back(n);
+            parents.push_back(i);
             block_index += 1;
             point_index += n;
         }
     }
+
+    auto blocks = build_blocks(indices, offsets, sizes);
+    blocks_.clear();
+    for (size_t A = 0; A < blocks.size(); A++) {
+        if (!blocks[A]) continue;
+        blocks[A]->set_parent_atom(parents[A]);
+        blocks_.push_back(blocks[A]);
+        atomic_blocks_[parents[A]].push_back(blocks[A]);
+    }
     // Determine max_functions per block and collocation size.
     max_functions_ = 0;
     collocation_size_ = 0;
@@ -4595,14 +4854,16 @@ void NaiveGridBlocker::block() {
     ::memcpy((void *)z_, (void *)z_ref_, sizeof(double) * npoints_);
     ::memcpy((void *)w_, (void *)w_ref_, sizeof(double) * npoints_);
 
-    blocks_.clear();
+    std::vector<size_t> offsets, sizes;
     for (size_t Q = 0; Q < npoints_; Q += max_points_) {
-        size_t n = (Q + max_points_ >= npoints_ ? npoints_ - Q : max_points_);
-        auto bop = std::make_shared<BlockOPoints>(Q, n, &x_[Q], &y_[Q], &z_[Q], &w_[Q], extents_);
-        // prevent blocks without bf that will crash collocation caching
-        if (bop->local_nbf()) {
-            blocks_.push_back(bop);
-        }
+        offsets.push_back(Q);
+        sizes.push_back(Q + max_points_ >= npoints_ ? npoints_ - Q : max_points_);
+    }
+
+    // prevent blocks without bf that will crash collocation caching
+    blocks_.clear();
+    for (const auto &bop : build_blocks(offsets, offsets, sizes)) {
+        if (bop) blocks_.push_back(bop);
     }
 
     max_functions_ = 0;
@@ -4662,9 +4923,14 @@ void OctreeGridBlocker::block() {
         for (int k = 0; k < 3; k++) {
             new_leaves.clear();
             double const *X = dims[k];
+            // Leaves split independently, collect their children per leaf to keep the serial order
+            std::vector<std::vector<std::vector<int>>> leaf_leaves(active_tree.size());
+            std::vector<std::vector<std::vector<int>>> leaf_completed(active_tree.size());
+// The bench trace is written in order, so keep that serial
+#pragma omp parallel for schedule(dynamic) if (!bench_)
             for (size_t A = 0; A < active_tree.size(); A++) {
                 // Block to subdivide
-                std::vector<int> block = active_tree[A];
+                const std::vector<int> &block = active_tree[A];
 
                 // Determine xcenter of mass
                 double xc = 0.0;
@@ -4699,9 +4965,9 @@ void OctreeGridBlocker::block() {
 
                 // Left side fate
                 if (left.size() > (size_t)tol_max_points_) {
-                    new_leaves.push_back(left);
+                    leaf_leaves[A].push_back(std::move(left));
                 } else if (left.size() <= (size_t)tol_min_points_) {
-                    completed_tree.push_back(left);
+                    leaf_completed[A].push_back(std::move(left));
                 } else {
                     double XC[3];
                     ::memset((void *)XC, '\0', 3 * sizeof(double));
@@ -4726,17 +4992,17 @@ void OctreeGridBlocker::block() {
 
                     // Terminate if necessary
                     if (RC2 < T2) {
-                        completed_tree.push_back(left);
+                        leaf_completed[A].push_back(std::move(left));
                     } else {
-                        new_leaves.push_back(left);
+                        leaf_leaves[A].push_back(std::move(left));
                     }
                 }
 
                 // Right side fate
                 if (right.size() > tol_max_points_) {
-                    new_leaves.push_back(right);
+                    leaf_leaves[A].push_back(std::move(right));
                 } else if (right.size() <= tol_min_points_) {
-                    completed_tree.push_back(right);
+                    leaf_completed[A].push_back(std::move(right));
                 } else {
                     double XC[3];
                     ::memset((void *)XC, '\0', 3 * sizeof(double));
@@ -4761,13 +5027,17 @@ void OctreeGridBlocker::block() {
 
                     // Terminate if necessary
                     if (RC2 < T2) {
-                        completed_tree.push_back(right);
+                        leaf_completed[A].push_back(std::move(right));
                     } else {
-                        new_leaves.push_back(right);
+                        leaf_leaves[A].push_back(std::move(right));
                     }
                 }
             }
-            active_tree = new_leaves;
+            for (size_t A = 0; A < active_tree.size(); A++) {
+                for (auto &leaf : leaf_completed[A]) completed_tree.push_back(std::move(leaf));
+                for (auto &leaf : leaf_leaves[A]) new_leaves.push_back(std::move(leaf));
+            }
+            active_tree = std::move(new_leaves);
             tree_level++;
             if (!active_tree.size()) {
                 completed = true;
@@ -4791,7 +5061,7 @@ void OctreeGridBlocker::block() {
         // outfile->Printf(fh_blocks, "#  %4s %15s %15s %15s %15s\n", "ID", "X", "Y", "Z", "W");
     }
     for (size_t A = 0; A < completed_tree.size(); A++) {
-        std::vector<int> block = completed_tree[A];
+        const std::vector<int> &block = completed_tree[A];
         for (size_t Q = 0; Q < block.size(); Q++) {
             int delta = block[Q];
             x_[index] = x[delta];
@@ -4806,22 +5076,24 @@ void OctreeGridBlocker::block() {
         if (block.size()) unique_block++;
     }
 
-    blocks_.clear();
+    std::vector<size_t> indices, offsets, sizes;
     index = 0;
-    max_points_ = 0;
     for (size_t A = 0; A < completed_tree.size(); A++) {
-        std::vector<int> block = completed_tree[A];
-        if (!block.size()) continue;
-        auto bop =
-            std::make_shared<BlockOPoints>(A, block.size(), &x_[index], &y_[index], &z_[index], &w_[index], extents_);
-        // BlockOPoints construction performs additional pruning. Need to test if any points remain.
-        if (bop->local_nbf()) {
-            blocks_.push_back(bop);
-            if ((size_t)max_points_ < block.size()) {
-                max_points_ = block.size();
-            }
+        if (!completed_tree[A].size()) continue;
+        indices.push_back(A);
+        offsets.push_back(index);
+        sizes.push_back(completed_tree[A].size());
+        index += completed_tree[A].size();
+    }
+
+    blocks_.clear();
+    max_points_ = 0;
+    for (const auto &bop : build_blocks(indices, offsets, sizes)) {
+        if (!bop) continue;
+        blocks_.push_back(bop);
+        if ((size_t)max_points_ < bop->npoints()) {
+            max_points_ = bop->npoints();
         }
-        index += block.size();
     }
 
     max_functions_ = 0;
@@ -108,10 +108,15 @@ class MolecularGrid {
     /// BasisSet from extents_
     std::shared_ptr<BasisSet> primary_;
 
+    /// Grid whose points and blocks this grid shares, set if it was taken from the grid cache
+    std::shared_ptr<const MolecularGrid> shared_grid_;
+
     /// Sieve and block
     void postProcess(std::shared_ptr<BasisExtents> extents, int max_points, int min_points, double max_radius);
     void remove_distant_points(double Rcut);
     void block(int max_points, int min_points, double max_radius);
+    /// Take the points, weights and blocks of grid instead of building them
+    void share(std::shared_ptr<const MolecularGrid> grid);
 
    public:
     struct MolecularGridOptions {
@@ -146,6 +151,14 @@ class MolecularGrid {
 
     /// Build the grid
     void buildGridFromOptions(MolecularGridOptions const& opt);
+    /// Build the grid and block it against extents. Keeps up to cache_size built grids, within a
+    /// tenth of the memory setting, and, if one matches the geometry, basis and options exactly,
+    /// shares it instead of rebuilding. Grids on a different geometry never match, so their points
+    /// and blocks are always rebuilt.
+    void buildGridFromOptions(MolecularGridOptions const& opt, std::shared_ptr<BasisExtents> extents, int max_points,
+                              int min_points, double max_radius, size_t cache_size);
+    /// Drop all grids kept by the grid cache; called by psi4.core.clean()
+    static void clear_cache();
 
     /// Print information about the grid
     void print(std::string out_fname = "outfile", int print = 2) const;
@@ -439,6 +452,8 @@ class BlockOPoints {
     double* w() const { return w_; }
     /// The center of the block
     Vector3 center() const { return xc_; }
+    /// The radius of a sphere around center() that holds all points
+    double radius() const { return R_; }
 
     /// Relevant shells, local -> global
     const std::vector<int>& shells_local_to_global() const { return shells_local_to_global_; }
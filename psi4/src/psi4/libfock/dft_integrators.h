@@ -62,11 +62,11 @@ inline std::vector<double> rks_quadrature_integrate(std::shared_ptr<BlockOPoints
     auto w = block->w();
 
     // Superfunctional data
-    auto zk = fworker->value("V")->pointer();
-    auto QTp = fworker->value("Q_TMP")->pointer();
+    auto zk = fworker->xc_value(XCValue::V);
+    auto QTp = fworker->xc_value(XCValue::Q_TMP);
 
     // Points data
-    auto rho_a = pworker->point_value("RHO_A")->pointer();
+    auto rho_a = pworker->xc_point_value(XCValue::RHO_A);
 
     // Build quadrature
     std::vector<double> ret(5);
@@ -125,8 +125,8 @@ inline void rks_integrator(std::shared_ptr<BlockOPoints> block, std::shared_ptr<
     ansatz = (ansatz == -1 ? fworker->ansatz() : ansatz);
     // printf("Ansatz %d\n", ansatz);
 
-    // Block data
-    const auto& function_map = block->functions_local_to_global();
+    // Block data, restricted to the functions that survived screening in compute_points
+    const auto& function_map = pworker->active_functions();
     auto nlocal = function_map.size();
     auto npoints = block->npoints();
     auto w = block->w();
@@ -136,7 +136,7 @@ inline void rks_integrator(std::shared_ptr<BlockOPoints> block, std::shared_ptr<
 
     // Points data
     auto phi = pworker->basis_value("PHI")->pointer();
-    auto rho_a = pworker->point_value("RHO_A")->pointer();
+    auto rho_a = pworker->xc_point_value(XCValue::RHO_A);
     auto coll_funcs = pworker->basis_value("PHI")->ncol();
 
     // V2 Temporary
@@ -147,33 +147,38 @@ inline void rks_integrator(std::shared_ptr<BlockOPoints> block, std::shared_ptr<
     //                                         ∂
     // T := 1/2 einsum("p, p, pn -> pn", w, φ, -- f)
     //                                         ∂ρ
-    auto v_rho_a = fworker->value("V_RHO_A")->pointer();
+    static const size_t lsda_timer = timer_key("LSDA Phi_tmp");
+    static const size_t gga_timer = timer_key("GGA Phi_tmp");
+    static const size_t meta_timer = timer_key("Meta");
+
+    thread_timer_on(lsda_timer);
+    auto v_rho_a = fworker->xc_value(XCValue::V_RHO_A);
     for (int P = 0; P < npoints; P++) {
         std::fill(Tp[P], Tp[P] + nlocal, 0.0);
         C_DAXPY(nlocal, 0.5 * v_rho_a[P] * w[P], phi[P], 1, Tp[P], 1);
     }
-    // parallel_timer_off("LSDA Phi_tmp", rank);
+    thread_timer_off(lsda_timer);
 
     // => GGA contribution <= //
     if (ansatz >= 1) {
         //                                        ∂
         // T += einsum("p, p, xp, xpn -> pnσ", w, -- f, ∇ρ, ∇φ)
         //                                        ∂Γ
-        // parallel_timer_on("GGA Phi_tmp", rank);
+        thread_timer_on(gga_timer);
         auto phix = pworker->basis_value("PHI_X")->pointer();
         auto phiy = pworker->basis_value("PHI_Y")->pointer();
         auto phiz = pworker->basis_value("PHI_Z")->pointer();
-        auto rho_ax = pworker->point_value("RHO_AX")->pointer();
-        auto rho_ay = pworker->point_value("RHO_AY")->pointer();
-        auto rho_az = pworker->point_value("RHO_AZ")->pointer();
-        auto v_gamma_aa = fworker->value("V_GAMMA_AA")->pointer();
+        auto rho_ax = pworker->xc_point_value(XCValue::RHO_AX);
+        auto rho_ay = pworker->xc_point_value(XCValue::RHO_AY);
+        auto rho_az = pworker->xc_point_value(XCValue::RHO_AZ);
+        auto v_gamma_aa = fworker->xc_value(XCValue::V_GAMMA_AA);
 
         for (int P = 0; P < npoints; P++) {
             C_DAXPY(nlocal, w[P] * (2.0 * v_gamma_aa[P] * rho_ax[P]), phix[P], 1, Tp[P], 1);
             C_DAXPY(nlocal, w[P] * (2.0 * v_gamma_aa[P] * rho_ay[P]), phiy[P], 1, Tp[P], 1);
             C_DAXPY(nlocal, w[P] * (2.0 * v_gamma_aa[P] * rho_az[P]), phiz[P], 1, Tp[P], 1);
         }
-        // parallel_timer_off("GGA Phi_tmp", rank);
+        thread_timer_off(gga_timer);
     }
 
     // ==> Contract T aginst φ, replacing a point index with  an AO index <==
@@ -189,11 +194,11 @@ inline void rks_integrator(std::shared_ptr<BlockOPoints> block, std::shared_ptr<
 
     // => Meta contribution <= //
     if (ansatz >= 2) {
-        // parallel_timer_on("Meta", rank);
+        thread_timer_on(meta_timer);
         auto phix = pworker->basis_value("PHI_X")->pointer();
         auto phiy = pworker->basis_value("PHI_Y")->pointer();
         auto phiz = pworker->basis_value("PHI_Z")->pointer();
-        auto v_tau_a = fworker->value("V_TAU_A")->pointer();
+        auto v_tau_a = fworker->xc_value(XCValue::V_TAU_A);
 
         double** phi_w[3];
         phi_w[0] = phix;
@@ -209,7 +214,7 @@ inline void rks_integrator(std::shared_ptr<BlockOPoints> block, std::shared_ptr<
             C_DGEMM('T', 'N', nlocal, nlocal, npoints, 1.0, phiw[0], coll_funcs, Tp[0], max_functions, 1.0, V2p[0],
                     max_functions);
         }
-        // parallel_timer_off("Meta", rank);
+        thread_timer_off(meta_timer);
     }
 }
 
@@ -239,7 +244,7 @@ inline void rks_gradient_integrator(std::shared_ptr<BasisSet> primary, std::shar
     auto phi_x = pworker->basis_value("PHI_X")->pointer();
     auto phi_y = pworker->basis_value("PHI_Y")->pointer();
     auto phi_z = pworker->basis_value("PHI_Z")->pointer();
-    auto rho_a = pworker->point_value("RHO_A")->pointer();
+    auto rho_a = pworker->xc_point_value(XCValue::RHO_A);
     auto coll_funcs = pworker->basis_value("PHI")->ncol();
 
     // => phi_x type contributions <= //
@@ -247,7 +252,7 @@ inline void rks_gradient_integrator(std::shared_ptr<BasisSet> primary, std::shar
     //                                      ∂        ∂
     // T:= -2 * einsum("p, p, pm -> pm", w, -- f, φ, -- φ, φ, D, δ)
     //                                      ∂ρ       ∂x
-    auto v_rho_a = fworker->value("V_RHO_A")->pointer();
+    auto v_rho_a = fworker->xc_value(XCValue::V_RHO_A);
     for (int P = 0; P < npoints; P++) {
         std::fill(Tp[P], Tp[P] + nlocal, 0.0);
         C_DAXPY(nlocal, -2.0 * w[P] * v_rho_a[P], phi[P], 1, Tp[P], 1);
@@ -255,10 +260,10 @@ inline void rks_gradient_integrator(std::shared_ptr<BasisSet> primary, std::shar
 
     // ==> GGA Contribution (Term 1) <== //
     if (fworker->is_gga()) {
-        auto rho_ax = pworker->point_value("RHO_AX")->pointer();
-        auto rho_ay = pworker->point_value("RHO_AY")->pointer();
-        auto rho_az = pworker->point_value("RHO_AZ")->pointer();
-        auto v_gamma_aa = fworker->value("V_GAMMA_AA")->pointer();
+        auto rho_ax = pworker->xc_point_value(XCValue::RHO_AX);
+        auto rho_ay = pworker->xc_point_value(XCValue::RHO_AY);
+        auto rho_az = pworker->xc_point_value(XCValue::RHO_AZ);
+        auto v_gamma_aa = fworker->xc_value(XCValue::V_GAMMA_AA);
 
         for (int P = 0; P < npoints; P++) {
             C_DAXPY(nlocal, -2.0 * w[P] * (2.0 * v_gamma_aa[P] * rho_ax[P]), phi_x[P], 1, Tp[P], 1);
@@ -290,10 +295,10 @@ inline void rks_gradient_integrator(std::shared_ptr<BasisSet> primary, std::shar
         double** phi_yy = pworker->basis_value("PHI_YY")->pointer();
         double** phi_yz = pworker->basis_value("PHI_YZ")->pointer();
         double** phi_zz = pworker->basis_value("PHI_ZZ")->pointer();
-        double* rho_ax = pworker->point_value("RHO_AX")->pointer();
-        double* rho_ay = pworker->point_value("RHO_AY")->pointer();
-        double* rho_az = pworker->point_value("RHO_AZ")->pointer();
-        double* v_gamma_aa = fworker->value("V_GAMMA_AA")->pointer();
+        double* rho_ax = pworker->xc_point_value(XCValue::RHO_AX);
+        double* rho_ay = pworker->xc_point_value(XCValue::RHO_AY);
+        double* rho_az = pworker->xc_point_value(XCValue::RHO_AZ);
+        double* v_gamma_aa = fworker->xc_value(XCValue::V_GAMMA_AA);
 
         C_DGEMM('N', 'N', npoints, nlocal, nlocal, 1.0, phi[0], coll_funcs, Dp[0], max_functions, 0.0, Up[0],
                 max_functions);
@@ -343,7 +348,7 @@ inline void rks_gradient_integrator(std::shared_ptr<BasisSet> primary, std::shar
         double** phi_yy = pworker->basis_value("PHI_YY")->pointer();
         double** phi_yz = pworker->basis_value("PHI_YZ")->pointer();
         double** phi_zz = pworker->basis_value("PHI_ZZ")->pointer();
-        double* v_tau_a = fworker->value("V_TAU_A")->pointer();
+        double* v_tau_a = fworker->xc_value(XCValue::V_TAU_A);
 
         double** phi_i[3];
         phi_i[0] = phi_x;
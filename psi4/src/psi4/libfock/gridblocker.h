@@ -73,6 +73,12 @@ class GridBlocker {
     double* w_;
     std::vector<std::shared_ptr<BlockOPoints>> blocks_;
 
+    /// Build blocks of the new layout in parallel. Block A holds sizes[A] points starting at
+    /// offsets[A] and gets index indices[A]; blocks without significant functions are null.
+    std::vector<std::shared_ptr<BlockOPoints>> build_blocks(const std::vector<size_t>& indices,
+                                                            const std::vector<size_t>& offsets,
+                                                            const std::vector<size_t>& sizes) const;
+
    public:
     GridBlocker(const int npoints_ref, double const* x_ref, double const* y_ref, double const* z_ref,
                 double const* w_ref, const int max_points, const int min_points, const double max_radius,
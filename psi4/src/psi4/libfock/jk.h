@@ -29,6 +29,9 @@
 #ifndef JK_H
 #define JK_H
 
+#include <array>
+#include <map>
+#include <tuple>
 #include <vector>
 
 #include "psi4/pragma.h"
@@ -52,6 +55,7 @@ class PSIO;
 class DFHelper;
 class DFTGrid;
 class PetiteList;
+class TaskScheduler;
 
 namespace pk {
 class PKManager;
@@ -485,6 +489,18 @@ class PSI_API JK {
     virtual void set_omega_beta(double beta) { omega_beta_ = beta; }
     double get_omega_beta() { return omega_beta_; }
 
+    /**
+    * Contract three-index quantities in single precision, for
+    * the early iterations of an SCF. Only honored by algorithms
+    * that support it; the others always work in double precision.
+    * @param mixed_precision use single precision,
+    *        defaults to false
+    */
+    virtual void set_mixed_precision(bool mixed_precision) {}
+    virtual bool get_mixed_precision() const { return false; }
+    /// Number of compute() calls that contracted in single precision
+    virtual size_t single_precision_builds() const { return 0; }
+
     // => Computers <= //
 
     /**
@@ -751,6 +767,24 @@ class PSI_API DirectJK : public JK {
     // Is the JK currently on the first SCF iteration of this SCF cycle?
     bool initial_iteration_ = true;
 
+    /// Load-balances the shell quartet tasks and keeps per-thread timings
+    std::shared_ptr<TaskScheduler> scheduler_;
+
+    /// Maximum number of shell quartets of one angular momentum class computed as a batch
+    int batch_quartets_;
+
+    /// Work done on one angular momentum class of shell quartets
+    struct AMClassStatistics {
+        size_t quartets = 0;
+        size_t integrals = 0;
+        double compute_time = 0.0;
+        double digest_time = 0.0;
+    };
+    /// Accumulated per (PQ|RS) angular momentum class over all builds
+    std::map<std::array<int, 4>, AMClassStatistics> am_class_stats_;
+    /// Print am_class_stats_ to the output file
+    void print_am_class_statistics() const;
+
     std::string name() override { return "DirectJK"; }
     size_t memory_estimate() override;
 
@@ -814,6 +848,12 @@ class PSI_API DirectJK : public JK {
     // => Accessors <= //
     bool do_incfock_iter() { return do_incfock_iter_; }
 
+    /**
+    * Shell quartets computed, integrals computed, and seconds spent computing and
+    * digesting them, per angular momentum class such as "(PP|DS)", over all builds so far
+    */
+    std::map<std::string, std::tuple<size_t, size_t, double, double>> am_class_statistics() const;
+
     /**
     * Print header information regarding JK
     * type on output file
@@ -1188,6 +1228,10 @@ class PSI_API MemDFJK : public JK {
     void set_omega_beta(double beta) override;
     void set_wcombine(bool wcombine) override;
     void set_cutoff(double cutoff) override; 
+    /// Single-precision J/K from the in-core AOs; no effect out-of-core
+    void set_mixed_precision(bool mixed_precision) override;
+    bool get_mixed_precision() const override;
+    size_t single_precision_builds() const override;
 
     /**
      * Returns the DFHelper object
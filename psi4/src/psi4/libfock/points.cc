@@ -27,6 +27,7 @@
  */
 
 #include "points.h"
+#include "collocation_cache.h"
 #include "cubature.h"
 
 #include "psi4/libmints/basisset.h"
@@ -39,14 +40,13 @@
 #include "gau2grid/gau2grid.h"
 #include <libint2/config.h>
 
+#include <algorithm>
 #include <cmath>
 
 namespace psi {
 
 SAPFunctions::SAPFunctions(std::shared_ptr<BasisSet> primary, int max_points, int max_functions)
-    : PointFunctions(primary, max_points, max_functions) {
-    current_basis_map_ = &basis_values_;
-}
+    : PointFunctions(primary, max_points, max_functions) {}
 SAPFunctions::~SAPFunctions() {}
 std::vector<SharedMatrix> SAPFunctions::scratch() {
     std::vector<SharedMatrix> vec;
@@ -57,17 +57,16 @@ void SAPFunctions::build_temps() { temp_ = std::make_shared<Matrix>("Temp", max_
 void SAPFunctions::allocate() {
     BasisFunctions::allocate();
     point_values_.clear();
+    xc_point_values_ = XCValues();
     build_temps();
 }
 void SAPFunctions::compute_points(std::shared_ptr<BlockOPoints> block, bool force_compute) {
     // => Build basis function values <= //
     block_index_ = block->index();
-    if (!force_compute && cache_map_ && (cache_map_->find(block->index()) != cache_map_->end())) {
-        current_basis_map_ = &(*cache_map_)[block->index()];
-    } else {
-        current_basis_map_ = &basis_values_;
+    if (force_compute || !collocation_cache_ || !collocation_cache_->expand(block->index(), deriv_, basis_values_)) {
         BasisFunctions::compute_functions(block);
     }
+    active_functions_ = block->functions_local_to_global();
 }
 void SAPFunctions::print(std::string out, int print) const {
     std::shared_ptr<psi::PsiOutStream> printer = (out == "outfile" ? outfile : std::make_shared<PsiOutStream>(out));
@@ -105,7 +104,6 @@ void SAPFunctions::set_pointers(SharedMatrix /*Ca_AO*/) {
 RKSFunctions::RKSFunctions(std::shared_ptr<BasisSet> primary, int max_points, int max_functions)
     : PointFunctions(primary, max_points, max_functions) {
     set_ansatz(0);
-    current_basis_map_ = &basis_values_;
 }
 RKSFunctions::~RKSFunctions() {}
 std::vector<SharedMatrix> RKSFunctions::scratch() {
@@ -144,6 +142,7 @@ void RKSFunctions::allocate() {
         point_values_["RHO_ZZ"] = std::make_shared<Vector>("RHO_ZZ", max_points_);
         point_values_["TAU_A"] = std::make_shared<Vector>("TAU_A", max_points_);
     }
+    xc_point_values_ = XCValues(point_values_);
     build_temps();
 }
 void RKSFunctions::set_pointers(SharedMatrix D_AO) { D_AO_ = D_AO; }
@@ -155,18 +154,16 @@ void RKSFunctions::compute_points(std::shared_ptr<BlockOPoints> block, bool forc
 
     // => Build basis function values <= //
     block_index_ = block->index();
-    if (!force_compute && cache_map_ && (cache_map_->find(block->index()) != cache_map_->end())) {
-        current_basis_map_ = &(*cache_map_)[block->index()];
-    } else {
-        current_basis_map_ = &basis_values_;
+    if (force_compute || !collocation_cache_ || !collocation_cache_->expand(block->index(), deriv_, basis_values_)) {
         BasisFunctions::compute_functions(block);
     }
+    screen_functions(block, {D_AO_});
 
     // => Global information <= //
     int npoints = block->npoints();
-    const std::vector<int>& function_map = block->functions_local_to_global();
+    const std::vector<int>& function_map = active_functions_;
     int nglobal = max_functions_;
-    int nlocal = function_map.size();
+    int nlocal = density_functions_;
 
     double** Tp = temp_->pointer();
 
@@ -188,7 +185,7 @@ void RKSFunctions::compute_points(std::shared_ptr<BlockOPoints> block, bool forc
 
     // => Build LSDA quantities <= //
     double** phip = basis_value("PHI")->pointer();
-    double* rhoap = point_value("RHO_A")->pointer();
+    double* rhoap = xc_point_value(XCValue::RHO_A);
     size_t coll_funcs = basis_value("PHI")->ncol();
 
     // Rho_a = 2.0 * D_xy phi_xa phi_ya
@@ -203,10 +200,10 @@ void RKSFunctions::compute_points(std::shared_ptr<BlockOPoints> block, bool forc
         double** phixp = basis_value("PHI_X")->pointer();
         double** phiyp = basis_value("PHI_Y")->pointer();
         double** phizp = basis_value("PHI_Z")->pointer();
-        double* rhoaxp = point_value("RHO_AX")->pointer();
-        double* rhoayp = point_value("RHO_AY")->pointer();
-        double* rhoazp = point_value("RHO_AZ")->pointer();
-        double* gammaaap = point_value("GAMMA_AA")->pointer();
+        double* rhoaxp = xc_point_value(XCValue::RHO_AX);
+        double* rhoayp = xc_point_value(XCValue::RHO_AY);
+        double* rhoazp = xc_point_value(XCValue::RHO_AZ);
+        double* gammaaap = xc_point_value(XCValue::GAMMA_AA);
 
         for (int P = 0; P < npoints; P++) {
             // 2.0 for Px D P + P D Px
@@ -225,7 +222,7 @@ void RKSFunctions::compute_points(std::shared_ptr<BlockOPoints> block, bool forc
         double** phixp = basis_value("PHI_X")->pointer();
         double** phiyp = basis_value("PHI_Y")->pointer();
         double** phizp = basis_value("PHI_Z")->pointer();
-        double* taup = point_value("TAU_A")->pointer();
+        double* taup = xc_point_value(XCValue::TAU_A);
 
         std::fill(taup, taup + npoints, 0.0);
 
@@ -300,10 +297,7 @@ void RKSFunctions::set_Cs(SharedMatrix /*Ca_AO*/, SharedMatrix /*Cb_AO*/) {
 void RKSFunctions::compute_orbitals(std::shared_ptr<BlockOPoints> block, bool force_compute) {
     // => Build basis function values <= //
     block_index_ = block->index();
-    if (!force_compute && cache_map_ && (cache_map_->find(block->index()) != cache_map_->end())) {
-        current_basis_map_ = &(*cache_map_)[block->index()];
-    } else {
-        current_basis_map_ = &basis_values_;
+    if (force_compute || !collocation_cache_ || !collocation_cache_->expand(block->index(), deriv_, basis_values_)) {
         BasisFunctions::compute_functions(block);
     }
     // timer_off("Functions: Points");
@@ -363,7 +357,6 @@ void RKSFunctions::print(std::string out, int print) const {
 UKSFunctions::UKSFunctions(std::shared_ptr<BasisSet> primary, int max_points, int max_functions)
     : PointFunctions(primary, max_points, max_functions) {
     set_ansatz(0);
-    current_basis_map_ = &basis_values_;
 }
 UKSFunctions::~UKSFunctions() {}
 std::vector<SharedMatrix> UKSFunctions::scratch() {
@@ -410,6 +403,7 @@ void UKSFunctions::allocate() {
         point_values_["TAU_A"] = std::make_shared<Vector>("TAU_A", max_points_);
         point_values_["TAU_B"] = std::make_shared<Vector>("TAU_A", max_points_);
     }
+    xc_point_values_ = XCValues(point_values_);
     build_temps();
 }
 void UKSFunctions::set_pointers(SharedMatrix /*Da_AO*/) {
@@ -424,18 +418,16 @@ void UKSFunctions::compute_points(std::shared_ptr<BlockOPoints> block, bool forc
 
     // => Build basis function values <= //
     block_index_ = block->index();
-    if (!force_compute && cache_map_ && (cache_map_->find(block->index()) != cache_map_->end())) {
-        current_basis_map_ = &(*cache_map_)[block->index()];
-    } else {
-        current_basis_map_ = &basis_values_;
+    if (force_compute || !collocation_cache_ || !collocation_cache_->expand(block->index(), deriv_, basis_values_)) {
         BasisFunctions::compute_functions(block);
     }
+    screen_functions(block, {Da_AO_, Db_AO_});
 
     // => Global information <= //
     int npoints = block->npoints();
-    const std::vector<int>& function_map = block->functions_local_to_global();
+    const std::vector<int>& function_map = active_functions_;
     int nglobal = max_functions_;
-    int nlocal = function_map.size();
+    int nlocal = density_functions_;
 
     double** Tap = tempa_->pointer();
     double** Tbp = tempb_->pointer();
@@ -463,8 +455,8 @@ void UKSFunctions::compute_points(std::shared_ptr<BlockOPoints> block, bool forc
 
     // => Build LSDA quantities <= //
     double** phip = basis_value("PHI")->pointer();
-    double* rhoap = point_value("RHO_A")->pointer();
-    double* rhobp = point_value("RHO_B")->pointer();
+    double* rhoap = xc_point_value(XCValue::RHO_A);
+    double* rhobp = xc_point_value(XCValue::RHO_B);
     size_t coll_funcs = basis_value("PHI")->ncol();
 
     C_DGEMM('N', 'N', npoints, nlocal, nlocal, 1.0, phip[0], coll_funcs, Da2p[0], nglobal, 0.0, Tap[0], nglobal);
@@ -482,15 +474,15 @@ void UKSFunctions::compute_points(std::shared_ptr<BlockOPoints> block, bool forc
         double** phixp = basis_value("PHI_X")->pointer();
         double** phiyp = basis_value("PHI_Y")->pointer();
         double** phizp = basis_value("PHI_Z")->pointer();
-        double* rhoaxp = point_value("RHO_AX")->pointer();
-        double* rhoayp = point_value("RHO_AY")->pointer();
-        double* rhoazp = point_value("RHO_AZ")->pointer();
-        double* rhobxp = point_value("RHO_BX")->pointer();
-        double* rhobyp = point_value("RHO_BY")->pointer();
-        double* rhobzp = point_value("RHO_BZ")->pointer();
-        double* gammaaap = point_value("GAMMA_AA")->pointer();
-        double* gammaabp = point_value("GAMMA_AB")->pointer();
-        double* gammabbp = point_value("GAMMA_BB")->pointer();
+        double* rhoaxp = xc_point_value(XCValue::RHO_AX);
+        double* rhoayp = xc_point_value(XCValue::RHO_AY);
+        double* rhoazp = xc_point_value(XCValue::RHO_AZ);
+        double* rhobxp = xc_point_value(XCValue::RHO_BX);
+        double* rhobyp = xc_point_value(XCValue::RHO_BY);
+        double* rhobzp = xc_point_value(XCValue::RHO_BZ);
+        double* gammaaap = xc_point_value(XCValue::GAMMA_AA);
+        double* gammaabp = xc_point_value(XCValue::GAMMA_AB);
+        double* gammabbp = xc_point_value(XCValue::GAMMA_BB);
 
         for (int P = 0; P < npoints; P++) {
             // 2.0 for Px D P + P D Px
@@ -517,8 +509,8 @@ void UKSFunctions::compute_points(std::shared_ptr<BlockOPoints> block, bool forc
         double** phixp = basis_value("PHI_X")->pointer();
         double** phiyp = basis_value("PHI_Y")->pointer();
         double** phizp = basis_value("PHI_Z")->pointer();
-        double* tauap = point_value("TAU_A")->pointer();
-        double* taubp = point_value("TAU_B")->pointer();
+        double* tauap = xc_point_value(XCValue::TAU_A);
+        double* taubp = xc_point_value(XCValue::TAU_B);
 
         std::fill(tauap, tauap + npoints, 0.0);
         std::fill(taubp, taubp + npoints, 0.0);
@@ -570,10 +562,7 @@ void UKSFunctions::set_Cs(SharedMatrix Ca_AO, SharedMatrix Cb_AO) {
 void UKSFunctions::compute_orbitals(std::shared_ptr<BlockOPoints> block, bool force_compute) {
     // => Build basis function values <= //
     block_index_ = block->index();
-    if (!force_compute && cache_map_ && (cache_map_->find(block->index()) != cache_map_->end())) {
-        current_basis_map_ = &(*cache_map_)[block->index()];
-    } else {
-        current_basis_map_ = &basis_values_;
+    if (force_compute || !collocation_cache_ || !collocation_cache_->expand(block->index(), deriv_, basis_values_)) {
         BasisFunctions::compute_functions(block);
     }
 
@@ -648,6 +637,97 @@ SharedVector PointFunctions::point_value(const std::string& key) { return point_
 
 SharedMatrix PointFunctions::orbital_value(const std::string& key) { return orbital_values_[key]; }
 
+void PointFunctions::pack_functions(int npoints, const std::vector<int>& keep) {
+    int nlocal = active_functions_.size();
+    std::vector<int> order(keep);
+    std::vector<bool> kept(nlocal, false);
+    for (int ml : keep) kept[ml] = true;
+    for (int ml = 0; ml < nlocal; ml++) {
+        if (!kept[ml]) order.push_back(ml);
+    }
+
+    std::vector<double> row(nlocal);
+    for (const auto& kv : basis_values_) {
+        double** phip = kv.second->pointer();
+        for (int P = 0; P < npoints; P++) {
+            for (int k = 0; k < nlocal; k++) row[k] = phip[P][order[k]];
+            std::copy(row.begin(), row.end(), phip[P]);
+        }
+    }
+    std::vector<int> functions(nlocal);
+    std::vector<double> function_max(nlocal);
+    for (int k = 0; k < nlocal; k++) {
+        functions[k] = active_functions_[order[k]];
+        function_max[k] = function_max_[order[k]];
+    }
+    active_functions_.swap(functions);
+    function_max_.swap(function_max);
+}
+
+void PointFunctions::screen_functions(std::shared_ptr<BlockOPoints> block, const std::vector<SharedMatrix>& Ds) {
+    const std::vector<int>& function_map = block->functions_local_to_global();
+    active_functions_ = function_map;
+    density_functions_ = function_map.size();
+    block_npoints_ = block->npoints();
+    if (screening_tolerance_ <= 0.0) return;
+
+    int npoints = block->npoints();
+    int nlocal = function_map.size();
+
+    // => Largest collocation of each function over the block, derivatives included <= //
+    function_max_.assign(nlocal, 0.0);
+    for (const auto& kv : basis_values_) {
+        double** phip = kv.second->pointer();
+        for (int P = 0; P < npoints; P++) {
+            for (int ml = 0; ml < nlocal; ml++) {
+                function_max_[ml] = std::max(function_max_[ml], std::fabs(phip[P][ml]));
+            }
+        }
+    }
+
+    // => Bound on each function's contribution to the density and its derivatives <= //
+    //
+    // |sum_n D_mn phi_m phi_n| <= max|phi_m| sum_n |D_mn| max|phi_n|
+    std::vector<int> kept;
+    for (int ml = 0; ml < nlocal; ml++) {
+        int mg = function_map[ml];
+        double bound = 0.0;
+        for (const auto& D : Ds) {
+            double** Dp = D->pointer();
+            double val = 0.0;
+            for (int nl = 0; nl < nlocal; nl++) {
+                val += std::fabs(Dp[mg][function_map[nl]]) * function_max_[nl];
+            }
+            bound = std::max(bound, function_max_[ml] * val);
+        }
+        if (bound >= screening_tolerance_) kept.push_back(ml);
+    }
+    density_functions_ = kept.size();
+    if (kept.size() == function_map.size()) return;
+
+    // The potential does not depend on the density, so the other functions stay behind the kept ones
+    pack_functions(npoints, kept);
+}
+
+void PointFunctions::screen_potential(double potential_bound) {
+    if (screening_tolerance_ <= 0.0) return;
+
+    int nlocal = active_functions_.size();
+    double phimax = 0.0;
+    for (int ml = 0; ml < nlocal; ml++) phimax = std::max(phimax, function_max_[ml]);
+
+    // max_n |V_mn| <= max|phi_m| max_n max|phi_n| potential_bound
+    std::vector<int> kept;
+    for (int ml = 0; ml < nlocal; ml++) {
+        if (function_max_[ml] * phimax * potential_bound >= screening_tolerance_) kept.push_back(ml);
+    }
+    if (kept.size() == active_functions_.size()) return;
+
+    pack_functions(block_npoints_, kept);
+    active_functions_.resize(kept.size());
+    function_max_.resize(kept.size());
+}
+
 BasisFunctions::BasisFunctions(std::shared_ptr<BasisSet> primary, int max_points, int max_functions)
     : primary_(primary), max_points_(max_points), max_functions_(max_functions) {
     
@@ -30,6 +30,7 @@
 #define libfock_points_H
 
 #include "psi4/libmints/typedefs.h"
+#include "psi4/libfunctional/xc_values.h"
 #include "psi4/pragma.h"
 
 #include <cstdio>
@@ -44,6 +45,7 @@ namespace psi {
 class BasisSet;
 class Vector;
 class BlockOPoints;
+class CollocationCache;
 
 class PSI_API BasisFunctions {
    protected:
@@ -110,22 +112,43 @@ class PointFunctions : public BasisFunctions {
     /// The index of the current referenced block.
     size_t block_index_;
 
-    // Contains a map to the cache the global basis_values
-    std::unordered_map<size_t, std::map<std::string, SharedMatrix>>* cache_map_ = nullptr;
-
-    // Contains a pointer to the current map to use for basis_values
-    std::map<std::string, SharedMatrix>* current_basis_map_ = nullptr;
+    /// Collocation cache consulted by compute_points, not owned
+    const CollocationCache* collocation_cache_ = nullptr;
 
     /// Ansatz (0 - LSDA, 1 - GGA, 2 - Meta-GGA)
     int ansatz_;
     /// Map of value names to Vectors containing values
     std::map<std::string, std::shared_ptr<Vector>> point_values_;
+    /// Pointers into point_values_ by XCValue, refreshed by allocate()
+    XCValues xc_point_values_;
 
     // => Orbital Collocation <= //
 
     /// Map of value names to Matrices containing values
     std::map<std::string, std::shared_ptr<Matrix>> orbital_values_;
 
+    // => Function Screening <= //
+
+    /// Functions whose largest collocation in a block times their density magnitude falls below this are
+    /// left out of the density built by compute_points, and functions whose largest collocation times the
+    /// potential bound passed to screen_potential falls below it are left out of the potential.
+    /// 0.0 disables screening.
+    double screening_tolerance_ = 0.0;
+    /// Global indices of the collocation columns of the last block
+    std::vector<int> active_functions_;
+    /// Largest collocation of each column over the block, derivatives included, when screening
+    std::vector<double> function_max_;
+    /// Number of leading columns that enter the density
+    size_t density_functions_ = 0;
+    /// Number of points of the last block, for screen_potential
+    int block_npoints_ = 0;
+    /// Moves the columns listed in keep to the front of the collocation matrices, in order, followed by the
+    /// others, and permutes active_functions_ and function_max_ alike
+    void pack_functions(int npoints, const std::vector<int>& keep);
+    /// Packs the functions of block that survive screening against the densities Ds to the front of the
+    /// collocation matrices, keeping the others behind them for the potential
+    void screen_functions(std::shared_ptr<BlockOPoints> block, const std::vector<SharedMatrix>& Ds);
+
    public:
     // => Constructors <= //
 
@@ -133,28 +156,38 @@ class PointFunctions : public BasisFunctions {
     ~PointFunctions() override;
 
     // => Setters <= //
-    void set_cache_map(std::unordered_map<size_t, std::map<std::string, SharedMatrix>>* cache_map) {
-        cache_map_ = cache_map;
-    }
+    void set_collocation_cache(const CollocationCache* collocation_cache) { collocation_cache_ = collocation_cache; }
+    void set_screening_tolerance(double screening_tolerance) { screening_tolerance_ = screening_tolerance; }
 
     // => Computers <= //
     /// Compute needed DFT intermediates, e.g. rho, gamma, at the points in block.
     /// ansatz_ determines which intermediates are needed.
-    /// force_compute forces basis function values at points to be re-computed.
+    /// force_compute forces basis function values at points to be re-computed,
+    /// otherwise they are taken from the collocation cache if it holds the block.
     virtual void compute_points(std::shared_ptr<BlockOPoints> block, bool force_compute = true) = 0;
 
     // => Accessors <= //
 
     std::shared_ptr<Vector> point_value(const std::string& key);
     std::map<std::string, SharedVector>& point_values() { return point_values_; }
-
-    SharedMatrix basis_value(const std::string& key) { return (*current_basis_map_)[key]; }
-    std::map<std::string, SharedMatrix>& basis_values() { return (*current_basis_map_); }
+    const XCValues& xc_point_values() const { return xc_point_values_; }
+    double* xc_point_value(XCValue key) const { return xc_point_values_[key]; }
 
     virtual std::vector<SharedMatrix> scratch() = 0;
     virtual std::vector<SharedMatrix> D_scratch() = 0;
 
     int ansatz() const { return ansatz_; }
+    double screening_tolerance() const { return screening_tolerance_; }
+    /// Global indices of the collocation columns. After compute_points these are all of the block's
+    /// functions, reordered if screening left some out of the density; after screen_potential only
+    /// those the potential is contracted with remain.
+    const std::vector<int>& active_functions() const { return active_functions_; }
+    /// Number of leading columns of active_functions() that entered the density in compute_points
+    size_t density_functions() const { return density_functions_; }
+    /// Drops the functions whose potential matrix elements over the last block are bounded below the
+    /// screening tolerance, given a bound on the integrated potential kernel such that
+    /// |V_mn| <= max|phi_m| max|phi_n| potential_bound, with derivatives in max|phi|
+    void screen_potential(double potential_bound);
 
     // => Setters <= //
 
@@ -296,9 +329,6 @@ class UKSFunctions : public PointFunctions {
 
     void set_pointers(SharedMatrix Da_occ_AO) override;
     void set_pointers(SharedMatrix Da_occ_AO, SharedMatrix Db_occ_AO) override;
-    void set_cache_map(std::unordered_map<size_t, std::map<std::string, SharedMatrix>>* cache_map) {
-        cache_map_ = cache_map;
-    }
 
     /// Compute the needed DFT intermediates at the points in the block.
     /// "Which DFT intermediates are needed?" is determined from ansatz_.
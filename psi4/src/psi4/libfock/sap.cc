@@ -42,9 +42,8 @@ order schemes may result in instabilities */
 /* Returns the cutoff radius in bohr */
 double sap_cutoff_radius() { return 3.99999995751228e+01; }
 
-/* Return the effective charge at radius x */
-double sap_effective_charge(int Z, double x) {
-    static const double Zeff[SAP_NELEM][SAP_NRAD] = {
+/* Tabulated effective charges; row 0 holds the radial grid in bohr */
+static const double Zeff[SAP_NELEM][SAP_NRAD] = {
         {0.00000000000000e+00, 7.74564534039568e-10, 2.47256327461087e-08, 1.86997862087340e-07, 7.83531011839395e-07,
          2.37369448442132e-06, 5.85385578447464e-06, 1.25192693640128e-05, 2.41120079015646e-05, 4.28530598081574e-05,
          7.14571735608571e-05, 1.13129528705579e-04, 1.71543841230856e-04, 2.50802052874775e-04, 3.55376294767219e-04,
@@ -18976,6 +18975,21 @@ double sap_effective_charge(int Z, double x) {
          5.68434188608080e-14, 7.10542735760100e-14, 5.68434188608080e-14, 5.68434188608080e-14, 5.68434188608080e-14,
          5.68434188608080e-14, 5.68434188608080e-14, 4.26325641456060e-14, 7.10542735760100e-14, 5.68434188608080e-14,
          5.68434188608080e-14}};
+
+/* Returns the number of radial points in the table */
+size_t sap_radial_points() { return SAP_NRAD; }
+
+/* Returns the number of rows in the table, i.e. the largest supported Z + 1 */
+int sap_num_elements() { return SAP_NELEM; }
+
+/* Returns the radial grid of the table in bohr */
+const double* sap_radial_grid() { return Zeff[0]; }
+
+/* Returns the effective charges of element Z tabulated on the radial grid */
+const double* sap_tabulated_charges(int Z) { return Zeff[Z]; }
+
+/* Return the effective charge at radius x */
+double sap_effective_charge(int Z, double x) {
     /* Array lookup */
     {
         /* Table lookup helpers */
@@ -29,6 +29,9 @@
 
 #ifndef SAP_POTENTIAL
 #define SAP_POTENTIAL
+
+#include <stddef.h>
+
 /*
   Routines for the implementation of the superposition of atomic
   potentials guess for electronic structure calculations, see
@@ -49,4 +52,11 @@
   DOI: 10.1002/qua.25945
 */
 double sap_effective_charge(int Z, double r);
+
+/* Raw access to the table, for evaluators that interpolate it themselves */
+double sap_cutoff_radius();
+size_t sap_radial_points();
+int sap_num_elements();
+const double* sap_radial_grid();
+const double* sap_tabulated_charges(int Z);
 #endif
@@ -0,0 +1,99 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2025 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+
+#include "sap_table.h"
+#include "sap.h"
+
+#include "psi4/libpsi4util/exception.h"
+
+namespace psi {
+
+SAPTable::SAPTable(const std::vector<int>& Z) {
+    r_ = sap_radial_grid();
+    nrad_ = sap_radial_points();
+
+    // => Buckets uniform in sqrt(r), the radial grid is densest near the nucleus <= //
+    size_t nbucket = 4096;
+    bucket_scale_ = nbucket / std::sqrt(r_[nrad_ - 1]);
+    bucket_start_.resize(nbucket);
+    int i = 0;
+    for (size_t bucket = 0; bucket < nbucket; bucket++) {
+        double rb = (bucket / bucket_scale_) * (bucket / bucket_scale_);
+        while (i + 1 < static_cast<int>(nrad_) - 1 && r_[i + 1] <= rb) i++;
+        bucket_start_[bucket] = i;
+    }
+
+    // => Linear pieces of the elements in use <= //
+    intercepts_.resize(sap_num_elements());
+    slopes_.resize(sap_num_elements());
+    for (int ZA : Z) {
+        if (ZA < 1 || ZA >= sap_num_elements() || !intercepts_[ZA].empty()) continue;
+        const double* Zeff = sap_tabulated_charges(ZA);
+        auto& intercept = intercepts_[ZA];
+        auto& slope = slopes_[ZA];
+        intercept.resize(nrad_);
+        slope.resize(nrad_);
+        for (size_t k = 0; k + 1 < nrad_; k++) {
+            slope[k] = (Zeff[k + 1] - Zeff[k]) / (r_[k + 1] - r_[k]);
+            intercept[k] = Zeff[k] - slope[k] * r_[k];
+        }
+        slope[nrad_ - 1] = 0.0;
+        intercept[nrad_ - 1] = Zeff[nrad_ - 1];
+    }
+}
+
+double SAPTable::cutoff_radius() const { return sap_cutoff_radius(); }
+
+void SAPTable::add_potential(int Z, double Ax, double Ay, double Az, size_t n, const double* x, const double* y,
+                             const double* z, double* V, double* r, int* index) const {
+    if (Z < 1 || Z >= static_cast<int>(intercepts_.size())) return;
+    if (intercepts_[Z].empty()) throw PSIEXCEPTION("SAPTable: element was not tabulated.");
+    const double* intercept = intercepts_[Z].data();
+    const double* slope = slopes_[Z].data();
+
+#pragma omp simd
+    for (size_t P = 0; P < n; P++) {
+        double dx = x[P] - Ax;
+        double dy = y[P] - Ay;
+        double dz = z[P] - Az;
+        r[P] = std::sqrt(dx * dx + dy * dy + dz * dz);
+    }
+
+    for (size_t P = 0; P < n; P++) {
+        index[P] = interval(r[P]);
+    }
+
+#pragma omp simd
+    for (size_t P = 0; P < n; P++) {
+        int k = index[P];
+        V[P] -= (intercept[k] + slope[k] * r[P]) / r[P];
+    }
+}
+
+}  // namespace psi
@@ -0,0 +1,93 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2025 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+
+#ifndef libfock_sap_table_h
+#define libfock_sap_table_h
+
+#include "psi4/pragma.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace psi {
+
+/**
+ * Class SAPTable
+ *
+ * Evaluates the superposition of atomic potentials on blocks of points from
+ * the tabulated effective charges of sap.cc. The linear interpolant of each
+ * element is stored as one intercept and slope per radial interval, and the
+ * interval holding a radius is found from buckets that are uniform in
+ * sqrt(r), so a point costs a short scan instead of a binary search. The
+ * table stays piecewise linear: the radial grid is dense and sap.cc warns
+ * that higher-order interpolation of it is unstable.
+ */
+class PSI_API SAPTable {
+   protected:
+    /// Radial grid of the table [bohr]
+    const double* r_;
+    /// Number of radial points
+    size_t nrad_;
+    /// Per element, Zeff(r) = intercept + slope * r on interval i, plus a constant piece past the grid
+    std::vector<std::vector<double>> intercepts_;
+    std::vector<std::vector<double>> slopes_;
+    /// First interval that each sqrt(r) bucket overlaps
+    std::vector<int> bucket_start_;
+    /// Number of buckets per sqrt(bohr)
+    double bucket_scale_;
+
+    /// Index of the interval holding r, nrad_ - 1 past the end of the grid
+    int interval(double r) const {
+        if (r >= r_[nrad_ - 1]) return nrad_ - 1;
+        size_t bucket = std::min(bucket_start_.size() - 1, static_cast<size_t>(std::sqrt(r) * bucket_scale_));
+        int i = bucket_start_[bucket];
+        while (r_[i + 1] <= r) i++;
+        return i;
+    }
+
+   public:
+    /// Tabulates the elements with nuclear charges Z
+    SAPTable(const std::vector<int>& Z);
+
+    /// Beyond this distance [bohr] the effective charges have decayed to zero
+    double cutoff_radius() const;
+
+    /**
+     * Adds the potential -Zeff(r) / r of a nucleus of charge Z at (Ax, Ay, Az) to V at the n points
+     * (x, y, z). r and index are scratch of at least n entries.
+     */
+    void add_potential(int Z, double Ax, double Ay, double Az, size_t n, const double* x, const double* y,
+                       const double* z, double* V, double* r, int* index) const;
+};
+
+}  // namespace psi
+
+#endif
@@ -0,0 +1,192 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2025 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+
+#include "task_scheduler.h"
+
+#include "psi4/libmints/gshell.h"
+#include "psi4/libpsi4util/PsiOutStream.h"
+#include "psi4/psi4-dec.h"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <numeric>
+#include <queue>
+#include <utility>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace psi {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double seconds_since(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// One thread's share of the tasks, most expensive first. The owner
+// takes from the front, thieves take the cheap end from the back.
+struct TaskQueue {
+    std::vector<size_t> tasks;
+    size_t head = 0;
+    size_t tail = 0;
+    std::mutex lock;
+
+    size_t remaining() {
+        std::lock_guard<std::mutex> guard(lock);
+        return tail - head;
+    }
+    bool pop_front(size_t& task) {
+        std::lock_guard<std::mutex> guard(lock);
+        if (head == tail) return false;
+        task = tasks[head++];
+        return true;
+    }
+    bool pop_back(size_t& task) {
+        std::lock_guard<std::mutex> guard(lock);
+        if (head == tail) return false;
+        task = tasks[--tail];
+        return true;
+    }
+};
+
+}  // namespace
+
+TaskScheduler::TaskScheduler(const std::string& name, int nthread) : name_(name), nthread_(std::max(nthread, 1)) {
+    reset_timings();
+}
+
+void TaskScheduler::reset_timings() {
+    busy_.assign(nthread_, 0.0);
+    idle_.assign(nthread_, 0.0);
+    ntask_.assign(nthread_, 0);
+    nstolen_.assign(nthread_, 0);
+}
+
+double TaskScheduler::shell_cost(const GaussianShell& shell) {
+    return static_cast<double>(shell.nprimitive()) * shell.ncartesian();
+}
+
+void TaskScheduler::run(size_t ntask, const std::function<double(size_t)>& cost,
+                        const std::function<void(size_t, int)>& body) {
+    if (ntask == 0) return;
+
+    // => Static assignment: longest task first to the least loaded thread <= //
+
+    std::vector<double> costs(ntask);
+    for (size_t task = 0; task < ntask; task++) costs[task] = cost(task);
+
+    std::vector<size_t> order(ntask);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&costs](size_t a, size_t b) { return costs[a] > costs[b]; });
+
+    std::vector<TaskQueue> queues(nthread_);
+    using Load = std::pair<double, int>;
+    std::priority_queue<Load, std::vector<Load>, std::greater<Load>> loads;
+    for (int thread = 0; thread < nthread_; thread++) loads.emplace(0.0, thread);
+    for (size_t task : order) {
+        Load least = loads.top();
+        loads.pop();
+        queues[least.second].tasks.push_back(task);
+        loads.emplace(least.first + costs[task], least.second);
+    }
+    for (auto& queue : queues) queue.tail = queue.tasks.size();
+
+    // => Execution, stealing once a thread's own queue is empty <= //
+
+    std::vector<double> busy(nthread_, 0.0);
+    Clock::time_point start = Clock::now();
+
+#pragma omp parallel num_threads(nthread_)
+    {
+        int thread = 0;
+#ifdef _OPENMP
+        thread = omp_get_thread_num();
+#endif
+        size_t task;
+        while (true) {
+            bool stolen = false;
+            if (!queues[thread].pop_front(task)) {
+                // the cheapest task of the thread with the most left
+                bool found = false;
+                while (!found) {
+                    int victim = -1;
+                    size_t most = 0;
+                    for (int other = 0; other < nthread_; other++) {
+                        size_t left = queues[other].remaining();
+                        if (left > most) {
+                            most = left;
+                            victim = other;
+                        }
+                    }
+                    if (victim < 0) break;
+                    found = queues[victim].pop_back(task);
+                }
+                if (!found) break;
+                stolen = true;
+            }
+
+            Clock::time_point task_start = Clock::now();
+            body(task, thread);
+            busy[thread] += seconds_since(task_start);
+            ntask_[thread]++;
+            if (stolen) nstolen_[thread]++;
+        }
+    }
+
+    double wall = seconds_since(start);
+    for (int thread = 0; thread < nthread_; thread++) {
+        busy_[thread] += busy[thread];
+        idle_[thread] += std::max(wall - busy[thread], 0.0);
+    }
+}
+
+void TaskScheduler::print_timings() const {
+    outfile->Printf("  ==> %s: Task Scheduling <==\n\n", name_.c_str());
+    outfile->Printf("    %6s %10s %10s %12s %12s\n", "Thread", "Tasks", "Stolen", "Busy [s]", "Idle [s]");
+    double busy_sum = 0.0;
+    double busy_max = 0.0;
+    for (int thread = 0; thread < nthread_; thread++) {
+        outfile->Printf("    %6d %10zu %10zu %12.3f %12.3f\n", thread, ntask_[thread], nstolen_[thread], busy_[thread],
+                        idle_[thread]);
+        busy_sum += busy_[thread];
+        busy_max = std::max(busy_max, busy_[thread]);
+    }
+    if (busy_max > 0.0) {
+        outfile->Printf("\n    Load balance (mean/max busy): %6.3f\n", busy_sum / (nthread_ * busy_max));
+    }
+    outfile->Printf("\n");
+}
+
+}  // namespace psi
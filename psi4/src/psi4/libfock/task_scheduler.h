@@ -0,0 +1,102 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2025 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+
+#ifndef libfock_task_scheduler_h
+#define libfock_task_scheduler_h
+
+#include "psi4/pragma.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace psi {
+
+class GaussianShell;
+
+/**
+ * Class TaskScheduler
+ *
+ * Runs independent tasks of very uneven cost, such as blocks of
+ * shell quartets, on the OpenMP threads. Tasks are sorted by an
+ * estimated cost and dealt out so that every thread starts with
+ * about the same total cost; a thread that runs out of work steals
+ * the cheapest remaining tasks of the most loaded thread.
+ *
+ * Busy and idle time per thread accumulate over all calls to run()
+ * until reset_timings(), and are reported by print_timings().
+ */
+class PSI_API TaskScheduler {
+   protected:
+    /// Label used in the timing report
+    std::string name_;
+    /// Number of threads to run tasks on
+    int nthread_;
+    /// Seconds spent inside tasks, per thread
+    std::vector<double> busy_;
+    /// Seconds spent in run() outside of tasks, per thread
+    std::vector<double> idle_;
+    /// Number of tasks run, per thread
+    std::vector<size_t> ntask_;
+    /// Number of tasks stolen from another thread, per thread
+    std::vector<size_t> nstolen_;
+
+   public:
+    /**
+     * @param name label for the timing report
+     * @param nthread number of threads to run tasks on
+     */
+    TaskScheduler(const std::string& name, int nthread);
+
+    /**
+     * Run body(task, thread) for every task in [0, ntask), where thread
+     * is the OpenMP thread number. Returns once all tasks are done.
+     * @param ntask number of tasks
+     * @param cost relative cost estimate of a task, need not be exact
+     * @param body the work; must be safe to run concurrently
+     */
+    void run(size_t ntask, const std::function<double(size_t)>& cost,
+             const std::function<void(size_t, int)>& body);
+
+    /// Cost of a shell in the ERI cost model: primitives times Cartesian components
+    static double shell_cost(const GaussianShell& shell);
+
+    int nthread() const { return nthread_; }
+    const std::vector<double>& busy_time() const { return busy_; }
+    const std::vector<double>& idle_time() const { return idle_; }
+
+    /// Zero the accumulated timings
+    void reset_timings();
+    /// Print per-thread busy and idle time to the output file
+    void print_timings() const;
+};
+
+}  // namespace psi
+
+#endif
@@ -27,10 +27,12 @@
  */
 
 #include "v.h"
+#include "collocation_cache.h"
 #include "cubature.h"
 #include "points.h"
 #include "dft_integrators.h"
-#include "sap.h"
+#include "sap_table.h"
+#include "v_accumulator.h"
 
 #include "psi4/libfunctional/LibXCfunctional.h"
 #include "psi4/libfunctional/functional.h"
@@ -92,6 +94,97 @@ extern bool brianBuildingNLCGrid;
 
 namespace psi {
 
+namespace {
+
+/* Thread timer keys of the block loops, interned on first use */
+struct VTimerKeys {
+    size_t properties = timer_key("Properties");
+    size_t functional = timer_key("Functional");
+    size_t kernel = timer_key("Kernel");
+    size_t vv10_fock = timer_key("VV10 Fock");
+    size_t v_xc = timer_key("V_xc");
+    size_t v_xc_gradient = timer_key("V_xc gradient");
+    size_t derivative_properties = timer_key("Derivative Properties");
+    size_t v_xcd = timer_key("V_XCd");
+};
+
+const VTimerKeys& v_timers() {
+    static const VTimerKeys keys;
+    return keys;
+}
+
+/* Turns function screening on in the point workers for one V build, and off again however the build ends */
+class ScopedFunctionScreening {
+   public:
+    ScopedFunctionScreening(const std::vector<std::shared_ptr<PointFunctions>>& workers, double tolerance)
+        : workers_(workers) {
+        for (const auto& worker : workers_) worker->set_screening_tolerance(tolerance);
+    }
+    ~ScopedFunctionScreening() {
+        for (const auto& worker : workers_) worker->set_screening_tolerance(0.0);
+    }
+    ScopedFunctionScreening(const ScopedFunctionScreening&) = delete;
+    ScopedFunctionScreening& operator=(const ScopedFunctionScreening&) = delete;
+
+   private:
+    const std::vector<std::shared_ptr<PointFunctions>>& workers_;
+};
+
+/*
+ * Bound B on the potential kernel integrated over a block, such that |V_mn| <= max|phi_m| max|phi_n| B with
+ * derivatives included in max|phi|.  Per point and spin, the LSDA term contributes |v_rho|, the symmetrized GGA
+ * term 2 |2 v_gamma_ss grad rho_s + v_gamma_ab grad rho_t|_1 and the meta term 3 |v_tau|.
+ */
+double potential_bound(std::shared_ptr<BlockOPoints> block, std::shared_ptr<SuperFunctional> fworker,
+                       std::shared_ptr<PointFunctions> pworker, int ansatz, bool unpolarized) {
+    int npoints = block->npoints();
+    double* w = block->w();
+    double bound = 0.0;
+    if (unpolarized) {
+        double* v_rho_a = fworker->xc_value(XCValue::V_RHO_A);
+        for (int P = 0; P < npoints; P++) {
+            double v = std::fabs(v_rho_a[P]);
+            if (ansatz >= 1) {
+                double grad = std::fabs(pworker->xc_point_value(XCValue::RHO_AX)[P]) +
+                              std::fabs(pworker->xc_point_value(XCValue::RHO_AY)[P]) +
+                              std::fabs(pworker->xc_point_value(XCValue::RHO_AZ)[P]);
+                v += 4.0 * std::fabs(fworker->xc_value(XCValue::V_GAMMA_AA)[P]) * grad;
+            }
+            if (ansatz >= 2) v += 3.0 * std::fabs(fworker->xc_value(XCValue::V_TAU_A)[P]);
+            bound += std::fabs(w[P]) * v;
+        }
+        return bound;
+    }
+
+    double* v_rho_a = fworker->xc_value(XCValue::V_RHO_A);
+    double* v_rho_b = fworker->xc_value(XCValue::V_RHO_B);
+    for (int P = 0; P < npoints; P++) {
+        double va = std::fabs(v_rho_a[P]);
+        double vb = std::fabs(v_rho_b[P]);
+        if (ansatz >= 1) {
+            double grad_a = std::fabs(pworker->xc_point_value(XCValue::RHO_AX)[P]) +
+                            std::fabs(pworker->xc_point_value(XCValue::RHO_AY)[P]) +
+                            std::fabs(pworker->xc_point_value(XCValue::RHO_AZ)[P]);
+            double grad_b = std::fabs(pworker->xc_point_value(XCValue::RHO_BX)[P]) +
+                            std::fabs(pworker->xc_point_value(XCValue::RHO_BY)[P]) +
+                            std::fabs(pworker->xc_point_value(XCValue::RHO_BZ)[P]);
+            double v_gamma_aa = std::fabs(fworker->xc_value(XCValue::V_GAMMA_AA)[P]);
+            double v_gamma_ab = std::fabs(fworker->xc_value(XCValue::V_GAMMA_AB)[P]);
+            double v_gamma_bb = std::fabs(fworker->xc_value(XCValue::V_GAMMA_BB)[P]);
+            va += 2.0 * (2.0 * v_gamma_aa * grad_a + v_gamma_ab * grad_b);
+            vb += 2.0 * (2.0 * v_gamma_bb * grad_b + v_gamma_ab * grad_a);
+        }
+        if (ansatz >= 2) {
+            va += 3.0 * std::fabs(fworker->xc_value(XCValue::V_TAU_A)[P]);
+            vb += 3.0 * std::fabs(fworker->xc_value(XCValue::V_TAU_B)[P]);
+        }
+        bound += std::fabs(w[P]) * std::max(va, vb);
+    }
+    return bound;
+}
+
+}  // namespace
+
 VBase::VBase(std::shared_ptr<SuperFunctional> functional, std::shared_ptr<BasisSet> primary, Options& options)
     : options_(options), primary_(primary), functional_(functional) {
     common_init();
@@ -109,13 +202,44 @@ void VBase::common_init() {
         v2_rho_cutoff_ = functional_->density_tolerance();
     }
     vv10_rho_cutoff_ = options_.get_double("DFT_VV10_RHO_CUTOFF");
+    vv10_screening_ = options_.get_double("DFT_VV10_SCREENING");
+    int v_buffer_mib = options_.get_int("DFT_V_BUFFER_MEMORY");
+    v_buffer_memory_ = (v_buffer_mib < 0) ? Process::environment.get_memory() / 10 / sizeof(double)
+                                          : (size_t)v_buffer_mib * 1024 * 1024 / sizeof(double);
+    vx_batch_memory_ = (size_t)options_.get_int("DFT_VX_BATCH_MEMORY") * 1024 * 1024 / sizeof(double);
+    function_screening_ = options_.get_double("DFT_FUNCTION_SCREENING");
     grac_initialized_ = false;
-    cache_map_deriv_ = -1;
+    collocation_cache_ = std::make_shared<CollocationCache>(options_.get_bool("DFT_COLLOCATION_FP32"),
+                                                            options_.get_double("DFT_COLLOCATION_TOLERANCE"));
     num_threads_ = 1;
 #ifdef _OPENMP
     num_threads_ = omp_get_max_threads();
 #endif
 }
+size_t VBase::vx_batch_size(size_t nrhs, size_t rhs_memory) const {
+    size_t nbatch = vx_batch_memory_ / std::max<size_t>(1, num_threads_ * rhs_memory);
+    return std::max<size_t>(1, std::min(nrhs, nbatch));
+}
+void VBase::print_function_screening(const std::vector<FunctionScreeningStats>& stats) {
+    FunctionScreeningStats total;
+    for (const auto& stat : stats) {
+        total.nblocks += stat.nblocks;
+        total.nlocal += stat.nlocal;
+        total.ndensity += stat.ndensity;
+        total.nkept += stat.nkept;
+        total.nscreened_blocks += stat.nscreened_blocks;
+        total.min_fraction = std::min(total.min_fraction, stat.min_fraction);
+    }
+    function_screening_stats_ = total;
+    if (function_screening_ <= 0.0 || print_ < 2 || !total.nblocks) return;
+
+    outfile->Printf("    DFT function screening (%.1E): %zu of %zu blocks screened, of %.1lf functions per block %.1lf "
+                    "enter the density and %.1lf the potential",
+                    function_screening_, total.nscreened_blocks, total.nblocks, (double)total.nlocal / total.nblocks,
+                    (double)total.ndensity / total.nblocks, (double)total.nkept / total.nblocks);
+    outfile->Printf(" (%.1lf%%, worst block %.1lf%%)\n", 100.0 * total.nkept / std::max<size_t>(1, total.nlocal),
+                    100.0 * total.min_fraction);
+}
 std::shared_ptr<VBase> VBase::build_V(std::shared_ptr<BasisSet> primary, std::shared_ptr<SuperFunctional> functional,
                                       Options& options, const std::string& type) {
     std::shared_ptr<VBase> v;
@@ -174,6 +298,7 @@ void VBase::set_D(std::vector<SharedMatrix> Dvec) {
     }
 }
 void VBase::initialize() {
+    collocation_cache_->clear();
     timer_on("V: Grid");
     grid_ = std::make_shared<DFTGrid>(primary_->molecule(), primary_, options_);
     timer_off("V: Grid");
@@ -733,86 +858,26 @@ void VBase::print_header() const {
 }
 std::shared_ptr<BlockOPoints> VBase::get_block(int block) { return grid_->blocks()[block]; }
 size_t VBase::nblocks() { return grid_->blocks().size(); }
-void VBase::finalize() { grid_.reset(); }
-void VBase::build_collocation_cache(size_t memory) {
-    // Figure out many blocks to skip
-
-    size_t collocation_size = grid_->collocation_size();
-    if (functional_->ansatz() == 1) {
-        collocation_size *= 4;  // For gradients
-    }
-    if (functional_->ansatz() == 2) {
-        collocation_size *= 10;  // For gradients and Hessians
-    }
-
-    // Figure out stride as closest whole number to amount we need
-    size_t stride = (size_t)(std::ceil(collocation_size / (double)memory));
-
-    // More memory than needed
-    if (stride == 0) {
-        stride = 1;
-    }
-    cache_map_.clear();
-
-    // Effectively zero blocks saved.
-    if (stride > grid_->blocks().size()) {
-        return;
-    }
-
-    cache_map_deriv_ = point_workers_[0]->deriv();
-    auto saved_size_rank = std::vector<size_t>(num_threads_, 0);
-    auto ncomputed_rank = std::vector<size_t>(num_threads_, 0);
-
-// Loop over the blocks
-#pragma omp parallel for schedule(guided) num_threads(num_threads_)
-    for (size_t Q = 0; Q < grid_->blocks().size(); Q += stride) {
-        // Get thread info
-        int rank = 0;
-#ifdef _OPENMP
-        rank = omp_get_thread_num();
-#endif
-
-        // Compute a collocation block
-        std::shared_ptr<BlockOPoints> block = grid_->blocks()[Q];
-        std::shared_ptr<PointFunctions> pworker = point_workers_[rank];
-        pworker->compute_functions(block);
-
-        // Build temps
-        size_t nrows = block->npoints();
-        size_t ncols = block->local_nbf();
-        std::map<std::string, SharedMatrix> collocation_map;
-
-        // Loop over components PHI, PHI_X, PHI_Y, ...
-        for (auto& kv : pworker->basis_values()) {
-            auto coll = std::make_shared<Matrix>(kv.second->name(), nrows, ncols);
-
-            double** sourcep = kv.second->pointer();
-            double** collp = coll->pointer();
-
-            // Matrices are packed in a upper left rectangle, cannot use pure DCOPY
-            for (size_t i = 0; i < nrows; i++) {
-                C_DCOPY(ncols, sourcep[i], 1, collp[i], 1);
-            }
-            collocation_map[kv.first] = coll;
-
-            saved_size_rank[rank] += nrows * ncols;
-        }
-        ncomputed_rank[rank]++;
-#pragma omp critical
-        cache_map_[block->index()] = collocation_map;
-    }
+void VBase::finalize() {
+    collocation_cache_->clear();
+    grid_.reset();
+}
+void VBase::build_collocation_cache(size_t memory, int deriv) {
+    if (deriv < 0) deriv = point_workers_[0]->deriv();
 
-    size_t saved_size = std::accumulate(saved_size_rank.begin(), saved_size_rank.end(), 0.0);
-    size_t ncomputed = std::accumulate(ncomputed_rank.begin(), ncomputed_rank.end(), 0.0);
+    timer_on("V: Collocation Cache");
+    collocation_cache_->build(*grid_, primary_, deriv, memory * sizeof(double), num_threads_);
+    timer_off("V: Collocation Cache");
 
-    double gib_saved = 8.0 * (double)saved_size / 1024.0 / 1024.0 / 1024.0;
-    double fraction = (double)ncomputed / grid_->blocks().size() * 100;
+    double gib_saved = (double)collocation_cache_->memory() / 1024.0 / 1024.0 / 1024.0;
+    double fraction = grid_->blocks().size() ? (double)collocation_cache_->ncached() / grid_->blocks().size() * 100 : 0.0;
     if (print_) {
-        outfile->Printf("  Cached %.1lf%% of DFT collocation blocks in %.3lf [GiB].\n\n", fraction, gib_saved);
+        outfile->Printf("  Cached %.1lf%% of DFT collocation blocks in %.3lf [GiB]%s.\n\n", fraction, gib_saved,
+                        collocation_cache_->fp32() ? " (FP32)" : "");
     }
 }
-void VBase::prepare_vv10_cache(DFTGrid& nlgrid, SharedMatrix D,
-                               std::vector<std::map<std::string, SharedVector>>& vv10_cache,
+void VBase::clear_collocation_cache() { collocation_cache_->clear(); }
+void VBase::prepare_vv10_cache(DFTGrid& nlgrid, SharedMatrix D, VV10Cache& vv10_cache,
                                std::vector<std::shared_ptr<PointFunctions>>& nl_point_workers, int ansatz) {
     // Densities should be set by the calling functional
     int rank = 0;
@@ -851,44 +916,10 @@ void VBase::prepare_vv10_cache(DFTGrid& nlgrid, SharedMatrix D,
             fworker->compute_vv10_cache(pworker->point_values(), block, vv10_rho_cutoff_, block->npoints(), false);
     }
 
-    // Stitch the cache together to make a single contiguous cache
-    size_t total_size = 0;
-    for (auto cache : vv10_tmp_cache) {
-        total_size += cache["W"]->dimpi()[0];
-    }
-
-    // printf("VV10 NL Total size %zu\n", total_size);
-
-    // Leave this as a vector of maps in case we ever revisit the on-the fly manipulation
-    vv10_cache.resize(1);
-    vv10_cache[0]["W"] = std::make_shared<Vector>("W Grid points", total_size);
-    vv10_cache[0]["X"] = std::make_shared<Vector>("X Grid points", total_size);
-    vv10_cache[0]["Y"] = std::make_shared<Vector>("Y Grid points", total_size);
-    vv10_cache[0]["Z"] = std::make_shared<Vector>("Z Grid points", total_size);
-    vv10_cache[0]["RHO"] = std::make_shared<Vector>("RHO Grid points", total_size);
-    vv10_cache[0]["W0"] = std::make_shared<Vector>("W0 Grid points", total_size);
-    vv10_cache[0]["KAPPA"] = std::make_shared<Vector>("KAPPA Grid points", total_size);
-
-    double* w_vecp = vv10_cache[0]["W"]->pointer();
-    double* x_vecp = vv10_cache[0]["X"]->pointer();
-    double* y_vecp = vv10_cache[0]["Y"]->pointer();
-    double* z_vecp = vv10_cache[0]["Z"]->pointer();
-    double* rho_vecp = vv10_cache[0]["RHO"]->pointer();
-    double* w0_vecp = vv10_cache[0]["W0"]->pointer();
-    double* kappa_vecp = vv10_cache[0]["KAPPA"]->pointer();
-
-    size_t offset = 0;
-    for (auto cache : vv10_tmp_cache) {
-        size_t csize = cache["W"]->dimpi()[0];
-        C_DCOPY(csize, cache["W"]->pointer(), 1, (w_vecp + offset), 1);
-        C_DCOPY(csize, cache["X"]->pointer(), 1, (x_vecp + offset), 1);
-        C_DCOPY(csize, cache["Y"]->pointer(), 1, (y_vecp + offset), 1);
-        C_DCOPY(csize, cache["Z"]->pointer(), 1, (z_vecp + offset), 1);
-        C_DCOPY(csize, cache["RHO"]->pointer(), 1, (rho_vecp + offset), 1);
-        C_DCOPY(csize, cache["W0"]->pointer(), 1, (w0_vecp + offset), 1);
-        C_DCOPY(csize, cache["KAPPA"]->pointer(), 1, (kappa_vecp + offset), 1);
-
-        offset += csize;
+    // Keep the grid blocks, which are spatially compact, so distant block pairs can be screened
+    vv10_cache.screening = vv10_screening_;
+    for (const auto& cache : vv10_tmp_cache) {
+        vv10_cache.add_block(cache);
     }
 }
 double VBase::vv10_nlc(SharedMatrix D, SharedMatrix ret) {
@@ -904,7 +935,7 @@ double VBase::vv10_nlc(SharedMatrix D, SharedMatrix ret) {
     opt_int_map["DFT_SPHERICAL_POINTS"] = options_.get_int("DFT_VV10_SPHERICAL_POINTS");
 
     DFTGrid nlgrid = DFTGrid(primary_->molecule(), primary_, opt_int_map, opt_map, options_);
-    std::vector<std::map<std::string, SharedVector>> vv10_cache;
+    VV10Cache vv10_cache;
     std::vector<std::shared_ptr<PointFunctions>> nl_point_workers;
     prepare_vv10_cache(nlgrid, D, vv10_cache, nl_point_workers);
 
@@ -913,7 +944,7 @@ double VBase::vv10_nlc(SharedMatrix D, SharedMatrix ret) {
     // => Setup info <=
     int rank = 0;
     const int max_functions = nlgrid.max_functions();
-    double** Vp = ret->pointer();
+    VAccumulator accumulator({ret}, num_threads_, v_buffer_memory_);
 
     // VV10 temps
     std::vector<double> vv10_exc(num_threads_);
@@ -941,37 +972,23 @@ double VBase::vv10_nlc(SharedMatrix D, SharedMatrix ret) {
         // Compute Rho, Phi, etc
         pworker->compute_points(block);
 
-        // Updates the vals map and returns the energy
-        std::map<std::string, SharedVector> vals = fworker->values();
-
-        parallel_timer_on("Kernel", rank);
+        // Updates the functional values and returns the energy
+        thread_timer_on(v_timers().kernel);
         vv10_exc[rank] += fworker->compute_vv10_kernel(pworker->point_values(), vv10_cache, block);
-        parallel_timer_off("Kernel", rank);
+        thread_timer_off(v_timers().kernel);
 
-        parallel_timer_on("VV10 Fock", rank);
+        thread_timer_on(v_timers().vv10_fock);
 
         // => LSDA and GGA contribution (symmetrized) <= //
         dft_integrators::rks_integrator(block, fworker, pworker, V_local[rank], 1);
 
         // => Unpacking <= //
-        const std::vector<int>& function_map = block->functions_local_to_global();
-        int nlocal = function_map.size();
-        double** V2p = V_local[rank]->pointer();
-
-        for (int ml = 0; ml < nlocal; ml++) {
-            int mg = function_map[ml];
-            for (int nl = 0; nl < ml; nl++) {
-                int ng = function_map[nl];
-#pragma omp atomic update
-                Vp[mg][ng] += V2p[ml][nl];
-#pragma omp atomic update
-                Vp[ng][mg] += V2p[ml][nl];
-            }
-#pragma omp atomic update
-            Vp[mg][mg] += V2p[ml][ml];
-        }
-        parallel_timer_off("VV10 Fock", rank);
+        accumulator.add(rank, 0, pworker->active_functions(), V_local[rank]->pointer());
+        thread_timer_off(v_timers().vv10_fock);
     }
+    accumulator.reduce();
+    vv10_pairs_ = vv10_cache.size() * vv10_cache.size();
+    vv10_skipped_pairs_ = vv10_cache.skipped_pairs;
 
     double vv10_e = std::accumulate(vv10_exc.begin(), vv10_exc.end(), 0.0);
     timer_off("V: VV10");
@@ -994,7 +1011,7 @@ SharedMatrix VBase::vv10_nlc_gradient(SharedMatrix D) {
     opt_int_map["DFT_SPHERICAL_POINTS"] = options_.get_int("DFT_VV10_SPHERICAL_POINTS");
 
     DFTGrid nlgrid = DFTGrid(primary_->molecule(), primary_, opt_int_map, opt_map, options_);
-    std::vector<std::map<std::string, SharedVector>> vv10_cache;
+    VV10Cache vv10_cache;
     std::vector<std::shared_ptr<PointFunctions>> nl_point_workers;
     prepare_vv10_cache(nlgrid, D, vv10_cache, nl_point_workers, 2);
 
@@ -1036,14 +1053,12 @@ SharedMatrix VBase::vv10_nlc_gradient(SharedMatrix D) {
         // Compute Rho, Phi, etc
         pworker->compute_points(block);
 
-        // Updates the vals map and returns the energy
-        std::map<std::string, SharedVector> vals = fworker->values();
-
-        parallel_timer_on("Kernel", rank);
+        // Updates the functional values and returns the energy
+        thread_timer_on(v_timers().kernel);
         vv10_exc[rank] += fworker->compute_vv10_kernel(pworker->point_values(), vv10_cache, block, npoints, true);
-        parallel_timer_off("Kernel", rank);
+        thread_timer_off(v_timers().kernel);
 
-        parallel_timer_on("V_xc gradient", rank);
+        thread_timer_on(v_timers().v_xc_gradient);
 
         // => LSDA and GGA gradient contributions <= //
         dft_integrators::rks_gradient_integrator(primary_, block, fworker, pworker, G_local[rank], U_local[rank]);
@@ -1075,7 +1090,7 @@ SharedMatrix VBase::vv10_nlc_gradient(SharedMatrix D) {
 
         // printf("--\n");
 
-        parallel_timer_off("V_xc gradient", rank);
+        thread_timer_off(v_timers().v_xc_gradient);
     }
 
     // Sum up the matrix
@@ -1103,10 +1118,17 @@ void SAP::initialize() {
         auto point_tmp = std::make_shared<SAPFunctions>(primary_, max_points, max_functions);
         // This is like LDA
         point_tmp->set_ansatz(0);
-        point_tmp->set_cache_map(&cache_map_);
+        point_tmp->set_collocation_cache(collocation_cache_.get());
         point_workers_.push_back(point_tmp);
     }
 
+    // Effective charge tables of the elements present
+    std::vector<int> Z(primary_->molecule()->natom());
+    for (size_t A = 0; A < Z.size(); A++) {
+        Z[A] = primary_->molecule()->Z(A);
+    }
+    sap_table_ = std::make_shared<SAPTable>(Z);
+
     // Initialize symmetry
     auto integral = std::make_shared<IntegralFactory>(primary_);
     PetiteList pet(primary_, integral);
@@ -1114,7 +1136,10 @@ void SAP::initialize() {
     USO2AO_ = AO2USO_->transpose();
     nbf_ = AO2USO_->rowspi()[0];
 }
-void SAP::finalize() { VBase::finalize(); }
+void SAP::finalize() {
+    sap_table_.reset();
+    VBase::finalize();
+}
 void SAP::print_header() const {
     outfile->Printf("  ==> SAP guess <==\n\n");
     grid_->print("outfile", print_);
@@ -1141,10 +1166,11 @@ void SAP::compute_V(std::vector<SharedMatrix> ret) {
     }
 
     auto V_AO = std::make_shared<Matrix>("V AO Temp", nbf_, nbf_);
-    double** Vp = V_AO->pointer();
+    VAccumulator accumulator({V_AO}, num_threads_, v_buffer_memory_);
 
     // Nuclear coordinates
-    std::vector<double> nucx, nucy, nucz, nucZ;
+    std::vector<double> nucx, nucy, nucz;
+    std::vector<int> nucZ;
     nucx.resize(primary_->molecule()->natom());
     nucy.resize(primary_->molecule()->natom());
     nucz.resize(primary_->molecule()->natom());
@@ -1155,6 +1181,11 @@ void SAP::compute_V(std::vector<SharedMatrix> ret) {
         nucz[iatom] = primary_->molecule()->z(iatom);
         nucZ[iatom] = primary_->molecule()->Z(iatom);
     }
+    double cutoff = sap_table_->cutoff_radius();
+
+    // Per thread distances and table intervals
+    std::vector<std::vector<double>> r_temp(num_threads_, std::vector<double>(max_points));
+    std::vector<std::vector<int>> index_temp(num_threads_, std::vector<int>(max_points));
 
 // Traverse the blocks of points
 #pragma omp parallel for private(rank) schedule(guided) num_threads(num_threads_)
@@ -1170,67 +1201,40 @@ void SAP::compute_V(std::vector<SharedMatrix> ret) {
         std::shared_ptr<PointFunctions> pworker = point_workers_[rank];
 
         // Compute Rho, Phi, etc
-        parallel_timer_on("Properties", rank);
+        thread_timer_on(v_timers().properties);
         pworker->compute_points(block, false);
-        parallel_timer_off("Properties", rank);
+        thread_timer_off(v_timers().properties);
 
-        // Compute the SAP potential
-        parallel_timer_on("Functional", rank);
+        // Compute the SAP potential a nucleus at a time over the whole block, skipping
+        // nuclei whose effective charge has decayed at every point of the block
+        thread_timer_on(v_timers().functional);
         SharedVector sap_potential = std::make_shared<Vector>("sappot", block->npoints());
-        for (int ip = 0; ip < block->npoints(); ip++) {
-            // Coordinates of the point
-            double xi = block->x()[ip];
-            double yi = block->y()[ip];
-            double zi = block->z()[ip];
-            // and its potential
-            double V = 0.0;
-
-            // Loop over nuclei
-            for (size_t iatom = 0; iatom < nucx.size(); iatom++) {
-                // Distance to nucleus is
-                double dx = xi - nucx[iatom];
-                double dy = yi - nucy[iatom];
-                double dz = zi - nucz[iatom];
-                double r = sqrt(dx * dx + dy * dy + dz * dz);
-                // and the SAP potential at this point is
-                V -= ::sap_effective_charge(nucZ[iatom], r) / r;
-            }
-
-            // Store
-            (*sap_potential)[ip] = V;
+        Vector3 center = block->center();
+        for (size_t iatom = 0; iatom < nucx.size(); iatom++) {
+            Vector3 A(nucx[iatom], nucy[iatom], nucz[iatom]);
+            if (center.distance(A) - block->radius() >= cutoff) continue;
+            sap_table_->add_potential(nucZ[iatom], nucx[iatom], nucy[iatom], nucz[iatom], block->npoints(),
+                                      block->x(), block->y(), block->z(), sap_potential->pointer(),
+                                      r_temp[rank].data(), index_temp[rank].data());
         }
 
-        parallel_timer_off("Functional", rank);
+        thread_timer_off(v_timers().functional);
 
         if (debug_ > 4) {
             block->print("outfile", debug_);
             pworker->print("outfile", debug_);
         }
 
-        parallel_timer_on("V_xc", rank);
+        thread_timer_on(v_timers().v_xc);
 
         // => LSDA contribution (symmetrized) <= //
         dft_integrators::sap_integrator(block, sap_potential, pworker, V_local[rank]);
 
         // => Unpacking <= //
-        double** V2p = V_local[rank]->pointer();
-        const std::vector<int>& function_map = block->functions_local_to_global();
-        int nlocal = function_map.size();
-
-        for (int ml = 0; ml < nlocal; ml++) {
-            int mg = function_map[ml];
-            for (int nl = 0; nl < ml; nl++) {
-                int ng = function_map[nl];
-#pragma omp atomic update
-                Vp[mg][ng] += V2p[ml][nl];
-#pragma omp atomic update
-                Vp[ng][mg] += V2p[ml][nl];
-            }
-#pragma omp atomic update
-            Vp[mg][mg] += V2p[ml][ml];
-        }
-        parallel_timer_off("V_xc", rank);
+        accumulator.add(rank, 0, block->functions_local_to_global(), V_local[rank]->pointer());
+        thread_timer_off(v_timers().v_xc);
     }
+    accumulator.reduce();
 
     // Set the result
     if (AO2USO_) {
@@ -1252,7 +1256,7 @@ void RV::initialize() {
         // Need a points worker per thread
         auto point_tmp = std::make_shared<RKSFunctions>(primary_, max_points, max_functions);
         point_tmp->set_ansatz(functional_->ansatz());
-        point_tmp->set_cache_map(&cache_map_);
+        point_tmp->set_collocation_cache(collocation_cache_.get());
         point_workers_.push_back(point_tmp);
     }
 }
@@ -1306,10 +1310,12 @@ void RV::compute_V(std::vector<SharedMatrix> ret) {
     int max_functions = grid_->max_functions();
     int max_points = grid_->max_points();
 
-    // Setup the pointers
+    // Setup the pointers, screening functions per block only for this integration
     for (size_t i = 0; i < num_threads_; i++) {
         point_workers_[i]->set_pointers(D_AO_[0]);
     }
+    std::vector<FunctionScreeningStats> screening_stats(num_threads_);
+    ScopedFunctionScreening screening(point_workers_, function_screening_);
 
     // Per thread temporaries
     std::vector<SharedMatrix> V_local;
@@ -1318,7 +1324,7 @@ void RV::compute_V(std::vector<SharedMatrix> ret) {
     }
 
     auto V_AO = std::make_shared<Matrix>("V AO Temp", nbf_, nbf_);
-    auto Vp = V_AO->pointer();
+    VAccumulator accumulator({V_AO}, num_threads_, v_buffer_memory_);
 
     std::vector<double> functionalq(num_threads_);
     std::vector<double> rhoaq(num_threads_);
@@ -1343,21 +1349,22 @@ void RV::compute_V(std::vector<SharedMatrix> ret) {
         auto pworker = point_workers_[rank];
 
         // ==> Compute rho, gamma, etc. for block <==
-        parallel_timer_on("Properties", rank);
+        thread_timer_on(v_timers().properties);
         pworker->compute_points(block, false);
-        parallel_timer_off("Properties", rank);
+        thread_timer_off(v_timers().properties);
 
         // ==> Compute functional values for block <==
-        parallel_timer_on("Functional", rank);
-        fworker->compute_functional(pworker->point_values());
-        parallel_timer_off("Functional", rank);
+        thread_timer_on(v_timers().functional);
+        fworker->compute_functional(pworker->xc_point_values(), block->npoints());
+        thread_timer_off(v_timers().functional);
+        pworker->screen_potential(potential_bound(block, fworker, pworker, ansatz, true));
 
         if (debug_ > 4) {
             block->print("outfile", debug_);
             pworker->print("outfile", debug_);
         }
 
-        parallel_timer_on("V_xc", rank);
+        thread_timer_on(v_timers().v_xc);
 
         // ==> Compute quadrature values <== //
         auto qvals = dft_integrators::rks_quadrature_integrate(block, fworker, pworker);
@@ -1371,24 +1378,13 @@ void RV::compute_V(std::vector<SharedMatrix> ret) {
         dft_integrators::rks_integrator(block, fworker, pworker, V_local[rank]);
 
         // ==> Unpacking <== //
-        auto V2p = V_local[rank]->pointer();
-        const auto& function_map = block->functions_local_to_global();
-        int nlocal = function_map.size();
-
-        for (int ml = 0; ml < nlocal; ml++) {
-            int mg = function_map[ml];
-            for (int nl = 0; nl < ml; nl++) {
-                int ng = function_map[nl];
-#pragma omp atomic update
-                Vp[mg][ng] += V2p[ml][nl];
-#pragma omp atomic update
-                Vp[ng][mg] += V2p[ml][nl];
-            }
-#pragma omp atomic update
-            Vp[mg][mg] += V2p[ml][ml];
-        }
-        parallel_timer_off("V_xc", rank);
+        accumulator.add(rank, 0, pworker->active_functions(), V_local[rank]->pointer());
+        screening_stats[rank].add(block->local_nbf(), pworker->density_functions(),
+                                  pworker->active_functions().size());
+        thread_timer_off(v_timers().v_xc);
     }
+    accumulator.reduce();
+    print_function_screening(screening_stats);
 
     // Do we need VV10?
     double vv10_e = 0.0;
@@ -1507,15 +1503,15 @@ std::vector<SharedMatrix> RV::compute_fock_derivatives() {
         int nlocal = function_map.size();
 
         // Compute Rho, Phi, etc
-        parallel_timer_on("Properties", rank);
-        pworker->compute_points(block);
-        parallel_timer_off("Properties", rank);
+        thread_timer_on(v_timers().properties);
+        pworker->compute_points(block, false);
+        thread_timer_off(v_timers().properties);
 
         // Compute functional values
 
-        parallel_timer_on("Functional", rank);
-        auto& vals = fworker->compute_functional(pworker->point_values(), npoints);
-        parallel_timer_off("Functional", rank);
+        thread_timer_on(v_timers().functional);
+        const auto& vals = fworker->compute_functional(pworker->xc_point_values(), npoints);
+        thread_timer_off(v_timers().functional);
 
         // => Grab quantities <= //
         // LDA
@@ -1523,9 +1519,9 @@ std::vector<SharedMatrix> RV::compute_fock_derivatives() {
         auto phi_x = pworker->basis_value("PHI_X")->pointer();
         auto phi_y = pworker->basis_value("PHI_Y")->pointer();
         auto phi_z = pworker->basis_value("PHI_Z")->pointer();
-        auto rho_a = pworker->point_value("RHO_A")->pointer();
-        auto v_rho_a = vals["V_RHO_A"]->pointer();
-        auto v_rho_aa = vals["V_RHO_A_RHO_A"]->pointer();
+        auto rho_a = pworker->xc_point_value(XCValue::RHO_A);
+        auto v_rho_a = vals[XCValue::V_RHO_A];
+        auto v_rho_aa = vals[XCValue::V_RHO_A_RHO_A];
         for (int P = 0; P < npoints; P++) {
             if (std::fabs(rho_a[P]) < v2_rho_cutoff_) {
                 v_rho_a[P] = 0.0;
@@ -1721,20 +1717,29 @@ void RV::compute_Vx_full(std::vector<SharedMatrix> Dx, std::vector<SharedMatrix>
         }
     }
 
+    // How many densities are contracted together per block. Each needs a slice of the stacked
+    // densities, T, and Vx, plus its perturbed point values.
+    size_t nrhs_values = (ansatz >= 1 ? 5 : 1);
+    size_t nbatch = vx_batch_size(Dx_vec.size(), 2 * max_functions * max_functions + max_points * max_functions +
+                                                     nrhs_values * max_points);
+    size_t ld_batch = nbatch * max_functions;
+
     // Per [R]ank quantities
-    std::vector<SharedMatrix> R_Vx_local, R_Dx_local;
-    std::vector<std::shared_ptr<Vector>> R_rho_k, R_rho_k_x, R_rho_k_y, R_rho_k_z, R_gamma_k;
+    std::vector<SharedMatrix> R_Vx_local, R_Dx_local, R_T_local;
+    std::vector<SharedMatrix> R_rho_k, R_rho_k_x, R_rho_k_y, R_rho_k_z, R_gamma_k;
+    std::vector<std::vector<double*>> R_Vx_rows(num_threads_, std::vector<double*>(max_functions));
     for (size_t i = 0; i < num_threads_; i++) {
-        R_Vx_local.push_back(std::make_shared<Matrix>("Vx Temp", max_functions, max_functions));
-        R_Dx_local.push_back(std::make_shared<Matrix>("Dk Temp", max_functions, max_functions));
+        R_Vx_local.push_back(std::make_shared<Matrix>("Vx Temp", max_functions, ld_batch));
+        R_Dx_local.push_back(std::make_shared<Matrix>("Dk Temp", max_functions, ld_batch));
+        R_T_local.push_back(std::make_shared<Matrix>("T Temp", max_points, ld_batch));
 
-        R_rho_k.push_back(std::make_shared<Vector>("Rho K Temp", max_points));
+        R_rho_k.push_back(std::make_shared<Matrix>("Rho K Temp", nbatch, max_points));
 
         if (ansatz >= 1) {
-            R_rho_k_x.push_back(std::make_shared<Vector>("RHO K X Temp", max_points));
-            R_rho_k_y.push_back(std::make_shared<Vector>("RHO K Y Temp", max_points));
-            R_rho_k_z.push_back(std::make_shared<Vector>("Rho K Z Temp", max_points));
-            R_gamma_k.push_back(std::make_shared<Vector>("Gamma K Temp", max_points));
+            R_rho_k_x.push_back(std::make_shared<Matrix>("RHO K X Temp", nbatch, max_points));
+            R_rho_k_y.push_back(std::make_shared<Matrix>("RHO K Y Temp", nbatch, max_points));
+            R_rho_k_z.push_back(std::make_shared<Matrix>("Rho K Z Temp", nbatch, max_points));
+            R_gamma_k.push_back(std::make_shared<Matrix>("Gamma K Temp", nbatch, max_points));
         }
 
         functional_workers_[i]->set_deriv(2);
@@ -1746,6 +1751,7 @@ void RV::compute_Vx_full(std::vector<SharedMatrix> Dx, std::vector<SharedMatrix>
     for (size_t i = 0; i < Dx.size(); i++) {
         Vx_AO.push_back(std::make_shared<Matrix>("Vx AO Temp", nbf_, nbf_));
     }
+    VAccumulator accumulator(Vx_AO, num_threads_, v_buffer_memory_);
 
     // => Compute Vx <=
     // Remember that this function computes the α block of the output, divided by 2.
@@ -1761,9 +1767,10 @@ void RV::compute_Vx_full(std::vector<SharedMatrix> Dx, std::vector<SharedMatrix>
         auto pworker = point_workers_[rank];
         auto Vx_localp = R_Vx_local[rank]->pointer();
         auto Dx_localp = R_Dx_local[rank]->pointer();
+        auto& Vx_rows = R_Vx_rows[rank];
 
         // => Compute blocks <= //
-        auto Tp = pworker->scratch()[0]->pointer();
+        auto Tp = R_T_local[rank]->pointer();
 
         auto block = grid_->blocks()[Q];
         auto npoints = block->npoints();
@@ -1772,28 +1779,28 @@ void RV::compute_Vx_full(std::vector<SharedMatrix> Dx, std::vector<SharedMatrix>
         auto nlocal = function_map.size();
 
         // ==> Compute rho, gamma, etc. for block <==
-        parallel_timer_on("Properties", rank);
-        pworker->compute_points(block);
-        parallel_timer_off("Properties", rank);
+        thread_timer_on(v_timers().properties);
+        pworker->compute_points(block, false);
+        thread_timer_off(v_timers().properties);
 
         // ==> Compute functional values for block <==
-        parallel_timer_on("Functional", rank);
+        thread_timer_on(v_timers().functional);
         auto& vals = fworker->compute_functional(pworker->point_values(), npoints, singlet);
-        parallel_timer_off("Functional", rank);
+        thread_timer_off(v_timers().functional);
 
         // ==> Define pointers to intermediates <==
         // LSDA
         auto phi = pworker->basis_value("PHI")->pointer();
-        auto rho_a = pworker->point_value("RHO_A")->pointer();
+        auto rho_a = pworker->xc_point_value(XCValue::RHO_A);
         auto v2_rho2 = vals["V_RHO_A_RHO_A"]->pointer();
-        auto rho_k = R_rho_k[rank]->pointer();
+        auto rho_kp = R_rho_k[rank]->pointer();
         auto coll_funcs = pworker->basis_value("PHI")->ncol();
 
         // GGA
-        double* rho_k_x;
-        double* rho_k_y;
-        double* rho_k_z;
-        double* gamma_k;
+        double** rho_k_xp;
+        double** rho_k_yp;
+        double** rho_k_zp;
+        double** gamma_kp;
         double** phi_x;
         double** phi_y;
         double** phi_z;
@@ -1801,152 +1808,172 @@ void RV::compute_Vx_full(std::vector<SharedMatrix> Dx, std::vector<SharedMatrix>
         double* rho_y;
         double* rho_z;
         if (ansatz >= 1) {
-            rho_k_x = R_rho_k_x[rank]->pointer();
-            rho_k_y = R_rho_k_y[rank]->pointer();
-            rho_k_z = R_rho_k_z[rank]->pointer();
-            gamma_k = R_gamma_k[rank]->pointer();
+            rho_k_xp = R_rho_k_x[rank]->pointer();
+            rho_k_yp = R_rho_k_y[rank]->pointer();
+            rho_k_zp = R_rho_k_z[rank]->pointer();
+            gamma_kp = R_gamma_k[rank]->pointer();
             phi_x = pworker->basis_value("PHI_X")->pointer();
             phi_y = pworker->basis_value("PHI_Y")->pointer();
             phi_z = pworker->basis_value("PHI_Z")->pointer();
-            rho_x = pworker->point_value("RHO_AX")->pointer();
-            rho_y = pworker->point_value("RHO_AY")->pointer();
-            rho_z = pworker->point_value("RHO_AZ")->pointer();
+            rho_x = pworker->xc_point_value(XCValue::RHO_AX);
+            rho_y = pworker->xc_point_value(XCValue::RHO_AY);
+            rho_z = pworker->xc_point_value(XCValue::RHO_AZ);
         }
 
         // Meta
         // Forget that!
 
-        // ==> Compute Vx contribution for each x <==
-        for (size_t dindex = 0; dindex < Dx_vec.size(); dindex++) {
-            auto Dxp = Dx_vec[dindex]->pointer();
+        // ==> Compute Vx contributions, nbatch densities at a time <==
+        // Density k of a batch occupies columns [k * nlocal, (k + 1) * nlocal) of Dx_local, T, and Vx_local,
+        // so the batch shares one GEMM into and one GEMM out of the grid.
+        for (size_t dstart = 0; dstart < Dx_vec.size(); dstart += nbatch) {
+            size_t nb = std::min(nbatch, Dx_vec.size() - dstart);
+            size_t ncol = nb * nlocal;
 
             // ===> Build Rotated Densities <=== //
-            for (int ml = 0; ml < nlocal; ml++) {
-                int mg = function_map[ml];
-                for (int nl = 0; nl < nlocal; nl++) {
-                    int ng = function_map[nl];
-                    Dx_localp[ml][nl] = Dxp[mg][ng];
+            // Dstack[k] := add_trans(Dk, (1, 0))
+            for (size_t k = 0; k < nb; k++) {
+                auto Dxp = Dx_vec[dstart + k]->pointer();
+                for (int ml = 0; ml < nlocal; ml++) {
+                    int mg = function_map[ml];
+                    auto Dkp = Dx_localp[ml] + k * nlocal;
+                    for (int nl = 0; nl < nlocal; nl++) {
+                        int ng = function_map[nl];
+                        Dkp[nl] = Dxp[mg][ng] + Dxp[ng][mg];
+                    }
                 }
             }
 
             // ===> Compute quantities using effective densities <===
             // N.B. We spin-sum over true density spin-indices, never effective density spin-indices. 
-            // T := einsum("pm, mn -> pn", φ, add_trans(Dk, (1, 0, 2)))
-            parallel_timer_on("Derivative Properties", rank);
-            C_DGEMM('N', 'N', npoints, nlocal, nlocal, 1.0, phi[0], coll_funcs, Dx_localp[0], max_functions, 0.0, Tp[0],
-                    max_functions);
-            C_DGEMM('N', 'T', npoints, nlocal, nlocal, 1.0, phi[0], coll_funcs, Dx_localp[0], max_functions, 1.0, Tp[0],
-                    max_functions);
+            // T[k] := einsum("pm, mn -> pn", φ, Dstack[k]) for the whole batch at once
+            thread_timer_on(v_timers().derivative_properties);
+            C_DGEMM('N', 'N', npoints, ncol, nlocal, 1.0, phi[0], coll_funcs, Dx_localp[0], ld_batch, 0.0, Tp[0],
+                    ld_batch);
 
-            // ρk = einsum("mn, pm, pn -> pσ", Dk, φ, φ)
-            // ρk = 1/2 * add_trans(ρκ, (1, 0, 2))
-            for (int P = 0; P < npoints; P++) {
-                rho_k[P] = 0.5 * C_DDOT(nlocal, phi[P], 1, Tp[P], 1);
-            }
+            for (size_t k = 0; k < nb; k++) {
+                size_t koff = k * nlocal;
+                auto rho_k = rho_kp[k];
 
-            // ∇ρk = einsum("mn, pm, pn -> p", add_trans(Dk, (1, 0, 2)), ∇φ, φ)
-            //  Γk = add_trans(einsum("xp, xp -> p", ∇ρk, ∇ρ), (0, 2, 1))
-            //      ...2x the size of UKS alpha-spin counterpart thanks to spin-summing of ∇ρ
-            if (ansatz >= 1) {
+                // ρk = einsum("mn, pm, pn -> pσ", Dk, φ, φ)
+                // ρk = 1/2 * add_trans(ρκ, (1, 0, 2))
                 for (int P = 0; P < npoints; P++) {
-                    rho_k_x[P] = C_DDOT(nlocal, phi_x[P], 1, Tp[P], 1);
-                    rho_k_y[P] = C_DDOT(nlocal, phi_y[P], 1, Tp[P], 1);
-                    rho_k_z[P] = C_DDOT(nlocal, phi_z[P], 1, Tp[P], 1);
-                    gamma_k[P] = rho_k_x[P] * rho_x[P];
-                    gamma_k[P] += rho_k_y[P] * rho_y[P];
-                    gamma_k[P] += rho_k_z[P] * rho_z[P];
-                    gamma_k[P] *= 2;
+                    rho_k[P] = 0.5 * C_DDOT(nlocal, phi[P], 1, Tp[P] + koff, 1);
                 }
-            }
-            parallel_timer_off("Derivative Properties", rank);
 
-            // ===> LSDA contribution <=== //
-            //                                         ∂^2
-            // T := 1/2 einsum("p, p, pm, p -> pm", w, ---- f , ρk, φ)
-            //                                         ∂ρ^2
-            parallel_timer_on("V_XCd", rank);
-            for (int P = 0; P < npoints; P++) {
-                std::fill(Tp[P], Tp[P] + nlocal, 0.0);
-                // Do a simple screen: ignore contributions where rho is too small.
-                if (rho_a[P] < v2_rho_cutoff_) continue;
-                C_DAXPY(nlocal, 0.5 * v2_rho2[P] * w[P] * rho_k[P], phi[P], 1, Tp[P], 1);
+                // ∇ρk = einsum("mn, pm, pn -> p", add_trans(Dk, (1, 0, 2)), ∇φ, φ)
+                //  Γk = add_trans(einsum("xp, xp -> p", ∇ρk, ∇ρ), (0, 2, 1))
+                //      ...2x the size of UKS alpha-spin counterpart thanks to spin-summing of ∇ρ
+                if (ansatz >= 1) {
+                    auto rho_k_x = rho_k_xp[k];
+                    auto rho_k_y = rho_k_yp[k];
+                    auto rho_k_z = rho_k_zp[k];
+                    auto gamma_k = gamma_kp[k];
+                    for (int P = 0; P < npoints; P++) {
+                        rho_k_x[P] = C_DDOT(nlocal, phi_x[P], 1, Tp[P] + koff, 1);
+                        rho_k_y[P] = C_DDOT(nlocal, phi_y[P], 1, Tp[P] + koff, 1);
+                        rho_k_z[P] = C_DDOT(nlocal, phi_z[P], 1, Tp[P] + koff, 1);
+                        gamma_k[P] = rho_k_x[P] * rho_x[P];
+                        gamma_k[P] += rho_k_y[P] * rho_y[P];
+                        gamma_k[P] += rho_k_z[P] * rho_z[P];
+                        gamma_k[P] *= 2;
+                    }
+                }
             }
+            thread_timer_off(v_timers().derivative_properties);
 
-            // ===> GGA contribution <=== //
-            if (ansatz >= 1) {
-                // ====> Define pointers for future use <====
-                auto v_gamma = vals["V_GAMMA_AA"]->pointer();
-                auto v2_gamma_gamma = vals["V_GAMMA_AA_GAMMA_AA"]->pointer();
-                auto v2_rho_gamma = vals["V_RHO_A_GAMMA_AA"]->pointer();
-                double tmp_val = 0.0, v2_val = 0.0;
+            thread_timer_on(v_timers().v_xcd);
+            for (size_t k = 0; k < nb; k++) {
+                size_t koff = k * nlocal;
+                auto rho_k = rho_kp[k];
 
-                // There are lots of GGA terms.
+                // ===> LSDA contribution <=== //
+                //                                         ∂^2
+                // T := 1/2 einsum("p, p, pm, p -> pm", w, ---- f , ρk, φ)
+                //                                         ∂ρ^2
                 for (int P = 0; P < npoints; P++) {
+                    std::fill(Tp[P] + koff, Tp[P] + koff + nlocal, 0.0);
+                    // Do a simple screen: ignore contributions where rho is too small.
                     if (rho_a[P] < v2_rho_cutoff_) continue;
+                    C_DAXPY(nlocal, 0.5 * v2_rho2[P] * w[P] * rho_k[P], phi[P], 1, Tp[P] + koff, 1);
+                }
 
-                    // ====> Term 2b, V in DOI: 10.1063/1.466887 <====
-                    //                                         ∂^2
-                    // T += 1/2 einsum("p, p, p, pr -> pr", w, ---- f, Γk, φ)
-                    //                                         ∂ρ∂γ
-                    // V contributions
-                    C_DAXPY(nlocal, (0.5 * w[P] * v2_rho_gamma[P] * gamma_k[P]), phi[P], 1, Tp[P], 1);
-
-                    // ====> All other terms, W in above DOI  <==== //
-                    //                            ∂^2
-                    // temp = einsum("p, p -> p", ---- f, ρk)
-                    //                            ∂ρ∂γ
-                    //                             ∂^2
-                    // temp += einsum("p, p -> p", ---- f, Γk)
-                    //                             ∂γ∂γ
-                    
-                    // Define Γk terms in 3 intermediate
-                    v2_val = (v2_rho_gamma[P] * rho_k[P] + v2_gamma_gamma[P] * gamma_k[P]);
-
-                    //                                      ∂
-                    // temp2 = einsum("p, p, xp -> xpσ", w, -- f, ∇ρk)
-                    //                                      ∂Γ
-                    // temp2 += einsum("p, p, x -> xp", w, temp, ∇ρ)
-                    // T += einsum("xp, xpm -> pm", temp2, ∇φ)
-
-                    tmp_val = 2.0 * w[P] * (v_gamma[P] * rho_k_x[P] + v2_val * rho_x[P]);
-                    C_DAXPY(nlocal, tmp_val, phi_x[P], 1, Tp[P], 1);
-
-                    tmp_val = 2.0 * w[P] * (v_gamma[P] * rho_k_y[P] + v2_val * rho_y[P]);
-                    C_DAXPY(nlocal, tmp_val, phi_y[P], 1, Tp[P], 1);
-
-                    tmp_val = 2.0 * w[P] * (v_gamma[P] * rho_k_z[P] + v2_val * rho_z[P]);
-                    C_DAXPY(nlocal, tmp_val, phi_z[P], 1, Tp[P], 1);
+                // ===> GGA contribution <=== //
+                if (ansatz >= 1) {
+                    // ====> Define pointers for future use <====
+                    auto v_gamma = vals["V_GAMMA_AA"]->pointer();
+                    auto v2_gamma_gamma = vals["V_GAMMA_AA_GAMMA_AA"]->pointer();
+                    auto v2_rho_gamma = vals["V_RHO_A_GAMMA_AA"]->pointer();
+                    auto rho_k_x = rho_k_xp[k];
+                    auto rho_k_y = rho_k_yp[k];
+                    auto rho_k_z = rho_k_zp[k];
+                    auto gamma_k = gamma_kp[k];
+                    double tmp_val = 0.0, v2_val = 0.0;
+
+                    // There are lots of GGA terms.
+                    for (int P = 0; P < npoints; P++) {
+                        if (rho_a[P] < v2_rho_cutoff_) continue;
+                        auto Tkp = Tp[P] + koff;
+
+                        // ====> Term 2b, V in DOI: 10.1063/1.466887 <====
+                        //                                         ∂^2
+                        // T += 1/2 einsum("p, p, p, pr -> pr", w, ---- f, Γk, φ)
+                        //                                         ∂ρ∂γ
+                        // V contributions
+                        C_DAXPY(nlocal, (0.5 * w[P] * v2_rho_gamma[P] * gamma_k[P]), phi[P], 1, Tkp, 1);
+
+                        // ====> All other terms, W in above DOI  <==== //
+                        //                            ∂^2
+                        // temp = einsum("p, p -> p", ---- f, ρk)
+                        //                            ∂ρ∂γ
+                        //                             ∂^2
+                        // temp += einsum("p, p -> p", ---- f, Γk)
+                        //                             ∂γ∂γ
+
+                        // Define Γk terms in 3 intermediate
+                        v2_val = (v2_rho_gamma[P] * rho_k[P] + v2_gamma_gamma[P] * gamma_k[P]);
+
+                        //                                      ∂
+                        // temp2 = einsum("p, p, xp -> xpσ", w, -- f, ∇ρk)
+                        //                                      ∂Γ
+                        // temp2 += einsum("p, p, x -> xp", w, temp, ∇ρ)
+                        // T += einsum("xp, xpm -> pm", temp2, ∇φ)
+
+                        tmp_val = 2.0 * w[P] * (v_gamma[P] * rho_k_x[P] + v2_val * rho_x[P]);
+                        C_DAXPY(nlocal, tmp_val, phi_x[P], 1, Tkp, 1);
+
+                        tmp_val = 2.0 * w[P] * (v_gamma[P] * rho_k_y[P] + v2_val * rho_y[P]);
+                        C_DAXPY(nlocal, tmp_val, phi_y[P], 1, Tkp, 1);
+
+                        tmp_val = 2.0 * w[P] * (v_gamma[P] * rho_k_z[P] + v2_val * rho_z[P]);
+                        C_DAXPY(nlocal, tmp_val, phi_z[P], 1, Tkp, 1);
+                    }
                 }
             }
 
-            // ===> Contract Ta and Tb aginst φ, replacing a point index with  an AO index <===
-            C_DGEMM('T', 'N', nlocal, nlocal, npoints, 1.0, phi[0], coll_funcs, Tp[0], max_functions, 0.0, Vx_localp[0],
-                    max_functions);
+            // ===> Contract T against φ for the whole batch, replacing a point index with an AO index <===
+            C_DGEMM('T', 'N', nlocal, ncol, npoints, 1.0, phi[0], coll_funcs, Tp[0], ld_batch, 0.0, Vx_localp[0],
+                    ld_batch);
 
-            // ===> Add the adjoint to complete the LDA and GGA contributions  <===
-            for (int m = 0; m < nlocal; m++) {
-                for (int n = 0; n <= m; n++) {
-                    Vx_localp[m][n] = Vx_localp[n][m] = Vx_localp[m][n] + Vx_localp[n][m];
+            for (size_t k = 0; k < nb; k++) {
+                for (int m = 0; m < nlocal; m++) {
+                    Vx_rows[m] = Vx_localp[m] + k * nlocal;
                 }
-            }
 
-            // => Unpacking <= //
-            auto Vxp = Vx_AO[dindex]->pointer();
-            for (int ml = 0; ml < nlocal; ml++) {
-                int mg = function_map[ml];
-                for (int nl = 0; nl < ml; nl++) {
-                    int ng = function_map[nl];
-#pragma omp atomic update
-                    Vxp[mg][ng] += Vx_localp[ml][nl];
-#pragma omp atomic update
-                    Vxp[ng][mg] += Vx_localp[ml][nl];
+                // ===> Add the adjoint to complete the LDA and GGA contributions  <===
+                for (int m = 0; m < nlocal; m++) {
+                    for (int n = 0; n <= m; n++) {
+                        Vx_rows[m][n] = Vx_rows[n][m] = Vx_rows[m][n] + Vx_rows[n][m];
+                    }
                 }
-#pragma omp atomic update
-                Vxp[mg][mg] += Vx_localp[ml][ml];
+
+                // => Unpacking <= //
+                accumulator.add(rank, dstart + k, function_map, Vx_rows.data());
             }
-            parallel_timer_off("V_XCd", rank);
+            thread_timer_off(v_timers().v_xcd);
         }
     }
+    accumulator.reduce();
 
     // Set the result
     for (size_t i = 0; i < Dx.size(); i++) {
@@ -2021,16 +2048,16 @@ SharedMatrix RV::compute_gradient() {
         auto block = grid_->blocks()[Q];
 
         // ==> Compute rho, gamma, etc. for block <== //
-        parallel_timer_on("Properties", rank);
-        pworker->compute_points(block);
-        parallel_timer_off("Properties", rank);
+        thread_timer_on(v_timers().properties);
+        pworker->compute_points(block, false);
+        thread_timer_off(v_timers().properties);
 
         // ==> Compute functional values for block <== //
-        parallel_timer_on("Functional", rank);
-        auto& vals = fworker->compute_functional(pworker->point_values());
-        parallel_timer_off("Functional", rank);
+        thread_timer_on(v_timers().functional);
+        const auto& vals = fworker->compute_functional(pworker->xc_point_values(), block->npoints());
+        thread_timer_off(v_timers().functional);
 
-        parallel_timer_on("V_xc gradient", rank);
+        thread_timer_on(v_timers().v_xc_gradient);
 
         // => Compute quadrature <= //
         auto qvals = dft_integrators::rks_quadrature_integrate(block, fworker, pworker);
@@ -2043,7 +2070,7 @@ SharedMatrix RV::compute_gradient() {
         // => Integrate all contributions into G <= //
         dft_integrators::rks_gradient_integrator(primary_, block, fworker, pworker, G_local[rank], U_local[rank]);
 
-        parallel_timer_off("V_xc gradient", rank);
+        thread_timer_off(v_timers().v_xc_gradient);
     }
 
     // Sum up the matrix
@@ -2195,8 +2222,8 @@ SharedMatrix RV::compute_hessian() {
         int nlocal = function_map.size();
 
         // ==> Compute values at points <==
-        pworker->compute_points(block);
-        auto& vals = fworker->compute_functional(pworker->point_values(), npoints);
+        pworker->compute_points(block, false);
+        const auto& vals = fworker->compute_functional(pworker->xc_point_values(), npoints);
 
         auto phi = pworker->basis_value("PHI")->pointer();
         auto phi_x = pworker->basis_value("PHI_X")->pointer();
@@ -2208,9 +2235,9 @@ SharedMatrix RV::compute_hessian() {
         auto phi_yy = pworker->basis_value("PHI_YY")->pointer();
         auto phi_yz = pworker->basis_value("PHI_YZ")->pointer();
         auto phi_zz = pworker->basis_value("PHI_ZZ")->pointer();
-        auto rho_a = pworker->point_value("RHO_A")->pointer();
-        auto v_rho_a = vals["V_RHO_A"]->pointer();
-        auto v_rho_aa = vals["V_RHO_A_RHO_A"]->pointer();
+        auto rho_a = pworker->xc_point_value(XCValue::RHO_A);
+        auto v_rho_a = vals[XCValue::V_RHO_A];
+        auto v_rho_aa = vals[XCValue::V_RHO_A_RHO_A];
         size_t coll_funcs = pworker->basis_value("PHI")->ncol();
 
         // ==> LSDA Contribution <== //
@@ -2586,7 +2613,7 @@ void UV::initialize() {
         // Need a points worker per thread
         std::shared_ptr<PointFunctions> point_tmp = std::make_shared<UKSFunctions>(primary_, max_points, max_functions);
         point_tmp->set_ansatz(functional_->ansatz());
-        point_tmp->set_cache_map(&cache_map_);
+        point_tmp->set_collocation_cache(collocation_cache_.get());
         point_workers_.push_back(point_tmp);
     }
 }
@@ -2642,10 +2669,12 @@ void UV::compute_V(std::vector<SharedMatrix> ret) {
     int max_functions = grid_->max_functions();
     int max_points = grid_->max_points();
 
-    // Setup the pointers
+    // Setup the pointers, screening functions per block only for this integration
     for (size_t i = 0; i < num_threads_; i++) {
         point_workers_[i]->set_pointers(D_AO_[0], D_AO_[1]);
     }
+    std::vector<FunctionScreeningStats> screening_stats(num_threads_);
+    ScopedFunctionScreening screening(point_workers_, function_screening_);
 
     // Per thread temporaries
     std::vector<SharedMatrix> Va_local, Vb_local;
@@ -2659,8 +2688,7 @@ void UV::compute_V(std::vector<SharedMatrix> ret) {
 
     auto Va_AO = std::make_shared<Matrix>("Va Temp", nbf_, nbf_);
     auto Vb_AO = std::make_shared<Matrix>("Vb Temp", nbf_, nbf_);
-    auto Vap = Va_AO->pointer();
-    auto Vbp = Vb_AO->pointer();
+    VAccumulator accumulator({Va_AO, Vb_AO}, num_threads_, v_buffer_memory_);
 
     std::vector<double> functionalq(num_threads_);
     std::vector<double> rhoaq(num_threads_);
@@ -2697,18 +2725,21 @@ void UV::compute_V(std::vector<SharedMatrix> ret) {
         auto y = block->y();
         auto z = block->z();
         auto w = block->w();
-        const auto& function_map = block->functions_local_to_global();
-        auto nlocal = function_map.size();
 
         // ==> Compute rho, gamma, etc. for block <==
-        parallel_timer_on("Properties", rank);
+        thread_timer_on(v_timers().properties);
         pworker->compute_points(block, false);
-        parallel_timer_off("Properties", rank);
+        thread_timer_off(v_timers().properties);
 
         // ==> Compute functional values for block <==
-        parallel_timer_on("Functional", rank);
-        auto& vals = fworker->compute_functional(pworker->point_values(), npoints);
-        parallel_timer_off("Functional", rank);
+        thread_timer_on(v_timers().functional);
+        const auto& vals = fworker->compute_functional(pworker->xc_point_values(), npoints);
+        thread_timer_off(v_timers().functional);
+
+        // Functions whose potential matrix elements survive screening
+        pworker->screen_potential(potential_bound(block, fworker, pworker, ansatz, false));
+        const auto& function_map = pworker->active_functions();
+        auto nlocal = function_map.size();
 
         if (debug_ > 3) {
             block->print("outfile", debug_);
@@ -2716,13 +2747,13 @@ void UV::compute_V(std::vector<SharedMatrix> ret) {
         }
 
         // ==> Define pointers to intermediates <==
-        parallel_timer_on("V_xc", rank);
+        thread_timer_on(v_timers().v_xc);
         auto phi = pworker->basis_value("PHI")->pointer();
-        auto rho_a = pworker->point_value("RHO_A")->pointer();
-        auto rho_b = pworker->point_value("RHO_B")->pointer();
-        auto zk = vals["V"]->pointer();
-        auto v_rho_a = vals["V_RHO_A"]->pointer();
-        auto v_rho_b = vals["V_RHO_B"]->pointer();
+        auto rho_a = pworker->xc_point_value(XCValue::RHO_A);
+        auto rho_b = pworker->xc_point_value(XCValue::RHO_B);
+        auto zk = vals[XCValue::V];
+        auto v_rho_a = vals[XCValue::V_RHO_A];
+        auto v_rho_b = vals[XCValue::V_RHO_B];
         auto coll_funcs = pworker->basis_value("PHI")->ncol();
 
         // ==> Compute quadrature values <== //
@@ -2762,15 +2793,15 @@ void UV::compute_V(std::vector<SharedMatrix> ret) {
             auto phix = pworker->basis_value("PHI_X")->pointer();
             auto phiy = pworker->basis_value("PHI_Y")->pointer();
             auto phiz = pworker->basis_value("PHI_Z")->pointer();
-            auto rho_ax = pworker->point_value("RHO_AX")->pointer();
-            auto rho_ay = pworker->point_value("RHO_AY")->pointer();
-            auto rho_az = pworker->point_value("RHO_AZ")->pointer();
-            auto rho_bx = pworker->point_value("RHO_BX")->pointer();
-            auto rho_by = pworker->point_value("RHO_BY")->pointer();
-            auto rho_bz = pworker->point_value("RHO_BZ")->pointer();
-            auto v_gamma_aa = vals["V_GAMMA_AA"]->pointer();
-            auto v_gamma_ab = vals["V_GAMMA_AB"]->pointer();
-            auto v_gamma_bb = vals["V_GAMMA_BB"]->pointer();
+            auto rho_ax = pworker->xc_point_value(XCValue::RHO_AX);
+            auto rho_ay = pworker->xc_point_value(XCValue::RHO_AY);
+            auto rho_az = pworker->xc_point_value(XCValue::RHO_AZ);
+            auto rho_bx = pworker->xc_point_value(XCValue::RHO_BX);
+            auto rho_by = pworker->xc_point_value(XCValue::RHO_BY);
+            auto rho_bz = pworker->xc_point_value(XCValue::RHO_BZ);
+            auto v_gamma_aa = vals[XCValue::V_GAMMA_AA];
+            auto v_gamma_ab = vals[XCValue::V_GAMMA_AB];
+            auto v_gamma_bb = vals[XCValue::V_GAMMA_BB];
 
             for (int P = 0; P < npoints; P++) {
                 C_DAXPY(nlocal, w[P] * (2.0 * v_gamma_aa[P] * rho_ax[P] + v_gamma_ab[P] * rho_bx[P]), phix[P], 1,
@@ -2811,8 +2842,8 @@ void UV::compute_V(std::vector<SharedMatrix> ret) {
             auto phix = pworker->basis_value("PHI_X")->pointer();
             auto phiy = pworker->basis_value("PHI_Y")->pointer();
             auto phiz = pworker->basis_value("PHI_Z")->pointer();
-            auto v_tau_a = vals["V_TAU_A"]->pointer();
-            auto v_tau_b = vals["V_TAU_B"]->pointer();
+            auto v_tau_a = vals[XCValue::V_TAU_A];
+            auto v_tau_b = vals[XCValue::V_TAU_B];
 
             double** phi[3];
             phi[0] = phix;
@@ -2845,26 +2876,13 @@ void UV::compute_V(std::vector<SharedMatrix> ret) {
         }
 
         // ==> Unpacking <== //
-        for (int ml = 0; ml < nlocal; ml++) {
-            int mg = function_map[ml];
-            for (int nl = 0; nl < ml; nl++) {
-                int ng = function_map[nl];
-#pragma omp atomic update
-                Vap[mg][ng] += Va2p[ml][nl];
-#pragma omp atomic update
-                Vap[ng][mg] += Va2p[ml][nl];
-#pragma omp atomic update
-                Vbp[mg][ng] += Vb2p[ml][nl];
-#pragma omp atomic update
-                Vbp[ng][mg] += Vb2p[ml][nl];
-            }
-#pragma omp atomic update
-            Vap[mg][mg] += Va2p[ml][ml];
-#pragma omp atomic update
-            Vbp[mg][mg] += Vb2p[ml][ml];
-        }
-        parallel_timer_off("V_xc", rank);
+        accumulator.add(rank, 0, function_map, Va2p);
+        accumulator.add(rank, 1, function_map, Vb2p);
+        screening_stats[rank].add(block->local_nbf(), pworker->density_functions(), nlocal);
+        thread_timer_off(v_timers().v_xc);
     }
+    accumulator.reduce();
+    print_function_screening(screening_stats);
 
     // Do we need VV10?
     double vv10_e = 0.0;
@@ -2999,15 +3017,15 @@ std::vector<SharedMatrix> UV::compute_fock_derivatives() {
         int nlocal = function_map.size();
 
         // Compute Rho, Phi, etc
-        parallel_timer_on("Properties", rank);
-        pworker->compute_points(block);
-        parallel_timer_off("Properties", rank);
+        thread_timer_on(v_timers().properties);
+        pworker->compute_points(block, false);
+        thread_timer_off(v_timers().properties);
 
         // Compute functional values
 
-        parallel_timer_on("Functional", rank);
-        auto& vals = fworker->compute_functional(pworker->point_values(), npoints);
-        parallel_timer_off("Functional", rank);
+        thread_timer_on(v_timers().functional);
+        const auto& vals = fworker->compute_functional(pworker->xc_point_values(), npoints);
+        thread_timer_off(v_timers().functional);
 
         // => Grab quantities <= //
         // LDA
@@ -3015,13 +3033,13 @@ std::vector<SharedMatrix> UV::compute_fock_derivatives() {
         auto phi_x = pworker->basis_value("PHI_X")->pointer();
         auto phi_y = pworker->basis_value("PHI_Y")->pointer();
         auto phi_z = pworker->basis_value("PHI_Z")->pointer();
-        auto rho_a = pworker->point_value("RHO_A")->pointer();
-        auto rho_b = pworker->point_value("RHO_B")->pointer();
-        auto v_rho_a = vals["V_RHO_A"]->pointer();
-        auto v_rho_b = vals["V_RHO_B"]->pointer();
-        auto v_rho_aa = vals["V_RHO_A_RHO_A"]->pointer();
-        auto v_rho_ab = vals["V_RHO_A_RHO_B"]->pointer();
-        auto v_rho_bb = vals["V_RHO_B_RHO_B"]->pointer();
+        auto rho_a = pworker->xc_point_value(XCValue::RHO_A);
+        auto rho_b = pworker->xc_point_value(XCValue::RHO_B);
+        auto v_rho_a = vals[XCValue::V_RHO_A];
+        auto v_rho_b = vals[XCValue::V_RHO_B];
+        auto v_rho_aa = vals[XCValue::V_RHO_A_RHO_A];
+        auto v_rho_ab = vals[XCValue::V_RHO_A_RHO_B];
+        auto v_rho_bb = vals[XCValue::V_RHO_B_RHO_B];
         for (int P = 0; P < npoints; P++) {
             if (std::fabs(rho_a[P]) + std::fabs(rho_b[P]) < v2_rho_cutoff_) {
                 v_rho_a[P] = 0.0;
@@ -3279,33 +3297,39 @@ void UV::compute_Vx(std::vector<SharedMatrix> Dx, std::vector<SharedMatrix> ret)
         }
     }
 
+    // How many alpha/beta pairs are contracted together per block. Each needs a slice of the stacked
+    // densities, T, and Vx per spin, plus its perturbed point values.
+    size_t npair_values = (ansatz >= 1 ? 9 : 2);
+    size_t nbatch = vx_batch_size(Dx_vec.size() / 2, 4 * max_functions * max_functions +
+                                                         2 * max_points * max_functions + npair_values * max_points);
+    size_t ld_batch = 2 * nbatch * max_functions;
+
     // Per [R]ank quantities
-    std::vector<SharedMatrix> R_Vax_local, R_Dax_local;
-    std::vector<SharedMatrix> R_Vbx_local, R_Dbx_local;
-    std::vector<std::shared_ptr<Vector>> R_rho_ak, R_rho_ak_x, R_rho_ak_y, R_rho_ak_z, R_gamma_ak;
-    std::vector<std::shared_ptr<Vector>> R_rho_bk, R_rho_bk_x, R_rho_bk_y, R_rho_bk_z, R_gamma_bk;
-    std::vector<std::shared_ptr<Vector>> R_gamma_abk;
+    std::vector<SharedMatrix> R_Vx_local, R_Dx_local, R_T_local;
+    std::vector<SharedMatrix> R_rho_ak, R_rho_ak_x, R_rho_ak_y, R_rho_ak_z, R_gamma_ak;
+    std::vector<SharedMatrix> R_rho_bk, R_rho_bk_x, R_rho_bk_y, R_rho_bk_z, R_gamma_bk;
+    std::vector<SharedMatrix> R_gamma_abk;
+    std::vector<std::vector<double*>> R_Vx_rows(num_threads_, std::vector<double*>(max_functions));
     for (size_t i = 0; i < num_threads_; i++) {
-        R_Vax_local.push_back(std::make_shared<Matrix>("Vax Temp", max_functions, max_functions));
-        R_Vbx_local.push_back(std::make_shared<Matrix>("Vbx Temp", max_functions, max_functions));
-        R_Dax_local.push_back(std::make_shared<Matrix>("Dak Temp", max_functions, max_functions));
-        R_Dbx_local.push_back(std::make_shared<Matrix>("Dbk Temp", max_functions, max_functions));
+        R_Vx_local.push_back(std::make_shared<Matrix>("Vx Temp", max_functions, ld_batch));
+        R_Dx_local.push_back(std::make_shared<Matrix>("Dk Temp", max_functions, ld_batch));
+        R_T_local.push_back(std::make_shared<Matrix>("T Temp", max_points, ld_batch));
 
-        R_rho_ak.push_back(std::make_shared<Vector>("Rho aK Temp", max_points));
-        R_rho_bk.push_back(std::make_shared<Vector>("Rho bK Temp", max_points));
+        R_rho_ak.push_back(std::make_shared<Matrix>("Rho aK Temp", nbatch, max_points));
+        R_rho_bk.push_back(std::make_shared<Matrix>("Rho bK Temp", nbatch, max_points));
 
         if (ansatz >= 1) {
-            R_rho_ak_x.push_back(std::make_shared<Vector>("RHO K X Temp", max_points));
-            R_rho_ak_y.push_back(std::make_shared<Vector>("RHO K Y Temp", max_points));
-            R_rho_ak_z.push_back(std::make_shared<Vector>("Rho K Z Temp", max_points));
-            R_gamma_ak.push_back(std::make_shared<Vector>("Gamma K Temp", max_points));
+            R_rho_ak_x.push_back(std::make_shared<Matrix>("RHO K X Temp", nbatch, max_points));
+            R_rho_ak_y.push_back(std::make_shared<Matrix>("RHO K Y Temp", nbatch, max_points));
+            R_rho_ak_z.push_back(std::make_shared<Matrix>("Rho K Z Temp", nbatch, max_points));
+            R_gamma_ak.push_back(std::make_shared<Matrix>("Gamma K Temp", nbatch, max_points));
 
-            R_rho_bk_x.push_back(std::make_shared<Vector>("RHO K X Temp", max_points));
-            R_rho_bk_y.push_back(std::make_shared<Vector>("RHO K Y Temp", max_points));
-            R_rho_bk_z.push_back(std::make_shared<Vector>("Rho K Z Temp", max_points));
-            R_gamma_bk.push_back(std::make_shared<Vector>("Gamma K Temp", max_points));
+            R_rho_bk_x.push_back(std::make_shared<Matrix>("RHO K X Temp", nbatch, max_points));
+            R_rho_bk_y.push_back(std::make_shared<Matrix>("RHO K Y Temp", nbatch, max_points));
+            R_rho_bk_z.push_back(std::make_shared<Matrix>("Rho K Z Temp", nbatch, max_points));
+            R_gamma_bk.push_back(std::make_shared<Matrix>("Gamma K Temp", nbatch, max_points));
 
-            R_gamma_abk.push_back(std::make_shared<Vector>("Gamma K Temp", max_points));
+            R_gamma_abk.push_back(std::make_shared<Matrix>("Gamma K Temp", nbatch, max_points));
         }
 
         functional_workers_[i]->set_deriv(2);
@@ -3320,6 +3344,14 @@ void UV::compute_Vx(std::vector<SharedMatrix> Dx, std::vector<SharedMatrix> ret)
         Vax_AO.push_back(std::make_shared<Matrix>("Vbx AO Temp", nbf_, nbf_));
     }
 
+    // Targets interleave alpha and beta, matching the layout of Dx
+    std::vector<SharedMatrix> Vx_targets;
+    for (size_t i = 0; i < (Dx.size() / 2); i++) {
+        Vx_targets.push_back(Vax_AO[i]);
+        Vx_targets.push_back(Vbx_AO[i]);
+    }
+    VAccumulator accumulator(Vx_targets, num_threads_, v_buffer_memory_);
+
     // => Compute Vx <=
 #pragma omp parallel for private(rank) schedule(guided) num_threads(num_threads_)
     for (size_t Q = 0; Q < grid_->blocks().size(); Q++) {
@@ -3331,14 +3363,12 @@ void UV::compute_Vx(std::vector<SharedMatrix> Dx, std::vector<SharedMatrix> ret)
         // => Setup <= //
         auto fworker = functional_workers_[rank];
         auto pworker = point_workers_[rank];
-        auto Vax_localp = R_Vax_local[rank]->pointer();
-        auto Vbx_localp = R_Vbx_local[rank]->pointer();
-        auto Dax_localp = R_Dax_local[rank]->pointer();
-        auto Dbx_localp = R_Dbx_local[rank]->pointer();
+        auto Vx_localp = R_Vx_local[rank]->pointer();
+        auto Dx_localp = R_Dx_local[rank]->pointer();
+        auto& Vx_rows = R_Vx_rows[rank];
 
         // => Compute blocks <= //
-        auto Tap = pworker->scratch()[0]->pointer();
-        auto Tbp = pworker->scratch()[1]->pointer();
+        auto Tp = R_T_local[rank]->pointer();
 
         auto block = grid_->blocks()[Q];
         auto npoints = block->npoints();
@@ -3347,41 +3377,41 @@ void UV::compute_Vx(std::vector<SharedMatrix> Dx, std::vector<SharedMatrix> ret)
         auto nlocal = function_map.size();
 
         // ==> Compute rho, gamma, etc. for block <==
-        parallel_timer_on("Properties", rank);
-        pworker->compute_points(block);
-        parallel_timer_off("Properties", rank);
+        thread_timer_on(v_timers().properties);
+        pworker->compute_points(block, false);
+        thread_timer_off(v_timers().properties);
 
         // ==> Compute functional values for block <==
-        parallel_timer_on("Functional", rank);
-        auto& vals = fworker->compute_functional(pworker->point_values(), npoints);
-        parallel_timer_off("Functional", rank);
+        thread_timer_on(v_timers().functional);
+        const auto& vals = fworker->compute_functional(pworker->xc_point_values(), npoints);
+        thread_timer_off(v_timers().functional);
 
         // ==> Define pointers to intermediates <==
         // LSDA
         auto phi = pworker->basis_value("PHI")->pointer();
-        auto rho_a = pworker->point_value("RHO_A")->pointer();
-        auto rho_b = pworker->point_value("RHO_B")->pointer();
-        auto v2_rho2_aa = vals["V_RHO_A_RHO_A"]->pointer();
-        auto v2_rho2_ab = vals["V_RHO_A_RHO_B"]->pointer();
-        auto v2_rho2_bb = vals["V_RHO_B_RHO_B"]->pointer();
+        auto rho_a = pworker->xc_point_value(XCValue::RHO_A);
+        auto rho_b = pworker->xc_point_value(XCValue::RHO_B);
+        auto v2_rho2_aa = vals[XCValue::V_RHO_A_RHO_A];
+        auto v2_rho2_ab = vals[XCValue::V_RHO_A_RHO_B];
+        auto v2_rho2_bb = vals[XCValue::V_RHO_B_RHO_B];
         auto coll_funcs = pworker->basis_value("PHI")->ncol();
 
-        auto rho_ak = R_rho_ak[rank]->pointer();
-        auto rho_bk = R_rho_bk[rank]->pointer();
+        auto rho_akp = R_rho_ak[rank]->pointer();
+        auto rho_bkp = R_rho_bk[rank]->pointer();
 
         // GGA
         double** phi_x;
         double** phi_y;
         double** phi_z;
 
-        double *rho_ak_x, *rho_bk_x;
-        double *rho_ak_y, *rho_bk_y;
-        double *rho_ak_z, *rho_bk_z;
-        double *gamma_aak, *gamma_bbk;
+        double **rho_ak_xp, **rho_bk_xp;
+        double **rho_ak_yp, **rho_bk_yp;
+        double **rho_ak_zp, **rho_bk_zp;
+        double **gamma_aakp, **gamma_bbkp;
         double *rho_ax, *rho_bx;
         double *rho_ay, *rho_by;
         double *rho_az, *rho_bz;
-        double* gamma_abk;
+        double** gamma_abkp;
         if (ansatz >= 1) {
             // Phi
             phi_x = pworker->basis_value("PHI_X")->pointer();
@@ -3389,337 +3419,361 @@ void UV::compute_Vx(std::vector<SharedMatrix> Dx, std::vector<SharedMatrix> ret)
             phi_z = pworker->basis_value("PHI_Z")->pointer();
 
             // Alpha
-            rho_ak_x = R_rho_ak_x[rank]->pointer();
-            rho_ak_y = R_rho_ak_y[rank]->pointer();
-            rho_ak_z = R_rho_ak_z[rank]->pointer();
-            gamma_aak = R_gamma_ak[rank]->pointer();
-            rho_ax = pworker->point_value("RHO_AX")->pointer();
-            rho_ay = pworker->point_value("RHO_AY")->pointer();
-            rho_az = pworker->point_value("RHO_AZ")->pointer();
+            rho_ak_xp = R_rho_ak_x[rank]->pointer();
+            rho_ak_yp = R_rho_ak_y[rank]->pointer();
+            rho_ak_zp = R_rho_ak_z[rank]->pointer();
+            gamma_aakp = R_gamma_ak[rank]->pointer();
+            rho_ax = pworker->xc_point_value(XCValue::RHO_AX);
+            rho_ay = pworker->xc_point_value(XCValue::RHO_AY);
+            rho_az = pworker->xc_point_value(XCValue::RHO_AZ);
 
             // Beta
-            rho_bk_x = R_rho_bk_x[rank]->pointer();
-            rho_bk_y = R_rho_bk_y[rank]->pointer();
-            rho_bk_z = R_rho_bk_z[rank]->pointer();
-            gamma_bbk = R_gamma_bk[rank]->pointer();
-            rho_bx = pworker->point_value("RHO_BX")->pointer();
-            rho_by = pworker->point_value("RHO_BY")->pointer();
-            rho_bz = pworker->point_value("RHO_BZ")->pointer();
-
-            gamma_abk = R_gamma_abk[rank]->pointer();
+            rho_bk_xp = R_rho_bk_x[rank]->pointer();
+            rho_bk_yp = R_rho_bk_y[rank]->pointer();
+            rho_bk_zp = R_rho_bk_z[rank]->pointer();
+            gamma_bbkp = R_gamma_bk[rank]->pointer();
+            rho_bx = pworker->xc_point_value(XCValue::RHO_BX);
+            rho_by = pworker->xc_point_value(XCValue::RHO_BY);
+            rho_bz = pworker->xc_point_value(XCValue::RHO_BZ);
+
+            gamma_abkp = R_gamma_abk[rank]->pointer();
         }
 
         // Meta
         // Forget that!
 
-        // ==> Compute Vx contribution for each x <==
-        for (size_t dindex = 0; dindex < (Dx_vec.size() / 2); dindex++) {
-            auto Daxp = Dx_vec[2 * dindex]->pointer();
-            auto Dbxp = Dx_vec[2 * dindex + 1]->pointer();
+        // ==> Compute Vx contributions, nbatch alpha/beta pairs at a time <==
+        // The alpha and beta densities of pair j of a batch occupy columns [2j * nlocal, (2j + 1) * nlocal) and
+        // [(2j + 1) * nlocal, (2j + 2) * nlocal) of Dx_local, T, and Vx_local, so the batch shares one GEMM into
+        // and one GEMM out of the grid.
+        size_t npairs = Dx_vec.size() / 2;
+        for (size_t pstart = 0; pstart < npairs; pstart += nbatch) {
+            size_t nb = std::min(nbatch, npairs - pstart);
+            size_t ncol = 2 * nb * nlocal;
 
             // ===> Build Rotated Densities <=== //
-            for (int ml = 0; ml < nlocal; ml++) {
-                int mg = function_map[ml];
-                for (int nl = 0; nl < nlocal; nl++) {
-                    int ng = function_map[nl];
-                    Dax_localp[ml][nl] = Daxp[mg][ng];
-                    Dbx_localp[ml][nl] = Dbxp[mg][ng];
+            // Dstack[k] := add_trans(Dk, (1, 0)), alternating alpha and beta
+            for (size_t k = 0; k < 2 * nb; k++) {
+                auto Dxp = Dx_vec[2 * pstart + k]->pointer();
+                for (int ml = 0; ml < nlocal; ml++) {
+                    int mg = function_map[ml];
+                    auto Dkp = Dx_localp[ml] + k * nlocal;
+                    for (int nl = 0; nl < nlocal; nl++) {
+                        int ng = function_map[nl];
+                        Dkp[nl] = Dxp[mg][ng] + Dxp[ng][mg];
+                    }
                 }
             }
 
             // ===> Compute quantities using effective densities <===
-            // Ta, Tb := einsum("pm, mnσ -> pnσ", φ, add_trans(Dk, (1, 0, 2)))[σ = α, β]
-            // Alpha
-            parallel_timer_on("Derivative Properties", rank);
-            C_DGEMM('N', 'N', npoints, nlocal, nlocal, 1.0, phi[0], coll_funcs, Dax_localp[0], max_functions, 0.0,
-                    Tap[0], max_functions);
-            C_DGEMM('N', 'T', npoints, nlocal, nlocal, 1.0, phi[0], coll_funcs, Dax_localp[0], max_functions, 1.0,
-                    Tap[0], max_functions);
-
-            // Beta
-            C_DGEMM('N', 'N', npoints, nlocal, nlocal, 1.0, phi[0], coll_funcs, Dbx_localp[0], max_functions, 0.0,
-                    Tbp[0], max_functions);
-            C_DGEMM('N', 'T', npoints, nlocal, nlocal, 1.0, phi[0], coll_funcs, Dbx_localp[0], max_functions, 1.0,
-                    Tbp[0], max_functions);
-
-            // ρk = einsum("mnσ, pm, pn -> pσ", Dk, φ, φ)
-            // ρk = 1/2 * add_trans(ρκ, (1, 0, 2))
-            for (int P = 0; P < npoints; P++) {
-                rho_ak[P] = 0.5 * C_DDOT(nlocal, phi[P], 1, Tap[P], 1);
-                rho_bk[P] = 0.5 * C_DDOT(nlocal, phi[P], 1, Tbp[P], 1);
-            }
+            // Ta, Tb := einsum("pm, mnσ -> pnσ", φ, Dstack) for the whole batch at once
+            thread_timer_on(v_timers().derivative_properties);
+            C_DGEMM('N', 'N', npoints, ncol, nlocal, 1.0, phi[0], coll_funcs, Dx_localp[0], ld_batch, 0.0, Tp[0],
+                    ld_batch);
+
+            for (size_t j = 0; j < nb; j++) {
+                size_t aoff = 2 * j * nlocal;
+                size_t boff = aoff + nlocal;
+                auto rho_ak = rho_akp[j];
+                auto rho_bk = rho_bkp[j];
+                double *rho_ak_x, *rho_ak_y, *rho_ak_z, *gamma_aak;
+                double *rho_bk_x, *rho_bk_y, *rho_bk_z, *gamma_bbk;
+                double* gamma_abk;
+                if (ansatz >= 1) {
+                    rho_ak_x = rho_ak_xp[j];
+                    rho_ak_y = rho_ak_yp[j];
+                    rho_ak_z = rho_ak_zp[j];
+                    gamma_aak = gamma_aakp[j];
+                    rho_bk_x = rho_bk_xp[j];
+                    rho_bk_y = rho_bk_yp[j];
+                    rho_bk_z = rho_bk_zp[j];
+                    gamma_bbk = gamma_bbkp[j];
+                    gamma_abk = gamma_abkp[j];
+                }
 
-            // ∇ρk = einsum("mnσ, pm, pn -> pσ", add_trans(Dk, (1, 0, 2)), ∇φ, φ)
-            //  Γk = add_trans(einsum("xpσ, xpτ -> pστ", ∇ρk, ∇ρ), (0, 2, 1))
-            if (ansatz >= 1) {
+                // ρk = einsum("mnσ, pm, pn -> pσ", Dk, φ, φ)
+                // ρk = 1/2 * add_trans(ρκ, (1, 0, 2))
                 for (int P = 0; P < npoints; P++) {
-                    // Alpha
-                    rho_ak_x[P] = C_DDOT(nlocal, phi_x[P], 1, Tap[P], 1);
-                    rho_ak_y[P] = C_DDOT(nlocal, phi_y[P], 1, Tap[P], 1);
-                    rho_ak_z[P] = C_DDOT(nlocal, phi_z[P], 1, Tap[P], 1);
-                    gamma_aak[P] = rho_ak_x[P] * rho_ax[P];
-                    gamma_aak[P] += rho_ak_y[P] * rho_ay[P];
-                    gamma_aak[P] += rho_ak_z[P] * rho_az[P];
-                    gamma_aak[P] *= 2.0;
-
-                    // Beta
-                    rho_bk_x[P] = C_DDOT(nlocal, phi_x[P], 1, Tbp[P], 1);
-                    rho_bk_y[P] = C_DDOT(nlocal, phi_y[P], 1, Tbp[P], 1);
-                    rho_bk_z[P] = C_DDOT(nlocal, phi_z[P], 1, Tbp[P], 1);
-                    gamma_bbk[P] = rho_bk_x[P] * rho_bx[P];
-                    gamma_bbk[P] += rho_bk_y[P] * rho_by[P];
-                    gamma_bbk[P] += rho_bk_z[P] * rho_bz[P];
-                    gamma_bbk[P] *= 2.0;
-
-                    // Alpha-Beta
-                    gamma_abk[P] = rho_ak_x[P] * rho_bx[P] + rho_bk_x[P] * rho_ax[P];
-                    gamma_abk[P] += rho_ak_y[P] * rho_by[P] + rho_bk_y[P] * rho_ay[P];
-                    gamma_abk[P] += rho_ak_z[P] * rho_bz[P] + rho_bk_z[P] * rho_az[P];
+                    rho_ak[P] = 0.5 * C_DDOT(nlocal, phi[P], 1, Tp[P] + aoff, 1);
+                    rho_bk[P] = 0.5 * C_DDOT(nlocal, phi[P], 1, Tp[P] + boff, 1);
                 }
-            }
-            parallel_timer_off("Derivative Properties", rank);
-
-            parallel_timer_on("V_XCd", rank);
-            // ===> LSDA contribution (symmetrized) <=== //
-            //                                                  ∂^2
-            // Ta, Tb := 1/2 einsum("p, pστ, pm, pτ -> pmσ", w, ---- f , ρk, φ)
-            //                                                  ∂ρ^2
-            double tmp_val = 0.0, tmp_ab_val = 0.0;
-            for (int P = 0; P < npoints; P++) {
-                std::fill(Tap[P], Tap[P] + nlocal, 0.0);
-                std::fill(Tbp[P], Tbp[P] + nlocal, 0.0);
 
-                // Do a simple screen: ignore contributions where rho is too small.
-                if (rho_a[P] + rho_b[P] > v2_rho_cutoff_) {
-                    tmp_val = v2_rho2_aa[P] * rho_ak[P];
-                    tmp_val += v2_rho2_ab[P] * rho_bk[P];
-                    tmp_val *= 0.5 * w[P];
-                    C_DAXPY(nlocal, tmp_val, phi[P], 1, Tap[P], 1);
-
-                    tmp_val = v2_rho2_bb[P] * rho_bk[P];
-                    tmp_val += v2_rho2_ab[P] * rho_ak[P];
-                    tmp_val *= 0.5 * w[P];
-                    C_DAXPY(nlocal, tmp_val, phi[P], 1, Tbp[P], 1);
+                // ∇ρk = einsum("mnσ, pm, pn -> pσ", add_trans(Dk, (1, 0, 2)), ∇φ, φ)
+                //  Γk = add_trans(einsum("xpσ, xpτ -> pστ", ∇ρk, ∇ρ), (0, 2, 1))
+                if (ansatz >= 1) {
+                    for (int P = 0; P < npoints; P++) {
+                        // Alpha
+                        rho_ak_x[P] = C_DDOT(nlocal, phi_x[P], 1, Tp[P] + aoff, 1);
+                        rho_ak_y[P] = C_DDOT(nlocal, phi_y[P], 1, Tp[P] + aoff, 1);
+                        rho_ak_z[P] = C_DDOT(nlocal, phi_z[P], 1, Tp[P] + aoff, 1);
+                        gamma_aak[P] = rho_ak_x[P] * rho_ax[P];
+                        gamma_aak[P] += rho_ak_y[P] * rho_ay[P];
+                        gamma_aak[P] += rho_ak_z[P] * rho_az[P];
+                        gamma_aak[P] *= 2.0;
+
+                        // Beta
+                        rho_bk_x[P] = C_DDOT(nlocal, phi_x[P], 1, Tp[P] + boff, 1);
+                        rho_bk_y[P] = C_DDOT(nlocal, phi_y[P], 1, Tp[P] + boff, 1);
+                        rho_bk_z[P] = C_DDOT(nlocal, phi_z[P], 1, Tp[P] + boff, 1);
+                        gamma_bbk[P] = rho_bk_x[P] * rho_bx[P];
+                        gamma_bbk[P] += rho_bk_y[P] * rho_by[P];
+                        gamma_bbk[P] += rho_bk_z[P] * rho_bz[P];
+                        gamma_bbk[P] *= 2.0;
+
+                        // Alpha-Beta
+                        gamma_abk[P] = rho_ak_x[P] * rho_bx[P] + rho_bk_x[P] * rho_ax[P];
+                        gamma_abk[P] += rho_ak_y[P] * rho_by[P] + rho_bk_y[P] * rho_ay[P];
+                        gamma_abk[P] += rho_ak_z[P] * rho_bz[P] + rho_bk_z[P] * rho_az[P];
+                    }
                 }
             }
+            thread_timer_off(v_timers().derivative_properties);
+
+            thread_timer_on(v_timers().v_xcd);
+            for (size_t j = 0; j < nb; j++) {
+                size_t aoff = 2 * j * nlocal;
+                size_t boff = aoff + nlocal;
+                auto rho_ak = rho_akp[j];
+                auto rho_bk = rho_bkp[j];
+                double *rho_ak_x, *rho_ak_y, *rho_ak_z, *gamma_aak;
+                double *rho_bk_x, *rho_bk_y, *rho_bk_z, *gamma_bbk;
+                double* gamma_abk;
+                if (ansatz >= 1) {
+                    rho_ak_x = rho_ak_xp[j];
+                    rho_ak_y = rho_ak_yp[j];
+                    rho_ak_z = rho_ak_zp[j];
+                    gamma_aak = gamma_aakp[j];
+                    rho_bk_x = rho_bk_xp[j];
+                    rho_bk_y = rho_bk_yp[j];
+                    rho_bk_z = rho_bk_zp[j];
+                    gamma_bbk = gamma_bbkp[j];
+                    gamma_abk = gamma_abkp[j];
+                }
 
-            // ===> GGA contribution <=== //
-            if (ansatz >= 1) {
-                // ====> Define pointers for future use <====
-                auto gamma_aa = pworker->point_value("GAMMA_AA")->pointer();
-                auto gamma_ab = pworker->point_value("GAMMA_AB")->pointer();
-                auto gamma_bb = pworker->point_value("GAMMA_BB")->pointer();
-
-                auto v_gamma_aa = vals["V_GAMMA_AA"]->pointer();
-                auto v_gamma_ab = vals["V_GAMMA_AB"]->pointer();
-                auto v_gamma_bb = vals["V_GAMMA_BB"]->pointer();
-
-                auto v2_gamma_aa_gamma_aa = vals["V_GAMMA_AA_GAMMA_AA"]->pointer();
-                auto v2_gamma_aa_gamma_ab = vals["V_GAMMA_AA_GAMMA_AB"]->pointer();
-                auto v2_gamma_aa_gamma_bb = vals["V_GAMMA_AA_GAMMA_BB"]->pointer();
-                auto v2_gamma_ab_gamma_ab = vals["V_GAMMA_AB_GAMMA_AB"]->pointer();
-                auto v2_gamma_ab_gamma_bb = vals["V_GAMMA_AB_GAMMA_BB"]->pointer();
-                auto v2_gamma_bb_gamma_bb = vals["V_GAMMA_BB_GAMMA_BB"]->pointer();
-
-                auto v2_rho_a_gamma_aa = vals["V_RHO_A_GAMMA_AA"]->pointer();
-                auto v2_rho_a_gamma_ab = vals["V_RHO_A_GAMMA_AB"]->pointer();
-                auto v2_rho_a_gamma_bb = vals["V_RHO_A_GAMMA_BB"]->pointer();
-                auto v2_rho_b_gamma_aa = vals["V_RHO_B_GAMMA_AA"]->pointer();
-                auto v2_rho_b_gamma_ab = vals["V_RHO_B_GAMMA_AB"]->pointer();
-                auto v2_rho_b_gamma_bb = vals["V_RHO_B_GAMMA_BB"]->pointer();
-
-                double tmp_val = 0.0, v2_val_aa = 0.0, v2_val_ab = 0.0, v2_val_bb = 0.0;
-
-                // There are lots of GGA terms.
+                // ===> LSDA contribution (symmetrized) <=== //
+                //                                                  ∂^2
+                // Ta, Tb := 1/2 einsum("p, pστ, pm, pτ -> pmσ", w, ---- f , ρk, φ)
+                //                                                  ∂ρ^2
+                double tmp_val = 0.0, tmp_ab_val = 0.0;
                 for (int P = 0; P < npoints; P++) {
-                    if (rho_a[P] + rho_b[P] < v2_rho_cutoff_) continue;
-                    // ====> Term 2b, V in DOI: 10.1063/1.466887 <====
-                    //                                                    ∂^2
-                    // Ta, Tb += 1/2 einsum("p, pτσυ, pσυ, pr -> prτ", w, ---- f, Γk, φ)[τ = α, β]
-                    //                                                    ∂ρ∂γ
-                    // V alpha contributions
-                    tmp_val = v2_rho_a_gamma_aa[P] * gamma_aak[P];
-                    tmp_val += v2_rho_a_gamma_ab[P] * gamma_abk[P];
-                    tmp_val += v2_rho_a_gamma_bb[P] * gamma_bbk[P];
-                    C_DAXPY(nlocal, (0.5 * w[P] * tmp_val), phi[P], 1, Tap[P], 1);
-
-                    // V beta contributions
-                    tmp_val = v2_rho_b_gamma_aa[P] * gamma_aak[P];
-                    tmp_val += v2_rho_b_gamma_ab[P] * gamma_abk[P];
-                    tmp_val += v2_rho_b_gamma_bb[P] * gamma_bbk[P];
-                    C_DAXPY(nlocal, (0.5 * w[P] * tmp_val), phi[P], 1, Tbp[P], 1);
-
-                    // ====> All other terms, W in above DOI  <==== //
-                    // Compute α block of final result.
-
-                    //                                  ∂^2
-                    // temp = einsum("pτσυ, pτ -> pσυ", ---- f, ρk)[συ = αα, αβ]
-                    //                                  ∂ρ∂γ
-
-                    // Define ρk[τ=α] terms in 2a intermediate
-                    v2_val_aa = v2_rho_a_gamma_aa[P] * rho_ak[P];
-                    v2_val_ab = v2_rho_a_gamma_ab[P] * rho_ak[P];
-
-                    // Define ρk[τ=β] terms in 2a intermediate
-                    v2_val_aa += v2_rho_b_gamma_aa[P] * rho_bk[P];
-                    v2_val_ab += v2_rho_b_gamma_ab[P] * rho_bk[P];
+                    std::fill(Tp[P] + aoff, Tp[P] + aoff + nlocal, 0.0);
+                    std::fill(Tp[P] + boff, Tp[P] + boff + nlocal, 0.0);
+
+                    // Do a simple screen: ignore contributions where rho is too small.
+                    if (rho_a[P] + rho_b[P] > v2_rho_cutoff_) {
+                        tmp_val = v2_rho2_aa[P] * rho_ak[P];
+                        tmp_val += v2_rho2_ab[P] * rho_bk[P];
+                        tmp_val *= 0.5 * w[P];
+                        C_DAXPY(nlocal, tmp_val, phi[P], 1, Tp[P] + aoff, 1);
+
+                        tmp_val = v2_rho2_bb[P] * rho_bk[P];
+                        tmp_val += v2_rho2_ab[P] * rho_ak[P];
+                        tmp_val *= 0.5 * w[P];
+                        C_DAXPY(nlocal, tmp_val, phi[P], 1, Tp[P] + boff, 1);
+                    }
+                }
+
+                // ===> GGA contribution <=== //
+                if (ansatz >= 1) {
+                    // ====> Define pointers for future use <====
+                    auto gamma_aa = pworker->xc_point_value(XCValue::GAMMA_AA);
+                    auto gamma_ab = pworker->xc_point_value(XCValue::GAMMA_AB);
+                    auto gamma_bb = pworker->xc_point_value(XCValue::GAMMA_BB);
+
+                    auto v_gamma_aa = vals[XCValue::V_GAMMA_AA];
+                    auto v_gamma_ab = vals[XCValue::V_GAMMA_AB];
+                    auto v_gamma_bb = vals[XCValue::V_GAMMA_BB];
+
+                    auto v2_gamma_aa_gamma_aa = vals[XCValue::V_GAMMA_AA_GAMMA_AA];
+                    auto v2_gamma_aa_gamma_ab = vals[XCValue::V_GAMMA_AA_GAMMA_AB];
+                    auto v2_gamma_aa_gamma_bb = vals[XCValue::V_GAMMA_AA_GAMMA_BB];
+                    auto v2_gamma_ab_gamma_ab = vals[XCValue::V_GAMMA_AB_GAMMA_AB];
+                    auto v2_gamma_ab_gamma_bb = vals[XCValue::V_GAMMA_AB_GAMMA_BB];
+                    auto v2_gamma_bb_gamma_bb = vals[XCValue::V_GAMMA_BB_GAMMA_BB];
+
+                    auto v2_rho_a_gamma_aa = vals[XCValue::V_RHO_A_GAMMA_AA];
+                    auto v2_rho_a_gamma_ab = vals[XCValue::V_RHO_A_GAMMA_AB];
+                    auto v2_rho_a_gamma_bb = vals[XCValue::V_RHO_A_GAMMA_BB];
+                    auto v2_rho_b_gamma_aa = vals[XCValue::V_RHO_B_GAMMA_AA];
+                    auto v2_rho_b_gamma_ab = vals[XCValue::V_RHO_B_GAMMA_AB];
+                    auto v2_rho_b_gamma_bb = vals[XCValue::V_RHO_B_GAMMA_BB];
+
+                    double tmp_val = 0.0, v2_val_aa = 0.0, v2_val_ab = 0.0, v2_val_bb = 0.0;
+
+                    // There are lots of GGA terms.
+                    for (int P = 0; P < npoints; P++) {
+                        if (rho_a[P] + rho_b[P] < v2_rho_cutoff_) continue;
+                        // ====> Term 2b, V in DOI: 10.1063/1.466887 <====
+                        //                                                    ∂^2
+                        // Ta, Tb += 1/2 einsum("p, pτσυ, pσυ, pr -> prτ", w, ---- f, Γk, φ)[τ = α, β]
+                        //                                                    ∂ρ∂γ
+                        // V alpha contributions
+                        tmp_val = v2_rho_a_gamma_aa[P] * gamma_aak[P];
+                        tmp_val += v2_rho_a_gamma_ab[P] * gamma_abk[P];
+                        tmp_val += v2_rho_a_gamma_bb[P] * gamma_bbk[P];
+                        C_DAXPY(nlocal, (0.5 * w[P] * tmp_val), phi[P], 1, Tp[P] + aoff, 1);
+
+                        // V beta contributions
+                        tmp_val = v2_rho_b_gamma_aa[P] * gamma_aak[P];
+                        tmp_val += v2_rho_b_gamma_ab[P] * gamma_abk[P];
+                        tmp_val += v2_rho_b_gamma_bb[P] * gamma_bbk[P];
+                        C_DAXPY(nlocal, (0.5 * w[P] * tmp_val), phi[P], 1, Tp[P] + boff, 1);
+
+                        // ====> All other terms, W in above DOI  <==== //
+                        // Compute α block of final result.
+
+                        //                                  ∂^2
+                        // temp = einsum("pτσυ, pτ -> pσυ", ---- f, ρk)[συ = αα, αβ]
+                        //                                  ∂ρ∂γ
+
+                        // Define ρk[τ=α] terms in 2a intermediate
+                        v2_val_aa = v2_rho_a_gamma_aa[P] * rho_ak[P];
+                        v2_val_ab = v2_rho_a_gamma_ab[P] * rho_ak[P];
+
+                        // Define ρk[τ=β] terms in 2a intermediate
+                        v2_val_aa += v2_rho_b_gamma_aa[P] * rho_bk[P];
+                        v2_val_ab += v2_rho_b_gamma_ab[P] * rho_bk[P];
                     
-                    //                                     ∂^2
-                    // temp += einsum("pσυτχ, pτχ -> pσυ", ---- f, Γk)[συ = αα, αβ]
-                    //                                     ∂γ∂γ
+                        //                                     ∂^2
+                        // temp += einsum("pσυτχ, pτχ -> pσυ", ---- f, Γk)[συ = αα, αβ]
+                        //                                     ∂γ∂γ
 
-                    // Define Γk[τχ=αα] terms in 3 intermediate
-                    v2_val_aa += v2_gamma_aa_gamma_aa[P] * gamma_aak[P];
-                    v2_val_ab += v2_gamma_aa_gamma_ab[P] * gamma_aak[P];
+                        // Define Γk[τχ=αα] terms in 3 intermediate
+                        v2_val_aa += v2_gamma_aa_gamma_aa[P] * gamma_aak[P];
+                        v2_val_ab += v2_gamma_aa_gamma_ab[P] * gamma_aak[P];
 
-                    // Define Γk[τχ=αβ] terms in 3 intermediate
-                    v2_val_aa += v2_gamma_aa_gamma_ab[P] * gamma_abk[P];
-                    v2_val_ab += v2_gamma_ab_gamma_ab[P] * gamma_abk[P];
+                        // Define Γk[τχ=αβ] terms in 3 intermediate
+                        v2_val_aa += v2_gamma_aa_gamma_ab[P] * gamma_abk[P];
+                        v2_val_ab += v2_gamma_ab_gamma_ab[P] * gamma_abk[P];
 
-                    // Define Γk[τχ=ββ] terms in 3 intermediate
-                    v2_val_aa += v2_gamma_aa_gamma_bb[P] * gamma_bbk[P];
-                    v2_val_ab += v2_gamma_ab_gamma_bb[P] * gamma_bbk[P];
+                        // Define Γk[τχ=ββ] terms in 3 intermediate
+                        v2_val_aa += v2_gamma_aa_gamma_bb[P] * gamma_bbk[P];
+                        v2_val_ab += v2_gamma_ab_gamma_bb[P] * gamma_bbk[P];
 
-                    // Compute W terms, first 1 and then 2a and 3 at once
+                        // Compute W terms, first 1 and then 2a and 3 at once
        
-                    //                                         ∂
-                    // temp2 = einsum("p, pστ, xpτ -> xpσ", w, -- f, ∇ρk)[σ = α]
-                    //                                         ∂Γ
-                    // temp2 += einsum("p, pσυ, xpυ -> xpσ", w, temp, ∇ρ)[σ = α]
-                    //   N.B. A prefactor of 2 on the same-spin terms accounts for using γ rather than Γ in defining temp.
-                    // Ta += einsum("xpσ, xpm -> pmσ", temp2, ∇φ)[σ = α]
-
-                    // Wx
-                    tmp_val = 2.0 * v_gamma_aa[P] * rho_ak_x[P];
-                    tmp_val += v_gamma_ab[P] * rho_bk_x[P];
-                    tmp_val += 2.0 * v2_val_aa * rho_ax[P];
-                    tmp_val += v2_val_ab * rho_bx[P];
-                    tmp_val *= w[P];
-
-                    C_DAXPY(nlocal, tmp_val, phi_x[P], 1, Tap[P], 1);
-
-                    // Wy
-                    tmp_val = 2.0 * v_gamma_aa[P] * rho_ak_y[P];
-                    tmp_val += v_gamma_ab[P] * rho_bk_y[P];
-                    tmp_val += 2.0 * v2_val_aa * rho_ay[P];
-                    tmp_val += v2_val_ab * rho_by[P];
-                    tmp_val *= w[P];
-
-                    C_DAXPY(nlocal, tmp_val, phi_y[P], 1, Tap[P], 1);
-
-                    // Wz
-                    tmp_val = 2.0 * v_gamma_aa[P] * rho_ak_z[P];
-                    tmp_val += v_gamma_ab[P] * rho_bk_z[P];
-                    tmp_val += 2.0 * v2_val_aa * rho_az[P];
-                    tmp_val += v2_val_ab * rho_bz[P];
-                    tmp_val *= w[P];
-
-                    C_DAXPY(nlocal, tmp_val, phi_z[P], 1, Tap[P], 1);
-
-                    // Compute β block of final result.
+                        //                                         ∂
+                        // temp2 = einsum("p, pστ, xpτ -> xpσ", w, -- f, ∇ρk)[σ = α]
+                        //                                         ∂Γ
+                        // temp2 += einsum("p, pσυ, xpυ -> xpσ", w, temp, ∇ρ)[σ = α]
+                        //   N.B. A prefactor of 2 on the same-spin terms accounts for using γ rather than Γ in defining temp.
+                        // Ta += einsum("xpσ, xpm -> pmσ", temp2, ∇φ)[σ = α]
+
+                        // Wx
+                        tmp_val = 2.0 * v_gamma_aa[P] * rho_ak_x[P];
+                        tmp_val += v_gamma_ab[P] * rho_bk_x[P];
+                        tmp_val += 2.0 * v2_val_aa * rho_ax[P];
+                        tmp_val += v2_val_ab * rho_bx[P];
+                        tmp_val *= w[P];
+
+                        C_DAXPY(nlocal, tmp_val, phi_x[P], 1, Tp[P] + aoff, 1);
+
+                        // Wy
+                        tmp_val = 2.0 * v_gamma_aa[P] * rho_ak_y[P];
+                        tmp_val += v_gamma_ab[P] * rho_bk_y[P];
+                        tmp_val += 2.0 * v2_val_aa * rho_ay[P];
+                        tmp_val += v2_val_ab * rho_by[P];
+                        tmp_val *= w[P];
+
+                        C_DAXPY(nlocal, tmp_val, phi_y[P], 1, Tp[P] + aoff, 1);
+
+                        // Wz
+                        tmp_val = 2.0 * v_gamma_aa[P] * rho_ak_z[P];
+                        tmp_val += v_gamma_ab[P] * rho_bk_z[P];
+                        tmp_val += 2.0 * v2_val_aa * rho_az[P];
+                        tmp_val += v2_val_ab * rho_bz[P];
+                        tmp_val *= w[P];
+
+                        C_DAXPY(nlocal, tmp_val, phi_z[P], 1, Tp[P] + aoff, 1);
+
+                        // Compute β block of final result.
                     
-                    //                                  ∂^2
-                    // temp = einsum("pτσυ, pτ -> pσυ", ---- f, ρk)[συ = ββ, αβ]
-                    //                                  ∂ρ∂γ
+                        //                                  ∂^2
+                        // temp = einsum("pτσυ, pτ -> pσυ", ---- f, ρk)[συ = ββ, αβ]
+                        //                                  ∂ρ∂γ
 
-                    // Define ρk[τ=α] terms in 2a intermediate
-                    v2_val_bb = v2_rho_a_gamma_bb[P] * rho_ak[P];
-                    v2_val_ab = v2_rho_a_gamma_ab[P] * rho_ak[P];
+                        // Define ρk[τ=α] terms in 2a intermediate
+                        v2_val_bb = v2_rho_a_gamma_bb[P] * rho_ak[P];
+                        v2_val_ab = v2_rho_a_gamma_ab[P] * rho_ak[P];
 
-                    // Define ρk[τ=β] terms in 2a intermediate
-                    v2_val_bb += v2_rho_b_gamma_bb[P] * rho_bk[P];
-                    v2_val_ab += v2_rho_b_gamma_ab[P] * rho_bk[P];
+                        // Define ρk[τ=β] terms in 2a intermediate
+                        v2_val_bb += v2_rho_b_gamma_bb[P] * rho_bk[P];
+                        v2_val_ab += v2_rho_b_gamma_ab[P] * rho_bk[P];
 
-                    // Define Γk[τχ=ββ] terms in 3 intermediate
-                    v2_val_bb += v2_gamma_bb_gamma_bb[P] * gamma_bbk[P];
-                    v2_val_ab += v2_gamma_ab_gamma_bb[P] * gamma_bbk[P];
+                        // Define Γk[τχ=ββ] terms in 3 intermediate
+                        v2_val_bb += v2_gamma_bb_gamma_bb[P] * gamma_bbk[P];
+                        v2_val_ab += v2_gamma_ab_gamma_bb[P] * gamma_bbk[P];
 
-                    // Define Γk[τχ=αβ] terms in 3 intermediate
-                    v2_val_bb += v2_gamma_ab_gamma_bb[P] * gamma_abk[P];
-                    v2_val_ab += v2_gamma_ab_gamma_ab[P] * gamma_abk[P];
+                        // Define Γk[τχ=αβ] terms in 3 intermediate
+                        v2_val_bb += v2_gamma_ab_gamma_bb[P] * gamma_abk[P];
+                        v2_val_ab += v2_gamma_ab_gamma_ab[P] * gamma_abk[P];
 
-                    // Define Γk[τχ=αα] terms in 3 intermediate
-                    v2_val_bb += v2_gamma_aa_gamma_bb[P] * gamma_aak[P];
-                    v2_val_ab += v2_gamma_aa_gamma_ab[P] * gamma_aak[P];
+                        // Define Γk[τχ=αα] terms in 3 intermediate
+                        v2_val_bb += v2_gamma_aa_gamma_bb[P] * gamma_aak[P];
+                        v2_val_ab += v2_gamma_aa_gamma_ab[P] * gamma_aak[P];
 
-                    // Compute W terms, first 1 and then 2a and 3 at once
+                        // Compute W terms, first 1 and then 2a and 3 at once
        
-                    //                                         ∂
-                    // temp2 = einsum("p, pστ, xpτ -> xpσ", w, -- f, ∇ρk)[σ = β]
-                    //                                         ∂Γ
-                    // temp2 += einsum("p, pσυ, xpυ -> xpσ", w, temp, ∇ρ)[σ = β]
-                    //   N.B. That a prefactor of 2 on the same-spin terms accounts for using γ rather than Γ in defining temp.
-                    // Tb += einsum("xpσ, xpm -> pmσ", temp2, ∇φ)[σ = β]
-
-                    // Wx
-                    tmp_val = 2.0 * v_gamma_bb[P] * rho_bk_x[P];
-                    tmp_val += v_gamma_ab[P] * rho_ak_x[P];
-                    tmp_val += 2.0 * v2_val_bb * rho_bx[P];
-                    tmp_val += v2_val_ab * rho_ax[P];
-                    tmp_val *= w[P];
-
-                    C_DAXPY(nlocal, tmp_val, phi_x[P], 1, Tbp[P], 1);
-
-                    // Wy
-                    tmp_val = 2.0 * v_gamma_bb[P] * rho_bk_y[P];
-                    tmp_val += v_gamma_ab[P] * rho_ak_y[P];
-                    tmp_val += 2.0 * v2_val_bb * rho_by[P];
-                    tmp_val += v2_val_ab * rho_ay[P];
-                    tmp_val *= w[P];
-
-                    C_DAXPY(nlocal, tmp_val, phi_y[P], 1, Tbp[P], 1);
-
-                    // Wz
-                    tmp_val = 2.0 * v_gamma_bb[P] * rho_bk_z[P];
-                    tmp_val += v_gamma_ab[P] * rho_ak_z[P];
-                    tmp_val += 2.0 * v2_val_bb * rho_bz[P];
-                    tmp_val += v2_val_ab * rho_az[P];
-                    tmp_val *= w[P];
-
-                    C_DAXPY(nlocal, tmp_val, phi_z[P], 1, Tbp[P], 1);
-                }
-            }
-
-            // ===> Contract Ta and Tb aginst φ, replacing a point index with  an AO index <===
-            C_DGEMM('T', 'N', nlocal, nlocal, npoints, 1.0, phi[0], coll_funcs, Tap[0], max_functions, 0.0,
-                    Vax_localp[0], max_functions);
-            C_DGEMM('T', 'N', nlocal, nlocal, npoints, 1.0, phi[0], coll_funcs, Tbp[0], max_functions, 0.0,
-                    Vbx_localp[0], max_functions);
-
-            // ===> Add the adjoint to complete the LDA and GGA contributions  <===
-            for (int m = 0; m < nlocal; m++) {
-                for (int n = 0; n <= m; n++) {
-                    Vax_localp[m][n] = Vax_localp[n][m] = Vax_localp[m][n] + Vax_localp[n][m];
-                    Vbx_localp[m][n] = Vbx_localp[n][m] = Vbx_localp[m][n] + Vbx_localp[n][m];
+                        //                                         ∂
+                        // temp2 = einsum("p, pστ, xpτ -> xpσ", w, -- f, ∇ρk)[σ = β]
+                        //                                         ∂Γ
+                        // temp2 += einsum("p, pσυ, xpυ -> xpσ", w, temp, ∇ρ)[σ = β]
+                        //   N.B. That a prefactor of 2 on the same-spin terms accounts for using γ rather than Γ in defining temp.
+                        // Tb += einsum("xpσ, xpm -> pmσ", temp2, ∇φ)[σ = β]
+
+                        // Wx
+                        tmp_val = 2.0 * v_gamma_bb[P] * rho_bk_x[P];
+                        tmp_val += v_gamma_ab[P] * rho_ak_x[P];
+                        tmp_val += 2.0 * v2_val_bb * rho_bx[P];
+                        tmp_val += v2_val_ab * rho_ax[P];
+                        tmp_val *= w[P];
+
+                        C_DAXPY(nlocal, tmp_val, phi_x[P], 1, Tp[P] + boff, 1);
+
+                        // Wy
+                        tmp_val = 2.0 * v_gamma_bb[P] * rho_bk_y[P];
+                        tmp_val += v_gamma_ab[P] * rho_ak_y[P];
+                        tmp_val += 2.0 * v2_val_bb * rho_by[P];
+                        tmp_val += v2_val_ab * rho_ay[P];
+                        tmp_val *= w[P];
+
+                        C_DAXPY(nlocal, tmp_val, phi_y[P], 1, Tp[P] + boff, 1);
+
+                        // Wz
+                        tmp_val = 2.0 * v_gamma_bb[P] * rho_bk_z[P];
+                        tmp_val += v_gamma_ab[P] * rho_ak_z[P];
+                        tmp_val += 2.0 * v2_val_bb * rho_bz[P];
+                        tmp_val += v2_val_ab * rho_az[P];
+                        tmp_val *= w[P];
+
+                        C_DAXPY(nlocal, tmp_val, phi_z[P], 1, Tp[P] + boff, 1);
+                    }
                 }
             }
 
-            // => Unpacking <= //
-            auto Vaxp = Vax_AO[dindex]->pointer();
-            auto Vbxp = Vbx_AO[dindex]->pointer();
-            for (int ml = 0; ml < nlocal; ml++) {
-                int mg = function_map[ml];
-                for (int nl = 0; nl < ml; nl++) {
-                    int ng = function_map[nl];
+            // ===> Contract Ta and Tb against φ for the whole batch, replacing a point index with an AO index <===
+            C_DGEMM('T', 'N', nlocal, ncol, npoints, 1.0, phi[0], coll_funcs, Tp[0], ld_batch, 0.0, Vx_localp[0],
+                    ld_batch);
 
-#pragma omp atomic update
-                    Vaxp[mg][ng] += Vax_localp[ml][nl];
-#pragma omp atomic update
-                    Vaxp[ng][mg] += Vax_localp[ml][nl];
+            for (size_t k = 0; k < 2 * nb; k++) {
+                for (int m = 0; m < nlocal; m++) {
+                    Vx_rows[m] = Vx_localp[m] + k * nlocal;
+                }
 
-#pragma omp atomic update
-                    Vbxp[mg][ng] += Vbx_localp[ml][nl];
-#pragma omp atomic update
-                    Vbxp[ng][mg] += Vbx_localp[ml][nl];
+                // ===> Add the adjoint to complete the LDA and GGA contributions  <===
+                for (int m = 0; m < nlocal; m++) {
+                    for (int n = 0; n <= m; n++) {
+                        Vx_rows[m][n] = Vx_rows[n][m] = Vx_rows[m][n] + Vx_rows[n][m];
+                    }
                 }
-#pragma omp atomic update
-                Vaxp[mg][mg] += Vax_localp[ml][ml];
-#pragma omp atomic update
-                Vbxp[mg][mg] += Vbx_localp[ml][ml];
+
+                // => Unpacking <= //
+                accumulator.add(rank, 2 * pstart + k, function_map, Vx_rows.data());
             }
-            parallel_timer_off("V_XCd", rank);
+            thread_timer_off(v_timers().v_xcd);
         }
     }
+    accumulator.reduce();
 
     // Set the result
     for (size_t i = 0; i < (Dx.size() / 2); i++) {
@@ -3823,26 +3877,26 @@ SharedMatrix UV::compute_gradient() {
         auto nlocal = function_map.size();
 
         // ==> Compute rho, gamma, etc. for block <== //
-        parallel_timer_on("Properties", rank);
-        pworker->compute_points(block);
-        parallel_timer_off("Properties", rank);
+        thread_timer_on(v_timers().properties);
+        pworker->compute_points(block, false);
+        thread_timer_off(v_timers().properties);
 
         // ==> Compute functional values for block <== //
-        parallel_timer_on("Functional", rank);
-        std::map<std::string, SharedVector>& vals = fworker->compute_functional(pworker->point_values(), npoints);
-        parallel_timer_off("Functional", rank);
+        thread_timer_on(v_timers().functional);
+        const auto& vals = fworker->compute_functional(pworker->xc_point_values(), npoints);
+        thread_timer_off(v_timers().functional);
 
         // ==> Setup accessors to computed values, and associated variables <== //
-        parallel_timer_on("V_xc gradient", rank);
+        thread_timer_on(v_timers().v_xc_gradient);
         auto phi = pworker->basis_value("PHI")->pointer();
         auto phi_x = pworker->basis_value("PHI_X")->pointer();
         auto phi_y = pworker->basis_value("PHI_Y")->pointer();
         auto phi_z = pworker->basis_value("PHI_Z")->pointer();
-        auto rho_a = pworker->point_value("RHO_A")->pointer();
-        auto rho_b = pworker->point_value("RHO_B")->pointer();
-        auto zk = vals["V"]->pointer();
-        auto v_rho_a = vals["V_RHO_A"]->pointer();
-        auto v_rho_b = vals["V_RHO_B"]->pointer();
+        auto rho_a = pworker->xc_point_value(XCValue::RHO_A);
+        auto rho_b = pworker->xc_point_value(XCValue::RHO_B);
+        auto zk = vals[XCValue::V];
+        auto v_rho_a = vals[XCValue::V_RHO_A];
+        auto v_rho_b = vals[XCValue::V_RHO_B];
         size_t coll_funcs = pworker->basis_value("PHI")->ncol();
 
         // ==> Compute quadrature values <== //
@@ -3876,15 +3930,15 @@ SharedMatrix UV::compute_gradient() {
 
         // ===> GGA Contribution (Term 1) <=== //
         if (fworker->is_gga()) {
-            auto rho_ax = pworker->point_value("RHO_AX")->pointer();
-            auto rho_ay = pworker->point_value("RHO_AY")->pointer();
-            auto rho_az = pworker->point_value("RHO_AZ")->pointer();
-            auto rho_bx = pworker->point_value("RHO_BX")->pointer();
-            auto rho_by = pworker->point_value("RHO_BY")->pointer();
-            auto rho_bz = pworker->point_value("RHO_BZ")->pointer();
-            auto v_gamma_aa = vals["V_GAMMA_AA"]->pointer();
-            auto v_gamma_ab = vals["V_GAMMA_AB"]->pointer();
-            auto v_gamma_bb = vals["V_GAMMA_BB"]->pointer();
+            auto rho_ax = pworker->xc_point_value(XCValue::RHO_AX);
+            auto rho_ay = pworker->xc_point_value(XCValue::RHO_AY);
+            auto rho_az = pworker->xc_point_value(XCValue::RHO_AZ);
+            auto rho_bx = pworker->xc_point_value(XCValue::RHO_BX);
+            auto rho_by = pworker->xc_point_value(XCValue::RHO_BY);
+            auto rho_bz = pworker->xc_point_value(XCValue::RHO_BZ);
+            auto v_gamma_aa = vals[XCValue::V_GAMMA_AA];
+            auto v_gamma_ab = vals[XCValue::V_GAMMA_AB];
+            auto v_gamma_bb = vals[XCValue::V_GAMMA_BB];
 
             for (int P = 0; P < npoints; P++) {
                 C_DAXPY(nlocal, -2.0 * w[P] * (2.0 * v_gamma_aa[P] * rho_ax[P] + v_gamma_ab[P] * rho_bx[P]), phi_x[P],
@@ -3930,15 +3984,15 @@ SharedMatrix UV::compute_gradient() {
             double** phi_yy = pworker->basis_value("PHI_YY")->pointer();
             double** phi_yz = pworker->basis_value("PHI_YZ")->pointer();
             double** phi_zz = pworker->basis_value("PHI_ZZ")->pointer();
-            double* rho_ax = pworker->point_value("RHO_AX")->pointer();
-            double* rho_ay = pworker->point_value("RHO_AY")->pointer();
-            double* rho_az = pworker->point_value("RHO_AZ")->pointer();
-            double* rho_bx = pworker->point_value("RHO_BX")->pointer();
-            double* rho_by = pworker->point_value("RHO_BY")->pointer();
-            double* rho_bz = pworker->point_value("RHO_BZ")->pointer();
-            double* v_gamma_aa = vals["V_GAMMA_AA"]->pointer();
-            double* v_gamma_ab = vals["V_GAMMA_AB"]->pointer();
-            double* v_gamma_bb = vals["V_GAMMA_BB"]->pointer();
+            double* rho_ax = pworker->xc_point_value(XCValue::RHO_AX);
+            double* rho_ay = pworker->xc_point_value(XCValue::RHO_AY);
+            double* rho_az = pworker->xc_point_value(XCValue::RHO_AZ);
+            double* rho_bx = pworker->xc_point_value(XCValue::RHO_BX);
+            double* rho_by = pworker->xc_point_value(XCValue::RHO_BY);
+            double* rho_bz = pworker->xc_point_value(XCValue::RHO_BZ);
+            double* v_gamma_aa = vals[XCValue::V_GAMMA_AA];
+            double* v_gamma_ab = vals[XCValue::V_GAMMA_AB];
+            double* v_gamma_bb = vals[XCValue::V_GAMMA_BB];
 
             C_DGEMM('N', 'N', npoints, nlocal, nlocal, 1.0, phi[0], coll_funcs, Dap[0], max_functions, 0.0, Uap[0],
                     max_functions);
@@ -4011,8 +4065,8 @@ SharedMatrix UV::compute_gradient() {
             double** phi_yy = pworker->basis_value("PHI_YY")->pointer();
             double** phi_yz = pworker->basis_value("PHI_YZ")->pointer();
             double** phi_zz = pworker->basis_value("PHI_ZZ")->pointer();
-            double* v_tau_a = vals["V_TAU_A"]->pointer();
-            double* v_tau_b = vals["V_TAU_B"]->pointer();
+            double* v_tau_a = vals[XCValue::V_TAU_A];
+            double* v_tau_b = vals[XCValue::V_TAU_B];
 
             double** phi_i[3];
             phi_i[0] = phi_x;
@@ -4059,7 +4113,7 @@ SharedMatrix UV::compute_gradient() {
         }
         Ua_local.reset();
         Ub_local.reset();
-        parallel_timer_off("V_xc gradient", rank);
+        thread_timer_off(v_timers().v_xc_gradient);
     }
     // timer_off("V: V_XC");
 
@@ -4215,8 +4269,8 @@ SharedMatrix UV::compute_hessian() {
         int nlocal = function_map.size();
 
         // ==> Compute values at points <==
-        pworker->compute_points(block);
-        auto& vals = fworker->compute_functional(pworker->point_values(), npoints);
+        pworker->compute_points(block, false);
+        const auto& vals = fworker->compute_functional(pworker->xc_point_values(), npoints);
 
         auto phi = pworker->basis_value("PHI")->pointer();
         auto phi_x = pworker->basis_value("PHI_X")->pointer();
@@ -4228,13 +4282,13 @@ SharedMatrix UV::compute_hessian() {
         auto phi_yy = pworker->basis_value("PHI_YY")->pointer();
         auto phi_yz = pworker->basis_value("PHI_YZ")->pointer();
         auto phi_zz = pworker->basis_value("PHI_ZZ")->pointer();
-        auto rho_a = pworker->point_value("RHO_A")->pointer();
-        auto rho_b = pworker->point_value("RHO_B")->pointer();
-        auto v_rho_a = vals["V_RHO_A"]->pointer();
-        auto v_rho_b = vals["V_RHO_B"]->pointer();
-        auto v_rho_aa = vals["V_RHO_A_RHO_A"]->pointer();
-        auto v_rho_ab = vals["V_RHO_A_RHO_B"]->pointer();
-        auto v_rho_bb = vals["V_RHO_B_RHO_B"]->pointer();
+        auto rho_a = pworker->xc_point_value(XCValue::RHO_A);
+        auto rho_b = pworker->xc_point_value(XCValue::RHO_B);
+        auto v_rho_a = vals[XCValue::V_RHO_A];
+        auto v_rho_b = vals[XCValue::V_RHO_B];
+        auto v_rho_aa = vals[XCValue::V_RHO_A_RHO_A];
+        auto v_rho_ab = vals[XCValue::V_RHO_A_RHO_B];
+        auto v_rho_bb = vals[XCValue::V_RHO_B_RHO_B];
         size_t coll_funcs = pworker->basis_value("PHI")->ncol();
 
         // ==> LSDA Contribution <== //
@@ -30,6 +30,7 @@
 #define LIBFOCK_DFT_H
 #include "psi4/libmints/typedefs.h"
 #include "psi4/pragma.h"
+#include <algorithm>
 #include <vector>
 #include <map>
 #include <unordered_map>
@@ -37,10 +38,13 @@
 
 namespace psi {
 class BasisSet;
+class CollocationCache;
 class Options;
 class DFTGrid;
 class PointFunctions;
+class SAPTable;
 class SuperFunctional;
+struct VV10Cache;
 class BlockOPoints;
 
 // => BASE CLASS <= //
@@ -66,6 +70,14 @@ class PSI_API VBase {
     double v2_rho_cutoff_;
     /// VV10 interior kernel threshold
     double vv10_rho_cutoff_;
+    /// VV10 block-pair energy screening threshold
+    double vv10_screening_;
+    /// Memory for thread-private V accumulation buffers [doubles]
+    size_t v_buffer_memory_;
+    /// Memory for the stacked per-thread intermediates of batched Vx builds [doubles]
+    size_t vx_batch_memory_;
+    /// Threshold on collocation times density below which V builds drop a function from a block, 0 disables
+    double function_screening_;
     /// Options object, used to build grid
     Options& options_;
     /// Basis set used in the integration
@@ -80,9 +92,8 @@ class PSI_API VBase {
     std::shared_ptr<DFTGrid> grid_;
     /// Quadrature values obtained during integration
     std::map<std::string, double> quad_values_;
-    // Caches collocation grids
-    std::unordered_map<size_t, std::map<std::string, SharedMatrix>> cache_map_;
-    int cache_map_deriv_;
+    /// Cached collocation, shared by the point workers of every integration
+    std::shared_ptr<CollocationCache> collocation_cache_;
 
     /// AO2USO matrix (if not C1)
     SharedMatrix AO2USO_;
@@ -95,14 +106,41 @@ class PSI_API VBase {
     bool grac_initialized_;
 
     // VV10 dispersion, return vv10_nlc energy
-    void prepare_vv10_cache(DFTGrid& nlgrid, SharedMatrix D,
-                            std::vector<std::map<std::string, SharedVector>>& vv10_cache,
+    void prepare_vv10_cache(DFTGrid& nlgrid, SharedMatrix D, VV10Cache& vv10_cache,
                             std::vector<std::shared_ptr<PointFunctions>>& nl_point_workers, int ansatz = 1);
     double vv10_nlc(SharedMatrix D, SharedMatrix ret);
     SharedMatrix vv10_nlc_gradient(SharedMatrix D);
 
     /// Set things up
     void common_init();
+    /// Number of right-hand sides a Vx build contracts together, given the per-thread doubles each needs
+    size_t vx_batch_size(size_t nrhs, size_t rhs_memory) const;
+
+    /// Per-thread sparsity of the blocks integrated with function screening
+    struct FunctionScreeningStats {
+        size_t nblocks = 0;
+        size_t nlocal = 0;
+        size_t ndensity = 0;
+        size_t nkept = 0;
+        size_t nscreened_blocks = 0;
+        double min_fraction = 1.0;
+        /// Counts a block with local functions, density of which entered the density and kept the potential
+        void add(size_t local, size_t density, size_t kept) {
+            nblocks++;
+            nlocal += local;
+            ndensity += density;
+            nkept += kept;
+            if (density < local || kept < local) nscreened_blocks++;
+            if (local) min_fraction = std::min(min_fraction, (double)kept / local);
+        }
+    };
+    /// Block sparsity summed over threads by the last V build
+    FunctionScreeningStats function_screening_stats_;
+    /// Sum the per-thread block sparsity of a V build and print it, if function screening was used
+    void print_function_screening(const std::vector<FunctionScreeningStats>& stats);
+    /// Block pairs of the last VV10 kernel, and how many of them screening skipped
+    size_t vv10_pairs_ = 0;
+    size_t vv10_skipped_pairs_ = 0;
 
    public:
     VBase(std::shared_ptr<SuperFunctional> functional, std::shared_ptr<BasisSet> primary, Options& options);
@@ -120,9 +158,24 @@ class PSI_API VBase {
     size_t nblocks();
     std::map<std::string, double>& quadrature_values() { return quad_values_; }
 
-    // Creates a collocation cache map based on stride
-    void build_collocation_cache(size_t memory);
-    void clear_collocation_cache() { cache_map_.clear(); }
+    /// Caches the collocation of the most expensive grid blocks that fit in memory doubles, with
+    /// derivatives up to deriv, or up to what compute_V needs if deriv is -1
+    void build_collocation_cache(size_t memory, int deriv = -1);
+    void clear_collocation_cache();
+    std::shared_ptr<CollocationCache> collocation_cache() const { return collocation_cache_; }
+    /// Blocks and basis functions integrated by the last V build, and how many of them function screening kept
+    /// in the density and in the potential
+    std::map<std::string, size_t> function_screening_statistics() const {
+        return {{"blocks", function_screening_stats_.nblocks},
+                {"screened blocks", function_screening_stats_.nscreened_blocks},
+                {"local functions", function_screening_stats_.nlocal},
+                {"density functions", function_screening_stats_.ndensity},
+                {"kept functions", function_screening_stats_.nkept}};
+    }
+    /// Block pairs integrated by the last VV10 kernel, and how many of them screening skipped
+    std::map<std::string, size_t> vv10_screening_statistics() const {
+        return {{"block pairs", vv10_pairs_}, {"skipped block pairs", vv10_skipped_pairs_}};
+    }
 
     // Set the D matrix, get it back if needed
     void set_D(std::vector<SharedMatrix> Dvec);
@@ -152,6 +205,9 @@ class PSI_API VBase {
 // => Derived Classes <= //
 class SAP : public VBase {
    protected:
+    /// Interpolation tables of the effective charges, built by initialize
+    std::shared_ptr<SAPTable> sap_table_;
+
    public:
     SAP(std::shared_ptr<SuperFunctional> functional, std::shared_ptr<BasisSet> primary, Options& options);
     ~SAP() override;
@@ -0,0 +1,135 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2025 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+#include "v_accumulator.h"
+
+#include "psi4/libmints/matrix.h"
+#include "psi4/libpsi4util/exception.h"
+
+#include <algorithm>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace psi {
+
+VAccumulator::VAccumulator(std::vector<SharedMatrix> targets, size_t nthread, size_t max_memory)
+    : targets_(targets), nthread_(nthread), nbf_(0), ntri_(0), nbuffer_(0) {
+    if (targets_.empty()) return;
+    nbf_ = targets_[0]->rowspi()[0];
+    for (const auto& target : targets_) {
+        if (target->nirrep() != 1 || target->rowspi()[0] != nbf_ || target->colspi()[0] != nbf_) {
+            throw PSIEXCEPTION("VAccumulator: targets must be nbf x nbf C1 matrices.");
+        }
+    }
+    ntri_ = nbf_ * (nbf_ + 1) / 2;
+
+    // A single buffer would serialize on atomics just like the targets, so it is not worth the memory
+    const size_t buffer_size = ntri_ * targets_.size();
+    nbuffer_ = std::min(nthread_, buffer_size ? max_memory / buffer_size : 0);
+    if (nbuffer_ < 2) nbuffer_ = 0;
+
+    buffers_.resize(nbuffer_);
+    for (size_t b = 0; b < nbuffer_; b++) {
+        buffers_[b] = std::unique_ptr<double[]>(new double[buffer_size]);
+    }
+
+// Zero each buffer on the thread that fills it, so its pages land on that thread's NUMA node
+#pragma omp parallel num_threads(nthread_)
+    {
+        size_t rank = 0;
+#ifdef _OPENMP
+        rank = omp_get_thread_num();
+#endif
+        if (rank < nbuffer_) std::fill(buffers_[rank].get(), buffers_[rank].get() + buffer_size, 0.0);
+    }
+}
+
+void VAccumulator::add(size_t rank, size_t index, const std::vector<int>& function_map, double** V2p) {
+    const int nlocal = function_map.size();
+
+    if (nbuffer_ == 0) {
+        double** Vp = targets_[index]->pointer();
+        for (int ml = 0; ml < nlocal; ml++) {
+            int mg = function_map[ml];
+            for (int nl = 0; nl < ml; nl++) {
+                int ng = function_map[nl];
+#pragma omp atomic update
+                Vp[mg][ng] += V2p[ml][nl];
+#pragma omp atomic update
+                Vp[ng][mg] += V2p[ml][nl];
+            }
+#pragma omp atomic update
+            Vp[mg][mg] += V2p[ml][ml];
+        }
+        return;
+    }
+
+    double* Bp = buffers_[rank % nbuffer_].get() + index * ntri_;
+    const bool shared = nbuffer_ < nthread_;
+    for (int ml = 0; ml < nlocal; ml++) {
+        const size_t mg = function_map[ml];
+        for (int nl = 0; nl <= ml; nl++) {
+            const size_t ng = function_map[nl];
+            const size_t pq = (mg >= ng) ? mg * (mg + 1) / 2 + ng : ng * (ng + 1) / 2 + mg;
+            if (shared) {
+#pragma omp atomic update
+                Bp[pq] += V2p[ml][nl];
+            } else {
+                Bp[pq] += V2p[ml][nl];
+            }
+        }
+    }
+}
+
+void VAccumulator::reduce() {
+    if (nbuffer_ == 0) return;
+
+    for (size_t index = 0; index < targets_.size(); index++) {
+        double** Vp = targets_[index]->pointer();
+        const size_t offset = index * ntri_;
+
+// Rows are independent: row m owns V[m][0..m] and V[0..m-1][m]
+#pragma omp parallel for schedule(dynamic) num_threads(nthread_)
+        for (size_t m = 0; m < nbf_; m++) {
+            const size_t row = offset + m * (m + 1) / 2;
+            for (size_t n = 0; n <= m; n++) {
+                double sum = 0.0;
+                for (size_t b = 0; b < nbuffer_; b++) {
+                    sum += buffers_[b][row + n];
+                    buffers_[b][row + n] = 0.0;
+                }
+                Vp[m][n] += sum;
+                if (n != m) Vp[n][m] += sum;
+            }
+        }
+    }
+}
+
+}  // namespace psi
@@ -0,0 +1,95 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2025 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+#ifndef libfock_v_accumulator_h
+#define libfock_v_accumulator_h
+
+#include "psi4/libmints/typedefs.h"
+#include "psi4/pragma.h"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace psi {
+
+/**
+ * Class VAccumulator
+ *
+ * Scatters the symmetric, block-local V matrices of a DFT integration
+ * into full AO matrices. Each thread adds into its own packed lower
+ * triangle of every target, and reduce() sums the buffers into the
+ * targets in parallel over rows, so blocks are scattered without
+ * atomics.
+ *
+ * The buffers are limited to max_memory doubles. If fewer buffers than
+ * threads fit, threads share them and add with atomics; if none fit,
+ * threads add straight into the targets with atomics, as before.
+ */
+class PSI_API VAccumulator {
+   protected:
+    /// Full AO matrices the blocks are scattered into
+    std::vector<SharedMatrix> targets_;
+    /// Number of threads that add blocks
+    size_t nthread_;
+    /// Number of basis functions
+    size_t nbf_;
+    /// Length of one packed lower triangle
+    size_t ntri_;
+    /// Number of buffers; thread t uses buffer t % nbuffer_
+    size_t nbuffer_;
+    /// Buffers, each holding a packed lower triangle per target
+    std::vector<std::unique_ptr<double[]>> buffers_;
+
+   public:
+    /**
+     * @param targets nbf x nbf C1 matrices, added to (not overwritten) by reduce()
+     * @param nthread number of threads that call add()
+     * @param max_memory maximum size of the thread buffers, in doubles
+     */
+    VAccumulator(std::vector<SharedMatrix> targets, size_t nthread, size_t max_memory);
+
+    /**
+     * Add the lower triangle of a symmetric block-local matrix to a target
+     * @param rank the OpenMP thread number of the caller
+     * @param index which target
+     * @param function_map block-local to global basis function indices
+     * @param V2p the block-local matrix, only its lower triangle is read
+     */
+    void add(size_t rank, size_t index, const std::vector<int>& function_map, double** V2p);
+
+    /// Sum the buffers into the targets and zero them. Call outside of parallel regions.
+    void reduce();
+
+    /// Number of thread buffers, zero if all threads add with atomics
+    size_t nbuffer() const { return nbuffer_; }
+};
+
+}  // namespace psi
+
+#endif
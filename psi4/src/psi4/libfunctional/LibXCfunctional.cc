@@ -368,8 +368,7 @@ std::vector<std::tuple<std::string, int, double>> LibXCFunctional::get_mix_data(
     }
     return ret;
 }
-void LibXCFunctional::compute_functional(const std::map<std::string, SharedVector>& in,
-                                         const std::map<std::string, SharedVector>& out, int npoints, int deriv) {
+void LibXCFunctional::compute_functional(const XCValues& in, const XCValues& out, int npoints, int deriv) {
     // Uncomment below to enable the parallel_timer calls (which must individually be uncommented).
     /*
             int rank = 0;
@@ -392,6 +391,20 @@ void LibXCFunctional::compute_functional(const std::map<std::string, SharedVecto
         throw PSIEXCEPTION("LibXCfunctional: Third derivatives are not implemented!");
     }
 
+    // => Scratch <= //
+
+    // LibXC's interleaved inputs and outputs, carved from a buffer that only grows. Zeroed so unused
+    // inputs such as the laplacian read as zero, as they did when these were freshly allocated.
+    const size_t scratch_size = (unpolarized_ ? 10 : 34) * static_cast<size_t>(npoints);
+    if (scratch_.size() < scratch_size) scratch_.resize(scratch_size);
+    std::fill(scratch_.begin(), scratch_.begin() + scratch_size, 0.0);
+    double* scratch_next = scratch_.data();
+    auto take = [&scratch_next](size_t n) {
+        double* block = scratch_next;
+        scratch_next += n;
+        return block;
+    };
+
     // => Input variables <= //
 
     double* rho_ap = nullptr;
@@ -405,25 +418,25 @@ void LibXCFunctional::compute_functional(const std::map<std::string, SharedVecto
     double* lapl_bp = nullptr;
 
     if (true) {
-        rho_ap = in.find("RHO_A")->second->pointer();
+        rho_ap = in[XCValue::RHO_A];
 
         if (!unpolarized_) {
-            rho_bp = in.find("RHO_B")->second->pointer();
+            rho_bp = in[XCValue::RHO_B];
         }
     }
     if (gga_) {
-        gamma_aap = in.find("GAMMA_AA")->second->pointer();
+        gamma_aap = in[XCValue::GAMMA_AA];
         if (!unpolarized_) {
-            gamma_abp = in.find("GAMMA_AB")->second->pointer();
-            gamma_bbp = in.find("GAMMA_BB")->second->pointer();
+            gamma_abp = in[XCValue::GAMMA_AB];
+            gamma_bbp = in[XCValue::GAMMA_BB];
         }
     }
     if (meta_) {
-        tau_ap = in.find("TAU_A")->second->pointer();
-        // lapl_ap = in.find("LAPL_RHO_A")->second->pointer();
+        tau_ap = in[XCValue::TAU_A];
+        // lapl_ap = in[XCValue::LAPL_RHO_A];
         if (!unpolarized_) {
-            tau_bp = in.find("TAU_B")->second->pointer();
-            // lapl_bp = in.find("LAPL_RHO_B")->second->pointer();
+            tau_bp = in[XCValue::TAU_B];
+            // lapl_bp = in[XCValue::LAPL_RHO_B];
         }
     }
 
@@ -473,88 +486,88 @@ void LibXCFunctional::compute_functional(const std::map<std::string, SharedVecto
     if (deriv >= 0) {
         // Energy doesnt make sense for all functionals
         if (exc_) {
-            v = out.find("V")->second->pointer();
+            v = out[XCValue::V];
         }
     }
     if (deriv >= 1) {
         if (true) {
-            v_rho_a = out.find("V_RHO_A")->second->pointer();
+            v_rho_a = out[XCValue::V_RHO_A];
             if (!unpolarized_) {
-                v_rho_b = out.find("V_RHO_B")->second->pointer();
+                v_rho_b = out[XCValue::V_RHO_B];
             }
         }
         if (gga_) {
-            v_gamma_aa = out.find("V_GAMMA_AA")->second->pointer();
+            v_gamma_aa = out[XCValue::V_GAMMA_AA];
             if (!unpolarized_) {
-                v_gamma_ab = out.find("V_GAMMA_AB")->second->pointer();
-                v_gamma_bb = out.find("V_GAMMA_BB")->second->pointer();
+                v_gamma_ab = out[XCValue::V_GAMMA_AB];
+                v_gamma_bb = out[XCValue::V_GAMMA_BB];
             }
         }
         if (meta_) {
-            v_tau_a = out.find("V_TAU_A")->second->pointer();
+            v_tau_a = out[XCValue::V_TAU_A];
             if (!unpolarized_) {
-                v_tau_b = out.find("V_TAU_B")->second->pointer();
+                v_tau_b = out[XCValue::V_TAU_B];
             }
-            // v_lapl_a = out.find("V_LAPL_A")->second->pointer();
-            // v_lapl_b = out.find("V_LAPL_B")->second->pointer();
+            // v_lapl_a = out[XCValue::V_LAPL_A];
+            // v_lapl_b = out[XCValue::V_LAPL_B];
         }
     }
     if (deriv >= 2) {
         if (true) {
-            v_rho_a_rho_a = out.find("V_RHO_A_RHO_A")->second->pointer();
+            v_rho_a_rho_a = out[XCValue::V_RHO_A_RHO_A];
 
             if (!unpolarized_) {
-                v_rho_a_rho_b = out.find("V_RHO_A_RHO_B")->second->pointer();
-                v_rho_b_rho_b = out.find("V_RHO_B_RHO_B")->second->pointer();
+                v_rho_a_rho_b = out[XCValue::V_RHO_A_RHO_B];
+                v_rho_b_rho_b = out[XCValue::V_RHO_B_RHO_B];
             }
         }
         if (gga_) {
-            v_gamma_aa_gamma_aa = out.find("V_GAMMA_AA_GAMMA_AA")->second->pointer();
+            v_gamma_aa_gamma_aa = out[XCValue::V_GAMMA_AA_GAMMA_AA];
 
             if (!unpolarized_) {
-                v_gamma_aa_gamma_ab = out.find("V_GAMMA_AA_GAMMA_AB")->second->pointer();
-                v_gamma_aa_gamma_bb = out.find("V_GAMMA_AA_GAMMA_BB")->second->pointer();
-                v_gamma_ab_gamma_ab = out.find("V_GAMMA_AB_GAMMA_AB")->second->pointer();
-                v_gamma_ab_gamma_bb = out.find("V_GAMMA_AB_GAMMA_BB")->second->pointer();
-                v_gamma_bb_gamma_bb = out.find("V_GAMMA_BB_GAMMA_BB")->second->pointer();
+                v_gamma_aa_gamma_ab = out[XCValue::V_GAMMA_AA_GAMMA_AB];
+                v_gamma_aa_gamma_bb = out[XCValue::V_GAMMA_AA_GAMMA_BB];
+                v_gamma_ab_gamma_ab = out[XCValue::V_GAMMA_AB_GAMMA_AB];
+                v_gamma_ab_gamma_bb = out[XCValue::V_GAMMA_AB_GAMMA_BB];
+                v_gamma_bb_gamma_bb = out[XCValue::V_GAMMA_BB_GAMMA_BB];
             }
         }
         if (meta_) {
-            v_tau_a_tau_a = out.find("V_TAU_A_TAU_A")->second->pointer();
+            v_tau_a_tau_a = out[XCValue::V_TAU_A_TAU_A];
 
             if (!unpolarized_) {
-                v_tau_a_tau_b = out.find("V_TAU_A_TAU_B")->second->pointer();
-                v_tau_b_tau_b = out.find("V_TAU_B_TAU_B")->second->pointer();
+                v_tau_a_tau_b = out[XCValue::V_TAU_A_TAU_B];
+                v_tau_b_tau_b = out[XCValue::V_TAU_B_TAU_B];
             }
         }
         if (gga_) {
-            v_rho_a_gamma_aa = out.find("V_RHO_A_GAMMA_AA")->second->pointer();
+            v_rho_a_gamma_aa = out[XCValue::V_RHO_A_GAMMA_AA];
 
             if (!unpolarized_) {
-                v_rho_a_gamma_ab = out.find("V_RHO_A_GAMMA_AB")->second->pointer();
-                v_rho_a_gamma_bb = out.find("V_RHO_A_GAMMA_BB")->second->pointer();
-                v_rho_b_gamma_aa = out.find("V_RHO_B_GAMMA_AA")->second->pointer();
-                v_rho_b_gamma_ab = out.find("V_RHO_B_GAMMA_AB")->second->pointer();
-                v_rho_b_gamma_bb = out.find("V_RHO_B_GAMMA_BB")->second->pointer();
+                v_rho_a_gamma_ab = out[XCValue::V_RHO_A_GAMMA_AB];
+                v_rho_a_gamma_bb = out[XCValue::V_RHO_A_GAMMA_BB];
+                v_rho_b_gamma_aa = out[XCValue::V_RHO_B_GAMMA_AA];
+                v_rho_b_gamma_ab = out[XCValue::V_RHO_B_GAMMA_AB];
+                v_rho_b_gamma_bb = out[XCValue::V_RHO_B_GAMMA_BB];
             }
         }
         if (meta_) {
-            v_rho_a_tau_a = out.find("V_RHO_A_TAU_A")->second->pointer();
+            v_rho_a_tau_a = out[XCValue::V_RHO_A_TAU_A];
 
             if (!unpolarized_) {
-                v_rho_a_tau_b = out.find("V_RHO_A_TAU_B")->second->pointer();
-                v_rho_b_tau_a = out.find("V_RHO_B_TAU_A")->second->pointer();
-                v_rho_b_tau_b = out.find("V_RHO_B_TAU_B")->second->pointer();
+                v_rho_a_tau_b = out[XCValue::V_RHO_A_TAU_B];
+                v_rho_b_tau_a = out[XCValue::V_RHO_B_TAU_A];
+                v_rho_b_tau_b = out[XCValue::V_RHO_B_TAU_B];
             }
         }
         if (gga_ && meta_) {
-            v_gamma_aa_tau_a = out.find("V_GAMMA_AA_TAU_A")->second->pointer();
+            v_gamma_aa_tau_a = out[XCValue::V_GAMMA_AA_TAU_A];
             if (!unpolarized_) {
-                v_gamma_aa_tau_b = out.find("V_GAMMA_AA_TAU_B")->second->pointer();
-                v_gamma_ab_tau_a = out.find("V_GAMMA_AB_TAU_A")->second->pointer();
-                v_gamma_ab_tau_b = out.find("V_GAMMA_AB_TAU_B")->second->pointer();
-                v_gamma_bb_tau_a = out.find("V_GAMMA_BB_TAU_A")->second->pointer();
-                v_gamma_bb_tau_b = out.find("V_GAMMA_BB_TAU_B")->second->pointer();
+                v_gamma_aa_tau_b = out[XCValue::V_GAMMA_AA_TAU_B];
+                v_gamma_ab_tau_a = out[XCValue::V_GAMMA_AB_TAU_A];
+                v_gamma_ab_tau_b = out[XCValue::V_GAMMA_AB_TAU_B];
+                v_gamma_bb_tau_a = out[XCValue::V_GAMMA_BB_TAU_A];
+                v_gamma_bb_tau_b = out[XCValue::V_GAMMA_BB_TAU_B];
             }
         }
     }
@@ -567,38 +580,37 @@ void LibXCFunctional::compute_functional(const std::map<std::string, SharedVecto
         // Compute deriv
         if (deriv >= 1) {
             // Allocate
-            std::vector<double> fv(npoints);
-            std::vector<double> fv_rho(npoints);
+            double* fv = take(npoints);
+            double* fv_rho = take(npoints);
 
             // GGA
-            std::vector<double> fgamma, fv_gamma;
+            double* fv_gamma = nullptr;
             if (gga_) {
-                fgamma.resize(npoints);
-                fv_gamma.resize(npoints);
+                fv_gamma = take(npoints);
             }
 
             // Meta
-            std::vector<double> flapl, fv_lapl, fv_tau;
+            double *flapl = nullptr, *fv_lapl = nullptr, *fv_tau = nullptr;
             if (meta_) {
-                flapl.resize(npoints);
-                fv_lapl.resize(npoints);
-                fv_tau.resize(npoints);
+                flapl = take(npoints);
+                fv_lapl = take(npoints);
+                fv_tau = take(npoints);
             }
 
             double* fvp = nullptr;
             if (exc_) {
-                fvp = fv.data();
+                fvp = fv;
             }
 
             // Compute
             if (meta_) {
-                xc_mgga_exc_vxc(xc_functional_.get(), npoints, rho_ap, gamma_aap, flapl.data(), tau_ap, fvp,
-                                fv_rho.data(), fv_gamma.data(), fv_lapl.data(), fv_tau.data());
+                xc_mgga_exc_vxc(xc_functional_.get(), npoints, rho_ap, gamma_aap, flapl, tau_ap, fvp,
+                                fv_rho, fv_gamma, fv_lapl, fv_tau);
             } else if (gga_) {
-                xc_gga_exc_vxc(xc_functional_.get(), npoints, rho_ap, gamma_aap, fvp, fv_rho.data(), fv_gamma.data());
+                xc_gga_exc_vxc(xc_functional_.get(), npoints, rho_ap, gamma_aap, fvp, fv_rho, fv_gamma);
 
             } else {
-                xc_lda_exc_vxc(xc_functional_.get(), npoints, rho_ap, fvp, fv_rho.data());
+                xc_lda_exc_vxc(xc_functional_.get(), npoints, rho_ap, fvp, fv_rho);
             }
             // printf("%s | %lf %lf\n", xc_func_name_.c_str(), fv_rho[0], fv_gamma[0]);
 
@@ -609,14 +621,14 @@ void LibXCFunctional::compute_functional(const std::map<std::string, SharedVecto
                 }
             }
 
-            C_DAXPY(npoints, alpha_, fv_rho.data(), 1, v_rho_a, 1);
+            C_DAXPY(npoints, alpha_, fv_rho, 1, v_rho_a, 1);
 
             if (gga_) {
-                C_DAXPY(npoints, alpha_, fv_gamma.data(), 1, v_gamma_aa, 1);
+                C_DAXPY(npoints, alpha_, fv_gamma, 1, v_gamma_aa, 1);
             }
 
             if (meta_) {
-                C_DAXPY(npoints, 0.5 * alpha_, fv_tau.data(), 1, v_tau_a, 1);
+                C_DAXPY(npoints, 0.5 * alpha_, fv_tau, 1, v_tau_a, 1);
             }
 
             // Data validation.
@@ -664,23 +676,23 @@ void LibXCFunctional::compute_functional(const std::map<std::string, SharedVecto
                     "available");
 
             } else if (gga_) {
-                std::vector<double> fv2_rho2(npoints);
-                std::vector<double> fv2_rho_gamma(npoints);
-                std::vector<double> fv2_gamma2(npoints);
+                double* fv2_rho2 = take(npoints);
+                double* fv2_rho_gamma = take(npoints);
+                double* fv2_gamma2 = take(npoints);
 
-                xc_gga_fxc(xc_functional_.get(), npoints, rho_ap, gamma_aap, fv2_rho2.data(), fv2_rho_gamma.data(),
-                           fv2_gamma2.data());
+                xc_gga_fxc(xc_functional_.get(), npoints, rho_ap, gamma_aap, fv2_rho2, fv2_rho_gamma,
+                           fv2_gamma2);
 
-                C_DAXPY(npoints, alpha_, fv2_rho2.data(), 1, v_rho_a_rho_a, 1);
-                C_DAXPY(npoints, alpha_, fv2_gamma2.data(), 1, v_gamma_aa_gamma_aa, 1);
-                C_DAXPY(npoints, alpha_, fv2_rho_gamma.data(), 1, v_rho_a_gamma_aa, 1);
+                C_DAXPY(npoints, alpha_, fv2_rho2, 1, v_rho_a_rho_a, 1);
+                C_DAXPY(npoints, alpha_, fv2_gamma2, 1, v_gamma_aa_gamma_aa, 1);
+                C_DAXPY(npoints, alpha_, fv2_rho_gamma, 1, v_rho_a_gamma_aa, 1);
 
             } else {
-                std::vector<double> fv2_rho2(npoints);
+                double* fv2_rho2 = take(npoints);
 
-                xc_lda_fxc(xc_functional_.get(), npoints, rho_ap, fv2_rho2.data());
+                xc_lda_fxc(xc_functional_.get(), npoints, rho_ap, fv2_rho2);
 
-                C_DAXPY(npoints, alpha_, fv2_rho2.data(), 1, v_rho_a_rho_a, 1);
+                C_DAXPY(npoints, alpha_, fv2_rho2, 1, v_rho_a_rho_a, 1);
             }
 
             // Data validation.
@@ -716,32 +728,32 @@ void LibXCFunctional::compute_functional(const std::map<std::string, SharedVecto
     } else {  // End unpolarized
 
         // Allocate input data
-        std::vector<double> frho(npoints * 2);
-        std::vector<double> fv(npoints);
-        std::vector<double> fv_rho(npoints * 2);
+        double* frho = take(npoints * 2);
+        double* fv = take(npoints);
+        double* fv_rho = take(npoints * 2);
 
-        C_DCOPY(npoints, rho_ap, 1, frho.data(), 2);
-        C_DCOPY(npoints, rho_bp, 1, (frho.data() + 1), 2);
+        C_DCOPY(npoints, rho_ap, 1, frho, 2);
+        C_DCOPY(npoints, rho_bp, 1, (frho + 1), 2);
 
-        std::vector<double> fgamma, fv_gamma;
+        double *fgamma = nullptr, *fv_gamma = nullptr;
         if (gga_) {
-            fgamma.resize(npoints * 3);
-            fv_gamma.resize(npoints * 3);
+            fgamma = take(npoints * 3);
+            fv_gamma = take(npoints * 3);
 
-            C_DCOPY(npoints, gamma_aap, 1, fgamma.data(), 3);
-            C_DCOPY(npoints, gamma_abp, 1, (fgamma.data() + 1), 3);
-            C_DCOPY(npoints, gamma_bbp, 1, (fgamma.data() + 2), 3);
+            C_DCOPY(npoints, gamma_aap, 1, fgamma, 3);
+            C_DCOPY(npoints, gamma_abp, 1, (fgamma + 1), 3);
+            C_DCOPY(npoints, gamma_bbp, 1, (fgamma + 2), 3);
         }
 
-        std::vector<double> ftau, flapl, fv_lapl, fv_tau;
+        double *ftau = nullptr, *flapl = nullptr, *fv_lapl = nullptr, *fv_tau = nullptr;
         if (meta_) {
-            ftau.resize(npoints * 2);
-            flapl.resize(npoints * 2);
-            fv_lapl.resize(npoints * 2);
-            fv_tau.resize(npoints * 2);
+            ftau = take(npoints * 2);
+            flapl = take(npoints * 2);
+            fv_lapl = take(npoints * 2);
+            fv_tau = take(npoints * 2);
 
-            C_DCOPY(npoints, tau_ap, 1, ftau.data(), 2);
-            C_DCOPY(npoints, tau_bp, 1, (ftau.data() + 1), 2);
+            C_DCOPY(npoints, tau_ap, 1, ftau, 2);
+            C_DCOPY(npoints, tau_bp, 1, (ftau + 1), 2);
         }
 
         // Compute first deriv
@@ -752,21 +764,21 @@ void LibXCFunctional::compute_functional(const std::map<std::string, SharedVecto
             // Special cases
             double* fvp;
             if (exc_) {
-                fvp = fv.data();
+                fvp = fv;
             } else {
                 fvp = nullptr;
             }
 
             if (meta_) {
-                xc_mgga_exc_vxc(xc_functional_.get(), npoints, frho.data(), fgamma.data(), flapl.data(), ftau.data(),
-                                fvp, fv_rho.data(), fv_gamma.data(), fv_lapl.data(), fv_tau.data());
+                xc_mgga_exc_vxc(xc_functional_.get(), npoints, frho, fgamma, flapl, ftau,
+                                fvp, fv_rho, fv_gamma, fv_lapl, fv_tau);
 
             } else if (gga_) {
-                xc_gga_exc_vxc(xc_functional_.get(), npoints, frho.data(), fgamma.data(), fvp, fv_rho.data(),
-                               fv_gamma.data());
+                xc_gga_exc_vxc(xc_functional_.get(), npoints, frho, fgamma, fvp, fv_rho,
+                               fv_gamma);
 
             } else {
-                xc_lda_exc_vxc(xc_functional_.get(), npoints, frho.data(), fvp, fv_rho.data());
+                xc_lda_exc_vxc(xc_functional_.get(), npoints, frho, fvp, fv_rho);
             }
 
             // Re-apply
@@ -776,18 +788,18 @@ void LibXCFunctional::compute_functional(const std::map<std::string, SharedVecto
                 }
             }
 
-            C_DAXPY(npoints, alpha_, fv_rho.data(), 2, v_rho_a, 1);
-            C_DAXPY(npoints, alpha_, (fv_rho.data() + 1), 2, v_rho_b, 1);
+            C_DAXPY(npoints, alpha_, fv_rho, 2, v_rho_a, 1);
+            C_DAXPY(npoints, alpha_, (fv_rho + 1), 2, v_rho_b, 1);
 
             if (gga_) {
-                C_DAXPY(npoints, alpha_, fv_gamma.data(), 3, v_gamma_aa, 1);
-                C_DAXPY(npoints, alpha_, (fv_gamma.data() + 1), 3, v_gamma_ab, 1);
-                C_DAXPY(npoints, alpha_, (fv_gamma.data() + 2), 3, v_gamma_bb, 1);
+                C_DAXPY(npoints, alpha_, fv_gamma, 3, v_gamma_aa, 1);
+                C_DAXPY(npoints, alpha_, (fv_gamma + 1), 3, v_gamma_ab, 1);
+                C_DAXPY(npoints, alpha_, (fv_gamma + 2), 3, v_gamma_bb, 1);
             }
 
             if (meta_) {
-                C_DAXPY(npoints, 0.5 * alpha_, fv_tau.data(), 2, v_tau_a, 1);
-                C_DAXPY(npoints, 0.5 * alpha_, (fv_tau.data() + 1), 2, v_tau_b, 1);
+                C_DAXPY(npoints, 0.5 * alpha_, fv_tau, 2, v_tau_a, 1);
+                C_DAXPY(npoints, 0.5 * alpha_, (fv_tau + 1), 2, v_tau_b, 1);
             }
 
             // Data validation.
@@ -833,12 +845,12 @@ void LibXCFunctional::compute_functional(const std::map<std::string, SharedVecto
             if (meta_) {
                 throw PSIEXCEPTION("Second derivative for meta functionals is not yet available");
             } else if (gga_) {
-                std::vector<double> fv2_rho2(npoints * 3);
-                std::vector<double> fv2_rhogamma(npoints * 6);
-                std::vector<double> fv2_gamma2(npoints * 6);
+                double* fv2_rho2 = take(npoints * 3);
+                double* fv2_rhogamma = take(npoints * 6);
+                double* fv2_gamma2 = take(npoints * 6);
 
-                xc_gga_fxc(xc_functional_.get(), npoints, frho.data(), fgamma.data(), fv2_rho2.data(),
-                           fv2_rhogamma.data(), fv2_gamma2.data());
+                xc_gga_fxc(xc_functional_.get(), npoints, frho, fgamma, fv2_rho2,
+                           fv2_rhogamma, fv2_gamma2);
 
                 for (size_t i = 0; i < npoints; i++) {
                     // v2rho2(3)       = (u_u, u_d, d_d)
@@ -864,9 +876,9 @@ void LibXCFunctional::compute_functional(const std::map<std::string, SharedVecto
                 }
 
             } else {
-                std::vector<double> fv2_rho2(npoints * 3);
+                double* fv2_rho2 = take(npoints * 3);
 
-                xc_lda_fxc(xc_functional_.get(), npoints, frho.data(), fv2_rho2.data());
+                xc_lda_fxc(xc_functional_.get(), npoints, frho, fv2_rho2);
 
                 for (size_t i = 0; i < npoints; i++) {
                     // v2rho2(3)       = (u_u, u_d, d_d)
@@ -33,6 +33,7 @@
 #include "psi4/libmints/typedefs.h"
 
 #include <map>
+#include <vector>
 
 struct xc_func_type;
 
@@ -69,12 +70,15 @@ class LibXCFunctional : public Functional {
     // * Libxc needs all set at once as list c. v5.1.0, but store as richer map anyways
     std::map<std::string, double> user_tweakers_;
 
+    // Interleaved LibXC inputs and outputs, reused between calls on this worker
+    std::vector<double> scratch_;
+
    public:
     LibXCFunctional(std::string xc_name, bool unpolarized);
     ~LibXCFunctional() override;
 
-    void compute_functional(const std::map<std::string, SharedVector>& in,
-                            const std::map<std::string, SharedVector>& out, int npoints, int deriv) override;
+    using Functional::compute_functional;
+    void compute_functional(const XCValues& in, const XCValues& out, int npoints, int deriv) override;
 
     // Clones a *polarized*, complete functional. Used, e.g., in spin-symmetry-
     // breaking eigenvectors of the MO hessian or linear response eigenproblem.
@@ -82,7 +82,7 @@ void Functional::print(std::string out, int level) const {
 }
 void Functional::compute_functional(const std::map<std::string, SharedVector>& in,
                                     const std::map<std::string, SharedVector>& out, int npoints, int deriv) {
-    throw PSIEXCEPTION("Functional: pseudo-abstract class.");
+    compute_functional(XCValues(in), XCValues(out), npoints, deriv);
 }
 double Functional::query_density_cutoff() { throw PSIEXCEPTION("Functional: pseudo-abstract class."); }
 void Functional::set_density_cutoff(double cut) { throw PSIEXCEPTION("Functional: pseudo-abstract class."); }
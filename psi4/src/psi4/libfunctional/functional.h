@@ -30,6 +30,7 @@
 #define FUNCTIONAL_H
 
 #include "psi4/libmints/typedefs.h"
+#include "psi4/libfunctional/xc_values.h"
 #include <map>
 #include <vector>
 #include <string>
@@ -103,8 +104,11 @@ class Functional {
 
     // => Computers <= //
 
-    virtual void compute_functional(const std::map<std::string, SharedVector>& in,
-                                    const std::map<std::string, SharedVector>& out, int npoints, int deriv) = 0;
+    // Adds this functional's values and partials into out. The XCValues form is the one used
+    // per grid block; the map form resolves the keys and calls it, and is kept for Python.
+    virtual void compute_functional(const XCValues& in, const XCValues& out, int npoints, int deriv) = 0;
+    void compute_functional(const std::map<std::string, SharedVector>& in,
+                            const std::map<std::string, SharedVector>& out, int npoints, int deriv);
 
     // => Parameters <= //
 
@@ -40,6 +40,7 @@
 
 #include <cmath>
 #include <cstdlib>
+#include <algorithm>
 
 // using namespace psi;
 
@@ -665,6 +666,9 @@ void SuperFunctional::allocate() {
         vv_values_["GRID_WY"] = std::make_shared<Vector>("W_Y_GRID", max_points_);
         vv_values_["GRID_WZ"] = std::make_shared<Vector>("W_Z_GRID", max_points_);
     }
+
+    xc_values_ = XCValues(values_);
+    ac_xc_values_ = XCValues(ac_values_);
 }
 std::map<std::string, SharedVector>& SuperFunctional::compute_functional(
     const std::map<std::string, SharedVector>& vals, int npoints, bool singlet) {
@@ -697,8 +701,7 @@ std::map<std::string, SharedVector>& SuperFunctional::compute_functional(
             UKS_vals["GAMMA_BB"] = UKS_vals["GAMMA_AA"];
         }
 
-        auto temp = UKS->compute_functional(UKS_vals, npoints);
-        values_ = std::move(UKS->compute_functional(UKS_vals, npoints));
+        values_ = UKS->compute_functional(UKS_vals, npoints);
 
         // Now we take the magic triplet combinations.
         if (true) {
@@ -725,44 +728,44 @@ std::map<std::string, SharedVector>& SuperFunctional::compute_functional(
             values_.at("V_GAMMA_AA_GAMMA_AA")->axpby(-0.125, 0.125, *values_.at("V_GAMMA_AA_GAMMA_BB"));
             values_.erase("V_GAMMA_AA_GAMMA_BB");
         }
+        xc_values_ = XCValues(values_);
         return values_;
     }
     npoints = (npoints == -1 ? vals.find("RHO_A")->second->dimpi()[0] : npoints);
 
+    compute_functional(XCValues(vals), npoints);
+    return values_;
+}
+const XCValues& SuperFunctional::compute_functional(const XCValues& vals, int npoints) {
     // Zero out values
-    for (auto kv : values_) {
-        kv.second->zero();
-    }
+    xc_values_.zero(npoints);
 
     for (int i = 0; i < x_functionals_.size(); i++) {
-        x_functionals_[i]->compute_functional(vals, values_, npoints, deriv_);
+        x_functionals_[i]->compute_functional(vals, xc_values_, npoints, deriv_);
     }
     for (int i = 0; i < c_functionals_.size(); i++) {
-        c_functionals_[i]->compute_functional(vals, values_, npoints, deriv_);
+        c_functionals_[i]->compute_functional(vals, xc_values_, npoints, deriv_);
     }
 
     // Apply the grac shift, only valid for gradient computations
     if (needs_grac_ && (deriv_ == 1)) {
-        for (std::map<std::string, SharedVector>::const_iterator it = ac_values_.begin(); it != ac_values_.end();
-             ++it) {
-            ::memset((void*)((*it).second->pointer()), '\0', sizeof(double) * npoints);
-        }
+        ac_xc_values_.zero(npoints);
         if (grac_x_functional_) {
-            grac_x_functional_->compute_functional(vals, ac_values_, npoints, 1);
+            grac_x_functional_->compute_functional(vals, ac_xc_values_, npoints, 1);
         }
         if (grac_c_functional_) {
-            grac_c_functional_->compute_functional(vals, ac_values_, npoints, 1);
+            grac_c_functional_->compute_functional(vals, ac_xc_values_, npoints, 1);
         }
 
         if (is_unpolarized()) {
-            double* rho = vals.find("RHO_A")->second->pointer();
-            double* sigma = vals.find("GAMMA_AA")->second->pointer();
+            double* rho = vals[XCValue::RHO_A];
+            double* sigma = vals[XCValue::GAMMA_AA];
 
-            double* v_rho = values_["V_RHO_A"]->pointer();
-            double* v_gamma = values_["V_GAMMA_AA"]->pointer();
+            double* v_rho = xc_values_[XCValue::V_RHO_A];
+            double* v_gamma = xc_values_[XCValue::V_GAMMA_AA];
 
-            double* grac_v_rho = ac_values_["V_RHO_A"]->pointer();
-            double* grac_v_gamma = ac_values_["V_GAMMA_AA"]->pointer();
+            double* grac_v_rho = ac_xc_values_[XCValue::V_RHO_A];
+            double* grac_v_gamma = ac_xc_values_[XCValue::V_GAMMA_AA];
 
             const double galpha = -1.0 * grac_alpha_;
             const double gbeta = grac_beta_;
@@ -835,7 +838,7 @@ std::map<std::string, SharedVector>& SuperFunctional::compute_functional(
         }
     }
 
-    return values_;
+    return xc_values_;
 }
 std::map<std::string, SharedVector> SuperFunctional::compute_vv10_cache(const std::map<std::string, SharedVector>& vals,
                                                                         std::shared_ptr<BlockOPoints> block,
@@ -925,9 +928,57 @@ std::map<std::string, SharedVector> SuperFunctional::compute_vv10_cache(const st
 
     return ret;
 }
+double VV10Cache::bound_distance(int k) { return 0.5 * std::pow(2.0, 0.5 * k); }
+int VV10Cache::bound_index(double R) {
+    if (R < bound_distance(0)) return -1;
+    int k = static_cast<int>(std::floor(2.0 * std::log2(R / bound_distance(0))));
+    return std::min(k, nbound - 1);
+}
+void VV10Cache::add_block(const std::map<std::string, SharedVector>& block) {
+    const double* x = block.find("X")->second->pointer();
+    const double* y = block.find("Y")->second->pointer();
+    const double* z = block.find("Z")->second->pointer();
+    const double* w = block.find("W")->second->pointer();
+    const double* rho = block.find("RHO")->second->pointer();
+    const double* W0 = block.find("W0")->second->pointer();
+    const double* kappa = block.find("KAPPA")->second->pointer();
+    const size_t npoints = block.find("W")->second->dimpi()[0];
+
+    std::array<double, 4> sphere = {0.0, 0.0, 0.0, 0.0};
+    for (size_t j = 0; j < npoints; j++) {
+        sphere[0] += x[j];
+        sphere[1] += y[j];
+        sphere[2] += z[j];
+    }
+    if (npoints) {
+        for (size_t c = 0; c < 3; c++) sphere[c] /= npoints;
+    }
+    for (size_t j = 0; j < npoints; j++) {
+        const double d_x = x[j] - sphere[0];
+        const double d_y = y[j] - sphere[1];
+        const double d_z = z[j] - sphere[2];
+        sphere[3] = std::max(sphere[3], std::sqrt(d_x * d_x + d_y * d_y + d_z * d_z));
+    }
+
+    std::array<double, nbound> bound;
+    for (int k = 0; k < nbound; k++) {
+        const double R2 = bound_distance(k) * bound_distance(k);
+        double sum = 0.0;
+        for (size_t j = 0; j < npoints; j++) {
+            const double gp = W0[j] * R2 + kappa[j];
+            sum += w[j] * rho[j] / (gp * std::sqrt(gp));
+        }
+        bound[k] = sum;
+    }
+
+    blocks.push_back(block);
+    points.push_back({x, y, z, w, rho, W0, kappa, npoints});
+    spheres.push_back(sphere);
+    bounds.push_back(bound);
+}
 double SuperFunctional::compute_vv10_kernel(const std::map<std::string, SharedVector>& vals,
-                                            const std::vector<std::map<std::string, SharedVector>>& vv10_cache,
-                                            std::shared_ptr<BlockOPoints> block, int npoints, bool do_grad) {
+                                            const VV10Cache& vv10_cache, std::shared_ptr<BlockOPoints> block,
+                                            int npoints, bool do_grad) {
     // Kernel between left (*this) and right (vv10_cache) grids
 
     // Compute the vv10 cache in place
@@ -959,6 +1010,43 @@ double SuperFunctional::compute_vv10_kernel(const std::map<std::string, SharedVe
     const double* l_W0 = vv_values_["W0"]->pointer();
     const double* l_kappa = vv_values_["KAPPA"]->pointer();
 
+    // => Block-pair screening <= //
+    // With g g' (g + g') >= 2 (g g')^(3/2) and g' growing with the distance, the energy between
+    // this block and a right block R_min apart is bounded by 0.375 B_l(R_min) B_r(R_min),
+    // where B(R) = sum_j w_j rho_j (W0_j R^2 + kappa_j)^(-3/2)
+    std::vector<size_t> r_active;
+    r_active.reserve(vv10_cache.size());
+    if (vv10_cache.screening > 0.0) {
+        const Vector3 l_center = block->center();
+        const double l_radius = block->radius();
+
+        std::array<double, VV10Cache::nbound> l_bound;
+        for (int k = 0; k < VV10Cache::nbound; k++) {
+            const double R2 = VV10Cache::bound_distance(k) * VV10Cache::bound_distance(k);
+            double sum = 0.0;
+            for (size_t i = 0; i < l_npoints; i++) {
+                if (l_rho[i] < l_thresh) continue;
+                const double g = l_W0[i] * R2 + l_kappa[i];
+                sum += l_w[i] * l_rho[i] / (g * std::sqrt(g));
+            }
+            l_bound[k] = sum;
+        }
+
+        for (size_t r = 0; r < vv10_cache.size(); r++) {
+            const std::array<double, 4>& sphere = vv10_cache.spheres[r];
+            const double d_x = l_center[0] - sphere[0];
+            const double d_y = l_center[1] - sphere[1];
+            const double d_z = l_center[2] - sphere[2];
+            const double R_min = std::sqrt(d_x * d_x + d_y * d_y + d_z * d_z) - l_radius - sphere[3];
+            const int k = VV10Cache::bound_index(R_min);
+            if (k >= 0 && 0.375 * l_bound[k] * vv10_cache.bounds[r][k] < vv10_cache.screening) continue;
+            r_active.push_back(r);
+        }
+        vv10_cache.skipped_pairs += vv10_cache.size() - r_active.size();
+    } else {
+        for (size_t r = 0; r < vv10_cache.size(); r++) r_active.push_back(r);
+    }
+
     for (size_t i = 0; i < l_npoints; i++) {
         // Add Phi agnostic quantities
         vv10_e += l_w[i] * l_rho[i] * vv10_beta;
@@ -974,44 +1062,53 @@ double SuperFunctional::compute_vv10_kernel(const std::map<std::string, SharedVe
         double xc = 0.0;
         double yc = 0.0;
         double zc = 0.0;
-        for (auto r_block : vv10_cache) {
+        const double x_i = l_x[i];
+        const double y_i = l_y[i];
+        const double z_i = l_z[i];
+        const double W0_i = l_W0[i];
+        const double kappa_i = l_kappa[i];
+        for (size_t r : r_active) {
             // Get right points
-            const double* r_x = r_block["X"]->pointer();
-            const double* r_y = r_block["Y"]->pointer();
-            const double* r_z = r_block["Z"]->pointer();
-            const double* r_w = r_block["W"]->pointer();
-            const double* r_rho = r_block["RHO"]->pointer();
-            const double* r_W0 = r_block["W0"]->pointer();
-            const double* r_kappa = r_block["KAPPA"]->pointer();
+            const VV10Cache::Points& r_block = vv10_cache.points[r];
+            const double* r_x = r_block.x;
+            const double* r_y = r_block.y;
+            const double* r_z = r_block.z;
+            const double* r_w = r_block.w;
+            const double* r_rho = r_block.rho;
+            const double* r_W0 = r_block.W0;
+            const double* r_kappa = r_block.kappa;
 
-            const size_t r_npoints = r_block["KAPPA"]->dimpi()[0];
+            const size_t r_npoints = r_block.npoints;
 
             // Interior Kernel
             if (do_grad) {
 #pragma omp simd reduction(+ : phi, U, W, xc, yc, zc)
                 for (size_t j = 0; j < r_npoints; j++) {
                     // Distance between grid points
-                    const double d_x = l_x[i] - r_x[j];
-                    const double d_y = l_y[i] - r_y[j];
-                    const double d_z = l_z[i] - r_z[j];
+                    const double d_x = x_i - r_x[j];
+                    const double d_y = y_i - r_y[j];
+                    const double d_z = z_i - r_z[j];
                     const double R2 = d_x * d_x + d_y * d_y + d_z * d_z;
 
                     // g/gp values
-                    const double g = l_W0[i] * R2 + l_kappa[i];
+                    const double g = W0_i * R2 + kappa_i;
                     const double gp = r_W0[j] * R2 + r_kappa[j];
                     const double gs = g + gp;
 
-                    // Sum the kernel
-                    const double phi_kernel = (-1.5 * r_w[j] * r_rho[j]) / (g * gp * gs);
+                    // One division, shared by the kernel and its derivatives
+                    const double inv = 1.0 / (g * gp * gs);
+                    const double phi_kernel = -1.5 * r_w[j] * r_rho[j] * inv;
+                    const double inv_g = gp * gs * inv;
+                    const double inv_gp = g * gs * inv;
+                    const double inv_gs = g * gp * inv;
 
-                    // Dumb question, does FMA do subtraction?
                     phi += phi_kernel;
-                    const double tmp_U = -1.0 * phi_kernel * ((1.0 / g) + (1.0 / gs));
+                    const double tmp_U = -1.0 * phi_kernel * (inv_g + inv_gs);
                     U += tmp_U;
                     W += tmp_U * R2;
 
                     // Grid contribution
-                    const double Q = -2.0 * phi_kernel * (l_W0[i] / g + r_W0[j] / gp + (l_W0[i] + r_W0[j]) / gs);
+                    const double Q = -2.0 * phi_kernel * (W0_i * inv_g + r_W0[j] * inv_gp + (W0_i + r_W0[j]) * inv_gs);
                     xc += Q * d_x;
                     yc += Q * d_y;
                     zc += Q * d_z;
@@ -1021,22 +1118,22 @@ double SuperFunctional::compute_vv10_kernel(const std::map<std::string, SharedVe
 #pragma omp simd reduction(+ : phi, U, W)
                 for (size_t j = 0; j < r_npoints; j++) {
                     // Distance between grid points
-                    const double d_x = l_x[i] - r_x[j];
-                    const double d_y = l_y[i] - r_y[j];
-                    const double d_z = l_z[i] - r_z[j];
+                    const double d_x = x_i - r_x[j];
+                    const double d_y = y_i - r_y[j];
+                    const double d_z = z_i - r_z[j];
                     const double R2 = d_x * d_x + d_y * d_y + d_z * d_z;
 
                     // g/gp values
-                    const double g = l_W0[i] * R2 + l_kappa[i];
+                    const double g = W0_i * R2 + kappa_i;
                     const double gp = r_W0[j] * R2 + r_kappa[j];
                     const double gs = g + gp;
 
-                    // Sum the kernel
-                    const double phi_kernel = (-1.5 * r_w[j] * r_rho[j]) / (g * gp * gs);
+                    // One division, shared by the kernel and its derivatives
+                    const double inv = 1.0 / (g * gp * gs);
+                    const double phi_kernel = -1.5 * r_w[j] * r_rho[j] * inv;
 
-                    // Dumb question, does FMA do subtraction?
                     phi += phi_kernel;
-                    const double tmp_U = -1.0 * phi_kernel * ((1.0 / g) + (1.0 / gs));
+                    const double tmp_U = -1.0 * phi_kernel * (gp * (gs + g) * inv);
                     U += tmp_U;
                     W += tmp_U * R2;
                 }
@@ -30,7 +30,10 @@
 #define SUPERFUNCTIONAL_H
 
 #include "psi4/libmints/typedefs.h"
+#include "psi4/libfunctional/xc_values.h"
 #include "psi4/pragma.h"
+#include <array>
+#include <atomic>
 #include <map>
 #include <vector>
 #include <cstdlib>
@@ -41,6 +44,52 @@ namespace psi {
 class Functional;
 class BlockOPoints;
 
+/**
+ * VV10Cache: the points a VV10 kernel integrates over
+ *
+ * The points are kept in spatially compact blocks. Each block carries a
+ * bounding sphere and upper bounds on its kernel-weighted density as seen
+ * from a range of distances, so that block pairs too far apart to
+ * contribute more than the screening threshold can be skipped.
+ **/
+struct VV10Cache {
+    /// Number of distances the screening bounds are tabulated at
+    static constexpr int nbound = 16;
+    /// The k-th tabulated distance [a0]: 0.5, 0.5 sqrt(2), 1, ...
+    static double bound_distance(int k);
+    /// Index of the largest tabulated distance not above R, -1 if R is below all of them
+    static int bound_index(double R);
+
+    /// Skip block pairs whose energy contribution is bounded by this. Zero disables screening.
+    double screening = 0.0;
+    /// Kernel data of one block, unpacked from its map so kernels need no lookups
+    struct Points {
+        const double* x;
+        const double* y;
+        const double* z;
+        const double* w;
+        const double* rho;
+        const double* W0;
+        const double* kappa;
+        size_t npoints;
+    };
+
+    /// Kernel data of each block, as returned by SuperFunctional::compute_vv10_cache
+    std::vector<std::map<std::string, SharedVector>> blocks;
+    /// Pointers into blocks
+    std::vector<Points> points;
+    /// Center (x, y, z) and bounding radius of each block
+    std::vector<std::array<double, 4>> spheres;
+    /// Per block, sum_j w_j rho_j (W0_j R_k^2 + kappa_j)^(-3/2) at each tabulated distance R_k
+    std::vector<std::array<double, nbound>> bounds;
+    /// Block pairs skipped by the kernels integrated against this cache
+    mutable std::atomic<size_t> skipped_pairs{0};
+
+    /// Append a block of kernel data, computing its bounding sphere and bounds
+    void add_block(const std::map<std::string, SharedVector>& block);
+    size_t size() const { return blocks.size(); }
+};
+
 /**
  * SuperFunctional: High-level semilocal DFA object
  *
@@ -138,8 +187,11 @@ class SuperFunctional {
     //      V_GAMMA_AA_GAMMA_AA : (∂^2/∂γ_αα^2 + ∂^2/∂γ_αα∂γ_αβ + ∂^2/∂γ_αα∂γ_ββ + ∂^2/∂γ_αβ^2) / 8
     //        ...note that for closed shells, ∂^2/∂γ_αβ^2 = 2 ∂^2/∂γ_αα∂γ_αβ
     std::map<std::string, SharedVector> values_;
+    // Pointers into values_ by XCValue, refreshed whenever values_ is rebuilt
+    XCValues xc_values_;
     // For GRAC
     std::map<std::string, SharedVector> ac_values_;
+    XCValues ac_xc_values_;
     // For VV10
     std::map<std::string, SharedVector> vv_values_;
 
@@ -177,6 +229,9 @@ class SuperFunctional {
     // If not spin polarized, singlet controls whether singlet or triplet is asked for.
     std::map<std::string, SharedVector>& compute_functional(const std::map<std::string, SharedVector>& vals,
                                                             int npoints = -1, bool singlet = true);
+    // Populates values_ without any string lookups, for the per-block integrators.
+    // Singlet only; triplet second derivatives go through the map form above.
+    const XCValues& compute_functional(const XCValues& vals, int npoints);
     void test_functional(SharedVector rho_a, SharedVector rho_b, SharedVector gamma_aa, SharedVector gamma_ab,
                          SharedVector gamma_bb, SharedVector tau_a, SharedVector tau_b);
 
@@ -185,15 +240,16 @@ class SuperFunctional {
                                                            std::shared_ptr<BlockOPoints> block, double rho_thresh,
                                                            int npoints = -1, bool internal = false);
 
-    // Copmutes the Cache data for VV10 dispersion
-    double compute_vv10_kernel(const std::map<std::string, SharedVector>& vals,
-                               const std::vector<std::map<std::string, SharedVector>>& vv10_cache,
+    // Computes the VV10 kernel between a block and the cached points, skipping distant cache blocks
+    double compute_vv10_kernel(const std::map<std::string, SharedVector>& vals, const VV10Cache& vv10_cache,
                                std::shared_ptr<BlockOPoints> block, int npoints = -1, bool do_grad = false);
 
     // => Input/Output <= //
 
     std::map<std::string, SharedVector>& values() { return values_; }
     SharedVector value(const std::string& key) { return values_[key]; }
+    const XCValues& xc_values() const { return xc_values_; }
+    double* xc_value(XCValue key) const { return xc_values_[key]; }
     SharedVector vv_value(const std::string& key) { return vv_values_[key]; }
 
     std::vector<std::shared_ptr<Functional>>& x_functionals() { return x_functionals_; }
@@ -0,0 +1,118 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2025 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+#include "xc_values.h"
+
+#include "psi4/libmints/vector.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace psi {
+
+namespace {
+
+// Must follow the order of XCValue
+const char* const xc_value_names[] = {
+    "RHO_A",
+    "RHO_B",
+    "RHO_AX",
+    "RHO_AY",
+    "RHO_AZ",
+    "RHO_BX",
+    "RHO_BY",
+    "RHO_BZ",
+    "GAMMA_AA",
+    "GAMMA_AB",
+    "GAMMA_BB",
+    "TAU_A",
+    "TAU_B",
+    "RHO_XX",
+    "RHO_YY",
+    "RHO_ZZ",
+    "LAPL_RHO_A",
+    "Q_TMP",
+    "V",
+    "V_RHO_A",
+    "V_RHO_B",
+    "V_GAMMA_AA",
+    "V_GAMMA_AB",
+    "V_GAMMA_BB",
+    "V_TAU_A",
+    "V_TAU_B",
+    "V_RHO_A_RHO_A",
+    "V_RHO_A_RHO_B",
+    "V_RHO_B_RHO_B",
+    "V_GAMMA_AA_GAMMA_AA",
+    "V_GAMMA_AA_GAMMA_AB",
+    "V_GAMMA_AA_GAMMA_BB",
+    "V_GAMMA_AB_GAMMA_AB",
+    "V_GAMMA_AB_GAMMA_BB",
+    "V_GAMMA_BB_GAMMA_BB",
+    "V_TAU_A_TAU_A",
+    "V_TAU_A_TAU_B",
+    "V_TAU_B_TAU_B",
+    "V_RHO_A_GAMMA_AA",
+    "V_RHO_A_GAMMA_AB",
+    "V_RHO_A_GAMMA_BB",
+    "V_RHO_B_GAMMA_AA",
+    "V_RHO_B_GAMMA_AB",
+    "V_RHO_B_GAMMA_BB",
+    "V_RHO_A_TAU_A",
+    "V_RHO_A_TAU_B",
+    "V_RHO_B_TAU_A",
+    "V_RHO_B_TAU_B",
+    "V_GAMMA_AA_TAU_A",
+    "V_GAMMA_AA_TAU_B",
+    "V_GAMMA_AB_TAU_A",
+    "V_GAMMA_AB_TAU_B",
+    "V_GAMMA_BB_TAU_A",
+    "V_GAMMA_BB_TAU_B",
+};
+static_assert(sizeof(xc_value_names) / sizeof(xc_value_names[0]) == static_cast<size_t>(XCValue::count),
+              "xc_value_names must list every XCValue");
+
+}  // namespace
+
+XCValues::XCValues(const std::map<std::string, SharedVector>& values) {
+    values_.fill(nullptr);
+    for (size_t k = 0; k < values_.size(); k++) {
+        auto it = values.find(xc_value_names[k]);
+        if (it != values.end() && it->second) values_[k] = it->second->pointer();
+    }
+}
+
+const char* XCValues::name(XCValue key) { return xc_value_names[static_cast<size_t>(key)]; }
+
+void XCValues::zero(size_t npoints) const {
+    for (double* value : values_) {
+        if (value) std::fill(value, value + npoints, 0.0);
+    }
+}
+
+}  // namespace psi
@@ -0,0 +1,137 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2025 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+#ifndef XC_VALUES_H
+#define XC_VALUES_H
+
+#include "psi4/libmints/typedefs.h"
+#include "psi4/pragma.h"
+
+#include <array>
+#include <map>
+#include <string>
+
+namespace psi {
+
+/**
+ * XCValue: the per-point quantities passed between PointFunctions,
+ * SuperFunctional and Functional. Names match the keys of the
+ * string-keyed maps used by the Python API.
+ **/
+enum class XCValue : int {
+    // => Densities and their derivatives <= //
+    RHO_A,
+    RHO_B,
+    RHO_AX,
+    RHO_AY,
+    RHO_AZ,
+    RHO_BX,
+    RHO_BY,
+    RHO_BZ,
+    GAMMA_AA,
+    GAMMA_AB,
+    GAMMA_BB,
+    TAU_A,
+    TAU_B,
+    RHO_XX,
+    RHO_YY,
+    RHO_ZZ,
+    LAPL_RHO_A,
+
+    // => Functional values and partials <= //
+    Q_TMP,
+    V,
+    V_RHO_A,
+    V_RHO_B,
+    V_GAMMA_AA,
+    V_GAMMA_AB,
+    V_GAMMA_BB,
+    V_TAU_A,
+    V_TAU_B,
+    V_RHO_A_RHO_A,
+    V_RHO_A_RHO_B,
+    V_RHO_B_RHO_B,
+    V_GAMMA_AA_GAMMA_AA,
+    V_GAMMA_AA_GAMMA_AB,
+    V_GAMMA_AA_GAMMA_BB,
+    V_GAMMA_AB_GAMMA_AB,
+    V_GAMMA_AB_GAMMA_BB,
+    V_GAMMA_BB_GAMMA_BB,
+    V_TAU_A_TAU_A,
+    V_TAU_A_TAU_B,
+    V_TAU_B_TAU_B,
+    V_RHO_A_GAMMA_AA,
+    V_RHO_A_GAMMA_AB,
+    V_RHO_A_GAMMA_BB,
+    V_RHO_B_GAMMA_AA,
+    V_RHO_B_GAMMA_AB,
+    V_RHO_B_GAMMA_BB,
+    V_RHO_A_TAU_A,
+    V_RHO_A_TAU_B,
+    V_RHO_B_TAU_A,
+    V_RHO_B_TAU_B,
+    V_GAMMA_AA_TAU_A,
+    V_GAMMA_AA_TAU_B,
+    V_GAMMA_AB_TAU_A,
+    V_GAMMA_AB_TAU_B,
+    V_GAMMA_BB_TAU_A,
+    V_GAMMA_BB_TAU_B,
+
+    count
+};
+
+/**
+ * XCValues: pointers to the contiguous per-point arrays of each XCValue,
+ * nullptr for values that are not present.
+ *
+ * The arrays are owned elsewhere, usually by the Vectors of a
+ * string-keyed map built once at allocation, so the table is cheap to
+ * copy and indexing it costs no lookups.
+ **/
+class PSI_API XCValues {
+   protected:
+    std::array<double*, static_cast<size_t>(XCValue::count)> values_;
+
+   public:
+    XCValues() { values_.fill(nullptr); }
+    /// Point at the Vectors of a string-keyed map; keys that are not XCValue names are ignored
+    explicit XCValues(const std::map<std::string, SharedVector>& values);
+
+    double* operator[](XCValue key) const { return values_[static_cast<size_t>(key)]; }
+    void set(XCValue key, double* value) { values_[static_cast<size_t>(key)] = value; }
+    bool has(XCValue key) const { return (*this)[key] != nullptr; }
+
+    /// The map key of an XCValue
+    static const char* name(XCValue key);
+    /// Zero the first npoints entries of every present array
+    void zero(size_t npoints) const;
+};
+
+}  // namespace psi
+
+#endif
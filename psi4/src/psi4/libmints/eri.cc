@@ -34,8 +34,23 @@
 
 #include <libint2/shell.h>
 #include <libint2/engine.h>
+
+#include <cstdio>
+#include <string>
+
 using namespace psi;
 
+namespace {
+
+/// Sieves depend on the operator parameter, so it is printed exactly into the key
+std::string sieve_key(const std::string &op, double param) {
+    char buf[64];
+    std::snprintf(buf, sizeof(buf), "%s %.17g", op.c_str(), param);
+    return buf;
+}
+
+}  // namespace
+
 /////////
 // Normal two-electron repulsion integrals
 /////////
@@ -79,6 +94,7 @@ Libint2ERI::Libint2ERI(const IntegralFactory *integral, double screening_thresho
     schwarz_engine_ =
         libint2::Engine(libint2::Operator::coulomb, max_nprim, max_am, 0, max_precision,
                         libint2::operator_traits<libint2::Operator::coulomb>::default_params(), libint2::BraKet::xx_xx);
+    sieve_key_ = "coulomb";
     common_init();
     timer_off("Libint2ERI::Libint2ERI");
 }
@@ -181,6 +197,7 @@ Libint2ErfERI::Libint2ErfERI(double omega, const IntegralFactory *integral, doub
     max_am = bra_same_ ? basis1()->max_am() : ket_same_ ? basis3()->max_am() : 0;
     schwarz_engine_ = libint2::Engine(libint2::Operator::erf_coulomb, max_nprim, max_am, 0, max_precision, omega,
                                       libint2::BraKet::xx_xx);
+    sieve_key_ = sieve_key("erf_coulomb", omega);
     common_init();
     timer_off("Libint2ErfERI::Libint2ErfERI");
 }
@@ -295,6 +312,7 @@ Libint2ErfComplementERI::Libint2ErfComplementERI(double omega, const IntegralFac
     max_am = bra_same_ ? basis1()->max_am() : ket_same_ ? basis3()->max_am() : 0;
     schwarz_engine_ = libint2::Engine(libint2::Operator::erfc_coulomb, max_nprim, max_am, 0, max_precision, omega,
                                       libint2::BraKet::xx_xx);
+    sieve_key_ = sieve_key("erfc_coulomb", omega);
     common_init();
     timer_off("Libint2ErfComplementERI::Libint2ErfComplementERI");
 }
@@ -412,6 +430,7 @@ Libint2YukawaERI::Libint2YukawaERI(double zeta, const IntegralFactory *integral,
     max_am = bra_same_ ? basis1()->max_am() : ket_same_ ? basis3()->max_am() : 0;
     schwarz_engine_ =
         libint2::Engine(libint2::Operator::yukawa, max_nprim, max_am, 0, max_precision, zeta, libint2::BraKet::xx_xx);
+    sieve_key_ = sieve_key("yukawa", zeta);
     common_init();
     timer_on("Libint2YukawaERI::Libint2YukawaERI");
 }
@@ -137,21 +137,21 @@ void Libint2TwoElectronInt::common_init() {
     create_blocks();
     const auto max_engine_precision = std::numeric_limits<double>::epsilon() * screening_threshold_;
 
-    size_t npairs = shell_pairs_bra_.size();
+    size_t npairs = sieve_->shell_pairs_bra.size();
     pairs12_.resize(npairs);
     // #pragma omp parallel for
     for (int pair = 0; pair < npairs; ++pair) {
-        auto s1 = shell_pairs_bra_[pair].first;
-        auto s2 = shell_pairs_bra_[pair].second;
+        auto s1 = sieve_->shell_pairs_bra[pair].first;
+        auto s2 = sieve_->shell_pairs_bra[pair].second;
         pairs12_[pair] = std::make_shared<libint2::ShellPair>(basis1()->l2_shell(s1), basis2()->l2_shell(s2),
                                                               std::log(max_engine_precision));
     }
-    npairs = shell_pairs_ket_.size();
+    npairs = sieve_->shell_pairs_ket.size();
     pairs34_.resize(npairs);
     // #pragma omp parallel for
     for (int pair = 0; pair < npairs; ++pair) {
-        auto s3 = shell_pairs_ket_[pair].first;
-        auto s4 = shell_pairs_ket_[pair].second;
+        auto s3 = sieve_->shell_pairs_ket[pair].first;
+        auto s4 = sieve_->shell_pairs_ket[pair].second;
         pairs34_[pair] = std::make_shared<libint2::ShellPair>(basis3()->l2_shell(s3), basis4()->l2_shell(s4),
                                                               std::log(max_engine_precision));
     }
@@ -166,21 +166,21 @@ void Libint2TwoElectronInt::initialize_sieve() {
     const auto max_engine_precision = std::numeric_limits<double>::epsilon() * screening_threshold_;
 
     // Reset the engine type back to the general case needed
-    size_t npairs = shell_pairs_bra_.size();
+    size_t npairs = sieve_->shell_pairs_bra.size();
     pairs12_.resize(npairs);
 //#pragma omp parallel for
     for (int pair = 0; pair < npairs; ++pair) {
-        auto s1 = shell_pairs_bra_[pair].first;
-        auto s2 = shell_pairs_bra_[pair].second;
+        auto s1 = sieve_->shell_pairs_bra[pair].first;
+        auto s2 = sieve_->shell_pairs_bra[pair].second;
         pairs12_[pair] = std::make_shared<libint2::ShellPair>(basis1()->l2_shell(s1), basis2()->l2_shell(s2),
                                                               std::log(max_engine_precision));
     }
-    npairs = shell_pairs_ket_.size();
+    npairs = sieve_->shell_pairs_ket.size();
     pairs34_.resize(npairs);
 //#pragma omp parallel for
     for (int pair = 0; pair < npairs; ++pair) {
-        auto s3 = shell_pairs_ket_[pair].first;
-        auto s4 = shell_pairs_ket_[pair].second;
+        auto s3 = sieve_->shell_pairs_ket[pair].first;
+        auto s4 = sieve_->shell_pairs_ket[pair].second;
         pairs34_[pair] = std::make_shared<libint2::ShellPair>(basis3()->l2_shell(s3), basis4()->l2_shell(s4),
                                                               std::log(max_engine_precision));
     }
@@ -32,11 +32,20 @@
 #include "psi4/libmints/matrix.h"
 #include "psi4/libmints/integral.h"
 #include "psi4/libmints/potential.h"
+#include "psi4/libmints/mcmurchiedavidson.h"
+#include "psi4/libmints/vector3.h"
 #include "psi4/libciomr/libciomr.h"
 #include "psi4/libqt/qt.h"
 #include "psi4/physconst.h"
 #include "psi4/libpsi4util/PsiOutStream.h"
 #include "psi4/libpsi4util/process.h"
+#include "psi4/liboptions/liboptions.h"
+#include "psi4/libpsi4util/exception.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
 
 #ifdef _OPENMP
 #include <omp.h>
@@ -44,6 +53,599 @@
 
 namespace psi {
 
+namespace {
+
+using mdintegrals::Point;
+
+// Shell pairs are grouped into blocks of at most this many pairs, charges into tree leaves of at most
+// this many charges, and clusters with fewer charges than kMinClusterCharges are expanded charge by charge
+constexpr size_t kMaxPairsPerBlock = 32;
+constexpr size_t kMaxChargesPerLeaf = 32;
+constexpr size_t kMinClusterCharges = 16;
+// Primitive products smaller than this are taken to vanish when sizing the shell-pair distributions
+constexpr double kPairExtentTolerance = 1.0e-12;
+
+/// A node of the bisection tree over the external charges
+struct ChargeNode {
+    Point center;
+    double radius;
+    /// Range of the node's charges in the tree ordering
+    size_t begin;
+    size_t end;
+    int left = -1;
+    int right = -1;
+    /// (-1)^|j| / j! sum_C q_C (C - center)^j for |j| <= order, empty for nodes that are never expanded
+    std::vector<double> moments;
+};
+
+/// A spatial block of significant shell pairs, whose distributions are expanded about a common center
+struct PairBlock {
+    Point center;
+    /// Radius about center enclosing every distribution in the block
+    double radius;
+    std::vector<std::pair<int, int>> pairs;
+};
+
+/*
+ * Evaluates the interaction of shell-pair distributions with many point charges.  Shell pairs are
+ * partitioned into spatial blocks and the charges into a bisection tree.  For each block, charges
+ * closer than radius / theta are integrated exactly, while farther charges and well-separated
+ * clusters of charges enter through a Taylor expansion of their potential about the block center,
+ * contracted with the Cartesian multipole moments of the block's distributions up to the given order.
+ */
+class FarFieldChargeEngine {
+   public:
+    FarFieldChargeEngine(std::shared_ptr<BasisSet> basis,
+                         const std::vector<std::pair<double, std::array<double, 3>>>& Zxyz, int order,
+                         double theta)
+        : basis_(basis), Zxyz_(Zxyz), order_(order), theta_(theta) {
+        if (theta_ <= 0.0 || theta_ >= 1.0) throw PSIEXCEPTION("EXTERN_MULTIPOLE_THETA must lie between 0 and 1.");
+        fact_ = std::make_shared<IntegralFactory>(basis, basis, basis, basis);
+
+        comps_.clear();
+        for (int l = 0; l <= order_; ++l) {
+            for (const auto& comp : mdintegrals::generate_am_components_cca(l)) comps_.push_back(comp);
+        }
+        std::vector<double> factorial(order_ + 1, 1.0);
+        for (int l = 1; l <= order_; ++l) factorial[l] = l * factorial[l - 1];
+        for (const auto& [t, u, v] : comps_) {
+            inv_fact_.push_back(1.0 / (factorial[t] * factorial[u] * factorial[v]));
+            signed_inv_fact_.push_back(((t + u + v) % 2 ? -1.0 : 1.0) * inv_fact_.back());
+        }
+
+        charge_order_.resize(Zxyz_.size());
+        for (size_t i = 0; i < Zxyz_.size(); ++i) charge_order_[i] = i;
+        if (!Zxyz_.empty()) build_charge_node(0, Zxyz_.size());
+
+        std::unique_ptr<OneBodyAOInt> pot(fact_->ao_potential());
+        build_pair_blocks(pot->shellpairs());
+    }
+
+    /// Adds the (negative definite) potential of the charges to V and returns how each block met the charges
+    std::map<std::string, size_t> compute_potential(SharedMatrix V, int nthreads) const;
+    /// Adds the electronic gradient of the charge interaction with density D to the atoms and to the charges
+    void compute_gradient(SharedMatrix D, SharedMatrix grad_on_atoms, SharedMatrix grad_on_charges,
+                          int nthreads) const;
+
+   private:
+    std::shared_ptr<BasisSet> basis_;
+    std::shared_ptr<IntegralFactory> fact_;
+    std::vector<std::pair<double, std::array<double, 3>>> Zxyz_;
+    int order_;
+    double theta_;
+
+    /// Cartesian components with |k| <= order, in CCA order within each l
+    std::vector<std::array<int, 3>> comps_;
+    /// 1 / k! and (-1)^|k| / k! for each component
+    std::vector<double> inv_fact_;
+    std::vector<double> signed_inv_fact_;
+
+    std::vector<int> charge_order_;
+    std::vector<ChargeNode> nodes_;
+    std::vector<PairBlock> blocks_;
+
+    Point charge_position(int i) const { return Zxyz_[i].second; }
+    int build_charge_node(size_t begin, size_t end);
+    void build_pair_blocks(const std::vector<std::pair<int, int>>& shellpairs);
+
+    /// Sorts the charges into those integrated exactly, those expanded individually, and expanded clusters
+    void classify(const PairBlock& block, std::vector<int>& near, std::vector<int>& far,
+                  std::vector<int>& clusters) const;
+    /// T_k = 1/k! d^k/dr^k sum_C q_C / |r - C| at the block center, for |k| <= order
+    void local_expansion(const PairBlock& block, const std::vector<int>& far, const std::vector<int>& clusters,
+                         std::vector<double>& R, std::vector<double>& T) const;
+};
+
+int FarFieldChargeEngine::build_charge_node(size_t begin, size_t end) {
+    Point lo{std::numeric_limits<double>::max(), std::numeric_limits<double>::max(),
+             std::numeric_limits<double>::max()};
+    Point hi{std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest(),
+             std::numeric_limits<double>::lowest()};
+    for (size_t i = begin; i < end; ++i) {
+        Point C = charge_position(charge_order_[i]);
+        for (int x = 0; x < 3; ++x) {
+            lo[x] = std::min(lo[x], C[x]);
+            hi[x] = std::max(hi[x], C[x]);
+        }
+    }
+
+    ChargeNode node;
+    node.center = {0.5 * (lo[0] + hi[0]), 0.5 * (lo[1] + hi[1]), 0.5 * (lo[2] + hi[2])};
+    node.radius = 0.0;
+    node.begin = begin;
+    node.end = end;
+    for (size_t i = begin; i < end; ++i) {
+        node.radius =
+            std::max(node.radius, mdintegrals::point_norm(mdintegrals::point_diff(charge_position(charge_order_[i]), node.center)));
+    }
+
+    if (end - begin >= kMinClusterCharges) {
+        node.moments.assign(comps_.size(), 0.0);
+        std::vector<double> cx(order_ + 1), cy(order_ + 1), cz(order_ + 1);
+        for (size_t i = begin; i < end; ++i) {
+            auto c = mdintegrals::point_diff(charge_position(charge_order_[i]), node.center);
+            cx[0] = Zxyz_[charge_order_[i]].first;
+            cy[0] = cz[0] = 1.0;
+            for (int l = 1; l <= order_; ++l) {
+                cx[l] = cx[l - 1] * c[0];
+                cy[l] = cy[l - 1] * c[1];
+                cz[l] = cz[l - 1] * c[2];
+            }
+            for (size_t j = 0; j < comps_.size(); ++j) {
+                const auto& [t, u, v] = comps_[j];
+                node.moments[j] += cx[t] * cy[u] * cz[v];
+            }
+        }
+        for (size_t j = 0; j < comps_.size(); ++j) node.moments[j] *= signed_inv_fact_[j];
+    }
+
+    int index = nodes_.size();
+    nodes_.push_back(node);
+
+    if (end - begin > kMaxChargesPerLeaf) {
+        int axis = 0;
+        for (int x = 1; x < 3; ++x) {
+            if (hi[x] - lo[x] > hi[axis] - lo[axis]) axis = x;
+        }
+        size_t mid = (begin + end) / 2;
+        std::nth_element(charge_order_.begin() + begin, charge_order_.begin() + mid, charge_order_.begin() + end,
+                         [&](int a, int b) { return Zxyz_[a].second[axis] < Zxyz_[b].second[axis]; });
+        int left = build_charge_node(begin, mid);
+        int right = build_charge_node(mid, end);
+        nodes_[index].left = left;
+        nodes_[index].right = right;
+    }
+    return index;
+}
+
+void FarFieldChargeEngine::build_pair_blocks(const std::vector<std::pair<int, int>>& shellpairs) {
+    // Each distribution is referenced to the product of its most diffuse primitives, and extends as far
+    // from that point as any of its primitive products exceeds kPairExtentTolerance
+    const double log_tol = -std::log(kPairExtentTolerance);
+    size_t npair = shellpairs.size();
+    std::vector<Point> refs(npair);
+    std::vector<double> extents(npair, 0.0);
+    for (size_t PQ = 0; PQ < npair; ++PQ) {
+        const auto& sP = basis_->shell(shellpairs[PQ].first);
+        const auto& sQ = basis_->shell(shellpairs[PQ].second);
+        const double* A = sP.center();
+        const double* B = sQ.center();
+        double AB2 = (A[0] - B[0]) * (A[0] - B[0]) + (A[1] - B[1]) * (A[1] - B[1]) + (A[2] - B[2]) * (A[2] - B[2]);
+
+        double amin = sP.exp(0);
+        double bmin = sQ.exp(0);
+        for (int i = 1; i < sP.nprimitive(); ++i) amin = std::min(amin, sP.exp(i));
+        for (int j = 1; j < sQ.nprimitive(); ++j) bmin = std::min(bmin, sQ.exp(j));
+        for (int x = 0; x < 3; ++x) refs[PQ][x] = (amin * A[x] + bmin * B[x]) / (amin + bmin);
+
+        for (int i = 0; i < sP.nprimitive(); ++i) {
+            for (int j = 0; j < sQ.nprimitive(); ++j) {
+                double a = sP.exp(i);
+                double b = sQ.exp(j);
+                double p = a + b;
+                double arg = log_tol - a * b / p * AB2;
+                if (arg <= 0.0) continue;
+                Point Pij{(a * A[0] + b * B[0]) / p, (a * A[1] + b * B[1]) / p, (a * A[2] + b * B[2]) / p};
+                double extent = mdintegrals::point_norm(mdintegrals::point_diff(Pij, refs[PQ])) + std::sqrt(arg / p);
+                extents[PQ] = std::max(extents[PQ], extent);
+            }
+        }
+    }
+
+    // Recursive bisection of the reference points along the longest side of their bounding box
+    std::vector<size_t> order(npair);
+    for (size_t PQ = 0; PQ < npair; ++PQ) order[PQ] = PQ;
+    std::vector<std::pair<size_t, size_t>> ranges{{0, npair}};
+    while (!ranges.empty()) {
+        auto [begin, end] = ranges.back();
+        ranges.pop_back();
+        if (begin == end) continue;
+
+        Point lo{std::numeric_limits<double>::max(), std::numeric_limits<double>::max(),
+                 std::numeric_limits<double>::max()};
+        Point hi{std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest(),
+                 std::numeric_limits<double>::lowest()};
+        for (size_t i = begin; i < end; ++i) {
+            for (int x = 0; x < 3; ++x) {
+                lo[x] = std::min(lo[x], refs[order[i]][x]);
+                hi[x] = std::max(hi[x], refs[order[i]][x]);
+            }
+        }
+
+        if (end - begin > kMaxPairsPerBlock) {
+            int axis = 0;
+            for (int x = 1; x < 3; ++x) {
+                if (hi[x] - lo[x] > hi[axis] - lo[axis]) axis = x;
+            }
+            size_t mid = (begin + end) / 2;
+            std::nth_element(order.begin() + begin, order.begin() + mid, order.begin() + end,
+                             [&](size_t a, size_t b) { return refs[a][axis] < refs[b][axis]; });
+            ranges.push_back({begin, mid});
+            ranges.push_back({mid, end});
+            continue;
+        }
+
+        PairBlock block;
+        block.center = {0.5 * (lo[0] + hi[0]), 0.5 * (lo[1] + hi[1]), 0.5 * (lo[2] + hi[2])};
+        block.radius = 0.0;
+        for (size_t i = begin; i < end; ++i) {
+            size_t PQ = order[i];
+            block.radius = std::max(
+                block.radius, mdintegrals::point_norm(mdintegrals::point_diff(refs[PQ], block.center)) + extents[PQ]);
+            block.pairs.push_back(shellpairs[PQ]);
+        }
+        blocks_.push_back(std::move(block));
+    }
+}
+
+void FarFieldChargeEngine::classify(const PairBlock& block, std::vector<int>& near, std::vector<int>& far,
+                                    std::vector<int>& clusters) const {
+    near.clear();
+    far.clear();
+    clusters.clear();
+    if (nodes_.empty()) return;
+
+    std::vector<int> stack{0};
+    while (!stack.empty()) {
+        int n = stack.back();
+        stack.pop_back();
+        const auto& node = nodes_[n];
+
+        double d = mdintegrals::point_norm(mdintegrals::point_diff(block.center, node.center));
+        if (!node.moments.empty() && block.radius + node.radius <= theta_ * d) {
+            clusters.push_back(n);
+        } else if (node.left < 0) {
+            for (size_t i = node.begin; i < node.end; ++i) {
+                int C = charge_order_[i];
+                double dC = mdintegrals::point_norm(mdintegrals::point_diff(block.center, charge_position(C)));
+                if (block.radius <= theta_ * dC) {
+                    far.push_back(C);
+                } else {
+                    near.push_back(C);
+                }
+            }
+        } else {
+            stack.push_back(node.left);
+            stack.push_back(node.right);
+        }
+    }
+}
+
+void FarFieldChargeEngine::local_expansion(const PairBlock& block, const std::vector<int>& far,
+                                           const std::vector<int>& clusters, std::vector<double>& R,
+                                           std::vector<double>& T) const {
+    std::fill(T.begin(), T.end(), 0.0);
+
+    int dim1 = order_ + 1;
+    for (int C : far) {
+        mdintegrals::fill_R_matrix_point(order_, mdintegrals::point_diff(block.center, charge_position(C)), R);
+        double q = Zxyz_[C].first;
+        for (size_t k = 0; k < comps_.size(); ++k) {
+            const auto& [t, u, v] = comps_[k];
+            T[k] += q * inv_fact_[k] * R[mdintegrals::address_3d(t, u, v, dim1, dim1)];
+        }
+    }
+
+    // Clusters enter through the derivatives of their own multipole expansions, which need R up to 2 * order
+    dim1 = 2 * order_ + 1;
+    for (int n : clusters) {
+        const auto& node = nodes_[n];
+        mdintegrals::fill_R_matrix_point(2 * order_, mdintegrals::point_diff(block.center, node.center), R);
+        for (size_t k = 0; k < comps_.size(); ++k) {
+            const auto& [tk, uk, vk] = comps_[k];
+            double val = 0.0;
+            for (size_t j = 0; j < comps_.size(); ++j) {
+                const auto& [tj, uj, vj] = comps_[j];
+                val += node.moments[j] * R[mdintegrals::address_3d(tk + tj, uk + uj, vk + vj, dim1, dim1)];
+            }
+            T[k] += inv_fact_[k] * val;
+        }
+    }
+}
+
+std::map<std::string, size_t> FarFieldChargeEngine::compute_potential(SharedMatrix V, int nthreads) const {
+    std::vector<std::shared_ptr<PotentialInt>> pot;
+    std::vector<std::shared_ptr<OneBodyAOInt>> overlap;
+    std::vector<std::shared_ptr<OneBodyAOInt>> multipoles;
+    for (int t = 0; t < nthreads; ++t) {
+        pot.push_back(std::shared_ptr<PotentialInt>(static_cast<PotentialInt*>(fact_->ao_potential().release())));
+        overlap.push_back(std::shared_ptr<OneBodyAOInt>(fact_->ao_overlap()));
+        multipoles.push_back(std::shared_ptr<OneBodyAOInt>(fact_->ao_multipoles(order_)));
+    }
+
+    int ncomp = comps_.size();
+    size_t Rdim = 2 * order_ + 2;
+    size_t Rsize = Rdim * Rdim * Rdim * Rdim;
+    size_t max_nfunction = basis_->max_function_per_shell();
+    double** Vp = V->pointer();
+    std::vector<std::array<size_t, 3>> block_counts(blocks_.size());
+
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads)
+    for (size_t b = 0; b < blocks_.size(); ++b) {
+        int rank = 0;
+#ifdef _OPENMP
+        rank = omp_get_thread_num();
+#endif
+        const auto& block = blocks_[b];
+
+        std::vector<int> near, far, clusters;
+        classify(block, near, far, clusters);
+        block_counts[b] = {near.size(), far.size(), clusters.size()};
+        bool has_far = !far.empty() || !clusters.empty();
+
+        std::vector<double> R(Rsize);
+        std::vector<double> T(ncomp);
+        if (has_far) {
+            local_expansion(block, far, clusters, R, T);
+            multipoles[rank]->set_origin(Vector3(block.center[0], block.center[1], block.center[2]));
+        }
+        if (!near.empty()) {
+            std::vector<std::pair<double, std::array<double, 3>>> near_field;
+            for (int C : near) near_field.push_back(Zxyz_[C]);
+            pot[rank]->set_charge_field(near_field);
+        }
+
+        std::vector<double> Vblock(max_nfunction * max_nfunction);
+        for (const auto& [P, Q] : block.pairs) {
+            int nP = basis_->shell(P).nfunction();
+            int oP = basis_->shell(P).function_index();
+            int nQ = basis_->shell(Q).nfunction();
+            int oQ = basis_->shell(Q).function_index();
+            int size = nP * nQ;
+            std::fill(Vblock.begin(), Vblock.begin() + size, 0.0);
+
+            if (!near.empty()) {
+                pot[rank]->compute_shell(P, Q);
+                const double* buffer = pot[rank]->buffers()[0];
+                for (int pq = 0; pq < size; ++pq) Vblock[pq] += buffer[pq];
+            }
+            if (has_far) {
+                // The multipole buffers hold -M^k for |k| >= 1, while the potential is -sum_k T_k M^k
+                overlap[rank]->compute_shell(P, Q);
+                const double* S = overlap[rank]->buffers()[0];
+                for (int pq = 0; pq < size; ++pq) Vblock[pq] -= T[0] * S[pq];
+                multipoles[rank]->compute_shell(P, Q);
+                const auto& buffers = multipoles[rank]->buffers();
+                for (int k = 1; k < ncomp; ++k) {
+                    const double* M = buffers[k - 1];
+                    for (int pq = 0; pq < size; ++pq) Vblock[pq] += T[k] * M[pq];
+                }
+            }
+
+            for (int p = 0, pq = 0; p < nP; ++p) {
+                for (int q = 0; q < nQ; ++q, ++pq) {
+                    Vp[p + oP][q + oQ] = Vp[q + oQ][p + oP] = Vblock[pq];
+                }
+            }
+        }
+    }
+
+    std::map<std::string, size_t> counts{{"blocks", blocks_.size()}, {"near charges", 0}, {"far charges", 0},
+                                         {"far clusters", 0}};
+    for (const auto& [nnear, nfar, nclusters] : block_counts) {
+        counts["near charges"] += nnear;
+        counts["far charges"] += nfar;
+        counts["far clusters"] += nclusters;
+    }
+    return counts;
+}
+
+void FarFieldChargeEngine::compute_gradient(SharedMatrix D, SharedMatrix grad_on_atoms, SharedMatrix grad_on_charges,
+                                            int nthreads) const {
+    std::vector<std::shared_ptr<PotentialInt>> pot;
+    std::vector<std::shared_ptr<OneBodyAOInt>> overlap, overlap_deriv;
+    std::vector<std::shared_ptr<OneBodyAOInt>> multipoles, multipoles_deriv;
+    std::vector<SharedMatrix> Gtemps, EGtemps;
+    for (int t = 0; t < nthreads; ++t) {
+        pot.push_back(std::shared_ptr<PotentialInt>(static_cast<PotentialInt*>(fact_->ao_potential(1).release())));
+        overlap.push_back(std::shared_ptr<OneBodyAOInt>(fact_->ao_overlap()));
+        overlap_deriv.push_back(std::shared_ptr<OneBodyAOInt>(fact_->ao_overlap(1)));
+        multipoles.push_back(std::shared_ptr<OneBodyAOInt>(fact_->ao_multipoles(order_)));
+        multipoles_deriv.push_back(std::shared_ptr<OneBodyAOInt>(fact_->ao_multipoles(order_, 1)));
+        Gtemps.push_back(SharedMatrix(grad_on_atoms->clone()));
+        Gtemps[t]->zero();
+        EGtemps.push_back(SharedMatrix(grad_on_charges->clone()));
+        EGtemps[t]->zero();
+    }
+
+    int ncomp = comps_.size();
+    size_t Rdim = 2 * order_ + 2;
+    size_t Rsize = Rdim * Rdim * Rdim * Rdim;
+    double** Dp = D->pointer();
+
+    // Local expansions about the cluster centers of the blocks' potentials, which give the forces on
+    // the clustered charges once all blocks are done
+    std::vector<std::vector<double>> node_U(nthreads, std::vector<double>(nodes_.size() * ncomp, 0.0));
+    std::vector<std::vector<char>> node_used(nthreads, std::vector<char>(nodes_.size(), 0));
+
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads)
+    for (size_t b = 0; b < blocks_.size(); ++b) {
+        int rank = 0;
+#ifdef _OPENMP
+        rank = omp_get_thread_num();
+#endif
+        const auto& block = blocks_[b];
+        double** Gp = Gtemps[rank]->pointer();
+        double** EGp = EGtemps[rank]->pointer();
+
+        std::vector<int> near, far, clusters;
+        classify(block, near, far, clusters);
+        bool has_far = !far.empty() || !clusters.empty();
+
+        std::vector<double> R(Rsize);
+        std::vector<double> T(ncomp);
+        // W_k = sum_pq D_pq M^k_pq, the density moments of the block about its center
+        std::vector<double> W(ncomp, 0.0);
+        if (has_far) {
+            local_expansion(block, far, clusters, R, T);
+            Vector3 origin(block.center[0], block.center[1], block.center[2]);
+            multipoles[rank]->set_origin(origin);
+            multipoles_deriv[rank]->set_origin(origin);
+        }
+        if (!near.empty()) {
+            std::vector<std::pair<double, std::array<double, 3>>> near_field;
+            for (int C : near) near_field.push_back(Zxyz_[C]);
+            pot[rank]->set_charge_field(near_field);
+        }
+
+        for (const auto& [P, Q] : block.pairs) {
+            int cP = basis_->shell(P).ncenter();
+            int nP = basis_->shell(P).nfunction();
+            int oP = basis_->shell(P).function_index();
+            int cQ = basis_->shell(Q).ncenter();
+            int nQ = basis_->shell(Q).nfunction();
+            int oQ = basis_->shell(Q).function_index();
+            double perm = (P == Q ? 1.0 : 2.0);
+
+            if (!near.empty()) {
+                pot[rank]->compute_shell_deriv1(P, Q);
+                const auto& buffers = pot[rank]->buffers();
+                for (int p = 0, pq = 0; p < nP; ++p) {
+                    for (int q = 0; q < nQ; ++q, ++pq) {
+                        double Vval = perm * Dp[p + oP][q + oQ];
+                        for (int x = 0; x < 3; ++x) {
+                            Gp[cP][x] += Vval * buffers[x][pq];
+                            Gp[cQ][x] += Vval * buffers[x + 3][pq];
+                        }
+                        for (size_t i = 0; i < near.size(); ++i) {
+                            for (int x = 0; x < 3; ++x) EGp[near[i]][x] += Vval * buffers[3 * i + x + 6][pq];
+                        }
+                    }
+                }
+            }
+
+            if (has_far) {
+                overlap[rank]->compute_shell(P, Q);
+                multipoles[rank]->compute_shell(P, Q);
+                overlap_deriv[rank]->compute_shell_deriv1(P, Q);
+                multipoles_deriv[rank]->compute_shell_deriv1(P, Q);
+                const double* S = overlap[rank]->buffers()[0];
+                const auto& M = multipoles[rank]->buffers();
+                const auto& dS = overlap_deriv[rank]->buffers();
+                // Derivatives of +M^k, six (Ax ... Bz) per component
+                const auto& dM = multipoles_deriv[rank]->buffers();
+                for (int p = 0, pq = 0; p < nP; ++p) {
+                    for (int q = 0; q < nQ; ++q, ++pq) {
+                        double Dval = perm * Dp[p + oP][q + oQ];
+                        W[0] += Dval * S[pq];
+                        for (int k = 1; k < ncomp; ++k) W[k] -= Dval * M[k - 1][pq];
+                        for (int d = 0; d < 6; ++d) {
+                            double dV = T[0] * dS[d][pq];
+                            for (int k = 1; k < ncomp; ++k) dV += T[k] * dM[6 * (k - 1) + d][pq];
+                            Gp[d < 3 ? cP : cQ][d % 3] -= Dval * dV;
+                        }
+                    }
+                }
+            }
+        }
+
+        if (!has_far) continue;
+
+        // The far-field energy is -sum_k W_k T_k, with T_k depending on the charge positions
+        int dim1 = order_ + 2;
+        for (int C : far) {
+            mdintegrals::fill_R_matrix_point(order_ + 1, mdintegrals::point_diff(block.center, charge_position(C)), R);
+            double q = Zxyz_[C].first;
+            for (int k = 0; k < ncomp; ++k) {
+                const auto& [t, u, v] = comps_[k];
+                double fac = q * inv_fact_[k] * W[k];
+                EGp[C][0] += fac * R[mdintegrals::address_3d(t + 1, u, v, dim1, dim1)];
+                EGp[C][1] += fac * R[mdintegrals::address_3d(t, u + 1, v, dim1, dim1)];
+                EGp[C][2] += fac * R[mdintegrals::address_3d(t, u, v + 1, dim1, dim1)];
+            }
+        }
+        dim1 = 2 * order_ + 1;
+        for (int n : clusters) {
+            mdintegrals::fill_R_matrix_point(2 * order_, mdintegrals::point_diff(block.center, nodes_[n].center), R);
+            double* U = node_U[rank].data() + n * ncomp;
+            for (int j = 0; j < ncomp; ++j) {
+                const auto& [tj, uj, vj] = comps_[j];
+                double val = 0.0;
+                for (int k = 0; k < ncomp; ++k) {
+                    const auto& [tk, uk, vk] = comps_[k];
+                    val += inv_fact_[k] * W[k] * R[mdintegrals::address_3d(tk + tj, uk + uj, vk + vj, dim1, dim1)];
+                }
+                U[j] += val;
+            }
+            node_used[rank][n] = 1;
+        }
+    }
+
+    for (int t = 1; t < nthreads; ++t) {
+        for (size_t n = 0; n < nodes_.size(); ++n) {
+            if (!node_used[t][n]) continue;
+            node_used[0][n] = 1;
+            for (int j = 0; j < ncomp; ++j) node_U[0][n * ncomp + j] += node_U[t][n * ncomp + j];
+        }
+    }
+
+    // A cluster's energy is -sum_j moments_j U_j, and moments_j = (-1)^|j| / j! sum_C q_C c^j
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads)
+    for (size_t n = 0; n < nodes_.size(); ++n) {
+        if (!node_used[0][n]) continue;
+        int rank = 0;
+#ifdef _OPENMP
+        rank = omp_get_thread_num();
+#endif
+        double** EGp = EGtemps[rank]->pointer();
+        const auto& node = nodes_[n];
+        const double* U = node_U[0].data() + n * ncomp;
+        std::vector<double> cx(order_ + 1), cy(order_ + 1), cz(order_ + 1);
+        for (size_t i = node.begin; i < node.end; ++i) {
+            int C = charge_order_[i];
+            auto c = mdintegrals::point_diff(charge_position(C), node.center);
+            cx[0] = cy[0] = cz[0] = 1.0;
+            for (int l = 1; l <= order_; ++l) {
+                cx[l] = cx[l - 1] * c[0];
+                cy[l] = cy[l - 1] * c[1];
+                cz[l] = cz[l - 1] * c[2];
+            }
+            double q = Zxyz_[C].first;
+            for (int j = 1; j < ncomp; ++j) {
+                const auto& [t, u, v] = comps_[j];
+                double fac = q * signed_inv_fact_[j] * U[j];
+                if (t) EGp[C][0] -= fac * t * cx[t - 1] * cy[u] * cz[v];
+                if (u) EGp[C][1] -= fac * u * cx[t] * cy[u - 1] * cz[v];
+                if (v) EGp[C][2] -= fac * v * cx[t] * cy[u] * cz[v - 1];
+            }
+        }
+    }
+
+    for (int t = 0; t < nthreads; ++t) {
+        grad_on_atoms->add(Gtemps[t]);
+        grad_on_charges->add(EGtemps[t]);
+    }
+}
+
+std::vector<std::pair<double, std::array<double, 3>>> charge_field(
+    const std::vector<std::tuple<double, double, double, double>>& charges) {
+    std::vector<std::pair<double, std::array<double, 3>>> Zxyz;
+    for (const auto& [Z, x, y, z] : charges) Zxyz.push_back({Z, {{x, y, z}}});
+    return Zxyz;
+}
+
+}  // namespace
+
 ExternalPotential::ExternalPotential() : debug_(0), print_(1) {}
 
 ExternalPotential::~ExternalPotential() {}
@@ -51,6 +653,7 @@ ExternalPotential::~ExternalPotential() {}
 void ExternalPotential::clear() {
     charges_.clear();
     bases_.clear();
+    far_field_statistics_.clear();
 }
 
 void ExternalPotential::addCharge(double Z, double x, double y, double z) {
@@ -106,7 +709,13 @@ SharedMatrix ExternalPotential::computePotentialMatrix(std::shared_ptr<BasisSet>
 #endif
 
     // Monopoles
-    if (charges_.size()) {
+    int multipole_order = Process::environment.options.get_int("EXTERN_MULTIPOLE_ORDER");
+    if (charges_.size() && multipole_order > 0) {
+        FarFieldChargeEngine engine(basis, charge_field(charges_), multipole_order,
+                                    Process::environment.options.get_double("EXTERN_MULTIPOLE_THETA"));
+        far_field_statistics_ = engine.compute_potential(V, nthreads);
+    } else if (charges_.size()) {
+        far_field_statistics_.clear();
         std::vector<std::pair<double, std::array<double, 3>>> Zxyz;
         for (size_t i=0; i< charges_.size(); ++i) {
             Zxyz.push_back({std::get<0>(charges_[i]),{{std::get<1>(charges_[i]),
@@ -253,6 +862,15 @@ SharedMatrix ExternalPotential::computePotentialGradients(std::shared_ptr<BasisS
     threads = Process::environment.get_n_threads();
 #endif
 
+    int multipole_order = Process::environment.options.get_int("EXTERN_MULTIPOLE_ORDER");
+    if (multipole_order > 0) {
+        FarFieldChargeEngine engine(basis, Zxyz, multipole_order,
+                                    Process::environment.options.get_double("EXTERN_MULTIPOLE_THETA"));
+        engine.compute_gradient(Dt, grad_on_atoms, grad_on_charges, threads);
+        gradient_on_charges_ = grad_on_charges;
+        return grad_on_atoms;
+    }
+
     // Potential derivatives
     std::vector<std::shared_ptr<PotentialInt> > Vint;
     std::vector<SharedMatrix> Vtemps;
@@ -29,6 +29,7 @@
 #ifndef _psi_src_lib_libmints_extern_potential_h_
 #define _psi_src_lib_libmints_extern_potential_h_
 
+#include <map>
 #include <vector>
 #include <utility>
 #include <string>
@@ -63,6 +64,8 @@ class PSI_API ExternalPotential {
     std::vector<std::pair<std::shared_ptr<BasisSet>, SharedVector> > bases_;
     /// Gradient, if available, as number of charges x 3 SharedMatrix
     SharedMatrix gradient_on_charges_;
+    /// Near, far and clustered charges summed over the shell-pair blocks of the last multipole potential build
+    std::map<std::string, size_t> far_field_statistics_;
 
    public:
     /// Constructur, does nothing
@@ -93,7 +96,8 @@ class PSI_API ExternalPotential {
     /// Reset the field to zero (eliminates all entries)
     void clear();
 
-    /// Compute the external potential matrix in the given basis set
+    /// Compute the external potential matrix in the given basis set.
+    /// Distant point charges are treated by multipole expansion if EXTERN_MULTIPOLE_ORDER > 0.
     SharedMatrix computePotentialMatrix(std::shared_ptr<BasisSet> basis);
     /// Compute the gradients due to the external potential
     SharedMatrix computePotentialGradients(std::shared_ptr<BasisSet> basis, std::shared_ptr<Matrix> Dt);
@@ -105,6 +109,8 @@ class PSI_API ExternalPotential {
 
     /// Returns the gradient on the external potential point charges from the wfn-extern interaction
     SharedMatrix gradient_on_charges();
+    /// Returns how the shell-pair blocks of the last potential build met the charges, empty without multipoles
+    const std::map<std::string, size_t>& far_field_statistics() const { return far_field_statistics_; }
 
     /// Print a trace of the external potential
     void print(const std::string& out_fname = "outfile") const;
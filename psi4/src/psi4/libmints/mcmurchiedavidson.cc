@@ -160,33 +160,13 @@ void fill_M_matrix(int maxam, int maxpow, const Point& PC, double a, double b, s
     }
 }
 
-void fill_R_matrix(int maxam, double p, const Point& P, const Point& C, std::vector<double>& R,
-                   std::shared_ptr<const libint2::FmEval_Chebyshev7<double>> fm_eval) {
-    // Generates the auxiliary integrals for Coulomb-type integrals using eq 9.9.13
-    // from Molecular Electronic-Structure Theory (10.1002/9781119019572)
-    auto PC = point_diff(P, C);
-    auto RPC = point_norm(PC);
-    double T = p * RPC * RPC;
-
-    std::vector<double> fmvals(maxam + 1);
-
-    // evaluate Boys function
-    fm_eval->eval(fmvals.data(), T, maxam);
+namespace {
 
+// Builds R_{tuv}^{n} for t + u + v <= maxam from the R_{000}^{n} already stored in R,
+// using eqs 9.9.18-20 from Molecular Electronic-Structure Theory (10.1002/9781119019572)
+void fill_R_recursion(int maxam, const Point& PC, std::vector<double>& R) {
     int dim1 = maxam + 1;
     int dim2 = dim1 * dim1 * dim1;
-    // R matrix buffer size needs to be at least dim1 * dim2,
-    // only zero out the required part of the buffer for performance
-    std::fill(R.begin(), R.begin() + dim1 * dim2, 0.0);
-
-    // NOTE: avoiding std::pow(-2.0 * p, n)
-    double fac = 1.0;
-    double mult = -2.0 * p;
-    for (int n = 0; n < dim1; ++n) {
-        // eq 9.9.14
-        R[n * dim2] = fac * fmvals[n];
-        fac *= mult;
-    }
     // t + u + v <= N
     // t = 0, u = 0
     for (int v = 1; v < dim1; ++v) {
@@ -234,4 +214,55 @@ void fill_R_matrix(int maxam, double p, const Point& P, const Point& C, std::vec
     }
 }
 
+}  // namespace
+
+void fill_R_matrix(int maxam, double p, const Point& P, const Point& C, std::vector<double>& R,
+                   std::shared_ptr<const libint2::FmEval_Chebyshev7<double>> fm_eval) {
+    // Generates the auxiliary integrals for Coulomb-type integrals using eq 9.9.13
+    // from Molecular Electronic-Structure Theory (10.1002/9781119019572)
+    auto PC = point_diff(P, C);
+    auto RPC = point_norm(PC);
+    double T = p * RPC * RPC;
+
+    std::vector<double> fmvals(maxam + 1);
+
+    // evaluate Boys function
+    fm_eval->eval(fmvals.data(), T, maxam);
+
+    int dim1 = maxam + 1;
+    int dim2 = dim1 * dim1 * dim1;
+    // R matrix buffer size needs to be at least dim1 * dim2,
+    // only zero out the required part of the buffer for performance
+    std::fill(R.begin(), R.begin() + dim1 * dim2, 0.0);
+
+    // NOTE: avoiding std::pow(-2.0 * p, n)
+    double fac = 1.0;
+    double mult = -2.0 * p;
+    for (int n = 0; n < dim1; ++n) {
+        // eq 9.9.14
+        R[n * dim2] = fac * fmvals[n];
+        fac *= mult;
+    }
+    fill_R_recursion(maxam, PC, R);
+}
+
+void fill_R_matrix_point(int maxam, const Point& PC, std::vector<double>& R) {
+    // The p -> infinity limit of fill_R_matrix, i.e. R_{tuv}^{0} are the derivatives
+    // d^{t+u+v} / dPx^t dPy^u dPz^v of 1 / |P - C| for a point charge at C
+    double r2 = PC[0] * PC[0] + PC[1] * PC[1] + PC[2] * PC[2];
+    double oor2 = 1.0 / r2;
+
+    int dim1 = maxam + 1;
+    int dim2 = dim1 * dim1 * dim1;
+    std::fill(R.begin(), R.begin() + dim1 * dim2, 0.0);
+
+    // R_{000}^{n} = (-1)^n (2n - 1)!! / r^{2n + 1}
+    double val = std::sqrt(oor2);
+    for (int n = 0; n < dim1; ++n) {
+        R[n * dim2] = val;
+        val *= -(2 * n + 1) * oor2;
+    }
+    fill_R_recursion(maxam, PC, R);
+}
+
 }  // namespace mdintegrals
\ No newline at end of file
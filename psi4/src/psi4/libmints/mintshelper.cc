@@ -472,6 +472,69 @@ void MintsHelper::one_body_ao_computer(std::vector<std::shared_ptr<OneBodyAOInt>
     }
 }
 
+void MintsHelper::one_body_ao_computer(std::vector<std::shared_ptr<OneBodyAOInt>> ints,
+                                       std::vector<SharedMatrix> &out) {
+    // Grab basis info
+    std::shared_ptr<BasisSet> bs1 = ints[0]->basis1();
+    std::shared_ptr<BasisSet> bs2 = ints[0]->basis2();
+    const bool bs1_equiv_bs2 = (bs1 == bs2);
+
+    const size_t nchunk = ints[0]->nchunk();
+    if (out.size() != nchunk) {
+        throw PSIEXCEPTION("MintsHelper::one_body_ao_computer: result has " + std::to_string(out.size()) +
+                           " matrices, integrals have " + std::to_string(nchunk) + " components.");
+    }
+    std::vector<double **> outp(nchunk);
+    for (size_t chunk = 0; chunk < nchunk; ++chunk) {
+        if (out[chunk]->nirrep() != 1) {
+            throw PSIEXCEPTION("MintsHelper::one_body_ao_computer: result matrices must be of C1 symmetry.");
+        }
+        outp[chunk] = out[chunk]->pointer();
+    }
+
+    // Limit to the number of incoming onebody ints
+    size_t nthread = nthread_;
+    if (nthread > ints.size()) {
+        nthread = ints.size();
+    }
+
+    const double sign = ints[0]->is_antisymmetric() ? -1.0 : 1.0;
+    const auto &shell_pairs = ints[0]->shellpairs();
+    size_t n_pairs = shell_pairs.size();
+
+    // Every shell pair owns the (mu, nu) block and, for a square basis, its transpose, so the
+    // accumulation below is race-free and adds the same values in the same order for any thread count
+#pragma omp parallel for schedule(guided) num_threads(nthread)
+    for (size_t p = 0; p < n_pairs; ++p) {
+        size_t rank = 0;
+#ifdef _OPENMP
+        rank = omp_get_thread_num();
+#endif
+        auto mu = shell_pairs[p].first;
+        auto nu = shell_pairs[p].second;
+        const size_t num_mu = bs1->shell(mu).nfunction();
+        const size_t index_mu = bs1->shell(mu).function_index();
+        const size_t num_nu = bs2->shell(nu).nfunction();
+        const size_t index_nu = bs2->shell(nu).function_index();
+        const bool transpose = bs1_equiv_bs2 && mu != nu;
+
+        ints[rank]->compute_shell(mu, nu);
+        const auto &buffers = ints[rank]->buffers();
+
+        for (size_t chunk = 0; chunk < nchunk; ++chunk) {
+            const double *ints_buff = buffers[chunk];
+            double **matp = outp[chunk];
+            for (size_t i = index_mu; i < (index_mu + num_mu); ++i) {
+                for (size_t j = index_nu; j < (index_nu + num_nu); ++j) {
+                    matp[i][j] += *ints_buff;
+                    if (transpose) matp[j][i] += sign * (*ints_buff);
+                    ints_buff++;
+                }
+            }
+        }
+    }
+}
+
 void MintsHelper::grad_two_center_computer(std::vector<std::shared_ptr<OneBodyAOInt>> ints, SharedMatrix D,
                                            SharedMatrix out) {
     // Grab basis info
@@ -1560,8 +1623,11 @@ std::vector<SharedMatrix> MintsHelper::ao_angular_momentum() {
     angmom.push_back(std::make_shared<Matrix>("AO Ly", basisset_->nbf(), basisset_->nbf()));
     angmom.push_back(std::make_shared<Matrix>("AO Lz", basisset_->nbf(), basisset_->nbf()));
 
-    std::shared_ptr<OneBodyAOInt> ints(integral_->ao_angular_momentum());
-    ints->compute(angmom);
+    std::vector<std::shared_ptr<OneBodyAOInt>> ints_vec;
+    for (size_t i = 0; i < nthread_; i++) {
+        ints_vec.push_back(std::shared_ptr<OneBodyAOInt>(integral_->ao_angular_momentum()));
+    }
+    one_body_ao_computer(ints_vec, angmom);
 
     return angmom;
 }
@@ -1574,8 +1640,11 @@ std::vector<SharedMatrix> MintsHelper::ao_dipole() {
     dipole.push_back(std::make_shared<Matrix>("AO Muy", basisset_->nbf(), basisset_->nbf()));
     dipole.push_back(std::make_shared<Matrix>("AO Muz", basisset_->nbf(), basisset_->nbf()));
 
-    std::shared_ptr<OneBodyAOInt> ints(integral_->ao_dipole());
-    ints->compute(dipole);
+    std::vector<std::shared_ptr<OneBodyAOInt>> ints_vec;
+    for (size_t i = 0; i < nthread_; i++) {
+        ints_vec.push_back(std::shared_ptr<OneBodyAOInt>(integral_->ao_dipole()));
+    }
+    one_body_ao_computer(ints_vec, dipole);
 
     return dipole;
 }
@@ -1591,8 +1660,11 @@ std::vector<SharedMatrix> MintsHelper::ao_quadrupole() {
     quadrupole.push_back(std::make_shared<Matrix>("AO Quadrupole YZ", basisset_->nbf(), basisset_->nbf()));
     quadrupole.push_back(std::make_shared<Matrix>("AO Quadrupole ZZ", basisset_->nbf(), basisset_->nbf()));
 
-    std::shared_ptr<OneBodyAOInt> ints(integral_->ao_quadrupole());
-    ints->compute(quadrupole);
+    std::vector<std::shared_ptr<OneBodyAOInt>> ints_vec;
+    for (size_t i = 0; i < nthread_; i++) {
+        ints_vec.push_back(std::shared_ptr<OneBodyAOInt>(integral_->ao_quadrupole()));
+    }
+    one_body_ao_computer(ints_vec, quadrupole);
 
     return quadrupole;
 }
@@ -1608,8 +1680,11 @@ std::vector<SharedMatrix> MintsHelper::ao_traceless_quadrupole() {
     quadrupole.push_back(std::make_shared<Matrix>("AO Traceless Quadrupole YZ", basisset_->nbf(), basisset_->nbf()));
     quadrupole.push_back(std::make_shared<Matrix>("AO Traceless Quadrupole ZZ", basisset_->nbf(), basisset_->nbf()));
 
-    std::shared_ptr<OneBodyAOInt> ints(integral_->ao_traceless_quadrupole());
-    ints->compute(quadrupole);
+    std::vector<std::shared_ptr<OneBodyAOInt>> ints_vec;
+    for (size_t i = 0; i < nthread_; i++) {
+        ints_vec.push_back(std::shared_ptr<OneBodyAOInt>(integral_->ao_traceless_quadrupole()));
+    }
+    one_body_ao_computer(ints_vec, quadrupole);
 
     return quadrupole;
 }
@@ -1645,9 +1720,12 @@ std::vector<SharedMatrix> MintsHelper::ao_multipoles(int order, const std::vecto
             }
         }
     }
-    std::shared_ptr<OneBodyAOInt> multipole_int(integral_->ao_multipoles(order));
-    multipole_int->set_origin(v3origin);
-    multipole_int->compute(ret);
+    std::vector<std::shared_ptr<OneBodyAOInt>> ints_vec;
+    for (size_t i = 0; i < nthread_; i++) {
+        ints_vec.push_back(std::shared_ptr<OneBodyAOInt>(integral_->ao_multipoles(order)));
+        ints_vec.back()->set_origin(v3origin);
+    }
+    one_body_ao_computer(ints_vec, ret);
     return ret;
 }
 
@@ -1713,9 +1791,12 @@ std::vector<SharedMatrix> MintsHelper::ao_multipole_potential(int order, const s
             }
         }
     }
-    std::shared_ptr<OneBodyAOInt> ints(integral_->ao_multipole_potential(order, deriv));
-    ints->set_origin(v3origin);
-    ints->compute(ret);
+    std::vector<std::shared_ptr<OneBodyAOInt>> ints_vec;
+    for (size_t i = 0; i < nthread_; i++) {
+        ints_vec.push_back(std::shared_ptr<OneBodyAOInt>(integral_->ao_multipole_potential(order, deriv)));
+        ints_vec.back()->set_origin(v3origin);
+    }
+    one_body_ao_computer(ints_vec, ret);
     return ret;
 }
 
@@ -1758,18 +1839,24 @@ SharedMatrix MintsHelper::electric_field_value(SharedMatrix coords, SharedMatrix
 SharedMatrix MintsHelper::ao_potential_erf(const std::vector<double> &origin, double omega, int deriv) {
     SharedMatrix int_erf = std::make_shared<Matrix>("AO Potential Erf", basisset_->nbf(), basisset_->nbf());
     Vector3 v3origin(origin[0], origin[1], origin[2]);
-    std::shared_ptr<OneBodyAOInt> ints(integral_->ao_potential_erf(omega, deriv));
-    ints->set_origin(v3origin);
-    ints->compute(int_erf);
+    std::vector<std::shared_ptr<OneBodyAOInt>> ints_vec;
+    for (size_t i = 0; i < nthread_; i++) {
+        ints_vec.push_back(std::shared_ptr<OneBodyAOInt>(integral_->ao_potential_erf(omega, deriv)));
+        ints_vec.back()->set_origin(v3origin);
+    }
+    one_body_ao_computer(ints_vec, int_erf, true);
     return int_erf;
 }
 
 SharedMatrix MintsHelper::ao_potential_erf_complement(const std::vector<double> &origin, double omega, int deriv) {
     SharedMatrix int_erfc = std::make_shared<Matrix>("AO Potential Erf Complement", basisset_->nbf(), basisset_->nbf());
     Vector3 v3origin(origin[0], origin[1], origin[2]);
-    std::shared_ptr<OneBodyAOInt> ints(integral_->ao_potential_erf_complement(omega, deriv));
-    ints->set_origin(v3origin);
-    ints->compute(int_erfc);
+    std::vector<std::shared_ptr<OneBodyAOInt>> ints_vec;
+    for (size_t i = 0; i < nthread_; i++) {
+        ints_vec.push_back(std::shared_ptr<OneBodyAOInt>(integral_->ao_potential_erf_complement(omega, deriv)));
+        ints_vec.back()->set_origin(v3origin);
+    }
+    one_body_ao_computer(ints_vec, int_erfc, true);
     return int_erfc;
 }
 
@@ -1781,8 +1868,11 @@ std::vector<SharedMatrix> MintsHelper::ao_nabla() {
     nabla.push_back(std::make_shared<Matrix>("AO Py", basisset_->nbf(), basisset_->nbf()));
     nabla.push_back(std::make_shared<Matrix>("AO Pz", basisset_->nbf(), basisset_->nbf()));
 
-    std::shared_ptr<OneBodyAOInt> ints(integral_->ao_nabla());
-    ints->compute(nabla);
+    std::vector<std::shared_ptr<OneBodyAOInt>> ints_vec;
+    for (size_t i = 0; i < nthread_; i++) {
+        ints_vec.push_back(std::shared_ptr<OneBodyAOInt>(integral_->ao_nabla()));
+    }
+    one_body_ao_computer(ints_vec, nabla);
 
     return nabla;
 }
@@ -2723,18 +2813,18 @@ void MintsHelper::play() {}
 std::vector<SharedMatrix> MintsHelper::ao_overlap_kinetic_deriv1_helper(const std::string &type, int atom) {
     std::array<std::string, 3> cartcomp{{"X", "Y", "Z"}};
 
-    std::shared_ptr<OneBodyAOInt> GInt;
-
-    if (type == "OVERLAP") {
-        std::shared_ptr<OneBodyAOInt> Int(integral_->ao_overlap(1));
-        GInt = Int;
-    } else {
-        std::shared_ptr<OneBodyAOInt> Int(integral_->ao_kinetic(1));
-        GInt = Int;
+    // One integral object per thread
+    std::vector<std::shared_ptr<OneBodyAOInt>> GInt;
+    for (size_t i = 0; i < nthread_; i++) {
+        if (type == "OVERLAP") {
+            GInt.push_back(std::shared_ptr<OneBodyAOInt>(integral_->ao_overlap(1)));
+        } else {
+            GInt.push_back(std::shared_ptr<OneBodyAOInt>(integral_->ao_kinetic(1)));
+        }
     }
 
-    std::shared_ptr<BasisSet> bs1 = GInt->basis1();
-    std::shared_ptr<BasisSet> bs2 = GInt->basis2();
+    std::shared_ptr<BasisSet> bs1 = GInt[0]->basis1();
+    std::shared_ptr<BasisSet> bs2 = GInt[0]->basis2();
 
     int nbf1 = bs1->nbf();
     int nbf2 = bs2->nbf();
@@ -2746,11 +2836,16 @@ std::vector<SharedMatrix> MintsHelper::ao_overlap_kinetic_deriv1_helper(const st
         grad.push_back(std::make_shared<Matrix>(sstream.str(), nbf1, nbf2));
     }
 
-    const auto &shell_pairs = GInt->shellpairs();
+    const auto &shell_pairs = GInt[0]->shellpairs();
     size_t n_pairs = shell_pairs.size();
 
-    // Loop it
+    // Each shell pair only touches its own (P, Q) and (Q, P) blocks, so threads never collide
+#pragma omp parallel for schedule(guided) num_threads(nthread_)
     for (size_t p = 0; p < n_pairs; ++p) {
+        size_t rank = 0;
+#ifdef _OPENMP
+        rank = omp_get_thread_num();
+#endif
         auto P = shell_pairs[p].first;
         auto Q = shell_pairs[p].second;
         const auto &shellP = basisset_->shell(P);
@@ -2766,8 +2861,8 @@ std::vector<SharedMatrix> MintsHelper::ao_overlap_kinetic_deriv1_helper(const st
 
         if (aP != atom && aQ != atom) continue;
 
-        GInt->compute_shell_deriv1(P, Q);
-        const auto &buffers = GInt->buffers();
+        GInt[rank]->compute_shell_deriv1(P, Q);
+        const auto &buffers = GInt[rank]->buffers();
         double scale = P == Q ? 0.5 : 1.0;
 
         if (aP == atom) {
@@ -2829,9 +2924,13 @@ std::vector<SharedMatrix> MintsHelper::ao_overlap_kinetic_deriv1_helper(const st
 std::vector<SharedMatrix> MintsHelper::ao_potential_deriv1_helper(int atom) {
     std::array<std::string, 3> cartcomp{{"X", "Y", "Z"}};
 
-    std::shared_ptr<OneBodyAOInt> Vint(integral_->ao_potential(1));
-    std::shared_ptr<BasisSet> bs1 = Vint->basis1();
-    std::shared_ptr<BasisSet> bs2 = Vint->basis2();
+    // One integral object per thread
+    std::vector<std::shared_ptr<OneBodyAOInt>> Vint;
+    for (size_t i = 0; i < nthread_; i++) {
+        Vint.push_back(std::shared_ptr<OneBodyAOInt>(integral_->ao_potential(1)));
+    }
+    std::shared_ptr<BasisSet> bs1 = Vint[0]->basis1();
+    std::shared_ptr<BasisSet> bs2 = Vint[0]->basis2();
 
     int nbf1 = bs1->nbf();
     int nbf2 = bs2->nbf();
@@ -2845,11 +2944,16 @@ std::vector<SharedMatrix> MintsHelper::ao_potential_deriv1_helper(int atom) {
         grad.push_back(std::make_shared<Matrix>(sstream.str(), nbf1, nbf2));
     }
 
-    const auto &shell_pairs = Vint->shellpairs();
+    const auto &shell_pairs = Vint[0]->shellpairs();
     size_t n_pairs = shell_pairs.size();
 
-    // Loop it
+    // Each shell pair only touches its own (P, Q) and (Q, P) blocks, so threads never collide
+#pragma omp parallel for schedule(guided) num_threads(nthread_)
     for (size_t p = 0; p < n_pairs; ++p) {
+        size_t rank = 0;
+#ifdef _OPENMP
+        rank = omp_get_thread_num();
+#endif
         auto P = shell_pairs[p].first;
         auto Q = shell_pairs[p].second;
         const auto &shellP = bs1->shell(P);
@@ -2863,8 +2967,8 @@ std::vector<SharedMatrix> MintsHelper::ao_potential_deriv1_helper(int atom) {
         int oQ = shellQ.function_index();
         int aQ = shellQ.ncenter();
 
-        Vint->compute_shell_deriv1(P, Q);
-        const auto &buffers = Vint->buffers();
+        Vint[rank]->compute_shell_deriv1(P, Q);
+        const auto &buffers = Vint[rank]->buffers();
 
         double scale = P == Q ? 0.5 : 1.0;
 
@@ -3059,10 +3163,15 @@ std::vector<SharedMatrix> MintsHelper::ao_potential_deriv2_helper(int atom1, int
     /* NOTE: the x, y, and z in this vector must remain lowercase for this function */
     std::array<std::string, 3> cartcomp{{"x", "y", "z"}};
 
-    std::shared_ptr<OneBodyAOInt> Vint(integral_->ao_potential(2));
+    // One integral object per thread, as the charge field is reset for every shell pair
+    std::vector<std::shared_ptr<PotentialInt>> Vint;
+    for (size_t i = 0; i < nthread_; i++) {
+        std::shared_ptr<OneBodyAOInt> Int(integral_->ao_potential(2));
+        Vint.push_back(std::dynamic_pointer_cast<PotentialInt>(Int));
+    }
 
-    std::shared_ptr<BasisSet> bs1 = Vint->basis1();
-    std::shared_ptr<BasisSet> bs2 = Vint->basis2();
+    std::shared_ptr<BasisSet> bs1 = Vint[0]->basis1();
+    std::shared_ptr<BasisSet> bs2 = Vint[0]->basis2();
 
     // Sets up the field of partial charges
     std::vector<std::pair<double, std::array<double, 3>>> full_params;
@@ -3089,10 +3198,16 @@ std::vector<SharedMatrix> MintsHelper::ao_potential_deriv2_helper(int atom1, int
         return std::min(i, j) * (2 * matrix_dim - std::min(i, j) - 1) / 2 + std::max(i, j);
     };
 
-    const auto &shell_pairs = Vint->shellpairs();
+    const auto &shell_pairs = Vint[0]->shellpairs();
     size_t n_pairs = shell_pairs.size();
 
+    // Each shell pair only touches its own (P, Q) and (Q, P) blocks, so threads never collide
+#pragma omp parallel for schedule(guided) num_threads(nthread_)
     for (size_t p = 0; p < n_pairs; ++p) {
+        size_t rank = 0;
+#ifdef _OPENMP
+        rank = omp_get_thread_num();
+#endif
         auto P = shell_pairs[p].first;
         auto Q = shell_pairs[p].second;
         const auto &shellP = bs1->shell(P);
@@ -3113,18 +3228,18 @@ std::vector<SharedMatrix> MintsHelper::ao_potential_deriv2_helper(int atom1, int
             // atom2
             do_full_field = false;
             num_buffers = 12;
-            std::dynamic_pointer_cast<PotentialInt>(Vint)->set_charge_field(
+            Vint[rank]->set_charge_field(
                 {{(double)mol->Z(atom1), {mol->x(atom1), mol->y(atom1), mol->z(atom1)}},
                  {(double)mol->Z(atom2), {mol->x(atom2), mol->y(atom2), mol->z(atom2)}}});
         } else {
             // One of the atoms of interest is in the bra or ket - do a full computation
             do_full_field = true;
             num_buffers = 3 * (natom + 2);
-            std::dynamic_pointer_cast<PotentialInt>(Vint)->set_charge_field(full_params);
+            Vint[rank]->set_charge_field(full_params);
         }
 
-        Vint->compute_shell_deriv2(P, Q);
-        const auto &buffers = Vint->buffers();
+        Vint[rank]->compute_shell_deriv2(P, Q);
+        const auto &buffers = Vint[rank]->buffers();
 
         double perm = P == Q ? 0.5 : 1.0;
         // clang-format off
@@ -3331,18 +3446,18 @@ std::vector<SharedMatrix> MintsHelper::ao_potential_deriv2_helper(int atom1, int
 std::vector<SharedMatrix> MintsHelper::ao_overlap_kinetic_deriv2_helper(const std::string &type, int atom1, int atom2) {
     std::array<std::string, 3> cartcomp{{"X", "Y", "Z"}};
 
-    std::shared_ptr<OneBodyAOInt> GInt;
-
-    if (type == "OVERLAP") {
-        std::shared_ptr<OneBodyAOInt> Int(integral_->ao_overlap(2));
-        GInt = Int;
-    } else {
-        std::shared_ptr<OneBodyAOInt> Int(integral_->ao_kinetic(2));
-        GInt = Int;
+    // One integral object per thread
+    std::vector<std::shared_ptr<OneBodyAOInt>> GInt;
+    for (size_t i = 0; i < nthread_; i++) {
+        if (type == "OVERLAP") {
+            GInt.push_back(std::shared_ptr<OneBodyAOInt>(integral_->ao_overlap(2)));
+        } else {
+            GInt.push_back(std::shared_ptr<OneBodyAOInt>(integral_->ao_kinetic(2)));
+        }
     }
 
-    std::shared_ptr<BasisSet> bs1 = GInt->basis1();
-    std::shared_ptr<BasisSet> bs2 = GInt->basis2();
+    std::shared_ptr<BasisSet> bs1 = GInt[0]->basis1();
+    std::shared_ptr<BasisSet> bs2 = GInt[0]->basis2();
 
     int nbf1 = bs1->nbf();
     int nbf2 = bs2->nbf();
@@ -3356,10 +3471,16 @@ std::vector<SharedMatrix> MintsHelper::ao_overlap_kinetic_deriv2_helper(const st
         }
     }
 
-    const auto &shell_pairs = GInt->shellpairs();
+    const auto &shell_pairs = GInt[0]->shellpairs();
     size_t n_pairs = shell_pairs.size();
 
+    // Each shell pair only touches its own (P, Q) and (Q, P) blocks, so threads never collide
+#pragma omp parallel for schedule(guided) num_threads(nthread_)
     for (size_t p = 0; p < n_pairs; ++p) {
+        size_t rank = 0;
+#ifdef _OPENMP
+        rank = omp_get_thread_num();
+#endif
         auto P = shell_pairs[p].first;
         auto Q = shell_pairs[p].second;
         const auto &shellP = bs1->shell(P);
@@ -3375,8 +3496,8 @@ std::vector<SharedMatrix> MintsHelper::ao_overlap_kinetic_deriv2_helper(const st
 
         if (aP != atom1 && aQ != atom1 && aP != atom2 && aQ != atom2) continue;
 
-        GInt->compute_shell_deriv2(P, Q);
-        const auto &buffers = GInt->buffers();
+        GInt[rank]->compute_shell_deriv2(P, Q);
+        const auto &buffers = GInt[rank]->buffers();
 
         double perm = P == Q ? 0.5 : 1.0;
 
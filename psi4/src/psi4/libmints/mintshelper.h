@@ -100,6 +100,17 @@ class PSI_API MintsHelper {
      * @param[in] symm Use symmetry flag
      */
     void one_body_ao_computer(std::vector<std::shared_ptr<OneBodyAOInt>> ints, SharedMatrix out, bool symm);
+    /**
+     * @brief Accumulate every component of a multi-component one-body operator.
+     *
+     * Threaded counterpart of OneBodyAOInt::compute(std::vector<SharedMatrix>&): each thread
+     * computes shell pairs with its own integral object and adds them into the blocks that
+     * pair owns, so the result does not depend on the number of threads.
+     *
+     * @param[in] ints Vector of OneBodyAOInt integrals, one per thread
+     * @param[in,out] out Matrices to accumulate into, one per integral component
+     */
+    void one_body_ao_computer(std::vector<std::shared_ptr<OneBodyAOInt>> ints, std::vector<SharedMatrix>& out);
     void grad_two_center_computer(std::vector<std::shared_ptr<OneBodyAOInt>> ints, SharedMatrix D, SharedMatrix out);
     /// Helper function to convert ao integrals to so and cache them
     void cache_ao_to_so_ints(SharedMatrix ao_ints, const std::string& label, bool include_perturbation);
@@ -56,12 +56,17 @@
 #include "psi4/libmints/petitelist.h"
 #include "psi4/libmints/multipoles.h"
 #include "psi4/libmints/dipole.h"
+#include "psi4/libmints/mcmurchiedavidson.h"
 #include "psi4/libpsi4util/libpsi4util.h"
 #include "psi4/libpsi4util/PsiOutStream.h"
 #include "psi4/libpsi4util/process.h"
 #include "psi4/libfock/cubature.h"
 #include "psi4/libfock/points.h"
 
+#include <libint2/shell.h>
+#include <libint2/boys.h>
+
+#include <algorithm>
 #include <iostream>
 #include <cstdlib>
 #include <cstdio>
@@ -72,6 +77,8 @@
 #include <regex>
 #include <tuple>
 #include <functional>
+#include <iterator>
+#include <numeric>
 #include <memory>
 #include <map>
 #include <vector>
@@ -1037,6 +1044,50 @@ class PSI_API GridIterator {
     ~GridIterator() { gridfile_.close(); }
 };
 
+namespace {
+
+/**
+ * A primitive basis function product contracted with the density and expanded in Hermite Gaussians,
+ * sum_tuv h_tuv Lambda_tuv(p, P). The 2 pi / p of the potential integrals is folded into h.
+ */
+struct HermiteDistribution {
+    double p;
+    mdintegrals::Point P;
+    int L;
+    /// (L + 1)^3 coefficients laid out as address_3d(t, u, v, L + 1, L + 1), zero for t + u + v > L
+    std::vector<double> h;
+    /// Sum of |h_tuv| over t + u + v = n, for bounding the far-field potential
+    std::vector<double> moments;
+};
+
+/// Recursively splits order[first, last) at the median of the longest extent until blocks hold at most max_points
+void partition_points(const std::vector<Vector3>& points, std::vector<size_t>& order, size_t first, size_t last,
+                      size_t max_points, std::vector<std::pair<size_t, size_t>>& blocks) {
+    if (last - first <= max_points) {
+        blocks.emplace_back(first, last);
+        return;
+    }
+    Vector3 lo = points[order[first]];
+    Vector3 hi = lo;
+    for (size_t i = first; i < last; i++) {
+        for (int k = 0; k < 3; k++) {
+            lo[k] = std::min(lo[k], points[order[i]][k]);
+            hi[k] = std::max(hi[k], points[order[i]][k]);
+        }
+    }
+    int axis = 0;
+    for (int k = 1; k < 3; k++) {
+        if (hi[k] - lo[k] > hi[axis] - lo[axis]) axis = k;
+    }
+    size_t mid = first + (last - first) / 2;
+    std::nth_element(order.begin() + first, order.begin() + mid, order.begin() + last,
+                     [&](size_t a, size_t b) { return points[a][axis] < points[b][axis]; });
+    partition_points(points, order, first, mid, max_points, blocks);
+    partition_points(points, order, mid, last, max_points, blocks);
+}
+
+}  // namespace
+
 ESPPropCalc::ESPPropCalc(std::shared_ptr<Wavefunction> wfn) : Prop(wfn) {}
 
 ESPPropCalc::~ESPPropCalc() {}
@@ -1046,40 +1097,24 @@ void OEProp::compute_esp_over_grid() { epc_.compute_esp_over_grid(true); }
 void ESPPropCalc::compute_esp_over_grid(bool print_output) {
     auto mol = basisset_->molecule();
 
-    std::shared_ptr<ElectrostaticInt> epot(dynamic_cast<ElectrostaticInt*>(integral_->electrostatic().release()));
-
     if (print_output) {
         outfile->Printf("\n Electrostatic potential to be computed on the grid and written to grid_esp.dat\n");
     }
-    SharedMatrix Dtot = wfn_->matrix_subset_helper(Da_so_, Ca_so_, "AO", "D");
-    if (same_dens_) {
-        Dtot->scale(2.0);
-    } else {
-        Dtot->add(wfn_->matrix_subset_helper(Db_so_, Cb_so_, "AO", "D beta"));
-    }
 
-    int nbf = basisset_->nbf();
-    auto ints = std::make_shared<Matrix>("Ex integrals", nbf, nbf);
-
-    Vvals_.clear();
-    FILE* gridout = fopen("grid_esp.dat", "w");
-    if (!gridout) throw PSIEXCEPTION("Unable to write to grid_esp.dat");
+    std::vector<Vector3> points;
     GridIterator griditer("grid.dat");
     for (griditer.first(); !griditer.last(); griditer.next()) {
         Vector3 origin(griditer.gridpoints());
         if (mol->units() == Molecule::Angstrom) origin /= pc_bohr2angstroms;
-        ints->zero();
-        epot->compute(ints, origin);
-        double Velec = Dtot->vector_dot(ints);
-        double Vnuc = 0.0;
-        int natom = mol->natom();
-        for (int i = 0; i < natom; i++) {
-            Vector3 dR = origin - mol->xyz(i);
-            double r = dR.norm();
-            if (r > 1.0E-8) Vnuc += mol->Z(i) / r;
-        }
-        Vvals_.push_back(Velec + Vnuc);
-        fprintf(gridout, "%16.10f\n", Velec + Vnuc);
+        points.push_back(origin);
+    }
+
+    Vvals_ = compute_esp_batched(points);
+
+    FILE* gridout = fopen("grid_esp.dat", "w");
+    if (!gridout) throw PSIEXCEPTION("Unable to write to grid_esp.dat");
+    for (double V : Vvals_) {
+        fprintf(gridout, "%16.10f\n", V);
     }
     fclose(gridout);
 }
@@ -1097,6 +1132,30 @@ SharedVector ESPPropCalc::compute_esp_over_grid_in_memory(SharedMatrix input_gri
     SharedVector output = std::make_shared<Vector>(number_of_grid_points);
 
     std::shared_ptr<Molecule> mol = basisset_->molecule();
+    bool convert = mol->units() == Molecule::Angstrom;
+
+    std::vector<Vector3> points(number_of_grid_points);
+    for (int i = 0; i < number_of_grid_points; ++i) {
+        points[i] = Vector3(input_grid->get(i, 0), input_grid->get(i, 1), input_grid->get(i, 2));
+        if (convert) points[i] /= pc_bohr2angstroms;
+    }
+
+    std::vector<double> V = compute_esp_batched(points);
+    std::copy(V.begin(), V.end(), output->pointer());
+    return output;
+}
+
+std::vector<double> ESPPropCalc::compute_esp_batched(const std::vector<Vector3>& points) const {
+    using namespace mdintegrals;
+
+    Options& options = Process::environment.options;
+    const double tol = options.get_double("GRID_ESP_TOLERANCE");
+    const size_t max_points = std::max(1, options.get_int("GRID_ESP_BLOCK_MAX_POINTS"));
+    // Beyond p |P - C|^2 = 36 a Hermite Gaussian is a point multipole to within exp(-36) relative
+    const double far_field_T = 36.0;
+
+    std::shared_ptr<Molecule> mol = basisset_->molecule();
+    int natom = mol->natom();
 
     SharedMatrix Dtot = wfn_->matrix_subset_helper(Da_so_, Ca_so_, "AO", "D");
     if (same_dens_) {
@@ -1104,54 +1163,241 @@ SharedVector ESPPropCalc::compute_esp_over_grid_in_memory(SharedMatrix input_gri
     } else {
         Dtot->add(wfn_->matrix_subset_helper(Db_so_, Cb_so_, "AO", "D beta"));
     }
-
-    int const nbf = basisset_->nbf();
-
-    bool convert = mol->units() == Molecule::Angstrom;
+    double** Dp = Dtot->pointer();
 
     int nthreads = 1;
 #ifdef _OPENMP
     nthreads = Process::environment.get_n_threads();
 #endif
 
-    std::vector<std::shared_ptr<Matrix>> VtempT;
-    std::vector<std::shared_ptr<ElectrostaticInt>> VintT;
+    int maxam = basisset_->max_am();
+    int maxL = 2 * maxam;
+    auto fm_eval = libint2::FmEval_Chebyshev7<double>::instance(maxL);
+
+    // => Cartesian-to-pure transformation, pure rows by Cartesian columns <= //
+
+    std::vector<std::vector<double>> pure_coefs(maxam + 1);
+    for (int l = 0; l <= maxam; l++) {
+        pure_coefs[l].assign((2 * l + 1) * INT_NCART(l), 0.0);
+        const SphericalTransform* trans = integral_->spherical_transform(l);
+        for (int i = 0; i < trans->n(); i++) {
+            pure_coefs[l][trans->pureindex(i) * INT_NCART(l) + trans->cartindex(i)] += trans->coef(i);
+        }
+    }
+
+    // => Density-contracted Hermite distributions, once per significant primitive pair <= //
+
+    std::vector<std::pair<int, int>> shell_pairs;
+    for (int M = 0; M < basisset_->nshell(); M++) {
+        for (int N = 0; N <= M; N++) {
+            shell_pairs.emplace_back(M, N);
+        }
+    }
+
+    size_t esize = (maxam + 1) * (maxam + 1) * (maxL + 2);
+    std::vector<std::vector<HermiteDistribution>> pair_distributions(shell_pairs.size());
+
+#pragma omp parallel num_threads(nthreads)
+    {
+        std::vector<double> Ex(esize), Ey(esize), Ez(esize);
+        std::vector<double> Dblock, Dhalf, Dcart;
+
+#pragma omp for schedule(dynamic)
+        for (size_t MN = 0; MN < shell_pairs.size(); MN++) {
+            int M = shell_pairs[MN].first;
+            int N = shell_pairs[MN].second;
+            const libint2::Shell& s1 = basisset_->l2_shell(M);
+            const libint2::Shell& s2 = basisset_->l2_shell(N);
+            int am1 = s1.contr[0].l;
+            int am2 = s2.contr[0].l;
+            int nbf1 = s1.size();
+            int nbf2 = s2.size();
+            int ncart1 = s1.cartesian_size();
+            int ncart2 = s2.cartesian_size();
+            int off1 = basisset_->shell(M).function_index();
+            int off2 = basisset_->shell(N).function_index();
+
+            // The pair stands in for both (M, N) and (N, M)
+            Dblock.assign(nbf1 * nbf2, 0.0);
+            double Dmax = 0.0;
+            for (int m = 0; m < nbf1; m++) {
+                for (int n = 0; n < nbf2; n++) {
+                    double val = Dp[off1 + m][off2 + n];
+                    if (M != N) val += Dp[off2 + n][off1 + m];
+                    Dblock[m * nbf2 + n] = val;
+                    Dmax = std::max(Dmax, std::fabs(val));
+                }
+            }
+            if (Dmax == 0.0) continue;
+
+            // Back-transform the density block to Cartesian functions
+            Dhalf.assign(ncart1 * nbf2, 0.0);
+            if (s1.contr[0].pure && am1 > 0) {
+                const double* T1 = pure_coefs[am1].data();
+                for (int m = 0; m < nbf1; m++) {
+                    for (int c = 0; c < ncart1; c++) {
+                        double coef = T1[m * ncart1 + c];
+                        if (coef == 0.0) continue;
+                        for (int n = 0; n < nbf2; n++) Dhalf[c * nbf2 + n] += coef * Dblock[m * nbf2 + n];
+                    }
+                }
+            } else {
+                Dhalf = Dblock;
+            }
+            Dcart.assign(ncart1 * ncart2, 0.0);
+            if (s2.contr[0].pure && am2 > 0) {
+                const double* T2 = pure_coefs[am2].data();
+                for (int c = 0; c < ncart1; c++) {
+                    for (int n = 0; n < nbf2; n++) {
+                        double val = Dhalf[c * nbf2 + n];
+                        if (val == 0.0) continue;
+                        for (int d = 0; d < ncart2; d++) Dcart[c * ncart2 + d] += val * T2[n * ncart2 + d];
+                    }
+                }
+            } else {
+                Dcart = Dhalf;
+            }
 
-    for (int thread = 0; thread < nthreads; thread++) {
-        VtempT.push_back(std::make_shared<Matrix>("ints", nbf, nbf));
-        VintT.push_back(std::shared_ptr<ElectrostaticInt>(static_cast<ElectrostaticInt*>(integral_->electrostatic().release())));
+            auto comps_am1 = generate_am_components_cca(am1);
+            auto comps_am2 = generate_am_components_cca(am2);
+            int L = am1 + am2;
+            int L1 = L + 1;
+            int edim2 = am2 + 1;
+            int edim3 = am1 + am2 + 2;
+
+            Point A = s1.O;
+            Point B = s2.O;
+            for (int p1 = 0; p1 < s1.nprim(); ++p1) {
+                double a = s1.alpha[p1];
+                double ca = s1.contr[0].coeff[p1];
+                for (int p2 = 0; p2 < s2.nprim(); ++p2) {
+                    double b = s2.alpha[p2];
+                    double cb = s2.contr[0].coeff[p2];
+
+                    double p = a + b;
+                    Point P{(a * A[0] + b * B[0]) / p, (a * A[1] + b * B[1]) / p, (a * A[2] + b * B[2]) / p};
+                    double prefac = 2.0 * M_PI * ca * cb / p;
+
+                    fill_E_matrix(am1, am2, P, A, B, a, b, Ex, Ey, Ez);
+
+                    HermiteDistribution dist{p, P, L, std::vector<double>(L1 * L1 * L1, 0.0),
+                                             std::vector<double>(L1, 0.0)};
+                    int ao12 = 0;
+                    for (const auto& comp_am1 : comps_am1) {
+                        for (const auto& comp_am2 : comps_am2) {
+                            double d = prefac * Dcart[ao12++];
+                            if (d == 0.0) continue;
+                            const double* Ex_p = &Ex[edim3 * (comp_am2[0] + edim2 * comp_am1[0])];
+                            const double* Ey_p = &Ey[edim3 * (comp_am2[1] + edim2 * comp_am1[1])];
+                            const double* Ez_p = &Ez[edim3 * (comp_am2[2] + edim2 * comp_am1[2])];
+                            for (int t = 0; t <= comp_am1[0] + comp_am2[0]; ++t) {
+                                for (int u = 0; u <= comp_am1[1] + comp_am2[1]; ++u) {
+                                    for (int v = 0; v <= comp_am1[2] + comp_am2[2]; ++v) {
+                                        dist.h[address_3d(t, u, v, L1, L1)] += d * Ex_p[t] * Ey_p[u] * Ez_p[v];
+                                    }
+                                }
+                            }
+                        }
+                    }
+
+                    // Screen on the largest potential the distribution can produce, |R_tuv| <~ (2p)^(n/2)
+                    double bound = 0.0;
+                    for (int t = 0; t <= L; ++t) {
+                        for (int u = 0; u <= L - t; ++u) {
+                            for (int v = 0; v <= L - t - u; ++v) {
+                                dist.moments[t + u + v] += std::fabs(dist.h[address_3d(t, u, v, L1, L1)]);
+                            }
+                        }
+                    }
+                    for (int n = 0; n <= L; ++n) bound += dist.moments[n] * std::pow(2.0 * p, 0.5 * n);
+                    if (bound < tol) continue;
+
+                    pair_distributions[MN].push_back(std::move(dist));
+                }
+            }
+        }
     }
 
-#ifdef _OPENMP
-#pragma omp parallel for schedule(dynamic)
-#endif
-    for (int i = 0; i < number_of_grid_points; ++i) {
-        Vector3 origin(input_grid->get(i, 0), input_grid->get(i, 1), input_grid->get(i, 2));
-        if (convert) origin /= pc_bohr2angstroms;
-         
-        // Thread info
-        int thread = 0;
-#ifdef _OPENMP
-        thread = omp_get_thread_num();
-#endif
-        // => Electronic part <= //
-        VtempT[thread]->zero();
-        VintT[thread]->compute(VtempT[thread],origin);
-        
-        double Velec = Dtot->vector_dot(VtempT[thread]);
+    std::vector<HermiteDistribution> distributions;
+    for (auto& pair : pair_distributions) {
+        std::move(pair.begin(), pair.end(), std::back_inserter(distributions));
+    }
+    pair_distributions.clear();
+
+    // => Spatial blocks of points <= //
+
+    std::vector<size_t> order(points.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::vector<std::pair<size_t, size_t>> blocks;
+    if (points.size()) partition_points(points, order, 0, points.size(), max_points, blocks);
+
+    std::vector<double> Vvals(points.size());
+    size_t rsize = (maxL + 1) * (maxL + 1) * (maxL + 1) * (maxL + 1);
+
+#pragma omp parallel num_threads(nthreads)
+    {
+        std::vector<double> R(rsize);
+        std::vector<const HermiteDistribution*> active;
+
+#pragma omp for schedule(dynamic)
+        for (size_t ind = 0; ind < blocks.size(); ind++) {
+            size_t first = blocks[ind].first;
+            size_t last = blocks[ind].second;
+
+            Vector3 center(0.0, 0.0, 0.0);
+            for (size_t i = first; i < last; i++) center += points[order[i]];
+            center /= static_cast<double>(last - first);
+            double radius = 0.0;
+            for (size_t i = first; i < last; i++) radius = std::max(radius, center.distance(points[order[i]]));
+
+            // => Distance screening <= //
+
+            // Distributions that look like point multipoles to the whole block are bounded by
+            // |d^n (1/R)| <= n! / R^(n + 1) and dropped when negligible
+            active.clear();
+            for (const auto& dist : distributions) {
+                double d = Vector3(dist.P[0], dist.P[1], dist.P[2]).distance(center) - radius;
+                if (d > 0.0 && dist.p * d * d > far_field_T) {
+                    double bound = 0.0;
+                    double Rinv = 1.0 / d;
+                    double fac = Rinv;
+                    double nfact = 1.0;
+                    for (int n = 0; n <= dist.L; n++) {
+                        bound += dist.moments[n] * nfact * fac;
+                        fac *= Rinv;
+                        nfact *= n + 1;
+                    }
+                    if (0.5 * std::sqrt(M_PI / dist.p) * bound < tol) continue;
+                }
+                active.push_back(&dist);
+            }
 
-        // => Nuclear part <= //
-        double Vnuc = 0.0;
-        int natom = mol->natom();
-        for (int iat = 0; iat < natom; iat++) {
-            Vector3 dR = origin - mol->xyz(iat);
-            double r = dR.norm();
-            if (r > 1.0E-8) Vnuc += mol->Z(iat) / r;
-        }
+            for (size_t i = first; i < last; i++) {
+                const Vector3& origin = points[order[i]];
+                Point C{origin[0], origin[1], origin[2]};
+
+                // => Electronic part <= //
+                double Velec = 0.0;
+                for (const auto* dist : active) {
+                    int L1 = dist->L + 1;
+                    fill_R_matrix(dist->L, dist->p, dist->P, C, R, fm_eval);
+                    Velec -= C_DDOT(L1 * L1 * L1, const_cast<double*>(dist->h.data()), 1, R.data(), 1);
+                }
+
+                // => Nuclear part <= //
+                double Vnuc = 0.0;
+                for (int iat = 0; iat < natom; iat++) {
+                    Vector3 dR = origin - mol->xyz(iat);
+                    double r = dR.norm();
+                    if (r > 1.0E-8) Vnuc += mol->Z(iat) / r;
+                }
 
-        (*output)[i] = Velec + Vnuc;
+                Vvals[order[i]] = Velec + Vnuc;
+            }
+        }
     }
-    return output;
+
+    return Vvals;
 }
 
 void OEProp::compute_field_over_grid() { epc_.compute_field_over_grid(true); }
@@ -298,6 +298,10 @@ class ESPPropCalc : public Prop {
     std::vector<double> Eyvals_;
     std::vector<double> Ezvals_;
 
+    /// Electrostatic potential at points given in bohr. Points are grouped into compact spatial blocks, and the
+    /// density is contracted once per shell pair into Hermite Gaussian distributions that are screened per block.
+    std::vector<double> compute_esp_batched(const std::vector<Vector3>& points) const;
+
    public:
     /// Constructor
     ESPPropCalc(std::shared_ptr<Wavefunction> wfn);
@@ -419,6 +423,11 @@ class PSI_API OEProp {
     std::vector<double> const& Eyvals() const { return epc_.Eyvals(); }
     std::vector<double> const& Ezvals() const { return epc_.Ezvals(); }
 
+    /// Compute electrostatic potential at grid points based on input grid, OpenMP version. input_grid is Nx3
+    SharedVector compute_esp_over_grid_in_memory(SharedMatrix input_grid) const {
+        return epc_.compute_esp_over_grid_in_memory(input_grid);
+    }
+
     // These functions need to be overridden to pass on to the feature classes:
 
     // Change restricted flag. Resets C/D/epsilon matrices from wfn
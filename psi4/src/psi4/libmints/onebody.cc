@@ -334,11 +334,12 @@ void OneBodyAOInt::compute(std::vector<SharedMatrix> &result) {
         // For each integral that we got put in its contribution
         for (int r = 0; r < nchunk_; ++r) {
             const double *location = buffers_[r];
+            double **resultp = result[r]->pointer();
             for (int p = 0; p < ni; ++p) {
                 for (int q = 0; q < nj; ++q) {
-                    result[r]->add(0, i_offset + p, j_offset + q, *location);
+                    resultp[i_offset + p][j_offset + q] += *location;
                     if (bs1_equiv_bs2 && p1 != p2) {
-                        result[r]->add(0, j_offset + q, i_offset + p, *location * sign);
+                        resultp[j_offset + q][i_offset + p] += *location * sign;
                     }
                     location++;
                 }
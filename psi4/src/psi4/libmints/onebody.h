@@ -103,9 +103,6 @@ class PSI_API OneBodyAOInt {
     virtual void compute_pair_deriv1(const libint2::Shell&, const libint2::Shell&);
     /// Compute second derivative integrals for a given shell pair
     virtual void compute_pair_deriv2(const libint2::Shell&, const libint2::Shell&);
-    /// Whether the operator is antisymmetric with respect to interchange of the bra and ket
-    virtual bool is_antisymmetric() const { return false; }
-
 
    public:
     virtual ~OneBodyAOInt();
@@ -122,6 +119,9 @@ class PSI_API OneBodyAOInt {
     /// Number of chunks. Normally 1, but dipoles (3) quadrupoles (6).
     int nchunk() const { return nchunk_; }
 
+    /// Whether the operator is antisymmetric with respect to interchange of the bra and ket
+    virtual bool is_antisymmetric() const { return false; }
+
     /*! @{
      * Computes all integrals and stores them in result
      * @param result Shared matrix object that will hold the results.
@@ -129,7 +129,8 @@ class PSI_API OneBodyAOInt {
     void compute(SharedMatrix& result);
     /*! @} */
 
-    /// Computes all integrals and stores them in result by default this method throws
+    /// Computes all integrals and stores them in result by default this method throws.
+    /// This is serial; MintsHelper::one_body_ao_computer drives one object per thread instead.
     virtual void compute(std::vector<SharedMatrix>& result);
 
     /// Does the method provide first derivatives?
@@ -446,7 +446,7 @@ void SimintTwoElectronInt::create_blocks(void) {
                 if (basis1()->shell(ishell).am() != iam) continue;
                 if(bra_same_) {
                     // In this case there's a list of shell pair info to loop over; use it
-                    for ( const auto &jshell : shell_to_shell_[ishell]) {
+                    for ( const auto &jshell : sieve_->shell_to_shell[ishell]) {
                         if (basis2()->shell(jshell).am() == jam) {
                             if (!bra_same_ || (bra_same_ && ishell >= jshell)) {
                                  blocks12_.push_back({{ishell, jshell}});
@@ -474,7 +474,7 @@ void SimintTwoElectronInt::create_blocks(void) {
             for (int kshell = 0; kshell < basis3()->nshell(); ++kshell) {
                 if (basis3()->shell(kshell).am() != kam) continue;
                 if(ket_same_){
-                    for ( const auto &lshell : shell_to_shell_[kshell]) {
+                    for ( const auto &lshell : sieve_->shell_to_shell[kshell]) {
                         if (basis4()->shell(lshell).am() == lam) {
                             if (kshell >= lshell) {
                                 if(braket_same_) {
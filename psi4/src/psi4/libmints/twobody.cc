@@ -27,6 +27,8 @@
  */
 
 #include <algorithm>
+#include <array>
+#include <mutex>
 #include <stdexcept>
 #include "psi4/libqt/qt.h"
 #include "psi4/libmints/twobody.h"
@@ -44,6 +46,44 @@ static void transform2e_2(int, SphericalTransformIter &, double *, double *, int
 static void transform2e_3(int, SphericalTransformIter &, double *, double *, int, int, int);
 static void transform2e_4(int, SphericalTransformIter &, double *, double *, int, int);
 
+namespace {
+
+/// An empty sieve, so that accessors work before (or without) sieve construction
+std::shared_ptr<const TwoBodySieve> empty_sieve() {
+    static const auto empty = std::make_shared<const TwoBodySieve>();
+    return empty;
+}
+
+/*
+ * Sieves already built in this process.  The basis sets are held weakly and their shell centers are
+ * recorded, so an entry is never matched against a basis set that has since been freed or moved.
+ */
+struct SieveCacheEntry {
+    std::string key;
+    ScreeningType screening_type;
+    double screening_threshold;
+    std::array<std::weak_ptr<BasisSet>, 4> bases;
+    std::vector<double> centers;
+    std::shared_ptr<const TwoBodySieve> sieve;
+};
+
+std::mutex sieve_cache_mutex;
+std::vector<SieveCacheEntry> sieve_cache;
+size_t sieve_cache_nhits = 0;
+
+std::vector<double> shell_centers(const std::array<std::shared_ptr<BasisSet>, 4> &bases) {
+    std::vector<double> centers;
+    for (const auto &bs : bases) {
+        for (int shell = 0; shell < bs->nshell(); ++shell) {
+            const auto &O = bs->l2_shell(shell).O;
+            centers.insert(centers.end(), O.begin(), O.end());
+        }
+    }
+    return centers;
+}
+
+}  // namespace
+
 TwoBodyAOInt::TwoBodyAOInt(const IntegralFactory *intsfactory, int deriv)
     : integral_(intsfactory),
       original_bs1_(integral_->basis1()),
@@ -72,6 +112,10 @@ TwoBodyAOInt::TwoBodyAOInt(const IntegralFactory *intsfactory, int deriv)
     screening_threshold_ = Process::environment.options.get_double("INTS_TOLERANCE");
 
     sieve_initialized_ = false;
+    sieve_ = empty_sieve();
+    nshell_ = 0;
+    nbf_ = 0;
+    max_integral_ = 0.0;
 
     auto screentype = Process::environment.options.get_str("SCREENING");
     if (screentype == "SCHWARZ")
@@ -100,26 +144,42 @@ TwoBodyAOInt::TwoBodyAOInt(const TwoBodyAOInt &rhs) : TwoBodyAOInt(rhs.integral_
     screening_threshold_squared_ = rhs.screening_threshold_squared_;
     nshell_ = rhs.nshell_;
     nbf_ = rhs.nbf_;
+    max_integral_ = rhs.max_integral_;
     screening_type_ = rhs.screening_type_;
-    function_pair_values_ = rhs.function_pair_values_;
-    shell_pair_values_ = rhs.shell_pair_values_;
+    sieve_key_ = rhs.sieve_key_;
+    // The sieve is immutable, so clones share it; only the density screening data is per object
+    sieve_ = rhs.sieve_;
+    sieve_initialized_ = rhs.sieve_initialized_;
     max_dens_shell_pair_ = rhs.max_dens_shell_pair_;
-    shell_pair_exchange_values_ = rhs.shell_pair_exchange_values_;
-    function_sqrt_ = rhs.function_sqrt_;
-    function_pairs_ = rhs.function_pairs_;
-    shell_pairs_ = rhs.shell_pairs_;
-    shell_pairs_bra_ = rhs.shell_pairs_bra_;
-    shell_pairs_ket_ = rhs.shell_pairs_ket_;
-    max_integral_ = rhs.max_integral_;
-    function_pairs_reverse_ = rhs.function_pairs_reverse_;
-    shell_pairs_reverse_ = rhs.shell_pairs_reverse_;
-    shell_to_shell_ = rhs.shell_to_shell_;
-    function_to_function_ = rhs.function_to_function_;
-    sieve_impl_ = rhs.sieve_impl_;
+    // Rebind rather than copy, so the clone screens with its own density data
+    if (rhs.sieve_impl_) bind_sieve_impl();
 }
 
 TwoBodyAOInt::~TwoBodyAOInt() {}
 
+size_t TwoBodyAOInt::compute_shell_batch(const std::vector<std::array<int, 4>>& quartets) {
+    size_t max_size = 0;
+    for (const auto& [P, Q, R, S] : quartets) {
+        max_size += static_cast<size_t>(bs1_->shell(P).nfunction()) * bs2_->shell(Q).nfunction() *
+                    bs3_->shell(R).nfunction() * bs4_->shell(S).nfunction();
+    }
+    if (batch_buffer_.size() < max_size) batch_buffer_.resize(max_size);
+
+    batch_offsets_.resize(quartets.size() + 1);
+    size_t total = 0;
+    for (size_t i = 0; i < quartets.size(); i++) {
+        batch_offsets_[i] = total;
+        const auto& [P, Q, R, S] = quartets[i];
+        size_t nints = compute_shell(P, Q, R, S);
+        if (nints) {
+            std::copy(buffer(), buffer() + nints, batch_buffer_.data() + total);
+            total += nints;
+        }
+    }
+    batch_offsets_[quartets.size()] = total;
+    return total;
+}
+
 // Haser 1989, Equation 7 
 void TwoBodyAOInt::update_density(const std::vector<SharedMatrix>& D) {
 
@@ -196,8 +256,8 @@ bool TwoBodyAOInt::shell_significant_density(int M, int N, int R, int S) {
     }
 
     // Square of Cauchy-Schwarz Q_MN terms (Eq. 13)
-    double mn_mn = shell_pair_values_[N * nshell_ + M];
-    double rs_rs = shell_pair_values_[S * nshell_ + R];
+    double mn_mn = sieve_->shell_pair_values[N * nshell_ + M];
+    double rs_rs = sieve_->shell_pair_values[S * nshell_ + R];
 
     // The density screened ERI bound (Eq. 6)
     return (mn_mn * rs_rs * max_density * max_density >= screening_threshold_squared_);
@@ -205,14 +265,16 @@ bool TwoBodyAOInt::shell_significant_density(int M, int N, int R, int S) {
 
 bool TwoBodyAOInt::shell_significant_csam(int M, int N, int R, int S) { 
     // Square of standard Cauchy-Schwarz Q_mu_nu terms (Eq. 1)
-    double mn_mn = shell_pair_values_[N * nshell_ + M];
-    double rs_rs = shell_pair_values_[S * nshell_ + R];
+    const auto &shell_pair_values = sieve_->shell_pair_values;
+    const auto &shell_pair_exchange_values = sieve_->shell_pair_exchange_values;
+    double mn_mn = shell_pair_values[N * nshell_ + M];
+    double rs_rs = shell_pair_values[S * nshell_ + R];
 
     // Square of M~_mu_nu terms (Eq. 9)
-    double mm_rr = shell_pair_exchange_values_[R * nshell_ + M];
-    double nn_ss = shell_pair_exchange_values_[S * nshell_ + N];
-    double mm_ss = shell_pair_exchange_values_[S * nshell_ + M];
-    double nn_rr = shell_pair_exchange_values_[R * nshell_ + N];
+    double mm_rr = shell_pair_exchange_values[R * nshell_ + M];
+    double nn_ss = shell_pair_exchange_values[S * nshell_ + N];
+    double mm_ss = shell_pair_exchange_values[S * nshell_ + M];
+    double nn_rr = shell_pair_exchange_values[R * nshell_ + N];
 
     // Square of M_mu_nu_lam_sig (Eq. 12)
     double csam_2 = std::max(mm_rr * nn_ss, mm_ss * nn_rr);
@@ -224,7 +286,8 @@ bool TwoBodyAOInt::shell_significant_csam(int M, int N, int R, int S) {
 }
 
 bool TwoBodyAOInt::shell_significant_schwarz(int M, int N, int R, int S) {
-    return shell_pair_values_[N * nshell_ + M] * shell_pair_values_[R * nshell_ + S] >= screening_threshold_squared_;
+    const auto &shell_pair_values = sieve_->shell_pair_values;
+    return shell_pair_values[N * nshell_ + M] * shell_pair_values[R * nshell_ + S] >= screening_threshold_squared_;
 }
 bool TwoBodyAOInt::shell_significant_none(int M, int N, int R, int S) { return true; }
 
@@ -238,6 +301,12 @@ void TwoBodyAOInt::setup_sieve() {
      * are present they must occupy the 2nd and/or 4th index.
      */
 
+    bind_sieve_impl();
+
+    if (screening_type_ != ScreeningType::None) create_sieve_pair_info_manager();
+}
+
+void TwoBodyAOInt::bind_sieve_impl() {
     // Different approaches are possible, so we use a function pointer and set it once, to avoid logic later on
     switch (screening_type_) {
         case ScreeningType::CSAM:
@@ -255,24 +324,26 @@ void TwoBodyAOInt::setup_sieve() {
         default:
             throw PSIEXCEPTION("Unimplemented screening type in TwoBodyAOInt::setup_sieve()");
     }
-
-    if (screening_type_ != ScreeningType::None) create_sieve_pair_info_manager();
 }
 
-void TwoBodyAOInt::create_sieve_pair_info(const std::shared_ptr<BasisSet> bs, PairList &shell_pairs, bool is_bra) {
+void TwoBodyAOInt::create_sieve_pair_info(const std::shared_ptr<BasisSet> bs, TwoBodySieve &sieve,
+                                          PairList &shell_pairs, bool is_bra) {
+    const int nshell = bs->nshell();
+    const int nbf = bs->nbf();
+    sieve.nshell = nshell;
+    sieve.nbf = nbf;
 
-    nshell_ = bs->nshell();
-    nbf_ = bs->nbf();
-
-    function_pair_values_.resize((size_t)nbf_ * nbf_, 0.0);
-    shell_pair_values_.resize((size_t)nshell_ * nshell_, 0.0);
-    max_integral_ = 0.0;
+    auto &function_pair_values = sieve.function_pair_values;
+    auto &shell_pair_values = sieve.shell_pair_values;
+    function_pair_values.resize((size_t)nbf * nbf, 0.0);
+    shell_pair_values.resize((size_t)nshell * nshell, 0.0);
+    double max_integral = 0.0;
 
     bs1_ = bs;
     bs2_ = bs;
     bs3_ = bs;
     bs4_ = bs;
-    for (int P = 0; P < nshell_; P++) {
+    for (int P = 0; P < nshell; P++) {
         for (int Q = 0; Q <= P; Q++) {
             int nP = bs->shell(P).nfunction();
             int nQ = bs->shell(Q).nfunction();
@@ -287,11 +358,11 @@ void TwoBodyAOInt::create_sieve_pair_info(const std::shared_ptr<BasisSet> bs, Pa
                         std::max(shell_max_val, std::abs(buffer[p * (nQ * nP * nQ + nQ) + q * (nP * nQ + 1)]));
                 }
             }
-            max_integral_ = std::max(max_integral_, shell_max_val);
-            shell_pair_values_[P * nshell_ + Q] = shell_pair_values_[Q * nshell_ + P] = shell_max_val;
+            max_integral = std::max(max_integral, shell_max_val);
+            shell_pair_values[P * nshell + Q] = shell_pair_values[Q * nshell + P] = shell_max_val;
             for (int p = 0; p < nP; p++) {
                 for (int q = 0; q < nQ; q++) {
-                    function_pair_values_[(p + oP) * nbf_ + (q + oQ)] = function_pair_values_[(q + oQ) * nbf_ + (p + oP)] = shell_max_val;
+                    function_pair_values[(p + oP) * nbf + (q + oQ)] = function_pair_values[(q + oQ) * nbf + (p + oP)] = shell_max_val;
                 }
             }
         }
@@ -301,73 +372,81 @@ void TwoBodyAOInt::create_sieve_pair_info(const std::shared_ptr<BasisSet> bs, Pa
     bs3_ = original_bs3_;
     bs4_ = original_bs4_;
 
-    screening_threshold_squared_ = screening_threshold_ * screening_threshold_;
-    double screening_threshold_over_max = screening_threshold_ / max_integral_;
-    double screening_threshold_squared_over_max = screening_threshold_squared_ / max_integral_;
+    sieve.max_integral = max_integral;
+    sieve.screening_threshold_squared = screening_threshold_ * screening_threshold_;
+    double screening_threshold_over_max = screening_threshold_ / max_integral;
+    double screening_threshold_squared_over_max = sieve.screening_threshold_squared / max_integral;
 
+    auto &function_pairs = sieve.function_pairs;
+    auto &shell_pairs_reverse = sieve.shell_pairs_reverse;
+    auto &function_pairs_reverse = sieve.function_pairs_reverse;
     shell_pairs.clear();
-    function_pairs_.clear();
-    shell_pairs_reverse_.resize(nshell_ * (nshell_ + 1L) / 2L);
-    function_pairs_reverse_.resize(nbf_ * (nbf_ + 1L) / 2L);
+    function_pairs.clear();
+    shell_pairs_reverse.resize(nshell * (nshell + 1L) / 2L);
+    function_pairs_reverse.resize(nbf * (nbf + 1L) / 2L);
 
     long int offset = 0L;
     size_t munu = 0L;
-    for (int mu = 0; mu < nbf_; mu++) {
+    for (int mu = 0; mu < nbf; mu++) {
         for (int nu = 0; nu <= mu; nu++, munu++) {
-            if (function_pair_values_[mu * nbf_ + nu] >= screening_threshold_squared_over_max) {
-                function_pairs_.push_back(std::make_pair(mu, nu));
-                function_pairs_reverse_[munu] = offset;
+            if (function_pair_values[mu * nbf + nu] >= screening_threshold_squared_over_max) {
+                function_pairs.push_back(std::make_pair(mu, nu));
+                function_pairs_reverse[munu] = offset;
                 offset++;
             } else {
-                function_pairs_reverse_[munu] = -1L;
+                function_pairs_reverse[munu] = -1L;
             }
         }
     }
 
-    shell_to_shell_.clear();
-    function_to_function_.clear();
-    shell_to_shell_.resize(nshell_);
-    function_to_function_.resize(nbf_);
-
-    for (int MU = 0; MU < nshell_; MU++) {
-        for (int NU = 0; NU < nshell_; NU++) {
-            if (shell_pair_values_[MU * nshell_ + NU] >= screening_threshold_squared_over_max) {
-                shell_to_shell_[MU].push_back(NU);
+    auto &shell_to_shell = sieve.shell_to_shell;
+    auto &function_to_function = sieve.function_to_function;
+    shell_to_shell.clear();
+    function_to_function.clear();
+    shell_to_shell.resize(nshell);
+    function_to_function.resize(nbf);
+
+    for (int MU = 0; MU < nshell; MU++) {
+        for (int NU = 0; NU < nshell; NU++) {
+            if (shell_pair_values[MU * nshell + NU] >= screening_threshold_squared_over_max) {
+                shell_to_shell[MU].push_back(NU);
             }
         }
     }
 
     shell_pairs.clear();
-    std::fill_n(shell_pairs_reverse_.begin(), nshell_ * (nshell_ + 1) / 2, -1);
+    std::fill_n(shell_pairs_reverse.begin(), nshell * (nshell + 1) / 2, -1);
 
     offset = 0L;
     size_t MUNU = 0L;
-    for (int MU = 0; MU < nshell_; MU++) {
+    for (int MU = 0; MU < nshell; MU++) {
         for (int NU = 0; NU <= MU; NU++, MUNU++) {
-            if (shell_pair_values_[MU * nshell_ + NU] >= screening_threshold_squared_over_max) {
+            if (shell_pair_values[MU * nshell + NU] >= screening_threshold_squared_over_max) {
                 shell_pairs.push_back(std::make_pair(MU, NU));
-                shell_pairs_reverse_[MUNU] = offset;
+                shell_pairs_reverse[MUNU] = offset;
                 offset++;
             }
         }
     }
 
-    for (int mu = 0; mu < nbf_; mu++) {
-        for (int nu = 0; nu < nbf_; nu++) {
-            if (function_pair_values_[mu * nbf_ + nu] >= screening_threshold_squared_over_max) {
-                function_to_function_[mu].push_back(nu);
+    for (int mu = 0; mu < nbf; mu++) {
+        for (int nu = 0; nu < nbf; nu++) {
+            if (function_pair_values[mu * nbf + nu] >= screening_threshold_squared_over_max) {
+                function_to_function[mu].push_back(nu);
             }
         }
     }
 
     if (screening_type_ == ScreeningType::CSAM) {
         // Setup information for exchange term screening
-        function_sqrt_.resize(nbf_);
-        shell_pair_exchange_values_.resize((size_t)nshell_ * nshell_);
-        std::fill(function_sqrt_.begin(), function_sqrt_.end(), 0.0);
-        std::fill(shell_pair_exchange_values_.begin(), shell_pair_exchange_values_.end(), 0.0);
-
-        for (int P = 0; P < nshell_; P++) {
+        auto &function_sqrt = sieve.function_sqrt;
+        auto &shell_pair_exchange_values = sieve.shell_pair_exchange_values;
+        function_sqrt.resize(nbf);
+        shell_pair_exchange_values.resize((size_t)nshell * nshell);
+        std::fill(function_sqrt.begin(), function_sqrt.end(), 0.0);
+        std::fill(shell_pair_exchange_values.begin(), shell_pair_exchange_values.end(), 0.0);
+
+        for (int P = 0; P < nshell; P++) {
             for (int Q = P; Q >= 0; Q--) {
                 int nP = bs->shell(P).nfunction();
                 int nQ = bs->shell(Q).nfunction();
@@ -380,7 +459,7 @@ void TwoBodyAOInt::create_sieve_pair_info(const std::shared_ptr<BasisSet> bs, Pa
                 if (Q == P) {
                     int oP = bs->shell(P).function_index();
                     for (int p = 0; p < nP; ++p) {
-                        function_sqrt_[oP + p] = std::sqrt(std::abs(buffer[p * (nP * nP * nP + nP) + p * (nP * nP + 1)]));
+                        function_sqrt[oP + p] = std::sqrt(std::abs(buffer[p * (nP * nP * nP + nP) + p * (nP * nP + 1)]));
                     }
                 }
 
@@ -389,10 +468,10 @@ void TwoBodyAOInt::create_sieve_pair_info(const std::shared_ptr<BasisSet> bs, Pa
                 for (int p = 0; p < nP; p++) {
                     for (int q = 0; q < nQ; q++) {
                         max_val = std::max(max_val, std::abs(buffer[p * nQ * nQ * (nP + 1) + q * (nQ + 1)]) /
-                                                        (function_sqrt_[p + oP] * function_sqrt_[q + oQ]));
+                                                        (function_sqrt[p + oP] * function_sqrt[q + oQ]));
                     }
                 }
-                shell_pair_exchange_values_[P * nshell_ + Q] = shell_pair_exchange_values_[Q * nshell_ + P] = max_val;
+                shell_pair_exchange_values[P * nshell + Q] = shell_pair_exchange_values[Q * nshell + P] = max_val;
             }
         }
     }
@@ -409,30 +488,87 @@ void TwoBodyAOInt::create_sieve_pair_info_manager() {
     // not needed and add a safety check to futureproof the code against that kind of use case further down the road.
     if(bra_same_ && ket_same_ && !braket_same_) throw PSIEXCEPTION("Unexpected integral type (aa|bb) in create_sieve_pair_info_manager()");
 
-    if(bra_same_) {
-        create_sieve_pair_info(basis1(), shell_pairs_bra_, true);
-        shell_pairs_ = shell_pairs_bra_;
-    } else {
-        if (basis2()->l2_shell(0) != libint2::Shell::unit())
-               throw PSIEXCEPTION("If different basis sets exist in the bra, basis3 is expected to be dummy in create_sieve_pair_info_manager()");
-        for(int shell = 0; shell < basis1()->nshell(); ++shell) shell_pairs_bra_.emplace_back(shell,0);
+    // Reuse a sieve built earlier for the same operator, basis sets and screening settings
+    const std::array<std::shared_ptr<BasisSet>, 4> bases{{basis1(), basis2(), basis3(), basis4()}};
+    const bool shareable = !sieve_key_.empty();
+    std::vector<double> centers;
+    if (shareable) {
+        centers = shell_centers(bases);
+        std::lock_guard<std::mutex> lock(sieve_cache_mutex);
+        sieve_cache.erase(std::remove_if(sieve_cache.begin(), sieve_cache.end(),
+                                         [](const SieveCacheEntry &entry) {
+                                             return std::any_of(entry.bases.begin(), entry.bases.end(),
+                                                                [](const auto &bs) { return bs.expired(); });
+                                         }),
+                          sieve_cache.end());
+        for (const auto &entry : sieve_cache) {
+            bool same_bases = true;
+            for (int i = 0; i < 4; ++i) same_bases = same_bases && entry.bases[i].lock() == bases[i];
+            if (same_bases && entry.key == sieve_key_ && entry.screening_type == screening_type_ &&
+                entry.screening_threshold == screening_threshold_ && entry.centers == centers) {
+                sieve_ = entry.sieve;
+                ++sieve_cache_nhits;
+                break;
+            }
+        }
     }
-    if(ket_same_) {
-        if(braket_same_) {
-            shell_pairs_ket_ = shell_pairs_bra_;
+
+    if (sieve_ == empty_sieve()) {
+        auto sieve = std::make_shared<TwoBodySieve>();
+        if(bra_same_) {
+            create_sieve_pair_info(basis1(), *sieve, sieve->shell_pairs_bra, true);
+            sieve->shell_pairs = sieve->shell_pairs_bra;
         } else {
-            create_sieve_pair_info(basis3(), shell_pairs_ket_, false);
-            shell_pairs_ = shell_pairs_ket_;
+            if (basis2()->l2_shell(0) != libint2::Shell::unit())
+                   throw PSIEXCEPTION("If different basis sets exist in the bra, basis3 is expected to be dummy in create_sieve_pair_info_manager()");
+            for(int shell = 0; shell < basis1()->nshell(); ++shell) sieve->shell_pairs_bra.emplace_back(shell,0);
+        }
+        if(ket_same_) {
+            if(braket_same_) {
+                sieve->shell_pairs_ket = sieve->shell_pairs_bra;
+            } else {
+                create_sieve_pair_info(basis3(), *sieve, sieve->shell_pairs_ket, false);
+                sieve->shell_pairs = sieve->shell_pairs_ket;
+            }
+        } else {
+            if (basis4()->l2_shell(0) != libint2::Shell::unit())
+                   throw PSIEXCEPTION("If different basis sets exist in the ket, basis4 is expected to be dummy in create_sieve_pair_info_manager()");
+            for(int shell = 0; shell < basis3()->nshell(); ++shell) sieve->shell_pairs_ket.emplace_back(shell,0);
+        }
+        sieve_ = sieve;
+
+        if (shareable) {
+            std::lock_guard<std::mutex> lock(sieve_cache_mutex);
+            SieveCacheEntry entry{sieve_key_, screening_type_, screening_threshold_, {}, std::move(centers), sieve_};
+            for (int i = 0; i < 4; ++i) entry.bases[i] = bases[i];
+            sieve_cache.push_back(std::move(entry));
         }
-    } else {
-        if (basis4()->l2_shell(0) != libint2::Shell::unit())
-               throw PSIEXCEPTION("If different basis sets exist in the ket, basis4 is expected to be dummy in create_sieve_pair_info_manager()");
-        for(int shell = 0; shell < basis3()->nshell(); ++shell) shell_pairs_ket_.emplace_back(shell,0);
     }
 
+    nshell_ = sieve_->nshell;
+    nbf_ = sieve_->nbf;
+    max_integral_ = sieve_->max_integral;
+    screening_threshold_squared_ = sieve_->screening_threshold_squared;
+
     sieve_initialized_ = true;
 }
 
+void TwoBodyAOInt::clear_sieve_cache() {
+    std::lock_guard<std::mutex> lock(sieve_cache_mutex);
+    sieve_cache.clear();
+    sieve_cache_nhits = 0;
+}
+
+size_t TwoBodyAOInt::sieve_cache_size() {
+    std::lock_guard<std::mutex> lock(sieve_cache_mutex);
+    return sieve_cache.size();
+}
+
+size_t TwoBodyAOInt::sieve_cache_hits() {
+    std::lock_guard<std::mutex> lock(sieve_cache_mutex);
+    return sieve_cache_nhits;
+}
+
 void TwoBodyAOInt::initialize_sieve() {
     /// Manual initialization must be manually implemented per ERI engine
     /// TODO: Add manual initialization for ERI engines beyond Libint2 (e.g., Simint)
@@ -467,14 +603,14 @@ void TwoBodyAOInt::create_blocks() {
 
     // Push back only the pairs that survived the sieving process.  This is only
     // possible if all four basis sets are the same in the current implementation.
-    blocks12_.reserve(shell_pairs_bra_.size());
-    for (const auto &pair : shell_pairs_bra_) {
+    blocks12_.reserve(sieve_->shell_pairs_bra.size());
+    for (const auto &pair : sieve_->shell_pairs_bra) {
         const auto &s1 = pair.first;
         const auto &s2 = pair.second;
         blocks12_.push_back({{s1, s2}});
     }
-    blocks34_.reserve(shell_pairs_ket_.size());
-    for (const auto &pair : shell_pairs_ket_) {
+    blocks34_.reserve(sieve_->shell_pairs_ket.size());
+    for (const auto &pair : sieve_->shell_pairs_ket) {
         const auto &s3 = pair.first;
         const auto &s4 = pair.second;
         blocks34_.push_back({{s3, s4}});
@@ -495,7 +631,7 @@ bool TwoBodyAOInt::shell_block_significant(int shellpair12, int shellpair34) con
 }
 
 bool TwoBodyAOInt::shell_pair_significant(int M, int N) const {
-    return screening_type_ != ScreeningType::None ? shell_pair_values_[M * nshell_ + N] * max_integral_ >= screening_threshold_squared_ : true;
+    return screening_type_ != ScreeningType::None ? sieve_->shell_pair_values[M * nshell_ + N] * max_integral_ >= screening_threshold_squared_ : true;
 }
 
 void TwoBodyAOInt::compute_shell_blocks(int shellpair12, int shellpair34, int npair12, int npair34) {
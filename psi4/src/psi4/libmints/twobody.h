@@ -31,8 +31,10 @@
 
 #include "psi4/pragma.h"
 
+#include <array>
 #include <functional>
 #include <memory>
+#include <string>
 #include <tuple>
 #include <vector>
 
@@ -58,6 +60,44 @@ class AOShellCombinationsIterator;
 class BasisSet;
 class GaussianShell;
 
+/*! \ingroup MINTS
+ *  \class TwoBodySieve
+ *  \brief Read-only pair screening data for a TwoBodyAOInt.
+ *
+ *  Built once per operator, basis set combination and screening setting, then shared by every
+ *  clone and by later integral objects that ask for the same sieve.  Nothing here depends on the
+ *  density, so none of it is ever written after construction.
+ */
+struct TwoBodySieve {
+    typedef std::vector<std::pair<int, int>> PairList;
+
+    int nshell = 0;
+    int nbf = 0;
+    double screening_threshold_squared = 0.0;
+    /// The largest value of any integral as predicted by the sieving method
+    double max_integral = 0.0;
+    /// |(mn|mn)| values (nbf * nbf)
+    std::vector<double> function_pair_values;
+    /// max |(MN|MN)| values (nshell * nshell)
+    std::vector<double> shell_pair_values;
+    /// max |(MM|NN)| values (nshell * nshell)
+    std::vector<double> shell_pair_exchange_values;
+    /// sqrt|(mm|mm)| values (nshell)
+    std::vector<double> function_sqrt;
+    /// Significant unique function pairs, in row-major, lower triangular indexing
+    PairList function_pairs;
+    /// Significant unique shell pairs, in row-major, lower triangular indexing
+    PairList shell_pairs, shell_pairs_bra, shell_pairs_ket;
+    /// Unique function pair indexing, accessed in triangular order, or -1 for non-significant pair
+    std::vector<long int> function_pairs_reverse;
+    /// Unique shell pair indexing, accessed in triangular order, or -1 for non-significant pair
+    std::vector<long int> shell_pairs_reverse;
+    /// Significant function pairs, indexes by function
+    std::vector<std::vector<int>> shell_to_shell;
+    /// Significant shell pairs, indexes by shell
+    std::vector<std::vector<int>> function_to_function;
+};
+
 /*! \ingroup MINTS
  *  \class TwoBodyInt
  *  \brief Two body integral base class.
@@ -111,6 +151,11 @@ class PSI_API TwoBodyAOInt {
     /// The blocking scheme used for the integrals
     std::vector<ShellPairBlock> blocks12_, blocks34_;
 
+    /// Integrals of the last batch of shell quartets, one quartet after another
+    std::vector<double> batch_buffer_;
+    /// Start of each quartet's integrals in batch_buffer_, plus the end of the last
+    std::vector<size_t> batch_offsets_;
+
     /*
      * Sieve information
      */
@@ -122,37 +167,24 @@ class PSI_API TwoBodyAOInt {
     double screening_threshold_squared_;
     int nshell_;
     int nbf_;
+    /// The largest value of any integral as predicted by the sieving method
+    double max_integral_;
     /// The algorithm to use for screening
     ScreeningType screening_type_;
-    /// |(mn|mn)| values (nbf * nbf)
-    std::vector<double> function_pair_values_;
-    /// max |(MN|MN)| values (nshell * nshell)
-    std::vector<double> shell_pair_values_;
-    /// max |(MM|NN)| values (nshell * nshell)
-    std::vector<double> shell_pair_exchange_values_;
-    /// sqrt|(mm|mm)| values (nshell)
-    std::vector<double> function_sqrt_;
+    /// Identifies the operator for sharing sieves between integral objects; empty if it cannot be shared
+    std::string sieve_key_;
+    /// Pair screening data, shared with clones and other objects with the same operator, bases and thresholds
+    std::shared_ptr<const TwoBodySieve> sieve_;
     /// Max density per matrix (Outer loop over density matrices, inner loop over shell pairs)
     std::vector<std::vector<double>> max_dens_shell_pair_;
-    /// Significant unique function pairs, in row-major, lower triangular indexing
-    PairList function_pairs_;
-    /// Significant unique shell pairs, in row-major, lower triangular indexing
-    PairList shell_pairs_, shell_pairs_bra_, shell_pairs_ket_;
-    /// The largest value of any integral as predicted by the sieving method
-    double max_integral_;
-    /// Unique function pair indexing, accessed in triangular order, or -1 for non-significant pair
-    std::vector<long int> function_pairs_reverse_;
-    /// Unique shell pair indexing, accessed in triangular order, or -1 for non-significant pair
-    std::vector<long int> shell_pairs_reverse_;
-    /// Significant function pairs, indexes by function
-    std::vector<std::vector<int>> shell_to_shell_;
-    /// Significant shell pairs, indexes by shell
-    std::vector<std::vector<int>> function_to_function_;
     std::function<bool(int, int, int, int)> sieve_impl_;
 
     void setup_sieve();
+    /// Point sieve_impl_ at this object's screening function
+    void bind_sieve_impl();
     void create_sieve_pair_info_manager();
-    void create_sieve_pair_info(const std::shared_ptr<BasisSet> bs, PairList &shell_pairs, bool is_bra);
+    void create_sieve_pair_info(const std::shared_ptr<BasisSet> bs, TwoBodySieve &sieve, PairList &shell_pairs,
+                                bool is_bra);
 
     /// Implements CSAM screening of a shell quartet
     bool shell_significant_csam(int M, int N, int R, int S);
@@ -218,24 +250,25 @@ class PSI_API TwoBodyAOInt {
     bool shell_pair_significant(int shell1, int shell2) const;
     /// Square of ceiling of shell quartet (MN|RS)
     inline double shell_ceiling2(int M, int N, int R, int S) {
-        return shell_pair_values_[N * nshell_ + M] * shell_pair_values_[R * nshell_ + S];
+        return sieve_->shell_pair_values[N * nshell_ + M] * sieve_->shell_pair_values[R * nshell_ + S];
     }
     /// Is the function pair (mn| ever significant according to sieve (no restriction on mn order)
     inline bool function_pair_significant(const int m, const int n) {
-        return function_pair_values_[m * nbf_ + n] * max_integral_ >= screening_threshold_squared_;
+        return sieve_->function_pair_values[m * nbf_ + n] * max_integral_ >= screening_threshold_squared_;
     }
     /// Is the integral (mn|rs) significant according to sieve? (no restriction on mnrs order)
     inline bool function_significant(const int m, const int n, const int r, const int s) {
-        return function_pair_values_[m * nbf_ + n] * function_pair_values_[r * nbf_ + s] >= screening_threshold_squared_;
+        return sieve_->function_pair_values[m * nbf_ + n] * sieve_->function_pair_values[r * nbf_ + s] >=
+               screening_threshold_squared_;
     }
     /// Return max(PQ|PQ)
     double max_integral() const { return max_integral_; }
     /// Square of ceiling of integral (mn|rs)
      inline double function_ceiling2(int m, int n, int r, int s) {
-        return function_pair_values_[m * nbf_ + n] * function_pair_values_[r * nbf_ + s];
+        return sieve_->function_pair_values[m * nbf_ + n] * sieve_->function_pair_values[r * nbf_ + s];
     }
     // the value of the bound for pair m and n
-    double shell_pair_value(int m, int n) { return shell_pair_values_[m * nshell_ + n]; };
+    double shell_pair_value(int m, int n) { return sieve_->shell_pair_values[m * nshell_ + n]; };
     /// Return the maximum density matrix element per shell pair. Maximum is over density matrices, if multiple set
     double shell_pair_max_density(int M, int N) const;
 
@@ -245,19 +278,21 @@ class PSI_API TwoBodyAOInt {
     virtual size_t first_RS_shell_block(size_t PQpair) const { return PQpair; }
 
     /// Significant unique function pair list, with only m>=n elements listed
-    const std::vector<std::pair<int, int> >& function_pairs() const { return function_pairs_; }
+    const std::vector<std::pair<int, int> >& function_pairs() const { return sieve_->function_pairs; }
     /// Significant unique shell pair pair list, with only M>=N elements listed
-    const std::vector<std::pair<int, int> >& shell_pairs() const { return shell_pairs_; }
+    const std::vector<std::pair<int, int> >& shell_pairs() const { return sieve_->shell_pairs; }
     /// Unique function pair indexing, element m*(m+1)/2 + n (where m>=n) gives the dense index or
     /// -1 if the function pair does not contribute
-    const std::vector<long int> function_pairs_to_dense() const { return function_pairs_reverse_; }
+    const std::vector<long int> function_pairs_to_dense() const { return sieve_->function_pairs_reverse; }
     /// Unique shell pair indexing, element M*(M+1)/2 + N (where M>=N) gives the dense index or
     /// -1 if the shell pair does not contribute
-    const std::vector<long int> shell_pairs_to_dense() const { return shell_pairs_reverse_; }
+    const std::vector<long int> shell_pairs_to_dense() const { return sieve_->shell_pairs_reverse; }
     /// Significant function pairs; for each function it gives a list of functions that contribute to make a function pair
-    const std::vector<std::vector<int> >& significant_partners_per_function() const { return function_to_function_; }
+    const std::vector<std::vector<int> >& significant_partners_per_function() const { return sieve_->function_to_function; }
     /// Significant shell pairs; for each shell it gives a list of shells that contribute to make a shell pair
-    const std::vector<std::vector<int> >& significant_parterns_per_shell() const { return shell_to_shell_; }
+    const std::vector<std::vector<int> >& significant_parterns_per_shell() const { return sieve_->shell_to_shell; }
+    /// The shared pair screening data
+    std::shared_ptr<const TwoBodySieve> sieve() const { return sieve_; }
 
     /// Returns the derivative level this object is setup for.
     int deriv() const { return deriv_; }
@@ -301,6 +336,20 @@ class PSI_API TwoBodyAOInt {
     /*! Compute derivative integrals for two blocks */
     virtual void compute_shell_blocks_deriv2(int shellpair12, int shellpair34, int npair12 = -1, int npair34 = -1);
 
+    /*! Compute the integrals of a batch of shell quartets
+     *
+     * Batches are meant to hold quartets of one angular momentum class, so that
+     * the engine runs the same kernel back to back.  The integrals of quartet i
+     * are batch_buffer()[batch_offsets()[i]] up to batch_buffer()[batch_offsets()[i + 1]];
+     * an empty range means the quartet has no integrals.  Returns the total number
+     * of integrals computed.
+     */
+    virtual size_t compute_shell_batch(const std::vector<std::array<int, 4>>& quartets);
+    /// Integrals of the last batch
+    const double *batch_buffer() const { return batch_buffer_.data(); }
+    /// Where each quartet's integrals start in batch_buffer()
+    const std::vector<size_t> &batch_offsets() const { return batch_offsets_; }
+
     /// Is the shell zero?
     virtual int shell_is_zero(int, int, int, int) { return 0; }
 
@@ -324,6 +373,13 @@ class PSI_API TwoBodyAOInt {
 
     /// Manually set up sieve if desired, per integral engine
     virtual void initialize_sieve();
+
+    /// Drop all cached sieves; integral objects that hold one keep it alive
+    static void clear_sieve_cache();
+    /// Number of sieves in the cache, including any whose basis sets have been freed since the last lookup
+    static size_t sieve_cache_size();
+    /// Number of integral objects that took their sieve from the cache since it was last cleared
+    static size_t sieve_cache_hits();
 };
 
 typedef std::shared_ptr<TwoBodyAOInt> SharedTwoBodyAOInt;
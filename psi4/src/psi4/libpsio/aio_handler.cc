@@ -37,446 +37,227 @@
 #include "psi4/libpsio/psio.h"
 #include "psi4/libpsio/psio.hpp"
 
-#include <cstdio>
-#include <memory>
 #include <algorithm>
-#include <functional>
+#include <cstring>
+#include <memory>
 
 namespace psi {
 
-AIOHandler::AIOHandler(std::shared_ptr<PSIO> psio) : psio_(psio) {
-    locked_ = new std::mutex();
-    uniqueID_ = 0;
+AIOHandler::AIOHandler(std::shared_ptr<PSIO> psio, int nthread) : psio_(psio), done_(false), uniqueID_(0) {
+#ifdef _MSC_VER
+    // PSIO::prw() falls back to the seeking PSIO::rw() here, so the workers would race on the file offset
+    nthread = 1;
+#endif
+    for (int i = 0; i < std::max(nthread, 1); i++) threads_.emplace_back(&AIOHandler::worker, this);
 }
 AIOHandler::~AIOHandler() {
-    synchronize();
-    delete locked_;
+    // Drain the queue, but never throw from a destructor: errors nobody waited for are dropped here
+    {
+        std::unique_lock<std::mutex> lock(lock_);
+        condition_.wait(lock, [this] { return jobs_.empty(); });
+        done_ = true;
+    }
+    work_.notify_all();
+    for (auto &thread : threads_) thread.join();
 }
 void AIOHandler::synchronize() {
-    // Joining a thread twice is an error. Thus, we check whether
-    // the thread is joinable before joining. Non-joinable threads
-    // have either been joined, detached (no synchronization possible)
-    // or have been moved from, and another thread object controls its execution.
-    //    std::unique_lock<std::mutex> lock(*locked_);
-    //    lock.unlock();
-    if (thread_)
-        if (thread_->joinable()) thread_->join();
+    std::unique_lock<std::mutex> lock(lock_);
+    condition_.wait(lock, [this] { return jobs_.empty(); });
+    rethrow();
 }
-size_t AIOHandler::read(size_t unit, const char *key, char *buffer, size_t size, psio_address start,
-                        psio_address *end) {
-    std::unique_lock<std::mutex> lock(*locked_);
-
-    ++uniqueID_;
-    job_.push(1);
-    unit_.push(unit);
-    key_.push(key);
-    buffer_.push(buffer);
-    size_.push(size);
-    start_.push(start);
-    end_.push(end);
-    jobID_.push_back(uniqueID_);
-
-    if (job_.size() > 1) return uniqueID_;
-
-    // In C++11, destructors of threads that are still joinable call terminate()
-    // Make sure current thread is joined before proceeding with next thread.
-    synchronize();
-
-    // thread start
-    thread_ = std::make_shared<std::thread>(std::bind(&AIOHandler::call_aio, this));
-    return uniqueID_;
+void AIOHandler::wait_for_job(size_t jobid) {
+    std::unique_lock<std::mutex> lock(lock_);
+    condition_.wait(lock, [this, jobid] { return jobs_.count(jobid) == 0; });
+    rethrow();
+}
+void AIOHandler::rethrow() {
+    if (error_) {
+        std::exception_ptr error = error_;
+        error_ = nullptr;
+        std::rethrow_exception(error);
+    }
 }
-size_t AIOHandler::write(size_t unit, const char *key, char *buffer, size_t size, psio_address start,
-                         psio_address *end) {
-    std::unique_lock<std::mutex> lock(*locked_);
-
-    ++uniqueID_;
-    job_.push(2);
-    unit_.push(unit);
-    key_.push(key);
-    buffer_.push(buffer);
-    size_.push(size);
-    start_.push(start);
-    end_.push(end);
-    jobID_.push_back(uniqueID_);
 
-    // printf("Adding a write to the queue\n");
+void AIOHandler::add_segment(Job &job, size_t unit, char *buffer, psio_address address, size_t size, int wrt) {
+    job.unit = unit;
+    job.wrt = job.wrt || wrt;
+    job.first = std::min(job.first, linear(address));
+    job.last = std::max(job.last, linear(address) + size);
+    job.bytes += size;
+
+    while (size) {
+        const size_t this_size = std::min(size, (size_t)PSIO_AIO_CHUNK);
+        job.segments.push_back({0, unit, buffer, address, this_size, wrt});
+        buffer += this_size;
+        size -= this_size;
+        address = psio_get_address(address, this_size);
+    }
+}
 
-    if (job_.size() > 1) return uniqueID_;
+size_t AIOHandler::submit(Job &&job, const char *key) {
+    if (PSIOManager::telemetry_enabled()) {
+        job.key = key;
+        job.start = std::chrono::steady_clock::now();
+    }
 
-    // fprintf(stderr,"Starting a thread\n");
-    // thread start
+    std::unique_lock<std::mutex> lock(lock_);
+    const size_t jobid = ++uniqueID_;
 
-    // In C++11, destructors of threads that are still joinable call terminate()
-    // Make sure current thread is joined before proceeding with next thread.
-    synchronize();
+    // Mapped units: the data already sits in the page cache and the mapping may move on the next write.
+    // Compressed units: pages are rewritten through the unit's small LRU page cache, which is not thread-safe.
+    if (!job.segments.empty() && (psio_->mmapped(job.unit) || psio_->compressed(job.unit))) {
+        lock.unlock();
+        for (const auto &segment : job.segments)
+            psio_->rw(segment.unit, segment.buffer, segment.address, segment.size, segment.wrt);
+        record(job);
+        return jobid;
+    }
+    if (job.segments.empty()) return jobid;
 
-    thread_ = std::make_shared<std::thread>(std::bind(&AIOHandler::call_aio, this));
-    return uniqueID_;
+    for (auto &segment : job.segments) segment.jobid = jobid;
+    job.pending = job.segments.size();
+    auto it = jobs_.emplace(jobid, std::move(job)).first;
+    if (!blocked(it)) dispatch(it->second);
+    return jobid;
 }
-size_t AIOHandler::read_entry(size_t unit, const char *key, char *buffer, size_t size) {
-    std::unique_lock<std::mutex> lock(*locked_);
 
-    ++uniqueID_;
-    job_.push(3);
-    unit_.push(unit);
-    key_.push(key);
-    buffer_.push(buffer);
-    size_.push(size);
-    jobID_.push_back(uniqueID_);
-
-    if (job_.size() > 1) return uniqueID_;
+void AIOHandler::record(const Job &job) {
+    if (job.key.empty()) return;
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - job.start;
+    PSIOManager::shared_object()->record_io(job.unit, job.key.c_str(), job.bytes, elapsed.count(), job.wrt);
+}
 
-    // In C++11, destructors of threads that are still joinable call terminate()
-    // Make sure current thread is joined before proceeding with next thread.
-    synchronize();
+bool AIOHandler::blocked(const std::map<size_t, Job>::iterator &job) {
+    const Job &mine = job->second;
+    for (auto it = jobs_.begin(); it != job; ++it) {
+        const Job &other = it->second;
+        if (other.unit != mine.unit || !(other.wrt || mine.wrt)) continue;
+        if (other.first < mine.last && mine.first < other.last) return true;
+    }
+    return false;
+}
 
-    // thread start
-    thread_ = std::make_shared<std::thread>(std::bind(&AIOHandler::call_aio, this));
-    return uniqueID_;
+void AIOHandler::dispatch(Job &job) {
+    job.dispatched = true;
+    ready_.insert(ready_.end(), job.segments.begin(), job.segments.end());
+    job.segments.clear();
+    work_.notify_all();
 }
-size_t AIOHandler::write_entry(size_t unit, const char *key, char *buffer, size_t size) {
-    std::unique_lock<std::mutex> lock(*locked_);
 
-    ++uniqueID_;
-    job_.push(4);
-    unit_.push(unit);
-    key_.push(key);
-    buffer_.push(buffer);
-    size_.push(size);
-    jobID_.push_back(uniqueID_);
+void AIOHandler::worker() {
+    std::unique_lock<std::mutex> lock(lock_);
+    while (true) {
+        work_.wait(lock, [this] { return done_ || !ready_.empty(); });
+        if (ready_.empty()) return;
 
-    if (job_.size() > 1) return uniqueID_;
+        Segment segment = ready_.front();
+        ready_.pop_front();
+        lock.unlock();
 
-    // In C++11, destructors of threads that are still joinable call terminate()
-    // Make sure current thread is joined before proceeding with next thread.
-    synchronize();
+        std::exception_ptr error;
+        try {
+            psio_->prw(segment.unit, segment.buffer, segment.address, segment.size, segment.wrt);
+        } catch (...) {
+            error = std::current_exception();
+        }
 
-    // thread start
-    thread_ = std::make_shared<std::thread>(std::bind(&AIOHandler::call_aio, this));
-    return uniqueID_;
+        lock.lock();
+        if (error && !error_) error_ = error;
+
+        auto it = jobs_.find(segment.jobid);
+        if (--(it->second.pending) == 0) {
+            record(it->second);
+            jobs_.erase(it);
+            // Release any held-back jobs that were only waiting on this one
+            for (auto next = jobs_.begin(); next != jobs_.end(); ++next) {
+                if (!next->second.dispatched && !blocked(next)) dispatch(next->second);
+            }
+            condition_.notify_all();
+        }
+    }
+}
+
+size_t AIOHandler::read(size_t unit, const char *key, char *buffer, size_t size, psio_address start,
+                        psio_address *end) {
+    std::lock_guard<std::mutex> guard(submit_lock_);
+    Job job;
+    psio_address address = psio_->read_address(unit, key, size, start, end);
+    add_segment(job, unit, buffer, address, size, 0);
+    return submit(std::move(job), key);
+}
+size_t AIOHandler::write(size_t unit, const char *key, char *buffer, size_t size, psio_address start,
+                         psio_address *end) {
+    std::lock_guard<std::mutex> guard(submit_lock_);
+    Job job;
+    psio_address address = psio_->write_address(unit, key, size, start, end);
+    add_segment(job, unit, buffer, address, size, 1);
+    return submit(std::move(job), key);
+}
+size_t AIOHandler::read_entry(size_t unit, const char *key, char *buffer, size_t size) {
+    psio_address end;
+    return read(unit, key, buffer, size, PSIO_ZERO, &end);
+}
+size_t AIOHandler::write_entry(size_t unit, const char *key, char *buffer, size_t size) {
+    psio_address end;
+    return write(unit, key, buffer, size, PSIO_ZERO, &end);
 }
 size_t AIOHandler::read_discont(size_t unit, const char *key, double **matrix, size_t row_length, size_t col_length,
                                 size_t col_skip, psio_address start) {
-    std::unique_lock<std::mutex> lock(*locked_);
-
-    ++uniqueID_;
-    job_.push(5);
-    unit_.push(unit);
-    key_.push(key);
-    matrix_.push(matrix);
-    row_length_.push(row_length);
-    col_length_.push(col_length);
-    col_skip_.push(col_skip);
-    start_.push(start);
-    jobID_.push_back(uniqueID_);
-
-    if (job_.size() > 1) return uniqueID_;
-
-    // In C++11, destructors of threads that are still joinable call terminate()
-    // Make sure current thread is joined before proceeding with next thread.
-    synchronize();
-
-    // thread start
-    thread_ = std::make_shared<std::thread>(std::bind(&AIOHandler::call_aio, this));
-    return uniqueID_;
+    std::lock_guard<std::mutex> guard(submit_lock_);
+    Job job;
+    for (size_t i = 0; i < row_length; i++) {
+        psio_address address = psio_->read_address(unit, key, sizeof(double) * col_length, start, &start);
+        add_segment(job, unit, (char *)&(matrix[i][0]), address, sizeof(double) * col_length, 0);
+        start = psio_get_address(start, sizeof(double) * col_skip);
+    }
+    return submit(std::move(job), key);
 }
 size_t AIOHandler::write_discont(size_t unit, const char *key, double **matrix, size_t row_length, size_t col_length,
                                  size_t col_skip, psio_address start) {
-    std::unique_lock<std::mutex> lock(*locked_);
-
-    ++uniqueID_;
-    job_.push(6);
-    unit_.push(unit);
-    key_.push(key);
-    matrix_.push(matrix);
-    row_length_.push(row_length);
-    col_length_.push(col_length);
-    col_skip_.push(col_skip);
-    start_.push(start);
-    jobID_.push_back(uniqueID_);
-
-    if (job_.size() > 1) return uniqueID_;
-
-    // In C++11, destructors of threads that are still joinable call terminate()
-    // Make sure current thread is joined before proceeding with next thread.
-    synchronize();
-
-    // thread start
-    thread_ = std::make_shared<std::thread>(std::bind(&AIOHandler::call_aio, this));
-    return uniqueID_;
+    std::lock_guard<std::mutex> guard(submit_lock_);
+    Job job;
+    for (size_t i = 0; i < row_length; i++) {
+        psio_address address = psio_->write_address(unit, key, sizeof(double) * col_length, start, &start);
+        add_segment(job, unit, (char *)&(matrix[i][0]), address, sizeof(double) * col_length, 1);
+        start = psio_get_address(start, sizeof(double) * col_skip);
+    }
+    return submit(std::move(job), key);
 }
 size_t AIOHandler::zero_disk(size_t unit, const char *key, size_t rows, size_t cols) {
-    std::unique_lock<std::mutex> lock(*locked_);
-
-    ++uniqueID_;
-    job_.push(7);
-    unit_.push(unit);
-    key_.push(key);
-    row_length_.push(rows);
-    col_length_.push(cols);
-    jobID_.push_back(uniqueID_);
-
-    if (job_.size() > 1) return uniqueID_;
-
-    // In C++11, destructors of threads that are still joinable call terminate()
-    // Make sure current thread is joined before proceeding with next thread.
-    synchronize();
-
-    // thread start
-    thread_ = std::make_shared<std::thread>(std::bind(&AIOHandler::call_aio, this));
-    return uniqueID_;
+    std::lock_guard<std::mutex> guard(submit_lock_);
+    Job job;
+
+    // The rows are contiguous, so the entry is extended once and every chunk is written from one zero buffer
+    const size_t size = rows * cols * sizeof(double);
+    psio_address end;
+    psio_address address = psio_->write_address(unit, key, size, PSIO_ZERO, &end);
+    job.scratch.assign(std::min(size, (size_t)PSIO_AIO_CHUNK), '\0');
+    add_segment(job, unit, nullptr, address, size, 1);
+    for (auto &segment : job.segments) segment.buffer = job.scratch.data();
+
+    return submit(std::move(job), key);
 }
-
 size_t AIOHandler::write_iwl(size_t unit, const char *key, size_t nints, int lastbuf, char *labels, char *values,
                              size_t labsize, size_t valsize, size_t *address) {
-    std::unique_lock<std::mutex> lock(*locked_);
-    ++uniqueID_;
-    job_.push(8);
-    unit_.push(unit);
-    key_.push(key);
-    buffer_.push(labels);
-    buffer_.push(values);
-    size_.push(labsize);
-    size_.push(valsize);
-    nints_.push(nints);
-    lastbuf_.push(lastbuf);
-    address_.push(address);
-    jobID_.push_back(uniqueID_);
-
-    if (job_.size() > 1) return uniqueID_;
-
-    // In C++11, destructors of threads that are still joinable call terminate()
-    // Make sure current thread is joined before proceeding with next thread.
-    synchronize();
-
-    // thread start
-    thread_ = std::make_shared<std::thread>(std::bind(&AIOHandler::call_aio, this));
-    return uniqueID_;
-}
-
-void AIOHandler::call_aio() {
-    std::unique_lock<std::mutex> lock(*locked_);
-
-    while (job_.size() > 0) {
-        int jobtype = job_.front();
-        lock.unlock();
-
-        if (jobtype == 1) {
-            lock.lock();
-
-            size_t unit = unit_.front();
-            const char *key = key_.front();
-            char *buffer = buffer_.front();
-            size_t size = size_.front();
-            psio_address start = start_.front();
-            psio_address *end = end_.front();
-
-            unit_.pop();
-            key_.pop();
-            buffer_.pop();
-            size_.pop();
-            start_.pop();
-            end_.pop();
-
-            lock.unlock();
+    std::lock_guard<std::mutex> guard(submit_lock_);
+    Job job;
 
-            psio_->read(unit, key, buffer, size, start, end);
-        } else if (jobtype == 2) {
-            lock.lock();
+    // The buffer header is copied, as the caller's values are gone by the time the write happens
+    const int header[2] = {lastbuf, (int)nints};
+    job.scratch.resize(sizeof(header));
+    ::memcpy(job.scratch.data(), header, sizeof(header));
 
-            size_t unit = unit_.front();
-            const char *key = key_.front();
-            char *buffer = buffer_.front();
-            size_t size = size_.front();
-            psio_address start = start_.front();
-            psio_address *end = end_.front();
+    psio_address start = psio_get_address(PSIO_ZERO, *address);
+    *address += valsize + labsize + 2 * sizeof(int);
 
-            unit_.pop();
-            key_.pop();
-            buffer_.pop();
-            size_.pop();
-            start_.pop();
-            end_.pop();
+    psio_address data = psio_->write_address(unit, key, sizeof(header), start, &start);
+    add_segment(job, unit, job.scratch.data(), data, sizeof(header), 1);
+    data = psio_->write_address(unit, key, labsize, start, &start);
+    add_segment(job, unit, labels, data, labsize, 1);
+    data = psio_->write_address(unit, key, valsize, start, &start);
+    add_segment(job, unit, values, data, valsize, 1);
 
-            // printf("Actually doing the psio_write from thread\n");
-            // printf("Unit is %d, key is %s, size is %d\n", unit, key, size);
-            lock.unlock();
-
-            // printf("Printing number %d now\n", *((int *) buffer));
-            // std::stringstream ss;
-            // ss << thread_->get_id();
-            // fprintf(stderr,"Printing from thread %s\n", ss.str().c_str());
-            // fprintf(stderr,"Starting address is %lu, %lu\n",start.page, start.offset);
-            psio_->write(unit, key, buffer, size, start, end);
-            // fprintf(stderr,"End address is %lu, %lu\n",end->page, end->offset);
-        } else if (jobtype == 3) {
-            lock.lock();
-
-            size_t unit = unit_.front();
-            const char *key = key_.front();
-            char *buffer = buffer_.front();
-            size_t size = size_.front();
-
-            unit_.pop();
-            key_.pop();
-            buffer_.pop();
-            size_.pop();
-
-            lock.unlock();
-
-            psio_->read_entry(unit, key, buffer, size);
-        } else if (jobtype == 4) {
-            lock.lock();
-
-            size_t unit = unit_.front();
-            const char *key = key_.front();
-            char *buffer = buffer_.front();
-            size_t size = size_.front();
-
-            unit_.pop();
-            key_.pop();
-            buffer_.pop();
-            size_.pop();
-
-            lock.unlock();
-
-            psio_->write_entry(unit, key, buffer, size);
-        } else if (jobtype == 5) {
-            lock.lock();
-
-            size_t unit = unit_.front();
-            const char *key = key_.front();
-            double **matrix = matrix_.front();
-            size_t row_length = row_length_.front();
-            size_t col_length = col_length_.front();
-            size_t col_skip = col_skip_.front();
-            psio_address start = start_.front();
-
-            unit_.pop();
-            key_.pop();
-            matrix_.pop();
-            row_length_.pop();
-            col_length_.pop();
-            col_skip_.pop();
-            start_.pop();
-
-            lock.unlock();
-
-            for (int i = 0; i < row_length; i++) {
-                psio_->read(unit, key, (char *)&(matrix[i][0]), sizeof(double) * col_length, start, &start);
-                start = psio_get_address(start, sizeof(double) * col_skip);
-            }
-        } else if (jobtype == 6) {
-            lock.lock();
-
-            size_t unit = unit_.front();
-            const char *key = key_.front();
-            double **matrix = matrix_.front();
-            size_t row_length = row_length_.front();
-            size_t col_length = col_length_.front();
-            size_t col_skip = col_skip_.front();
-            psio_address start = start_.front();
-
-            unit_.pop();
-            key_.pop();
-            matrix_.pop();
-            row_length_.pop();
-            col_length_.pop();
-            col_skip_.pop();
-            start_.pop();
-
-            lock.unlock();
-
-            for (int i = 0; i < row_length; i++) {
-                psio_->write(unit, key, (char *)&(matrix[i][0]), sizeof(double) * col_length, start, &start);
-                start = psio_get_address(start, sizeof(double) * col_skip);
-            }
-        } else if (jobtype == 7) {
-            lock.lock();
-
-            size_t unit = unit_.front();
-            const char *key = key_.front();
-            size_t row_length = row_length_.front();
-            size_t col_length = col_length_.front();
-
-            unit_.pop();
-            key_.pop();
-            row_length_.pop();
-            col_length_.pop();
-
-            lock.unlock();
-
-            double *buf = new double[col_length];
-            memset(static_cast<void *>(buf), '\0', col_length * sizeof(double));
-
-            psio_address next_psio = PSIO_ZERO;
-            for (int i = 0; i < row_length; i++) {
-                psio_->write(unit, key, (char *)(buf), sizeof(double) * col_length, next_psio, &next_psio);
-            }
-
-            delete[] buf;
-        } else if (jobtype == 8) {
-            lock.lock();
-
-            size_t unit = unit_.front();
-            const char *key = key_.front();
-            char *labels = buffer_.front();
-            buffer_.pop();
-            char *values = buffer_.front();
-            size_t lab_size = size_.front();
-            size_.pop();
-            size_t val_size = size_.front();
-            int nints = nints_.front();
-            int lastbuf = lastbuf_.front();
-            size_t *address = address_.front();
-
-            psio_address start = psio_get_address(PSIO_ZERO, *address);
-            *address += val_size + lab_size + 2 * sizeof(int);
-
-            unit_.pop();
-            key_.pop();
-            buffer_.pop();
-            size_.pop();
-            nints_.pop();
-            lastbuf_.pop();
-            address_.pop();
-
-            lock.unlock();
-
-            psio_->write(unit, key, (char *)&(lastbuf), sizeof(int), start, &start);
-            psio_->write(unit, key, (char *)&(nints), sizeof(int), start, &start);
-            psio_->write(unit, key, labels, lab_size, start, &start);
-            psio_->write(unit, key, values, val_size, start, &start);
-
-        } else {
-            throw PsiException("Error in AIO: Unknown job type", __FILE__, __LINE__);
-        }
-
-        lock.lock();
-        // Only pop the job once the work is actually done and we are gonna leave the loop.
-        // This way, job_.size() == 0 indicates there is no active thread.
-        job_.pop();
-        // We also pop the jobID so that external threads may check that the job completed
-        jobID_.pop_front();
-        // Once it is popped, notify waiting threads to check again for their jobid.
-        condition_.notify_all();
-    }
-    // printf("End of function call_aio\n");
-}
-
-void AIOHandler::wait_for_job(size_t jobid) {
-    std::deque<size_t>::iterator it;
-
-    std::unique_lock<std::mutex> lock(*locked_);
-    it = std::find(jobID_.begin(), jobID_.end(), jobid);
-    bool found = it != jobID_.end();
-    while (found) {
-        condition_.wait(lock);
-        it = std::find(jobID_.begin(), jobID_.end(), jobid);
-        found = it != jobID_.end();
-    }
-    return;
+    return submit(std::move(job), key);
 }
 
-}  // Namespace psi
+}  // namespace psi
@@ -29,63 +29,121 @@
 #ifndef AIOHANDLER_H
 #define AIOHANDLER_H
 
+#include <chrono>
 #include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <list>
+#include <map>
+#include <memory>
 #include <mutex>
-#include <queue>
+#include <string>
 #include <thread>
+#include <vector>
 
 #include "config.h"
 
+/// Default number of I/O worker threads, i.e., the queue depth offered to the device (always 1 on MSVC)
+#define PSIO_AIO_NTHREAD 4
+/// Requests larger than this many bytes are split so that several workers can serve them at once
+#define PSIO_AIO_CHUNK (64 * PSIO_PAGELEN)
+
 namespace psi {
 
 class PSIO;
 
+/**
+ * AIOHandler queues PSIO reads and writes for completion in the background.
+ *
+ * Each request is handled in two phases. The TOC bookkeeping (locating,
+ * creating or extending the entry) is done immediately, in submission order,
+ * on the calling thread. The data itself is then moved by a pool of worker
+ * threads with positioned reads and writes, in chunks of at most
+ * PSIO_AIO_CHUNK bytes, so many requests are outstanding on the device at once.
+ * A job whose byte range overlaps that of an earlier, unfinished job is held
+ * back until the earlier one completes, whenever either of them writes; hence
+ * jobs appear to execute in submission order, as with a single I/O thread.
+ *
+ * Memory-mapped and compressed units are transferred at submission. Errors
+ * raised by the workers are rethrown from wait_for_job() or synchronize().
+ */
 class AIOHandler {
    private:
-    /// What is the job type?
-    std::queue<size_t> job_;
-    /// Unique job ID to check for job completion. Should NEVER be 0.
-    std::deque<size_t> jobID_;
-    /// Unit number argument
-    std::queue<size_t> unit_;
-    /// Entry Key (80-char) argument
-    std::queue<const char *> key_;
-    /// Memory buffer argument
-    std::queue<char *> buffer_;
-    /// Size argument
-    std::queue<size_t> size_;
-    /// Start address argument
-    std::queue<psio_address> start_;
-    /// End address pointer argument
-    std::queue<psio_address *> end_;
-    /// Matrix pointer for discontinuous I/O
-    std::queue<double **> matrix_;
-    /// Size argument for discontinuous I/O
-    std::queue<size_t> row_length_;
-    /// Size argument for discontinuous I/O
-    std::queue<size_t> col_length_;
-    /// Size argument for discontinuous I/O
-    std::queue<size_t> col_skip_;
-    /// For IWL: number of ints in the buffer
-    std::queue<int> nints_;
-    /// For IWL: is this the last buffer ?
-    std::queue<int> lastbuf_;
-    /// For IWL: pointer to current position in file
-    std::queue<size_t *> address_;
-    /// PSIO object this AIO_Handler is built on
+    /// A contiguous piece of a job, moved with a single positioned read or write
+    struct Segment {
+        size_t jobid;
+        size_t unit;
+        char *buffer;
+        psio_address address;
+        size_t size;
+        int wrt;
+    };
+    /// Everything known about a submitted, unfinished job
+    struct Job {
+        /// Unit all segments belong to
+        size_t unit = 0;
+        /// Does any segment write?
+        bool wrt = false;
+        /// Global byte span [first, last) covered by the job, for ordering
+        size_t first = SIZE_MAX;
+        size_t last = 0;
+        /// Segments not yet completed
+        size_t pending = 0;
+        /// Segments to be dispatched once no earlier job conflicts
+        std::vector<Segment> segments;
+        /// Bytes owned by the job itself (zero fill, IWL buffer headers)
+        std::vector<char> scratch;
+        /// Has the job been handed to the workers?
+        bool dispatched = false;
+        /// Telemetry: TOC key, bytes moved and submission time (only set while telemetry is enabled)
+        std::string key;
+        size_t bytes = 0;
+        std::chrono::steady_clock::time_point start;
+    };
+
+    /// PSIO object this AIOHandler is built on
     std::shared_ptr<PSIO> psio_;
-    /// Thread this AIO_Handler is currently running on
-    std::shared_ptr<std::thread> thread_;
-    /// Lock variable
-    std::mutex *locked_;
-    /// Latest unique job ID
-    size_t uniqueID_;
-    /// condition variable to wait for a specific job to finish
+    /// Serializes the TOC bookkeeping of concurrent submitters
+    std::mutex submit_lock_;
+    /// Guards all members below
+    std::mutex lock_;
+    /// Signals workers that segments are ready (or that they should exit)
+    std::condition_variable work_;
+    /// Signals waiters that a job has completed
     std::condition_variable condition_;
+    /// Unfinished jobs, ordered by job ID
+    std::map<size_t, Job> jobs_;
+    /// Segments ready for the workers, in dispatch order
+    std::list<Segment> ready_;
+    /// First error raised by a worker, rethrown to the next waiter
+    std::exception_ptr error_;
+    /// Worker threads
+    std::vector<std::thread> threads_;
+    /// Set when the workers should exit
+    bool done_;
+    /// Latest unique job ID. Job IDs are never 0.
+    size_t uniqueID_;
+
+    /// Global byte index of a PSIO address
+    static size_t linear(psio_address address) { return address.page * PSIO_PAGELEN + address.offset; }
+    /// Register a fully planned job on entry key and dispatch it if nothing earlier is in its way; returns its ID
+    size_t submit(Job &&job, const char *key);
+    /// Report a completed job to the PSIOManager telemetry
+    static void record(const Job &job);
+    /// Append a data transfer at global address to a job being planned, splitting it into chunks
+    void add_segment(Job &job, size_t unit, char *buffer, psio_address address, size_t size, int wrt);
+    /// Does the job conflict with an unfinished job submitted before it? Call with lock_ held.
+    bool blocked(const std::map<size_t, Job>::iterator &job);
+    /// Hand the segments of a job to the workers. Call with lock_ held.
+    void dispatch(Job &job);
+    /// Rethrow (once) the first error raised by a worker. Call with lock_ held.
+    void rethrow();
+    /// Worker thread main loop
+    void worker();
 
    public:
     /// AIO_Handlers are constructed around a synchronous PSIO object
-    AIOHandler(std::shared_ptr<PSIO> psio);
+    AIOHandler(std::shared_ptr<PSIO> psio, int nthread = PSIO_AIO_NTHREAD);
     /// Destructor
     ~AIOHandler();
     /// When called, synchronize will not return until all requested data has been read or written
@@ -123,7 +181,7 @@ class AIOHandler {
     /// Zero disk
     /// Fills a double precision disk entry with zeros
     /// Total fill size is rows*cols*sizeof(double)
-    /// Buffer memory of cols*sizeof(double) is used
+    /// Buffer memory of at most PSIO_AIO_CHUNK bytes is used
     size_t zero_disk(size_t unit, const char *key, size_t rows, size_t cols);
 
     /// Write IWL
@@ -133,8 +191,6 @@ class AIOHandler {
     /// counting the number of integrals in the current buffer
     size_t write_iwl(size_t unit, const char *key, size_t nints, int lastbuf, char *labels, char *values,
                      size_t labsize, size_t valsize, size_t *address);
-    /// Generic function bound to thread internally
-    void call_aio();
 
     /// Function that checks if a job has been completed using the JobID.
     /// The function only returns when the job is completed.
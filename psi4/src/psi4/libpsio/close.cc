@@ -56,6 +56,9 @@ void PSIO::close(size_t unit, int keep) {
     /* Dump the current TOC back out to disk */
     tocwrite(unit);
 
+    /* Flush compressed pages and the page index; the lossy codec still needs the TOC */
+    if (this_unit->zip != nullptr) zip_close(unit);
+
     /* Free the TOC */
     this_entry = this_unit->toc;
     for (i = 0; i < this_unit->toclen; i++) {
@@ -64,6 +67,9 @@ void PSIO::close(size_t unit, int keep) {
         this_entry = next_entry;
     }
 
+    /* Drop the mappings before the streams they are backed by */
+    if (this_unit->mmapped) mmap_close(unit);
+
     /* Close each volume (remove if necessary) and free the path */
     for (i = 0; i < this_unit->numvols; i++) {
         int errcod;
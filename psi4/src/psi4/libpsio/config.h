@@ -62,6 +62,8 @@ namespace psi {
 #define PSIO_ERROR_IDENTVOLPATH 19
 #define PSIO_ERROR_MAXUNIT 20
 #define PSIO_ERROR_UNOPENED 21
+#define PSIO_ERROR_MMAP 22
+#define PSIO_ERROR_ZIP 23
 
 struct psio_address {
     /*! First page of entry */
@@ -73,6 +75,12 @@ struct psio_address {
 struct psio_vol {
     char *path;
     int stream;
+    /*! Base of the shared mapping of this volume (nullptr unless the unit is memory-mapped) */
+    char *map;
+    /*! Length of the address range reserved for the mapping */
+    size_t mapcap;
+    /*! Current length of the volume file on disk */
+    size_t filelen;
 };
 
 typedef struct psio_entry {
@@ -83,11 +91,38 @@ typedef struct psio_entry {
     struct psio_entry *last;
 } psio_tocentry;
 
+/*! Compression state of a unit (defined in zip.cc) */
+struct psio_zip;
+
+/*! Counters for the compression layer of a unit */
+struct psio_zipstats {
+    /*! Logical bytes handed to the codec */
+    size_t packed_in;
+    /*! Compressed bytes written to disk */
+    size_t packed_out;
+    /*! Compressed bytes read from disk */
+    size_t unpacked_in;
+    /*! Logical bytes recovered from them */
+    size_t unpacked_out;
+    /*! Pages compressed and decompressed */
+    size_t npacked;
+    size_t nunpacked;
+    /*! Pages stored with the lossy fixed-precision codec */
+    size_t nlossy;
+    /*! Seconds spent in the codecs */
+    double pack_time;
+    double unpack_time;
+};
+
 struct psio_ud {
     size_t numvols;
     psio_vol vol[PSIO_MAXVOL];
     size_t toclen;
     psio_tocentry *toc;
+    /*! Nonzero if reads and writes on this unit are served from memory-mapped volumes */
+    int mmapped;
+    /*! Compression state (nullptr unless the unit is compressed) */
+    psio_zip *zip;
 };
 
 /** A convenient address initialization struct */
@@ -130,6 +130,12 @@ void psio_error(size_t unit, size_t errval, std::string prev_msg /* = ""*/) {
                         " If you're a user, contact developers immediately. This is a bug.\n"
                         " If you're a developer, get yourself some coffee.\n";
             break;
+        case PSIO_ERROR_MMAP:
+            prev_msg += "PSIO_ERROR: " + std::to_string(PSIO_ERROR_MMAP) + " (memory mapping of file failed)\n";
+            break;
+        case PSIO_ERROR_ZIP:
+            prev_msg += "PSIO_ERROR: " + std::to_string(PSIO_ERROR_ZIP) + " (corrupt compressed file)\n";
+            break;
     }
 
     prev_msg += "\n";
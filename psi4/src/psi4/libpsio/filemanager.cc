@@ -99,6 +99,40 @@ bool PSIOManager::get_specific_retention(int fileno) {
     return retaining;
 }
 
+void PSIOManager::set_specific_mmap(int fileno, bool mmap) {
+    if (mmap)
+        specific_mmaps_.insert(fileno);
+    else
+        specific_mmaps_.erase(fileno);
+}
+
+bool PSIOManager::get_specific_mmap(int fileno) { return specific_mmaps_.count(fileno) != 0; }
+
+size_t PSIOManager::mmap_opens(int fileno) {
+    auto it = mmap_opens_.find(fileno);
+    return (it == mmap_opens_.end()) ? 0 : it->second;
+}
+
+void PSIOManager::set_specific_compression(int fileno, bool compress, double tolerance) {
+    if (tolerance < 0.0) throw PSIEXCEPTION("PSIOManager: compression tolerance must not be negative");
+    if (compress)
+        specific_compressions_[fileno] = tolerance;
+    else
+        specific_compressions_.erase(fileno);
+}
+
+bool PSIOManager::get_specific_compression(int fileno) { return specific_compressions_.count(fileno) != 0; }
+
+double PSIOManager::get_specific_compression_tolerance(int fileno) {
+    auto it = specific_compressions_.find(fileno);
+    return (it == specific_compressions_.end()) ? 0.0 : it->second;
+}
+
+size_t PSIOManager::compressed_opens(int fileno) {
+    auto it = compressed_opens_.find(fileno);
+    return (it == compressed_opens_.end()) ? 0 : it->second;
+}
+
 void PSIOManager::write_scratch_file(const std::string& full_path, const std::string& text) {
     files_[full_path] = true;
     FILE* fh = fopen(full_path.c_str(), "w");
@@ -150,6 +184,23 @@ void PSIOManager::print(std::string out) {
     }
     printer->Printf("\n");
 
+    printer->Printf("  Specific File Mappings:\n\n");
+    printer->Printf("  %-6s \n", "FileNo");
+    printer->Printf("  -------\n");
+    for (std::set<int>::iterator it = specific_mmaps_.begin(); it != specific_mmaps_.end(); it++) {
+        printer->Printf("  %-6d\n", (*it));
+    }
+    printer->Printf("\n");
+
+    printer->Printf("  Specific File Compression:\n\n");
+    printer->Printf("  %-6s %-12s\n", "FileNo", "Tolerance");
+    printer->Printf("  --------------------\n");
+    for (std::map<int, double>::iterator it = specific_compressions_.begin(); it != specific_compressions_.end();
+         it++) {
+        printer->Printf("  %-6d %-12.3E\n", (*it).first, (*it).second);
+    }
+    printer->Printf("\n");
+
     printer->Printf("  Current File Retention Rules:\n\n");
 
     printer->Printf("  %-6s \n", "Filename");
@@ -168,6 +219,8 @@ void PSIOManager::print(std::string out) {
                         (retained_files_.count((*it).first) == 0 ? "DEREZZ" : "SAVE"));
     }
     printer->Printf("\n");
+
+    if (telemetry_enabled() || !unit_stats_.empty()) print_telemetry(out);
 }
 void PSIOManager::mirror_to_disk() {
     //      FILE* fh = fopen("psi.clean","w");
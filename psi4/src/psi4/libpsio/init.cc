@@ -72,9 +72,14 @@ PSIO::PSIO() {
         for (j = 0; j < PSIO_MAXVOL; j++) {
             psio_unit[i].vol[j].path = nullptr;
             psio_unit[i].vol[j].stream = -1;
+            psio_unit[i].vol[j].map = nullptr;
+            psio_unit[i].vol[j].mapcap = 0;
+            psio_unit[i].vol[j].filelen = 0;
         }
         psio_unit[i].toclen = 0;
         psio_unit[i].toc = nullptr;
+        psio_unit[i].mmapped = 0;
+        psio_unit[i].zip = nullptr;
     }
 
     /* Open user's general .psirc file, if exists */
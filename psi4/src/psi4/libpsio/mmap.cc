@@ -0,0 +1,210 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2025 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+/*!
+ \file
+ \ingroup PSIO
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <sys/stat.h>
+#ifndef _MSC_VER
+#include <sys/mman.h>
+#endif
+#include "psi4/libpsio/psio.h"
+#include "psi4/libpsio/psio.hpp"
+
+// Smallest address range reserved for a mapped volume (in PSIO pages)
+#define PSIO_MMAP_MINPAGES 16
+
+namespace psi {
+
+#ifndef _MSC_VER
+namespace {
+
+/*!
+ ** PSIO_VOLRESERVE(): Make sure that the first len bytes of a mapped volume
+ ** exist on disk and are covered by the mapping. For writes the file is
+ ** extended as needed; for reads a short file is an error, exactly as a short
+ ** SYSTEM_READ would be.
+ **
+ ** The mapping is grown geometrically, so that an entry written front to back
+ ** costs only a logarithmic number of remaps. The file itself is only ever
+ ** extended to the requested length, so its size on disk matches what the
+ ** read/write backend would produce.
+ */
+void psio_volreserve(psio_vol *vol, size_t len, int wrt, size_t unit) {
+    if (len > vol->filelen) {
+        // The TOC length is written through the stream, so refresh our view of the file first
+        struct stat st;
+        if (::fstat(vol->stream, &st) == -1) {
+            const int saved_errno = errno;
+            const std::string errmsg =
+                psio_compose_err_msg("FSTAT failed.", "Cannot determine the length of a mapped volume", unit,
+                                     saved_errno);
+            psio_error(unit, PSIO_ERROR_MMAP, errmsg);
+        }
+        vol->filelen = st.st_size;
+    }
+
+    if (len > vol->filelen) {
+        if (!wrt) {
+            const std::string errmsg = psio_compose_err_msg("READ failed. Only some of the bytes were read!",
+                                                            "Error reading past the end of a mapped volume", unit);
+            psio_error(unit, PSIO_ERROR_READ, errmsg);
+        }
+        if (::ftruncate(vol->stream, len) == -1) {
+            const int saved_errno = errno;
+            const std::string errmsg = psio_compose_err_msg(
+                "WRITE failed.", "Error extending a mapped volume", unit, saved_errno);
+            psio_error(unit, PSIO_ERROR_WRITE, errmsg);
+        }
+        vol->filelen = len;
+    }
+
+    if (len > vol->mapcap) {
+        size_t cap = std::max(std::max(len, 2 * vol->mapcap), (size_t)PSIO_MMAP_MINPAGES * PSIO_PAGELEN);
+        cap = ((cap + PSIO_PAGELEN - 1) / PSIO_PAGELEN) * PSIO_PAGELEN;
+
+        if (vol->map != nullptr) ::munmap(vol->map, vol->mapcap);
+        void *map = ::mmap(nullptr, cap, PROT_READ | PROT_WRITE, MAP_SHARED, vol->stream, 0);
+        if (map == MAP_FAILED) {
+            const int saved_errno = errno;
+            vol->map = nullptr;
+            vol->mapcap = 0;
+            const std::string errmsg =
+                psio_compose_err_msg("MMAP failed.", "Cannot map volume into memory", unit, saved_errno);
+            psio_error(unit, PSIO_ERROR_MMAP, errmsg);
+        }
+        vol->map = (char *)map;
+        vol->mapcap = cap;
+    }
+}
+
+}  // namespace
+#endif
+
+/*!
+ ** PSIO_MMAP_OPEN(): Prepare the (already opened) volumes of a unit for
+ ** memory-mapped access. The mapping itself is created lazily on first use,
+ ** since a freshly opened unit may still be empty.
+ **
+ ** \param unit = The PSI unit number.
+ **
+ ** \ingroup PSIO
+ */
+void PSIO::mmap_open(size_t unit) {
+    psio_ud *this_unit = &(psio_unit[unit]);
+
+#ifdef _MSC_VER
+    // No POSIX mappings here; quietly fall back to the read/write backend
+    this_unit->mmapped = 0;
+#else
+    for (size_t i = 0; i < this_unit->numvols; i++) {
+        this_unit->vol[i].map = nullptr;
+        this_unit->vol[i].mapcap = 0;
+        this_unit->vol[i].filelen = 0;
+    }
+    this_unit->mmapped = 1;
+#endif
+}
+
+/*!
+ ** PSIO_MMAP_CLOSE(): Release the mappings of a unit. Must be called before
+ ** the volume streams are closed or unlinked. Dirty pages live in the shared
+ ** page cache, so nothing needs to be flushed explicitly.
+ **
+ ** \param unit = The PSI unit number.
+ **
+ ** \ingroup PSIO
+ */
+void PSIO::mmap_close(size_t unit) {
+    psio_ud *this_unit = &(psio_unit[unit]);
+
+#ifndef _MSC_VER
+    for (size_t i = 0; i < this_unit->numvols; i++) {
+        if (this_unit->vol[i].map != nullptr) ::munmap(this_unit->vol[i].map, this_unit->vol[i].mapcap);
+        this_unit->vol[i].map = nullptr;
+        this_unit->vol[i].mapcap = 0;
+        this_unit->vol[i].filelen = 0;
+    }
+#endif
+    this_unit->mmapped = 0;
+}
+
+/*!
+ ** PSIO_RW_MMAP(): Memory-mapped counterpart of PSIO_RW(). The page layout is
+ ** identical: page p of the unit lives on volume p % numvols at byte
+ ** (p / numvols) * PSIO_PAGELEN of that volume. For a single volume the whole
+ ** request is contiguous and is moved with a single memcpy.
+ **
+ ** \param unit    = The PSI unit number.
+ ** \param buffer  = The buffer containing the bytes for the read/write event.
+ ** \param address = the PSIO global address for the start of the read/write.
+ ** \param size    = The number of bytes to read/write.
+ ** \param wrt     = Indicates if the call is to read (0) or write (1) the input data.
+ **
+ ** \ingroup PSIO
+ */
+void PSIO::rw_mmap(size_t unit, char *buffer, psio_address address, size_t size, int wrt) {
+#ifndef _MSC_VER
+    psio_ud *this_unit = &(psio_unit[unit]);
+    const size_t numvols = this_unit->numvols;
+    size_t page = address.page;
+    size_t offset = address.offset;
+    size_t buf_offset = 0;
+
+    while (size) {
+        const size_t this_total = (numvols == 1) ? size : std::min(size, (size_t)PSIO_PAGELEN - offset);
+        psio_vol *vol = &(this_unit->vol[page % numvols]);
+        const size_t pos = (page / numvols) * PSIO_PAGELEN + offset;
+
+        psio_volreserve(vol, pos + this_total, wrt, unit);
+
+        if (wrt) {
+            ::memcpy(vol->map + pos, buffer + buf_offset, this_total);
+        } else {
+            // Large reads: ask the kernel to start paging the whole range in before we touch it
+            if (this_total > PSIO_PAGELEN) {
+                const size_t align = pos % PSIO_PAGELEN;
+                ::madvise(vol->map + pos - align, this_total + align, MADV_WILLNEED);
+            }
+            ::memcpy(buffer + buf_offset, vol->map + pos, this_total);
+        }
+
+        buf_offset += this_total;
+        size -= this_total;
+        page += (offset + this_total) / PSIO_PAGELEN;
+        offset = (offset + this_total) % PSIO_PAGELEN;
+    }
+#endif
+}
+
+}  // namespace psi
@@ -114,6 +114,14 @@ void PSIO::open(size_t unit, int status) {
         free(path);
     }
 
+    /* Compressed units are recognized from the file itself when reopened */
+    zip_open(unit, status);
+    if (this_unit->zip != nullptr) PSIOManager::shared_object()->record_compressed_open(unit);
+
+    /* Serve this unit from memory-mapped volumes, if requested */
+    if (this_unit->zip == nullptr && PSIOManager::shared_object()->get_specific_mmap(unit)) mmap_open(unit);
+    if (this_unit->mmapped) PSIOManager::shared_object()->record_mmap_open(unit);
+
     if (status == PSIO_OPEN_OLD)
         tocread(unit);
     else if (status == PSIO_OPEN_NEW) {
@@ -0,0 +1,107 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2025 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+/*!
+ \file
+ \ingroup PSIO
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include "psi4/libpsio/psio.h"
+#include "psi4/libpsio/psio.hpp"
+#include "psi4/psi4-dec.h"
+
+namespace psi {
+
+/*!
+ ** PSIO_PRW(): Positioned counterpart of PSIO_RW(). Each contiguous piece of
+ ** the request is moved with a single pread()/pwrite() at an explicit file
+ ** position, so no seeks are issued and concurrent requests on disjoint
+ ** ranges do not interfere with one another.
+ **
+ ** \param unit    = The PSI unit number.
+ ** \param buffer  = The buffer containing the bytes for the read/write event.
+ ** \param address = the PSIO global address for the start of the read/write.
+ ** \param size    = The number of bytes to read/write.
+ ** \param wrt     = Indicates if the call is to read (0) or write (1) the input data.
+ **
+ ** \ingroup PSIO
+ */
+void PSIO::prw(size_t unit, char *buffer, psio_address address, size_t size, int wrt) {
+#ifdef _MSC_VER
+    // No positioned I/O here; callers must serialize access themselves (AIOHandler runs a single worker)
+    rw(unit, buffer, address, size, wrt);
+#else
+    psio_ud *this_unit = &(psio_unit[unit]);
+
+    /* Compressed pages are rewritten in place; there is nothing positioned about them */
+    if (this_unit->zip != nullptr) {
+        rw(unit, buffer, address, size, wrt);
+        return;
+    }
+
+    const size_t numvols = this_unit->numvols;
+    size_t page = address.page;
+    size_t offset = address.offset;
+    size_t buf_offset = 0;
+
+    while (size) {
+        /* A single volume holds the whole request contiguously; otherwise stop at the page boundary */
+        const size_t this_total = (numvols == 1) ? size : std::min(size, (size_t)PSIO_PAGELEN - offset);
+        const int stream = this_unit->vol[page % numvols].stream;
+        const off_t pos = (page / numvols) * PSIO_PAGELEN + offset;
+
+        /* pread/pwrite may legitimately move fewer bytes than asked for; keep going until done */
+        size_t done = 0;
+        while (done < this_total) {
+            const ssize_t errcod = wrt ? ::pwrite(stream, buffer + buf_offset + done, this_total - done, pos + done)
+                                       : ::pread(stream, buffer + buf_offset + done, this_total - done, pos + done);
+            const int saved_errno = errno;
+            if (errcod == -1 && saved_errno == EINTR) continue;
+            if (errcod <= 0) {
+                const std::string beginning =
+                    wrt ? ((errcod == -1) ? "WRITE failed." : "WRITE failed. Only some of the bytes were written!")
+                        : ((errcod == -1) ? "READ failed." : "READ failed. Only some of the bytes were read!");
+                const std::string context = wrt ? "Error in positioned write" : "Error in positioned read";
+                const std::string errmsg = (errcod == -1) ? psio_compose_err_msg(beginning, context, unit, saved_errno)
+                                                          : psio_compose_err_msg(beginning, context, unit);
+                psio_error(unit, wrt ? PSIO_ERROR_WRITE : PSIO_ERROR_READ, errmsg);
+            }
+            done += errcod;
+        }
+
+        buf_offset += this_total;
+        size -= this_total;
+        page += (offset + this_total) / PSIO_PAGELEN;
+        offset = (offset + this_total) % PSIO_PAGELEN;
+    }
+#endif
+}
+
+}  // namespace psi
@@ -29,8 +29,11 @@
 #ifndef _psi_src_lib_libpsio_psio_hpp_
 #define _psi_src_lib_libpsio_psio_hpp_
 
+#include <array>
+#include <atomic>
 #include <string>
 #include <map>
+#include <mutex>
 #include <set>
 #include <queue>
 #include <memory>
@@ -44,6 +47,25 @@ class PSIOManager;
 extern PSI_API std::shared_ptr<PSIO> _default_psio_lib_;
 extern PSI_API std::shared_ptr<PSIOManager> _default_psio_manager_;
 
+/// Number of latency buckets in psio_iostats: below 1 us, then one per power of two up to ~1 s and beyond
+#define PSIO_TELEMETRY_NBUCKET 22
+
+/**
+    I/O counters for one unit or one TOC entry, collected by PSIOManager while
+    telemetry is enabled. Asynchronous (AIOHandler) operations are timed from
+    submission to completion.
+   */
+struct psio_iostats {
+    size_t nread = 0;
+    size_t nwrite = 0;
+    size_t read_bytes = 0;
+    size_t write_bytes = 0;
+    double read_time = 0.0;
+    double write_time = 0.0;
+    /// Operation counts by latency. Bucket 0 is below 1 us, bucket b covers [2^(b-1), 2^b) us
+    std::array<size_t, PSIO_TELEMETRY_NBUCKET> latency{};
+};
+
 /**
     PSIOManager is a class designed to be used as a static object to track all
     PSIO operations in a given PSI4 computation
@@ -59,6 +81,14 @@ class PSI_API PSIOManager {
     std::map<int, std::string> specific_paths_;
     /// Default retained files
     std::set<int> specific_retains_;
+    /// File numbers served from memory-mapped volumes
+    std::set<int> specific_mmaps_;
+    /// Number of times each file number was opened with memory-mapped volumes
+    std::map<int, size_t> mmap_opens_;
+    /// File numbers to be compressed, with the tolerance of the lossy codec (0.0 for lossless)
+    std::map<int, double> specific_compressions_;
+    /// Number of times each file number was opened compressed
+    std::map<int, size_t> compressed_opens_;
 
     /// Map of files, bool denotes open or closed
     std::map<std::string, bool> files_;
@@ -67,6 +97,15 @@ class PSI_API PSIOManager {
 
     std::string pid_;
 
+    /// Is I/O telemetry being collected? Static, so PSIO can test it without touching the manager
+    static std::atomic<bool> telemetry_;
+    /// Guards the telemetry tables, which AIOHandler workers update concurrently
+    std::mutex telemetry_lock_;
+    /// Telemetry per file number
+    std::map<int, psio_iostats> unit_stats_;
+    /// Telemetry per file number and TOC key
+    std::map<std::pair<int, std::string>, psio_iostats> key_stats_;
+
    public:
     /// Default constructor (does nothing)
     PSIOManager();
@@ -105,6 +144,61 @@ class PSI_API PSIOManager {
      * \return keeping or not?
      */
     bool get_specific_retention(int fileno);
+    /**
+     * Serve a specific file number from memory-mapped volumes instead of
+     * seek/read/write system calls. Takes effect the next time the unit is
+     * opened; the on-disk layout is unchanged, so files remain readable by
+     * either backend.
+     * \param fileno PSI4 file number
+     * \param mmap map or not? (Allows override)
+     */
+    void set_specific_mmap(int fileno, bool mmap);
+    /**
+     * Inquire whether a specific file number is to be memory-mapped
+     * \param fileno PSI4 file number
+     * \return mapping or not?
+     */
+    bool get_specific_mmap(int fileno);
+    /// Count an open of fileno that is served from memory-mapped volumes
+    void record_mmap_open(int fileno) { mmap_opens_[fileno]++; }
+    /**
+     * Inquire how often a specific file number was actually opened with
+     * memory-mapped volumes, as opposed to merely requested
+     * \param fileno PSI4 file number
+     * \return number of mapped opens
+     */
+    size_t mmap_opens(int fileno);
+    /**
+     * Compress a specific file number. Takes effect when the unit is next
+     * created; existing files keep the format they were written in.
+     * \param fileno PSI4 file number
+     * \param compress compress or not? (Allows override)
+     * \param tolerance 0.0 for lossless compression, else the largest
+     *        absolute error allowed for any double in the file. Only for
+     *        units holding nothing but double-precision data!
+     */
+    void set_specific_compression(int fileno, bool compress, double tolerance = 0.0);
+    /**
+     * Inquire whether a specific file number is to be compressed
+     * \param fileno PSI4 file number
+     * \return compressing or not?
+     */
+    bool get_specific_compression(int fileno);
+    /**
+     * Tolerance of the lossy codec for a specific file number
+     * \param fileno PSI4 file number
+     * \return the tolerance, 0.0 for lossless compression
+     */
+    double get_specific_compression_tolerance(int fileno);
+    /// Count an open of fileno that goes through the compression layer
+    void record_compressed_open(int fileno) { compressed_opens_[fileno]++; }
+    /**
+     * Inquire how often a specific file number was actually opened
+     * compressed, as opposed to merely requested
+     * \param fileno PSI4 file number
+     * \return number of compressed opens
+     */
+    size_t compressed_opens(int fileno);
 
     /**
      * Get the path for a specific file number
@@ -180,6 +274,36 @@ class PSI_API PSIOManager {
     void crashclean();
     /// The one and (should be) only instance of PSIOManager for a PSI4 instance
     static std::shared_ptr<PSIOManager> shared_object();
+
+    /**
+     * Start or stop collecting I/O telemetry (bytes, operation counts,
+     * latency histograms and bandwidth per unit and per TOC entry). When
+     * disabled, the cost to PSIO is a single test of a static flag.
+     * \param enable collect or not?
+     */
+    void set_telemetry(bool enable) { telemetry_.store(enable, std::memory_order_relaxed); }
+    /// Is I/O telemetry being collected?
+    static bool telemetry_enabled() { return telemetry_.load(std::memory_order_relaxed); }
+    /**
+     * Record one completed I/O operation. Thread safe.
+     * \param fileno PSI4 file number
+     * \param key TOC key of the entry
+     * \param bytes number of bytes moved
+     * \param seconds time taken
+     * \param wrt write (true) or read (false)?
+     */
+    void record_io(int fileno, const char *key, size_t bytes, double seconds, bool wrt);
+    /// Forget all telemetry collected so far
+    void clear_telemetry();
+    /// Telemetry per file number collected so far
+    std::map<int, psio_iostats> unit_telemetry();
+    /// Telemetry per file number and TOC key collected so far
+    std::map<std::pair<int, std::string>, psio_iostats> key_telemetry();
+    /**
+     * Print the I/O telemetry report
+     * \param out file to print to
+     */
+    void print_telemetry(std::string out = "outfile");
 };
 
 /**
@@ -257,6 +381,20 @@ class PSI_API PSIO {
      */
     void write(size_t unit, const char *key, char *buffer, size_t size, psio_address start, psio_address *end);
 
+    /** Performs the TOC bookkeeping of read() without moving any data.
+     **
+     **  Arguments are those of read(); the return value is the global address
+     **  of the first byte requested, suitable for rw() or prw().
+     */
+    psio_address read_address(size_t unit, const char *key, size_t size, psio_address start, psio_address *end);
+    /** Performs the TOC bookkeeping of write() without moving any data.
+     **
+     **  New entries are created and existing ones extended exactly as write()
+     **  would, including updating the entry header on disk. The return value is
+     **  the global address at which the data belongs, suitable for rw() or prw().
+     */
+    psio_address write_address(size_t unit, const char *key, size_t size, psio_address start, psio_address *end);
+
     void read_entry(size_t unit, const char *key, char *buffer, size_t size);
     void write_entry(size_t unit, const char *key, char *buffer, size_t size);
 
@@ -284,6 +422,22 @@ class PSI_API PSIO {
      */
     void rw(size_t unit, char *buffer, psio_address address, size_t size, int wrt);
 
+    /** Positioned variant of rw(). Uses pread/pwrite, so the file offsets of
+     ** the volumes are never moved and concurrent calls on disjoint ranges of
+     ** the same unit are safe. Arguments are those of rw(). Memory-mapped units
+     ** are not supported, as their mappings may be moved by a concurrent write.
+     */
+    void prw(size_t unit, char *buffer, psio_address address, size_t size, int wrt);
+
+    /// Return 1 if the unit is served from memory-mapped volumes
+    int mmapped(size_t unit) { return psio_unit[unit].mmapped; }
+    /// Return 1 if the unit is stored compressed
+    int compressed(size_t unit) { return psio_unit[unit].zip != nullptr; }
+    /// Counters of the compression layer for unit, accumulated over every time it was open
+    psio_zipstats zip_stats(size_t unit);
+    /// Print the compression counters of all units that were ever compressed
+    void print_zip_stats(std::string out = "outfile");
+
     /// Delete all TOC entries after the given key. If a blank key is given, the entire TOC will be wiped.
     void tocclean(size_t unit, const char *key);
     /// Print the table of contents for the given unit
@@ -331,6 +485,9 @@ class PSI_API PSIO {
     /// library configuration is described by a set of keywords
     KWDMap files_keywords_;
 
+    /// Compression counters, per unit
+    std::map<size_t, psio_zipstats> zipstats_;
+
 #ifdef PSIO_STATS
     size_t *psio_readlen;
     size_t *psio_writlen;
@@ -351,6 +508,24 @@ class PSI_API PSIO {
     /// Read the table of contents for file number 'unit'.
     void tocread(size_t unit);
 
+    /// Set up memory-mapped access for the open volumes of unit
+    void mmap_open(size_t unit);
+    /// Release the mappings of unit; must precede closing its volumes
+    void mmap_close(size_t unit);
+    /// Memory-mapped counterpart of rw()
+    void rw_mmap(size_t unit, char *buffer, psio_address address, size_t size, int wrt);
+
+    /// Set up (or recognize) page compression for the open volume of unit
+    void zip_open(size_t unit, int status);
+    /// Flush and release the compression state of unit; must precede closing its volume
+    void zip_close(size_t unit);
+    /// Decompress one logical page of unit into dest
+    void zip_load(size_t unit, size_t page, char *dest);
+    /// Compress one logical page of unit from src and store it
+    void zip_store(size_t unit, size_t page, const char *src);
+    /// Compressed counterpart of rw()
+    void rw_zip(size_t unit, char *buffer, psio_address address, size_t size, int wrt);
+
     friend class AIO_Handler;
 
    public:
@@ -31,6 +31,7 @@
  \ingroup PSIO
  */
 
+#include <chrono>
 #include <cstdlib>
 #include <cstring>
 #include "psi4/pragma.h"
@@ -40,7 +41,8 @@
 
 namespace psi {
 
-void PSIO::read(size_t unit, const char *key, char *buffer, size_t size, psio_address start, psio_address *end) {
+psio_address PSIO::read_address(size_t unit, const char *key, size_t size, psio_address start,
+                                psio_address *end) {
     psio_ud *this_unit;
     psio_tocentry *this_entry;
     psio_address start_toc, start_data, end_data; /* global addresses */
@@ -88,9 +90,24 @@ void PSIO::read(size_t unit, const char *key, char *buffer, size_t size, psio_ad
         *end = psio_get_address(start, size);
     }
 
+    return start_data;
+}
+
+void PSIO::read(size_t unit, const char *key, char *buffer, size_t size, psio_address start, psio_address *end) {
+    const bool telemetry = PSIOManager::telemetry_enabled();
+    const auto t_start = telemetry ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+
+    /* Locate the data within the unit */
+    psio_address start_data = read_address(unit, key, size, start, end);
+
     /* Now read the actual data from the unit */
     rw(unit, buffer, start_data, size, 0);
 
+    if (telemetry) {
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - t_start;
+        PSIOManager::shared_object()->record_io(unit, key, size, elapsed.count(), false);
+    }
+
 #ifdef PSIO_STATS
     psio_readlen[unit] += size;
 #endif
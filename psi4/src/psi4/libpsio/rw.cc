@@ -61,6 +61,17 @@ void PSIO::rw(size_t unit, char *buffer, psio_address address, size_t size, int
     psio_ud *this_unit;
 
     this_unit = &(psio_unit[unit]);
+
+    /* Compressed and memory-mapped units bypass the seek/read/write machinery entirely */
+    if (this_unit->zip != nullptr) {
+        rw_zip(unit, buffer, address, size, wrt);
+        return;
+    }
+    if (this_unit->mmapped) {
+        rw_mmap(unit, buffer, address, size, wrt);
+        return;
+    }
+
     numvols = this_unit->numvols;
     page = address.page;
     offset = address.offset;
@@ -0,0 +1,165 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2025 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+/*!
+ \file
+ \ingroup PSIO
+
+ I/O telemetry: byte counts, operation counts, latency histograms and
+ effective bandwidth per unit and per TOC entry, collected by PSIOManager
+ from PSIO::read(), PSIO::write() and the AIOHandler workers while enabled
+ with PSIOManager::set_telemetry().
+ */
+
+#include <algorithm>
+#include <cmath>
+#include "psi4/libpsio/psio.hpp"
+#include "psi4/libpsi4util/PsiOutStream.h"
+#include "psi4/psi4-dec.h"
+
+namespace psi {
+
+std::atomic<bool> PSIOManager::telemetry_(false);
+
+namespace {
+
+void psio_iostats_add(psio_iostats &stats, size_t bytes, double seconds, bool wrt) {
+    if (wrt) {
+        stats.nwrite++;
+        stats.write_bytes += bytes;
+        stats.write_time += seconds;
+    } else {
+        stats.nread++;
+        stats.read_bytes += bytes;
+        stats.read_time += seconds;
+    }
+    /* Bucket 0 is below 1 us, bucket b covers [2^(b-1), 2^b) us */
+    const double us = seconds * 1.0E6;
+    size_t bucket = 0;
+    if (us >= 1.0) bucket = std::min<size_t>(PSIO_TELEMETRY_NBUCKET - 1, (size_t)std::ilogb(us) + 1);
+    stats.latency[bucket]++;
+}
+
+/* Bandwidth in MiB/s, or zero when nothing was timed */
+double psio_bandwidth(size_t bytes, double seconds) { return seconds > 0.0 ? bytes / 1048576.0 / seconds : 0.0; }
+
+void psio_print_iostats(std::shared_ptr<PsiOutStream> printer, const std::string &label, const psio_iostats &stats) {
+    const size_t nops = stats.nread + stats.nwrite;
+    const double avg = nops ? (double)(stats.read_bytes + stats.write_bytes) / nops / 1024.0 : 0.0;
+    printer->Printf("  %-22s %9zu %11.2f %9.1f %9zu %11.2f %9.1f %10.1f\n", label.c_str(), stats.nread,
+                    stats.read_bytes / 1048576.0, psio_bandwidth(stats.read_bytes, stats.read_time), stats.nwrite,
+                    stats.write_bytes / 1048576.0, psio_bandwidth(stats.write_bytes, stats.write_time), avg);
+}
+
+}  // namespace
+
+/*!
+** PSIOManager::record_io(): Account one completed read or write of an entry.
+**
+** \param fileno  = PSI4 file number
+** \param key     = TOC key of the entry
+** \param bytes   = number of bytes moved
+** \param seconds = time taken
+** \param wrt     = write (true) or read (false)
+**
+** \ingroup PSIO
+*/
+void PSIOManager::record_io(int fileno, const char *key, size_t bytes, double seconds, bool wrt) {
+    std::lock_guard<std::mutex> guard(telemetry_lock_);
+    psio_iostats_add(unit_stats_[fileno], bytes, seconds, wrt);
+    psio_iostats_add(key_stats_[std::make_pair(fileno, std::string(key))], bytes, seconds, wrt);
+}
+
+void PSIOManager::clear_telemetry() {
+    std::lock_guard<std::mutex> guard(telemetry_lock_);
+    unit_stats_.clear();
+    key_stats_.clear();
+}
+
+std::map<int, psio_iostats> PSIOManager::unit_telemetry() {
+    std::lock_guard<std::mutex> guard(telemetry_lock_);
+    return unit_stats_;
+}
+
+std::map<std::pair<int, std::string>, psio_iostats> PSIOManager::key_telemetry() {
+    std::lock_guard<std::mutex> guard(telemetry_lock_);
+    return key_stats_;
+}
+
+/*!
+** PSIOManager::print_telemetry(): Print bandwidth and operation counts per
+** unit and per entry, followed by the latency histogram of every unit.
+**
+** \param out = file to print to
+**
+** \ingroup PSIO
+*/
+void PSIOManager::print_telemetry(std::string out) {
+    std::shared_ptr<psi::PsiOutStream> printer = (out == "outfile" ? outfile : std::make_shared<PsiOutStream>(out));
+    std::lock_guard<std::mutex> guard(telemetry_lock_);
+
+    printer->Printf("  ==> PSIO Telemetry <==\n\n");
+    if (unit_stats_.empty()) {
+        printer->Printf("  No I/O recorded%s.\n\n", telemetry_enabled() ? "" : " (telemetry is disabled)");
+        return;
+    }
+
+    const char *header = "  %-22s %9s %11s %9s %9s %11s %9s %10s\n";
+    const char *rule =
+        "  ---------------------------------------------------------------------------------------------\n";
+    printer->Printf(header, "Unit", "Reads", "Read [MiB]", "[MiB/s]", "Writes", "Wrote [MiB]", "[MiB/s]",
+                    "Avg [KiB]");
+    printer->Printf(rule);
+    for (const auto &kv : unit_stats_) psio_print_iostats(printer, std::to_string(kv.first), kv.second);
+    printer->Printf("\n");
+
+    printer->Printf(header, "Unit:Entry", "Reads", "Read [MiB]", "[MiB/s]", "Writes", "Wrote [MiB]", "[MiB/s]",
+                    "Avg [KiB]");
+    printer->Printf(rule);
+    for (const auto &kv : key_stats_)
+        psio_print_iostats(printer, std::to_string(kv.first.first) + ":" + kv.first.second, kv.second);
+    printer->Printf("\n");
+
+    printer->Printf("  Latency histogram (operations per bucket):\n\n");
+    printer->Printf("  %-12s", "Bucket [us]");
+    for (const auto &kv : unit_stats_) printer->Printf(" %10d", kv.first);
+    printer->Printf("\n");
+    for (size_t b = 0; b < PSIO_TELEMETRY_NBUCKET; b++) {
+        bool empty = true;
+        for (const auto &kv : unit_stats_) empty = empty && kv.second.latency[b] == 0;
+        if (empty) continue;
+        std::string label = (b == 0 ? std::string("< 1") : "< " + std::to_string(1UL << b));
+        if (b == PSIO_TELEMETRY_NBUCKET - 1) label = ">= " + std::to_string(1UL << (b - 1));
+        printer->Printf("  %-12s", label.c_str());
+        for (const auto &kv : unit_stats_) printer->Printf(" %10zu", kv.second.latency[b]);
+        printer->Printf("\n");
+    }
+    printer->Printf("\n");
+}
+
+}  // namespace psi
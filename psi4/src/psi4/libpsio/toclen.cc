@@ -77,6 +77,12 @@ void PSIO::rewind_toclen(const size_t unit) {
 /// @return length of the TOC for a given unit
 size_t PSIO::rd_toclen(const size_t unit) {
     if (!open_check(unit)) psio_error(unit, PSIO_ERROR_UNOPENED);
+    // Compressed units hold the value in their first (logical) page; pages never written read as zero
+    if (psio_unit[unit].zip != nullptr) {
+        size_t len;
+        rw(unit, (char *)&len, PSIO_ZERO, sizeof(size_t), 0);
+        return (len);
+    }
     // Seek to the beginning
     rewind_toclen(unit);
     // Read the value
@@ -100,6 +106,10 @@ size_t PSIO::rd_toclen(const size_t unit) {
 /// @param len  : length value to write
 void PSIO::wt_toclen(const size_t unit, const size_t len) {
     if (!open_check(unit)) psio_error(unit, PSIO_ERROR_UNOPENED);
+    if (psio_unit[unit].zip != nullptr) {
+        rw(unit, (char *)&len, PSIO_ZERO, sizeof(size_t), 1);
+        return;
+    }
     // Seek to the beginning
     rewind_toclen(unit);
     // Write the value
@@ -31,6 +31,7 @@
  \ingroup PSIO
  */
 
+#include <chrono>
 #include <cstdlib>
 #include <cstring>
 #include "psi4/pragma.h"
@@ -40,7 +41,8 @@
 
 namespace psi {
 
-void PSIO::write(size_t unit, const char *key, char *buffer, size_t size, psio_address start, psio_address *end) {
+psio_address PSIO::write_address(size_t unit, const char *key, size_t size, psio_address start,
+                                 psio_address *end) {
     psio_ud *this_unit;
     psio_tocentry *this_entry, *last_entry;
     psio_address start_toc, start_data, end_data; /* global addresses */
@@ -130,9 +132,24 @@ void PSIO::write(size_t unit, const char *key, char *buffer, size_t size, psio_a
     if (dirty) /* Need to first write/update the TOC header for this record */
         rw(unit, (char *)this_entry, start_toc, tocentry_size, 1);
 
+    return start_data;
+}
+
+void PSIO::write(size_t unit, const char *key, char *buffer, size_t size, psio_address start, psio_address *end) {
+    const bool telemetry = PSIOManager::telemetry_enabled();
+    const auto t_start = telemetry ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+
+    /* Locate the data within the unit, creating or extending the entry as needed */
+    psio_address start_data = write_address(unit, key, size, start, end);
+
     /* Now write the actual data to the unit */
     rw(unit, buffer, start_data, size, 1);
 
+    if (telemetry) {
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - t_start;
+        PSIOManager::shared_object()->record_io(unit, key, size, elapsed.count(), true);
+    }
+
 #ifdef PSIO_STATS
     psio_writlen[unit] += size;
 #endif
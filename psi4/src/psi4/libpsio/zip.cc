@@ -0,0 +1,510 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2025 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+/*!
+ \file
+ \ingroup PSIO
+
+ Transparent page compression for PSIO units.
+
+ A compressed unit keeps the logical layout of an ordinary unit (TOC, entry
+ headers and data at the same global addresses) but stores every
+ PSIO_PAGELEN-byte page of that address space as an independently compressed
+ record in a single volume file. An index, one slot per logical page, locates
+ the records; it is kept in core while the unit is open and appended to the
+ file on close. Pages that were never written read as zeros. Since everything
+ above PSIO::rw() is unchanged, random access by psio_address works exactly
+ as for uncompressed units, at the price of a read-modify-write of one page
+ for partial updates. The few most recently touched pages are cached
+ uncompressed to absorb runs of small reads and writes (including the entry
+ header updates that accompany each appending write).
+
+ On-disk layout:
+   [psio_zipheader][record]...[record][index: psio_zipslot x npages]
+
+ Two codecs are available. The lossless one XORs every 8-byte word with its
+ predecessor and stores only the nonzero low-order bytes, behind a nibble
+ giving their count; it is cheap and works well on sparse or smooth data such
+ as prestriped integral files. The lossy one, selected by a positive
+ tolerance, rounds every word, read as a double, to a multiple of twice the
+ tolerance and stores varint-coded differences of the multiples, so the
+ absolute error of every value is at most the tolerance. It must only be used
+ for units holding nothing but doubles (e.g. amplitudes); pages holding the
+ TOC length or an entry header are always stored losslessly.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "psi4/libpsio/psio.h"
+#include "psi4/libpsio/psio.hpp"
+#include "psi4/libpsi4util/PsiOutStream.h"
+#include "psi4/psi4-dec.h"
+
+// Number of uncompressed pages cached per unit
+#define PSIO_ZIP_NCACHE 4
+// "PSIOZIP1"; no plain unit can begin with this, as it would be its TOC length
+#define PSIO_ZIP_MAGIC 0x3150495A4F495350ULL
+
+namespace psi {
+
+namespace {
+
+enum psio_zipcodec : char { PSIO_ZIP_RAW = 0, PSIO_ZIP_XOR = 1, PSIO_ZIP_QUANT = 2 };
+
+constexpr size_t PSIO_ZIP_WORDS = PSIO_PAGELEN / sizeof(uint64_t);
+// Worst case for any record we are willing to store: the raw page plus its codec byte
+constexpr size_t PSIO_ZIP_MAXREC = PSIO_PAGELEN + 1;
+
+struct psio_zipheader {
+    uint64_t magic;
+    uint64_t npages;
+    uint64_t index;
+    double tolerance;
+    uint64_t reserved[4];
+};
+
+struct psio_zipslot {
+    uint64_t offset;
+    uint32_t length;
+    uint32_t capacity;
+};
+
+/// Lossless codec; returns the encoded length or 0 if it does not pay off
+size_t zip_xor_encode(const char *in, char *out) {
+    char *nibbles = out;
+    char *bytes = out + PSIO_ZIP_WORDS / 2;
+    char *const end = out + PSIO_PAGELEN;
+    std::memset(nibbles, 0, PSIO_ZIP_WORDS / 2);
+
+    uint64_t prev = 0;
+    for (size_t w = 0; w < PSIO_ZIP_WORDS; w++) {
+        uint64_t word;
+        std::memcpy(&word, in + w * sizeof(uint64_t), sizeof(uint64_t));
+        uint64_t x = word ^ prev;
+        prev = word;
+
+        size_t nbytes = 0;
+        while (nbytes < 8 && (x >> (8 * nbytes))) nbytes++;
+        if (bytes + nbytes > end) return 0;
+
+        nibbles[w / 2] |= (char)(nbytes << (4 * (w % 2)));
+        for (size_t b = 0; b < nbytes; b++) *bytes++ = (char)(x >> (8 * b));
+    }
+    return bytes - out;
+}
+
+void zip_xor_decode(const char *in, size_t len, char *out, size_t unit) {
+    const char *nibbles = in;
+    const char *bytes = in + PSIO_ZIP_WORDS / 2;
+    const char *const end = in + len;
+
+    uint64_t prev = 0;
+    for (size_t w = 0; w < PSIO_ZIP_WORDS; w++) {
+        const size_t nbytes = (nibbles[w / 2] >> (4 * (w % 2))) & 0xF;
+        if (nbytes > 8 || bytes + nbytes > end) psio_error(unit, PSIO_ERROR_ZIP);
+
+        uint64_t x = 0;
+        for (size_t b = 0; b < nbytes; b++) x |= (uint64_t)(unsigned char)(*bytes++) << (8 * b);
+        prev ^= x;
+        std::memcpy(out + w * sizeof(uint64_t), &prev, sizeof(uint64_t));
+    }
+}
+
+/// Lossy fixed-precision codec; returns the encoded length or 0 if the page cannot be quantized profitably
+size_t zip_quant_encode(const char *in, char *out, double tolerance) {
+    const double step = 2.0 * tolerance;
+    const double qmax = 4503599627370496.0;  // 2^52: beyond this the quantization is not exact anymore
+    char *bytes = out;
+    char *const end = out + PSIO_PAGELEN;
+
+    int64_t prev = 0;
+    for (size_t w = 0; w < PSIO_ZIP_WORDS; w++) {
+        double value;
+        std::memcpy(&value, in + w * sizeof(double), sizeof(double));
+        const double scaled = value / step;
+        if (!std::isfinite(scaled) || std::fabs(scaled) > qmax) return 0;
+
+        const int64_t q = std::llround(scaled);
+        const int64_t delta = q - prev;
+        prev = q;
+        uint64_t zigzag = ((uint64_t)delta << 1) ^ (uint64_t)(delta >> 63);
+        do {
+            if (bytes == end) return 0;
+            *bytes++ = (char)((zigzag & 0x7F) | (zigzag > 0x7F ? 0x80 : 0));
+            zigzag >>= 7;
+        } while (zigzag);
+    }
+    return bytes - out;
+}
+
+void zip_quant_decode(const char *in, size_t len, char *out, double tolerance, size_t unit) {
+    const double step = 2.0 * tolerance;
+    const char *bytes = in;
+    const char *const end = in + len;
+
+    int64_t prev = 0;
+    for (size_t w = 0; w < PSIO_ZIP_WORDS; w++) {
+        uint64_t zigzag = 0;
+        for (int shift = 0;; shift += 7) {
+            if (bytes == end || shift > 63) psio_error(unit, PSIO_ERROR_ZIP);
+            const unsigned char byte = *bytes++;
+            zigzag |= (uint64_t)(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) break;
+        }
+        prev += (int64_t)(zigzag >> 1) ^ -(int64_t)(zigzag & 1);
+        const double value = prev * step;
+        std::memcpy(out + w * sizeof(double), &value, sizeof(double));
+    }
+}
+
+/// Positioned I/O on the single volume of a compressed unit
+void zip_pio(int stream, char *buffer, size_t size, size_t pos, int wrt, size_t unit) {
+#ifndef _MSC_VER
+    size_t done = 0;
+    while (done < size) {
+        const ssize_t errcod = wrt ? ::pwrite(stream, buffer + done, size - done, pos + done)
+                                   : ::pread(stream, buffer + done, size - done, pos + done);
+        const int saved_errno = errno;
+        if (errcod == -1 && saved_errno == EINTR) continue;
+        if (errcod <= 0) {
+            const std::string beginning =
+                wrt ? ((errcod == -1) ? "WRITE failed." : "WRITE failed. Only some of the bytes were written!")
+                    : ((errcod == -1) ? "READ failed." : "READ failed. Only some of the bytes were read!");
+            const std::string context = wrt ? "Error writing a compressed page" : "Error reading a compressed page";
+            const std::string errmsg = (errcod == -1) ? psio_compose_err_msg(beginning, context, unit, saved_errno)
+                                                      : psio_compose_err_msg(beginning, context, unit);
+            psio_error(unit, wrt ? PSIO_ERROR_WRITE : PSIO_ERROR_READ, errmsg);
+        }
+        done += errcod;
+    }
+#endif
+}
+
+}  // namespace
+
+/// An uncompressed page held in core
+struct psio_zipcache {
+    size_t page = 0;
+    bool valid = false;
+    bool dirty = false;
+    /// Time of last use, for LRU replacement
+    size_t stamp = 0;
+    std::vector<char> data;
+};
+
+struct psio_zip {
+    /// Zero for lossless compression, else the absolute error bound of the lossy codec
+    double tolerance;
+    /// First free byte of the volume
+    size_t append;
+    /// Where each logical page is stored
+    std::vector<psio_zipslot> index;
+    /// The most recently touched pages, uncompressed
+    psio_zipcache cache[PSIO_ZIP_NCACHE];
+    size_t clock;
+    /// Scratch space for encoded records
+    std::vector<char> record;
+};
+
+/*!
+ ** PSIO_ZIP_OPEN(): Set up compression for a freshly opened unit. New units
+ ** are compressed if PSIOManager asks for it; existing units are compressed if
+ ** (and only if) they were written compressed, whatever the current setting.
+ ** Only single-volume units can be compressed.
+ **
+ ** \param unit   = The PSI unit number.
+ ** \param status = PSIO_OPEN_NEW or PSIO_OPEN_OLD.
+ **
+ ** \ingroup PSIO
+ */
+void PSIO::zip_open(size_t unit, int status) {
+#ifndef _MSC_VER
+    psio_ud *this_unit = &(psio_unit[unit]);
+    if (this_unit->numvols != 1) return;
+    const int stream = this_unit->vol[0].stream;
+
+    psio_zipheader header;
+    std::memset(&header, 0, sizeof(header));
+
+    // Units opened "old" that do not exist yet are as good as new
+    bool fresh = (status == PSIO_OPEN_NEW);
+    if (status == PSIO_OPEN_OLD) {
+        const ssize_t errcod = ::pread(stream, &header, sizeof(header), 0);
+        if (errcod == 0)
+            fresh = true;
+        else if (errcod != (ssize_t)sizeof(header) || header.magic != PSIO_ZIP_MAGIC)
+            return;
+    }
+    if (fresh) {
+        std::memset(&header, 0, sizeof(header));
+        if (!PSIOManager::shared_object()->get_specific_compression(unit)) return;
+        header.magic = PSIO_ZIP_MAGIC;
+        header.index = sizeof(header);
+        header.tolerance = PSIOManager::shared_object()->get_specific_compression_tolerance(unit);
+        zip_pio(stream, (char *)&header, sizeof(header), 0, 1, unit);
+    }
+
+    auto *zip = new psio_zip;
+    zip->tolerance = header.tolerance;
+    zip->append = header.index;
+    zip->index.resize(header.npages);
+    if (header.npages)
+        zip_pio(stream, (char *)zip->index.data(), header.npages * sizeof(psio_zipslot), header.index, 0, unit);
+    for (auto &slot : zip->cache) slot.data.resize(PSIO_PAGELEN);
+    zip->clock = 0;
+    zip->record.resize(PSIO_ZIP_MAXREC);
+    this_unit->zip = zip;
+#endif
+}
+
+/*!
+ ** PSIO_ZIP_CLOSE(): Flush the page cache, append the page index to the
+ ** volume and release the compression state of a unit.
+ **
+ ** \param unit = The PSI unit number.
+ **
+ ** \ingroup PSIO
+ */
+void PSIO::zip_close(size_t unit) {
+    psio_ud *this_unit = &(psio_unit[unit]);
+    psio_zip *zip = this_unit->zip;
+    if (zip == nullptr) return;
+
+    for (auto &slot : zip->cache) {
+        if (slot.valid && slot.dirty) zip_store(unit, slot.page, slot.data.data());
+    }
+
+    psio_zipheader header;
+    std::memset(&header, 0, sizeof(header));
+    header.magic = PSIO_ZIP_MAGIC;
+    header.npages = zip->index.size();
+    header.index = zip->append;
+    header.tolerance = zip->tolerance;
+
+    const int stream = this_unit->vol[0].stream;
+    if (header.npages)
+        zip_pio(stream, (char *)zip->index.data(), header.npages * sizeof(psio_zipslot), header.index, 1, unit);
+    zip_pio(stream, (char *)&header, sizeof(header), 0, 1, unit);
+
+    delete zip;
+    this_unit->zip = nullptr;
+}
+
+/*!
+ ** PSIO_ZIP_LOAD(): Decompress logical page 'page' of a unit into 'dest'
+ ** (PSIO_PAGELEN bytes). The page cache is not consulted.
+ **
+ ** \ingroup PSIO
+ */
+void PSIO::zip_load(size_t unit, size_t page, char *dest) {
+    psio_zip *zip = psio_unit[unit].zip;
+    if (page >= zip->index.size() || zip->index[page].length == 0) {
+        std::memset(dest, 0, PSIO_PAGELEN);
+        return;
+    }
+
+    const psio_zipslot &slot = zip->index[page];
+    if (slot.length > PSIO_ZIP_MAXREC) psio_error(unit, PSIO_ERROR_ZIP);
+    zip_pio(psio_unit[unit].vol[0].stream, zip->record.data(), slot.length, slot.offset, 0, unit);
+
+    auto start = std::chrono::steady_clock::now();
+    const char *payload = zip->record.data() + 1;
+    const size_t length = slot.length - 1;
+    switch (zip->record[0]) {
+        case PSIO_ZIP_RAW:
+            if (length != PSIO_PAGELEN) psio_error(unit, PSIO_ERROR_ZIP);
+            std::memcpy(dest, payload, PSIO_PAGELEN);
+            break;
+        case PSIO_ZIP_XOR:
+            zip_xor_decode(payload, length, dest, unit);
+            break;
+        case PSIO_ZIP_QUANT:
+            zip_quant_decode(payload, length, dest, zip->tolerance, unit);
+            break;
+        default:
+            psio_error(unit, PSIO_ERROR_ZIP);
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    psio_zipstats &stats = zipstats_[unit];
+    stats.unpacked_in += slot.length;
+    stats.unpacked_out += PSIO_PAGELEN;
+    stats.nunpacked++;
+    stats.unpack_time += elapsed.count();
+}
+
+/*!
+ ** PSIO_ZIP_STORE(): Compress PSIO_PAGELEN bytes at 'src' and store them as
+ ** logical page 'page' of a unit, in place if the previous record of the page
+ ** has room for it and at the end of the volume otherwise.
+ **
+ ** \ingroup PSIO
+ */
+void PSIO::zip_store(size_t unit, size_t page, const char *src) {
+    psio_ud *this_unit = &(psio_unit[unit]);
+    psio_zip *zip = this_unit->zip;
+    char *record = zip->record.data();
+
+    // Pages carrying TOC bookkeeping must survive bit for bit
+    bool lossy = zip->tolerance > 0.0 && page != 0;
+    if (lossy) {
+        const size_t tocentry_size = sizeof(psio_tocentry) - 2 * sizeof(psio_tocentry *);
+        for (psio_tocentry *entry = this_unit->toc; entry != nullptr && lossy; entry = entry->next) {
+            const psio_address last = psio_get_address(entry->sadd, tocentry_size - 1);
+            if (entry->sadd.page <= page && last.page >= page) lossy = false;
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    size_t length = 0;
+    if (lossy) {
+        length = zip_quant_encode(src, record + 1, zip->tolerance);
+        record[0] = PSIO_ZIP_QUANT;
+    }
+    if (!length) {
+        lossy = false;
+        length = zip_xor_encode(src, record + 1);
+        record[0] = PSIO_ZIP_XOR;
+    }
+    if (!length) {
+        length = PSIO_PAGELEN;
+        std::memcpy(record + 1, src, PSIO_PAGELEN);
+        record[0] = PSIO_ZIP_RAW;
+    }
+    length += 1;
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    if (page >= zip->index.size()) zip->index.resize(page + 1, psio_zipslot{0, 0, 0});
+    psio_zipslot &slot = zip->index[page];
+    if (length > slot.capacity) {
+        // Leave some slack, so that pages that are updated repeatedly settle into their slot
+        slot.capacity = std::min(length + length / 8 + 16, PSIO_ZIP_MAXREC);
+        slot.offset = zip->append;
+        zip->append += slot.capacity;
+    }
+    slot.length = length;
+    zip_pio(this_unit->vol[0].stream, record, length, slot.offset, 1, unit);
+
+    psio_zipstats &stats = zipstats_[unit];
+    stats.packed_in += PSIO_PAGELEN;
+    stats.packed_out += length;
+    stats.npacked++;
+    if (lossy) stats.nlossy++;
+    stats.pack_time += elapsed.count();
+}
+
+/*!
+ ** PSIO_RW_ZIP(): Compressed counterpart of PSIO_RW(). Whole pages go
+ ** straight between the caller's buffer and the codec; partial pages are
+ ** assembled in the page cache.
+ **
+ ** \param unit    = The PSI unit number.
+ ** \param buffer  = The buffer containing the bytes for the read/write event.
+ ** \param address = the PSIO global address for the start of the read/write.
+ ** \param size    = The number of bytes to read/write.
+ ** \param wrt     = Indicates if the call is to read (0) or write (1) the input data.
+ **
+ ** \ingroup PSIO
+ */
+void PSIO::rw_zip(size_t unit, char *buffer, psio_address address, size_t size, int wrt) {
+    psio_zip *zip = psio_unit[unit].zip;
+    size_t page = address.page;
+    size_t offset = address.offset;
+    size_t buf_offset = 0;
+
+    while (size) {
+        const size_t this_total = std::min(size, (size_t)PSIO_PAGELEN - offset);
+
+        psio_zipcache *slot = nullptr;
+        for (auto &candidate : zip->cache) {
+            if (candidate.valid && candidate.page == page) slot = &candidate;
+        }
+
+        if (this_total == PSIO_PAGELEN && slot == nullptr) {
+            if (wrt)
+                zip_store(unit, page, buffer + buf_offset);
+            else
+                zip_load(unit, page, buffer + buf_offset);
+        } else {
+            if (slot == nullptr) {
+                // Evict the least recently used page
+                slot = &(zip->cache[0]);
+                for (auto &candidate : zip->cache) {
+                    if (!candidate.valid || (slot->valid && candidate.stamp < slot->stamp)) slot = &candidate;
+                }
+                if (slot->valid && slot->dirty) zip_store(unit, slot->page, slot->data.data());
+                zip_load(unit, page, slot->data.data());
+                slot->page = page;
+                slot->valid = true;
+                slot->dirty = false;
+            }
+            slot->stamp = ++(zip->clock);
+            if (wrt) {
+                std::memcpy(slot->data.data() + offset, buffer + buf_offset, this_total);
+                slot->dirty = true;
+            } else {
+                std::memcpy(buffer + buf_offset, slot->data.data() + offset, this_total);
+            }
+        }
+
+        buf_offset += this_total;
+        size -= this_total;
+        page += (offset + this_total) / PSIO_PAGELEN;
+        offset = (offset + this_total) % PSIO_PAGELEN;
+    }
+}
+
+psio_zipstats PSIO::zip_stats(size_t unit) {
+    psio_zipstats stats;
+    std::memset(&stats, 0, sizeof(stats));
+    if (zipstats_.count(unit)) stats = zipstats_[unit];
+    return stats;
+}
+
+void PSIO::print_zip_stats(std::string out) {
+    std::shared_ptr<psi::PsiOutStream> printer = (out == "outfile" ? outfile : std::make_shared<PsiOutStream>(out));
+    printer->Printf("  ==> PSIO Compression <==\n\n");
+    printer->Printf("  %-6s %12s %12s %7s %10s %12s %12s %10s\n", "Unit", "Packed [MiB]", "Stored [MiB]", "Ratio",
+                    "Lossy", "Pack [s]", "Read [MiB]", "Unpack [s]");
+    printer->Printf("  -----------------------------------------------------------------------------------------------\n");
+    for (const auto &kv : zipstats_) {
+        const psio_zipstats &stats = kv.second;
+        const double ratio = stats.packed_out ? (double)stats.packed_in / stats.packed_out : 0.0;
+        printer->Printf("  %-6zu %12.2f %12.2f %7.2f %10zu %12.3f %12.2f %10.3f\n", kv.first,
+                        stats.packed_in / 1048576.0, stats.packed_out / 1048576.0, ratio, stats.nlossy,
+                        stats.pack_time, stats.unpacked_out / 1048576.0, stats.unpack_time);
+    }
+    printer->Printf("\n");
+}
+
+}  // namespace psi
@@ -64,6 +64,8 @@ extern void F_DTRMM(char*, char*, char*, char*, int*, int*, double*, double*, in
 extern void F_DTRMV(char*, char*, char*, int*, double*, int*, double*, int*);
 extern void F_DTRSM(char*, char*, char*, char*, int*, int*, double*, double*, int*, double*, int*);
 extern void F_DTRSV(char*, char*, char*, int*, double*, int*, double*, int*);
+extern void F_SGEMM(char*, char*, int*, int*, int*, float*, float*, int*, float*, int*, float*, float*, int*);
+extern void F_SGEMV(char*, int*, int*, float*, float*, int*, float*, int*, float*, float*, int*);
 }
 
 namespace psi {
@@ -2670,4 +2672,30 @@ void C_DTRSV(char uplo, char trans, char diag, int n, double* a, int lda, double
     ::F_DTRSV(&uplo, &trans, &diag, &n, a, &lda, x, &incx);
 }
 
+/**
+ * Single-precision counterpart of C_DGEMM, with the same row-major
+ * conventions. Intended for reduced-precision intermediates only.
+ **/
+PSI_API void C_SGEMM(char transa, char transb, int m, int n, int k, float alpha, float* a, int lda, float* b, int ldb,
+                     float beta, float* c, int ldc) {
+    if (m == 0 || n == 0 || k == 0) return;
+    ::F_SGEMM(&transb, &transa, &n, &m, &k, &alpha, b, &ldb, a, &lda, &beta, c, &ldc);
+}
+
+/**
+ * Single-precision counterpart of C_DGEMV, with the same row-major
+ * conventions. Intended for reduced-precision intermediates only.
+ **/
+PSI_API void C_SGEMV(char trans, int m, int n, float alpha, float* a, int lda, float* x, int incx, float beta,
+                     float* y, int incy) {
+    if (m == 0 || n == 0) return;
+    if (trans == 'N' || trans == 'n')
+        trans = 'T';
+    else if (trans == 'T' || trans == 't')
+        trans = 'N';
+    else
+        throw std::invalid_argument("C_SGEMV trans argument is invalid.");
+    ::F_SGEMV(&trans, &n, &m, &alpha, a, &lda, x, &incx, &beta, y, &incy);
+}
+
 }  // namespace psi
@@ -46,6 +46,7 @@
 
 namespace psi {
 class Options;
+class PsiOutStream;
 class Wavefunction;
 
 void dx_write(std::shared_ptr<Wavefunction> wfn, Options& options, double** D);
@@ -80,6 +81,13 @@ void parallel_timer_off(const std::string& key, int thread_rank);
 void start_skip_timers();
 void stop_skip_timers();
 void clean_timers();
+PSI_API size_t timer_key(const std::string& key);
+PSI_API void thread_timer_on(size_t key);
+PSI_API void thread_timer_off(size_t key);
+void thread_timer_trace(bool enable);
+void thread_timer_write_trace(const std::string& filename);
+void print_thread_timers(std::shared_ptr<PsiOutStream> printer);
+void clean_thread_timers();
 
 int cc_excited(const char* wfn);
 int cc_excited(std::string wfn);
@@ -138,6 +146,14 @@ void C_DSYR2K(char uplo, char trans, int n, int k, double alpha, double* a, int
 PSI_API
 void C_DTRSV(char uplo, char trans, char diag, int n, double* a, int lda, double* x, int incx);
 
+// BLAS 2/3 Single routines
+PSI_API
+void C_SGEMV(char trans, int m, int n, float alpha, float* a, int lda, float* x, int incx, float beta, float* y,
+             int incy);
+PSI_API
+void C_SGEMM(char transa, char transb, int m, int n, int k, float alpha, float* a, int lda, float* b, int ldb,
+             float beta, float* c, int ldc);
+
 // LAPACK 3.2 Double routines
 // Sorry guys, I know its rather epic
 int C_DBDSDC(char uplo, char compq, int n, double* d, double* e, double* u, int ldu, double* vt, int ldvt, double* q,
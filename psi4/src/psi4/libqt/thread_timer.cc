@@ -0,0 +1,398 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2025 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This file is part of Psi4.
+ *
+ * Psi4 is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * Psi4 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along
+ * with Psi4; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+/*!
+** \file
+** \brief Low-overhead per-thread timers and timeline traces
+** \ingroup QT
+**
+** THREAD_TIMER.CC: Timers cheap enough to be left on inside OpenMP
+** loops over DFT blocks or shell quartets. Unlike parallel_timer_on(),
+** which takes a global lock and looks up a string key in a shared
+** tree on every call, these keep all state in a buffer private to the
+** calling thread and identify timers by interned integer keys, so
+** starting and stopping a timer touches no shared data. The buffers
+** of all threads are merged only when the report is written. When a
+** thread exits, its buffer (with everything recorded so far) is handed
+** to the next thread that starts timing, so short-lived threads do not
+** accumulate buffers.
+**
+** Usage:
+**
+**   static const size_t key = timer_key("My Kernel");  // once, interns the name
+**   thread_timer_on(key);
+**   ...
+**   thread_timer_off(key);
+**
+** Thread timers nest like the serial timers but must be stopped in the
+** reverse order in which they were started. The merged call tree, with
+** the summed and the slowest thread's wall time, is appended to
+** timer.dat by timer_done(). If tracing has been enabled with
+** thread_timer_trace(), every timed interval is also recorded and can be
+** written as a Chrome trace (chrome://tracing, Perfetto) with
+** thread_timer_write_trace() to inspect load imbalance between threads.
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "psi4/libpsi4util/PsiOutStream.h"
+#include "psi4/libpsi4util/exception.h"
+#include "psi4/libqt/qt.h"
+
+/* Maximum number of intervals traced per thread; later ones are counted but dropped */
+#define THREAD_TIMER_MAX_EVENTS (1 << 20)
+
+namespace psi {
+
+extern bool skip_timers;
+
+namespace {
+
+using clock = std::chrono::steady_clock;
+
+struct ThreadTimerNode {
+    size_t key;
+    size_t n_calls;
+    clock::duration wtime;
+    /// (key, node index) of the timers started while this one was running
+    std::vector<std::pair<size_t, size_t>> children;
+};
+
+struct ThreadTimerEvent {
+    size_t key;
+    clock::time_point start;
+    clock::duration duration;
+};
+
+/* Everything one thread records. Only the owning thread touches it until the report is written. */
+struct ThreadTimerBuffer {
+    int id;
+    int omp_rank;
+    /// Call tree; node 0 is the root
+    std::vector<ThreadTimerNode> nodes;
+    /// Running timers: node index and start time
+    std::vector<std::pair<size_t, clock::time_point>> stack;
+    std::vector<ThreadTimerEvent> events;
+    size_t dropped;
+
+    void clear() {
+        nodes.assign(1, ThreadTimerNode{0, 0, clock::duration::zero(), {}});
+        stack.clear();
+        events.clear();
+        dropped = 0;
+    }
+};
+
+/* Guards the key table and the buffer registry, both of which are only touched outside timed regions */
+std::mutex thread_timer_lock;
+std::unordered_map<std::string, size_t> thread_timer_ids;
+std::vector<std::string> thread_timer_names(1, "");
+std::vector<std::unique_ptr<ThreadTimerBuffer>> thread_timer_buffers;
+/// Buffers of threads that have exited, handed to the next new thread; their records are kept
+std::vector<ThreadTimerBuffer *> thread_timer_free;
+std::atomic<bool> thread_timer_tracing(false);
+clock::time_point thread_timer_epoch = clock::now();
+
+thread_local ThreadTimerBuffer *local_buffer = nullptr;
+
+/* Returns the buffer of the owning thread to the free list when that thread exits */
+struct ThreadTimerRelease {
+    ThreadTimerBuffer *buffer = nullptr;
+    ~ThreadTimerRelease() {
+        if (buffer == nullptr) return;
+        std::lock_guard<std::mutex> guard(thread_timer_lock);
+        // Timers still running when the thread died are abandoned
+        buffer->stack.clear();
+        thread_timer_free.push_back(buffer);
+    }
+};
+thread_local ThreadTimerRelease local_release;
+
+ThreadTimerBuffer *register_thread_timer_buffer() {
+    std::lock_guard<std::mutex> guard(thread_timer_lock);
+    ThreadTimerBuffer *buffer;
+    if (!thread_timer_free.empty()) {
+        buffer = thread_timer_free.back();
+        thread_timer_free.pop_back();
+    } else {
+        thread_timer_buffers.push_back(std::make_unique<ThreadTimerBuffer>());
+        buffer = thread_timer_buffers.back().get();
+        buffer->id = thread_timer_buffers.size() - 1;
+        buffer->clear();
+    }
+#ifdef _OPENMP
+    buffer->omp_rank = omp_get_thread_num();
+#else
+    buffer->omp_rank = 0;
+#endif
+    local_release.buffer = buffer;
+    return buffer;
+}
+
+/* Call tree summed over threads */
+struct MergedTimer {
+    size_t key;
+    size_t n_calls = 0;
+    size_t n_threads = 0;
+    double wtime = 0.0;
+    double max_wtime = 0.0;
+    std::vector<MergedTimer> children;
+
+    MergedTimer(size_t k) : key(k) {}
+    MergedTimer &child(size_t k) {
+        for (auto &c : children)
+            if (c.key == k) return c;
+        children.emplace_back(k);
+        return children.back();
+    }
+};
+
+void merge_thread_timers(MergedTimer &merged, const ThreadTimerBuffer &buffer, size_t node) {
+    for (const auto &kv : buffer.nodes[node].children) {
+        const ThreadTimerNode &timer = buffer.nodes[kv.second];
+        MergedTimer &target = merged.child(kv.first);
+        const double wtime = std::chrono::duration<double>(timer.wtime).count();
+        target.n_calls += timer.n_calls;
+        target.n_threads++;
+        target.wtime += wtime;
+        target.max_wtime = std::max(target.max_wtime, wtime);
+        merge_thread_timers(target, buffer, kv.second);
+    }
+}
+
+void print_merged_timers(const MergedTimer &merged, std::shared_ptr<PsiOutStream> printer, const std::string &indent) {
+    for (const auto &timer : merged.children) {
+        std::string key = indent + thread_timer_names[timer.key];
+        if (key.length() < 36) key.resize(36, ' ');
+        // Slowest thread relative to the average thread: 1.0 is perfect balance
+        const double imbalance = timer.wtime > 0.0 ? timer.max_wtime * timer.n_threads / timer.wtime : 1.0;
+        printer->Printf("%s: %10.3fp %10.3fm %8.2fx %6zu calls %4zu threads\n", key.c_str(), timer.wtime,
+                        timer.max_wtime, imbalance, timer.n_calls, timer.n_threads);
+        print_merged_timers(timer, printer, indent + "| ");
+    }
+}
+
+std::string json_escape(const std::string &str) {
+    std::string escaped;
+    for (char c : str) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+            escaped += c;
+        } else if ((unsigned char)c < 0x20) {
+            char code[8];
+            std::snprintf(code, sizeof(code), "\\u%04x", c);
+            escaped += code;
+        } else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+}  // namespace
+
+/*!
+** timer_key(): Intern a thread timer name. The returned key is what
+** thread_timer_on() and thread_timer_off() take; look it up once (e.g.
+** into a function-local static) rather than on every call.
+**
+** \param key = Name of timer
+**
+** \ingroup QT
+*/
+size_t timer_key(const std::string &key) {
+    std::lock_guard<std::mutex> guard(thread_timer_lock);
+    auto it = thread_timer_ids.find(key);
+    if (it != thread_timer_ids.end()) return it->second;
+    thread_timer_names.push_back(key);
+    thread_timer_ids.emplace(key, thread_timer_names.size() - 1);
+    return thread_timer_names.size() - 1;
+}
+
+/*!
+** thread_timer_on(): Turn on the thread timer with the given key on the
+** calling thread. May be called from inside or outside OpenMP parallel
+** sections; no lock is taken.
+**
+** \param key = Key of timer, from timer_key()
+**
+** \ingroup QT
+*/
+void thread_timer_on(size_t key) {
+    if (skip_timers) return;
+    ThreadTimerBuffer *buffer = local_buffer;
+    if (buffer == nullptr) buffer = local_buffer = register_thread_timer_buffer();
+
+    const size_t parent = buffer->stack.empty() ? 0 : buffer->stack.back().first;
+    size_t node = 0;
+    for (const auto &kv : buffer->nodes[parent].children) {
+        if (kv.first == key) {
+            node = kv.second;
+            break;
+        }
+    }
+    if (node == 0) {
+        node = buffer->nodes.size();
+        buffer->nodes.push_back(ThreadTimerNode{key, 0, clock::duration::zero(), {}});
+        buffer->nodes[parent].children.emplace_back(key, node);
+    }
+    buffer->stack.emplace_back(node, clock::now());
+}
+
+/*!
+** thread_timer_off(): Turn off the thread timer with the given key on the
+** calling thread. It must be the innermost thread timer running there.
+**
+** \param key = Key of timer, from timer_key()
+**
+** \ingroup QT
+*/
+void thread_timer_off(size_t key) {
+    const clock::time_point now = clock::now();
+    if (skip_timers) return;
+    ThreadTimerBuffer *buffer = local_buffer;
+    if (buffer == nullptr || buffer->stack.empty() || buffer->nodes[buffer->stack.back().first].key != key) {
+        std::string str = "Thread timer ";
+        str += (key < thread_timer_names.size() ? thread_timer_names[key] : std::to_string(key));
+        str += " is not the innermost thread timer running on this thread.";
+        throw PsiException(str, __FILE__, __LINE__);
+    }
+
+    const auto &running = buffer->stack.back();
+    ThreadTimerNode &timer = buffer->nodes[running.first];
+    timer.n_calls++;
+    timer.wtime += now - running.second;
+    if (thread_timer_tracing.load(std::memory_order_relaxed)) {
+        if (buffer->events.size() < THREAD_TIMER_MAX_EVENTS)
+            buffer->events.push_back(ThreadTimerEvent{key, running.second, now - running.second});
+        else
+            buffer->dropped++;
+    }
+    buffer->stack.pop_back();
+}
+
+/*!
+** thread_timer_trace(): Start or stop recording every thread timer
+** interval for thread_timer_write_trace(). Enabling discards the
+** intervals recorded so far. Call outside parallel sections.
+**
+** \param enable = Record or not
+**
+** \ingroup QT
+*/
+void thread_timer_trace(bool enable) {
+    std::lock_guard<std::mutex> guard(thread_timer_lock);
+    if (enable) {
+        for (auto &buffer : thread_timer_buffers) {
+            buffer->events.clear();
+            buffer->dropped = 0;
+        }
+        thread_timer_epoch = clock::now();
+    }
+    thread_timer_tracing.store(enable);
+}
+
+/*!
+** thread_timer_write_trace(): Write the intervals recorded since
+** thread_timer_trace(true) as a Chrome trace event file (JSON), one track
+** per thread. Call outside parallel sections.
+**
+** \param filename = File to write
+**
+** \ingroup QT
+*/
+void thread_timer_write_trace(const std::string &filename) {
+    std::lock_guard<std::mutex> guard(thread_timer_lock);
+    auto printer = std::make_shared<PsiOutStream>(filename, std::ostream::trunc);
+    printer->Printf("{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n");
+    bool first = true;
+    for (const auto &buffer : thread_timer_buffers) {
+        printer->Printf("%s{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 0, \"tid\": %d, "
+                        "\"args\": {\"name\": \"thread %d (OpenMP rank %d)\"}}",
+                        first ? "" : ",\n", buffer->id, buffer->id, buffer->omp_rank);
+        first = false;
+        for (const auto &event : buffer->events) {
+            const double ts = std::chrono::duration<double, std::micro>(event.start - thread_timer_epoch).count();
+            const double dur = std::chrono::duration<double, std::micro>(event.duration).count();
+            printer->Printf(",\n{\"name\": \"%s\", \"ph\": \"X\", \"pid\": 0, \"tid\": %d, \"ts\": %.3f, \"dur\": %.3f}",
+                            json_escape(thread_timer_names[event.key]).c_str(), buffer->id, ts, dur);
+        }
+    }
+    printer->Printf("\n]}\n");
+}
+
+/*!
+** print_thread_timers(): Merge the thread timers of all threads and print
+** the call tree. Called by timer_done().
+**
+** \param printer = Stream to print to
+**
+** \ingroup QT
+*/
+void print_thread_timers(std::shared_ptr<PsiOutStream> printer) {
+    std::lock_guard<std::mutex> guard(thread_timer_lock);
+    MergedTimer merged(0);
+    size_t dropped = 0;
+    for (const auto &buffer : thread_timer_buffers) {
+        merge_thread_timers(merged, *buffer, 0);
+        dropped += buffer->dropped;
+    }
+    if (merged.children.empty()) return;
+
+    printer->Printf("\nThread Timers                        %12s%12s%10s\n", "Wall Sum", "Wall Max", "Imbalance");
+    print_merged_timers(merged, printer, "");
+    if (dropped) printer->Printf("  (%zu trace intervals beyond %d per thread were not recorded)\n", dropped,
+                                 THREAD_TIMER_MAX_EVENTS);
+}
+
+/*!
+** clean_thread_timers(): Reset the thread timers of all threads. Called
+** by clean_timers(), outside parallel sections.
+**
+** \ingroup QT
+*/
+void clean_thread_timers() {
+    std::lock_guard<std::mutex> guard(thread_timer_lock);
+    for (auto &buffer : thread_timer_buffers) buffer->clear();
+}
+
+}  // namespace psi
@@ -118,6 +118,7 @@ typedef int omp_lock_t;
 #include "psi4/libciomr/libciomr.h"
 #include "psi4/libpsi4util/PsiOutStream.h"
 #include "psi4/libpsi4util/exception.h"
+#include "psi4/libqt/qt.h"
 
 /* guess for HZ, if missing */
 #ifndef HZ
@@ -1037,6 +1038,8 @@ void timer_done() {
 
     print_nested_timer(root_timer, printer, "");
 
+    print_thread_timers(printer);
+
     printer->Printf("\n**************************************************************************************\n");
 
     omp_unset_lock(&lock_timer);
@@ -1045,6 +1048,7 @@ void timer_done() {
 
 void clean_timers() {
     timer_done();
+    clean_thread_timers();
     Timer_Structure new_root_timer(nullptr, ""), new_parallel_timer(nullptr, "");
     extern Timer_Structure root_timer, parallel_timer;
     root_timer = new_root_timer;
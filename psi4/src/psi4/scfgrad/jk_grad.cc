@@ -45,6 +45,9 @@
 #include "psi4/liboptions/liboptions.h"
 #include "psi4/libpsi4util/process.h"
 
+#include <algorithm>
+#include <cmath>
+
 #ifdef _OPENMP
 #include <omp.h>
 #endif
@@ -2650,7 +2653,47 @@ std::map<std::string, std::shared_ptr<Matrix>> DirectJKGrad::compute2(
     double** Dap = Da_->pointer();
     double** Dbp = Db_->pointer();
 
-    size_t computed_shells = 0L;
+    // => Density screening <= //
+    // The Hessian is quadratic in the density, so a quartet contributes at most its Schwarz bound
+    // times the largest Coulomb or exchange density product; tabulate the shell pair maxima once
+    int nshell = primary_->nshell();
+    std::vector<double> DtMax(nshell * nshell, 0.0);
+    std::vector<double> DsMax(nshell * nshell, 0.0);
+    for (int P = 0; P < nshell; P++) {
+        int Poff = primary_->shell(P).function_index();
+        int Psize = primary_->shell(P).nfunction();
+        for (int Q = 0; Q < nshell; Q++) {
+            int Qoff = primary_->shell(Q).function_index();
+            int Qsize = primary_->shell(Q).nfunction();
+            double tmax = 0.0;
+            double smax = 0.0;
+            for (int p = Poff; p < Poff + Psize; p++) {
+                for (int q = Qoff; q < Qoff + Qsize; q++) {
+                    tmax = std::max(tmax, std::fabs(Dtp[p][q]));
+                    smax = std::max(smax, std::max(std::fabs(Dap[p][q]), std::fabs(Dbp[p][q])));
+                }
+            }
+            DtMax[P * nshell + Q] = tmax;
+            DsMax[P * nshell + Q] = smax;
+        }
+    }
+    bool do_screen = ints[0]->sieve_initialized() && cutoff_ > 0.0;
+    double cutoff2 = cutoff_ * cutoff_;
+
+    auto quartet_significant = [&](int P, int Q, int R, int S) {
+        // One-center quartets cancel exactly by translational invariance
+        int center = primary_->shell(P).ncenter();
+        if (primary_->shell(Q).ncenter() == center && primary_->shell(R).ncenter() == center &&
+            primary_->shell(S).ncenter() == center)
+            return false;
+        if (!do_screen) return true;
+        double DJ = DtMax[P * nshell + Q] * DtMax[R * nshell + S];
+        double DK = DsMax[P * nshell + R] * DsMax[Q * nshell + S] + DsMax[P * nshell + S] * DsMax[Q * nshell + R];
+        double Dmax = std::max(DJ, DK);
+        return ints[0]->shell_ceiling2(P, Q, R, S) * Dmax * Dmax >= cutoff2;
+    };
+
+    std::vector<size_t> computed_shells(nthreads, 0L);
     // shell pair blocks
     auto blocksPQ = ints[0]->get_blocks12();
     auto blocksRS = ints[0]->get_blocks34();
@@ -2673,9 +2716,21 @@ std::map<std::string, std::shared_ptr<Matrix>> DirectJKGrad::compute2(
         for (int blockRS_idx = loop_start; blockRS_idx < blocksRS.size(); ++blockRS_idx) {
             const auto& blockRS = blocksRS[blockRS_idx];
 
-            // This is where we want to screen with density and schwarz-like screening
+            bool block_significant = false;
+            for (const auto& pairPQ : blockPQ) {
+                for (const auto& pairRS : blockRS) {
+                    const auto& P = pairPQ.first;
+                    const auto& R = pairRS.first;
+                    if (use_batching && ((P > R) || (P == R && pairPQ.second > pairRS.second))) continue;
+                    if (quartet_significant(P, pairPQ.second, R, pairRS.second)) {
+                        block_significant = true;
+                        break;
+                    }
+                }
+                if (block_significant) break;
+            }
+            if (!block_significant) continue;
 
-            // compute the integrals and continue if none were computed
             ints[rank]->compute_shell_blocks_deriv2(blockPQ_idx, blockRS_idx);
 
             std::array<const double*, 78> bufptrs;
@@ -2715,6 +2770,12 @@ std::map<std::string, std::shared_ptr<Matrix>> DirectJKGrad::compute2(
                         for (int buf = 0; buf < 78; ++buf) bufptrs[buf] += block_size;
                         continue;
                     }
+                    if (!quartet_significant(P, Q, R, S)) {
+                        for (auto& buf : bufptrs) buf += block_size;
+                        continue;
+                    }
+                    computed_shells[rank]++;
+
                     double PQscale = Pcenter == Qcenter ? 2.0 : 1.0;
                     double PRscale = Pcenter == Rcenter ? 2.0 : 1.0;
                     double PSscale = Pcenter == Scenter ? 2.0 : 1.0;
@@ -2974,6 +3035,11 @@ std::map<std::string, std::shared_ptr<Matrix>> DirectJKGrad::compute2(
             Kp[row][col] = Kp[col][row] = (Kp[row][col] + Kp[col][row]);
         }
     }
+    if (bench_) {
+        size_t computed = 0L;
+        for (size_t count : computed_shells) computed += count;
+        outfile->Printf("  DirectJKGrad: computed %zu second derivative shell quartets\n\n", computed);
+    }
     Jhess[0]->print();
     Khess[0]->print();
 
@@ -176,11 +176,30 @@ int read_options(const std::string &name, Options &options, bool suppress_printi
     MOLDEN output file, the Hessian file, the internal coordinate file,
     etc. Use the add_str_i function to make this string case sensitive. -*/
     options.add_str_i("WRITER_FILE_LABEL", "");
+    /*- Directory of a persistent cache of density-fitting metrics and
+    three-index integrals, shared between calculations on the same basis
+    sets and geometry. Entries are keyed on everything they depend on, so
+    the directory may be shared by concurrent jobs. Empty disables caching. -*/
+    options.add_str_i("DF_CACHE_DIR", "");
+    /*- Do place in-core density-fitted AO integrals in POSIX shared memory,
+    so that concurrent |PSIfour| processes on one node that need the same
+    integrals attach to a single read-only copy instead of each building
+    their own? -*/
+    options.add_bool("DF_SHARED_MEMORY", false);
     /*- The density fitting basis to use in coupled cluster computations. -*/
     options.add_str("DF_BASIS_CC", "");
     /*- Assume external fields are arranged so that they have symmetry. It is up to the user to know what to do here.
        The code does NOT help you out in any way! !expert -*/
     options.add_bool("EXTERNAL_POTENTIAL_SYMMETRY", false);
+    /*- Order of the multipole expansion of shell-pair distributions used for distant external point charges.
+    Charges farther from a block of shell pairs than its radius divided by |globals__extern_multipole_theta|
+    enter the potential and its gradient through this expansion, and clusters of such charges through their own
+    multipoles. 0 integrates every charge exactly. !expert -*/
+    options.add_int("EXTERN_MULTIPOLE_ORDER", 0);
+    /*- Opening criterion for the far-field treatment of external point charges: the ratio of the extent of a
+    block of shell pairs (plus that of a charge cluster) to its distance from the charges. Smaller values are
+    more accurate. !expert -*/
+    options.add_double("EXTERN_MULTIPOLE_THETA", 0.3);
     /*- Text to be passed directly into CFOUR input files. May contain
     molecule, options, percent blocks, etc. Access through ``cfour {...}``
     block. -*/
@@ -269,6 +288,9 @@ int read_options(const std::string &name, Options &options, bool suppress_printi
     options.add_double("CUBIC_BASIS_TOLERANCE", 1.0E-12);
     /*- CubicScalarGrid maximum number of grid points per evaluation block. !expert -*/
     options.add_int("CUBIC_BLOCK_MAX_POINTS", 1000);
+    /*- Evaluate the ESP of atoms whose auxiliary shells do not reach a block of grid points from
+        their multipoles. Turning this off integrates every shell at every point. !expert -*/
+    options.add_bool("CUBIC_ESP_FAR_FIELD", true);
     /*- CubicScalarGrid spatial extent in bohr [O_X, O_Y, O_Z]. Defaults to 4.0 bohr each. -*/
     options.add("CUBIC_GRID_OVERAGE", new ArrayType());
     /*- CubicScalarGrid grid spacing in bohr [D_X, D_Y, D_Z]. Defaults to 0.2 bohr each. -*/
@@ -310,6 +332,13 @@ int read_options(const std::string &name, Options &options, bool suppress_printi
                     "ROBUST TREUTLER NONE FLAT P_GAUSSIAN D_GAUSSIAN P_SLATER D_SLATER LOG_GAUSSIAN LOG_SLATER NONE");
     /*- Maximum Radial Moment to Calculate -*/
     options.add_int("MAX_RADIAL_MOMENT", 4);
+    /*- Screening threshold for the electronic part of ESPs evaluated on grid points (GRID_ESP and
+    ESPPropCalc). Density-contracted basis function products whose potential is estimated below this
+    value for a block of points are skipped. !expert -*/
+    options.add_double("GRID_ESP_TOLERANCE", 1.0e-12);
+    /*- Maximum number of grid points grouped into one spatial block for GRID_ESP and ESPPropCalc
+    evaluations. !expert -*/
+    options.add_int("GRID_ESP_BLOCK_MAX_POINTS", 128);
 
     /*- PCM boolean for pcmsolver module -*/
     options.add_bool("PCM", false);
@@ -1263,6 +1292,9 @@ int read_options(const std::string &name, Options &options, bool suppress_printi
         options.add_double("CUBIC_BASIS_TOLERANCE", 1.0E-12);
         /*- CubicScalarGrid maximum number of grid points per evaluation block. !expert -*/
         options.add_int("CUBIC_BLOCK_MAX_POINTS", 1000);
+        /*- Evaluate the ESP of atoms whose auxiliary shells do not reach a block of grid points from
+            their multipoles. Turning this off integrates every shell at every point. !expert -*/
+        options.add_bool("CUBIC_ESP_FAR_FIELD", true);
 
         // => Scalar Field Plotting Options <= //
 
@@ -1627,6 +1659,17 @@ int read_options(const std::string &name, Options &options, bool suppress_printi
         options.add_int("INCFOCK_FULL_FOCK_EVERY", 5);
         /*- The density threshold at which to stop building the Fock matrix incrementally -*/
         options.add_double("INCFOCK_CONVERGENCE", 1.0e-5);
+        /*- Maximum number of shell quartets of one angular momentum class that |globals__scf_type| DIRECT
+        computes as a batch before digesting them into J and K. !expert -*/
+        options.add_int("DIRECTJK_BATCH_QUARTETS", 64);
+        /*- Do build J and K in single precision until the orbital gradient drops below
+        |scf__mixed_precision_convergence|? At least one final iteration is always done in double
+        precision, so converged energies are unaffected. Only the in-core MEM_DF algorithm
+        supports this; other |globals__scf_type| values ignore it. -*/
+        options.add_bool("MIXED_PRECISION", false);
+        /*- The orbital gradient (DIIS error) threshold at which |scf__mixed_precision| J/K builds
+        switch to double precision -*/
+        options.add_double("MIXED_PRECISION_CONVERGENCE", 1.0e-4);
 
         /*- The screening tolerance used for ERI/Density sparsity in the LinK algorithm -*/
         options.add_double("LINK_INTS_TOLERANCE", 1.0e-12);
@@ -1880,6 +1923,46 @@ int read_options(const std::string &name, Options &options, bool suppress_printi
         options.add_bool("DFT_REMOVE_DISTANT_POINTS",true);
         /*- The blocking scheme for DFT. !expert -*/
         options.add_str("DFT_BLOCK_SCHEME", "OCTREE", "NAIVE OCTREE ATOMIC");
+        /*- Number of built DFT grids kept in memory. A grid requested again for the same geometry,
+            basis and grid options, e.g. the VV10 grid in every SCF iteration or the grids of
+            repeated computations on one geometry, is then shared instead of rebuilt. Any change of
+            geometry, as between optimization or trajectory steps, builds and blocks a new grid; only
+            the atomic grid templates of each element carry over. The least recently used grids are
+            dropped beyond this number or beyond a tenth of the memory setting, and psi4.core.clean()
+            drops them all. 0 disables the cache. !expert -*/
+        options.add_int("DFT_GRID_CACHE_SIZE", 4);
+        /*- Maximum memory [MiB] for the thread-private buffers that DFT V and Vx builds accumulate
+            into before a parallel reduction. If buffers for fewer than all threads fit, threads share
+            them; if fewer than two fit, threads add directly to the result with atomics. The default
+            of -1 takes a tenth of the memory budget, part of what SCF_MEM_SAFETY_FACTOR keeps out of
+            JK and the collocation cache. !expert -*/
+        options.add_int("DFT_V_BUFFER_MEMORY", -1);
+        /*- Maximum memory [MiB] for the per-thread intermediates of response (TDDFT, CPKS) Vx builds,
+            which contract as many trial densities together per grid block as fit. !expert -*/
+        options.add_int("DFT_VX_BATCH_MEMORY", 256);
+        /*- Store the cached DFT collocation (basis function values on the grid) in single precision,
+            which halves its memory so more blocks are cached, at the cost of roughly 1.0E-7 relative
+            error in the collocation. !expert -*/
+        options.add_bool("DFT_COLLOCATION_FP32", false);
+        /*- Basis functions smaller than this at every point of a grid block, including their
+            derivatives, are dropped from the cached DFT collocation of that block. !expert -*/
+        options.add_double("DFT_COLLOCATION_TOLERANCE", 1.0E-14);
+        /*- In DFT potential builds, leave a basis function out of a grid block's density when its
+            largest collocation over the block (derivatives included) times its density magnitude,
+            sum_n |D_mn| max|phi_n|, falls below this, and out of the block's potential matrix when
+            its largest collocation times the block's largest collocation and integrated potential
+            kernel falls below this. The surviving functions are packed so the block's dense
+            contractions shrink. Per-block sparsity is printed with PRINT > 1.
+            0.0 disables the screening. !expert -*/
+        options.add_double("DFT_FUNCTION_SCREENING", 0.0);
+        /*- Keep the DFT collocation cache after the SCF has converged, so that response (TDDFT,
+            CPKS) and XC gradient computations on the same wavefunction reuse it. The gradient and
+            TDSCF drivers set this for their reference SCF and release the cache when done;
+            otherwise the cache is freed once the SCF finishes. !expert -*/
+        options.add_bool("DFT_COLLOCATION_REUSE", false);
+        /*- Cache the DFT collocation with the additional derivative needed by the XC gradient.
+            Set by the gradient driver. !expert -*/
+        options.add_bool("DFT_COLLOCATION_GRADIENT", false);
         /*- Parameters defining the dispersion correction. See Table
         :ref:`-D Functionals <table:dft_disp>` for default values and Table
         :ref:`Dispersion Corrections <table:dashd>` for the order in which
@@ -1895,6 +1978,9 @@ int read_options(const std::string &name, Options &options, bool suppress_printi
         options.add_int("DFT_VV10_RADIAL_POINTS", 50);
         /*- Rho cutoff for VV10 NL integration. !expert -*/
         options.add_double("DFT_VV10_RHO_CUTOFF", 1.e-8);
+        /*- Skip VV10 NL kernel contributions between grid blocks whose energy is rigorously bounded
+            by this value. A value of 0.0 evaluates all block pairs. !expert -*/
+        options.add_double("DFT_VV10_SCREENING", 1.e-12);
         /*- Define VV10 parameter b -*/
         options.add_double("DFT_VV10_B", 0.0);
         /*- Define VV10 parameter C -*/
@@ -3158,6 +3244,12 @@ int read_options(const std::string &name, Options &options, bool suppress_printi
         options.add_int("CC_DIIS_MIN_VECS", 2);
         /*- Maximum number of vectors used in amplitude DIIS -*/
         options.add_int("CC_DIIS_MAX_VECS", 6);
+        /*- Where the amplitude and orbital DIIS subspaces are kept. DISK streams the stored vectors back from
+            PSIF_LIBDIIS in blocks, reading ahead asynchronously. !expert -*/
+        options.add_str("CC_DIIS_STORAGE", "DISK", "DISK CORE");
+        /*- Do keep the DIIS subspace vectors in single precision? Halves their memory or disk footprint; the
+            extrapolation itself is still done in double precision. !expert -*/
+        options.add_bool("CC_DIIS_FP32", false);
         /*- Cutoff value for DF integrals -*/
         options.add_int("INTEGRAL_CUTOFF", 9);
         /*- Cutoff value for numerical procedures -*/
@@ -37,6 +37,25 @@ def set_up():
     psi4.set_output_file("pytest_output.dat", True)
 
 
+@pytest.fixture(scope="function")
+def water_dimer():
+    """Unsymmetric water dimer in a fixed frame, for the screening and batching tests"""
+    import psi4
+
+    return psi4.geometry("""
+    0 1
+    O  -1.551007  -0.114520   0.000000
+    H  -1.934259   0.762503   0.000000
+    H  -0.599677   0.040712   0.000000
+    O   1.350625   0.111469   0.000000
+    H   1.680398  -0.373741  -0.758561
+    H   1.680398  -0.373741   0.758561
+    symmetry c1
+    no_reorient
+    no_com
+    """)
+
+
 def tear_down():
     import os
     import glob
@@ -0,0 +1,38 @@
+"""
+Tests that blocked, screened ESP cube evaluation matches the exact ESP and does not depend on the blocking or
+thread count
+"""
+
+import pytest
+import psi4
+from utils import compare_cubes
+
+pytestmark = [pytest.mark.psi, pytest.mark.api, pytest.mark.quick]
+
+
+def test_cubeprop_esp_blocks(water_dimer, tmp_path):
+    """The far-field ESP on small blocks and several threads reproduces the exact ESP, and LOL cubes agree"""
+
+    psi4.set_options({"basis": "cc-pvdz", "scf_type": "df", "cubeprop_tasks": ["esp", "lol"],
+                      "cubic_grid_spacing": [0.4, 0.4, 0.4], "cubic_grid_overage": [6.0, 6.0, 6.0]})
+    _, wfn = psi4.energy("scf", return_wfn=True)
+
+    # Exact reference: every auxiliary shell integrated at every point
+    exact = tmp_path / "exact"
+    exact.mkdir()
+    psi4.set_options({"cubeprop_filepath": str(exact), "cubic_esp_far_field": False,
+                      "cubic_block_max_points": 1000})
+    psi4.set_num_threads(1)
+    psi4.cubeprop(wfn)
+
+    # Small blocks move most atoms of most blocks into the far field
+    blocked = tmp_path / "blocked"
+    blocked.mkdir()
+    psi4.set_options({"cubeprop_filepath": str(blocked), "cubic_esp_far_field": True,
+                      "cubic_block_max_points": 27})
+    psi4.set_num_threads(4)
+    psi4.cubeprop(wfn)
+    psi4.set_num_threads(1)
+
+    assert compare_cubes(str(exact / "ESP.cube"), str(blocked / "ESP.cube"), "ESP cube, far field vs exact")
+    assert compare_cubes(str(exact / "LOLa.cube"), str(blocked / "LOLa.cube"), "LOL cube, blocking and threads")
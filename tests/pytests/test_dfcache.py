@@ -0,0 +1,110 @@
+"""
+Tests for reusing density-fitting integrals across calculations (DF_CACHE_DIR, DF_SHARED_MEMORY)
+"""
+
+import json
+import os
+import subprocess
+import sys
+import textwrap
+
+import numpy as np
+import pytest
+import psi4
+from utils import *
+
+pytestmark = [pytest.mark.psi, pytest.mark.api, pytest.mark.quick]
+
+
+def test_dfcache_mem_df(tmp_path):
+    """A second MemDF SCF loads the metric and three-index integrals from the cache and reproduces the energy"""
+
+    psi4.geometry("""
+    O
+    H 1 1.00
+    H 1 1.00 2 103.1
+    """)
+    psi4.set_options({"basis": "cc-pvdz", "scf_type": "mem_df"})
+
+    e_ref = psi4.energy("scf")
+
+    psi4.set_options({"df_cache_dir": str(tmp_path)})
+    e_store = psi4.energy("scf")
+    entries = sorted(p.name for p in tmp_path.iterdir())
+    assert entries and all(name.endswith(".dfc") for name in entries)
+
+    hits = psi4.core.DFCache.hits()
+    e_load = psi4.energy("scf")
+    assert sorted(p.name for p in tmp_path.iterdir()) == entries
+    # Every entry the first run stored, the metric and the AO integrals, is loaded back
+    assert psi4.core.DFCache.hits() - hits >= len(entries)
+
+    assert compare_values(e_ref, e_store, 10, "MemDF SCF energy, storing to the DF cache")
+    assert compare_values(e_ref, e_load, 10, "MemDF SCF energy, loading from the DF cache")
+
+
+def test_df_shared_memory():
+    """MemDF SCF with its AO integrals in a shared-memory segment reproduces the private-memory energy"""
+
+    psi4.geometry("""
+    O
+    H 1 1.00
+    H 1 1.00 2 103.1
+    """)
+    psi4.set_options({"basis": "cc-pvdz", "scf_type": "mem_df"})
+
+    e_private = psi4.energy("scf")
+    psi4.set_options({"df_shared_memory": True})
+    e_shared = psi4.energy("scf")
+
+    assert compare_values(e_private, e_shared, 10, "MemDF SCF energy, shared-memory AO integrals")
+
+
+# Builds the AO integrals of water/cc-pVDZ with DF_SHARED_MEMORY and transforms them to (Q|ij) over the first
+# five functions, so that a second process can show it read the integrals the first one published
+_shared_dfh_script = textwrap.dedent("""
+    import json
+    import numpy as np
+    import psi4
+
+    mol = psi4.geometry('''
+    O
+    H 1 1.00
+    H 1 1.00 2 103.1
+    ''')
+    psi4.set_options({"basis": "cc-pvdz"})
+    wfn = psi4.core.Wavefunction.build(mol, psi4.core.get_global_option("BASIS"))
+    aux = psi4.core.BasisSet.build(mol, "DF_BASIS_SCF", "", "JKFIT", "cc-pvdz")
+
+    dfh = psi4.core.DFHelper(wfn.basisset(), aux)
+    dfh.set_memory(50000000)
+    dfh.set_shared_memory(True)
+    dfh.initialize()
+    dfh.add_space("c", psi4.core.Matrix.from_array(np.eye(wfn.nso())[:, :5]))
+    dfh.add_transformation("Qcc", "c", "c")
+    dfh.transform()
+    Qcc = dfh.get_tensor("Qcc").np
+""")
+
+
+@pytest.mark.skipif(not sys.platform.startswith("linux"), reason="needs POSIX shared memory with flock")
+def test_df_shared_memory_second_process():
+    """A second process attaches to the AO integrals the first one holds in shared memory, and reads them"""
+
+    scope = {}
+    exec(_shared_dfh_script, scope)
+    dfh, Qcc = scope["dfh"], scope["Qcc"]
+    assert not dfh.shared_memory_attached()
+
+    child = "import psi4\npsi4.core.be_quiet()\n" + _shared_dfh_script + textwrap.dedent("""
+        print(json.dumps({"attached": dfh.shared_memory_attached(), "Qcc": Qcc.ravel().tolist()}))
+    """)
+    psi4_path = os.path.dirname(os.path.dirname(psi4.__file__))
+    env = dict(os.environ, PYTHONPATH=os.pathsep.join([psi4_path] + sys.path))
+    result = subprocess.run([sys.executable, "-c", child], env=env, capture_output=True, text=True, check=True)
+    report = json.loads(result.stdout.strip().splitlines()[-1])
+
+    # The parent still holds the segment, so the child must have attached rather than computed
+    assert report["attached"]
+    assert compare_arrays(Qcc, np.array(report["Qcc"]).reshape(Qcc.shape), 12,
+                          "(Q|ij) from integrals attached in a second process")
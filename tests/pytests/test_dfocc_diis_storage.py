@@ -0,0 +1,42 @@
+"""
+Tests the DIISManager storage variants through the DF-CCSD amplitude and orbital DIIS in dfocc
+"""
+
+import pytest
+import psi4
+from utils import *
+
+pytestmark = [pytest.mark.psi, pytest.mark.api, pytest.mark.dfocc]
+
+
+@pytest.mark.parametrize("reference, method", [("rhf", "ccsd"), ("uhf", "ccsd"), ("rhf", "omp2")])
+def test_dfocc_diis_storage(reference, method):
+    """Energies agree between in-core and on-disk subspaces, and with single-precision storage"""
+
+    # Ethane/cc-pVDZ has more T2 amplitudes than DIISManager reads back at a time, so the on-disk
+    # subspace is streamed in several blocks with read-ahead
+    psi4.geometry("""
+    0 1
+    C   0.000000   0.000000   0.765000
+    C   0.000000   0.000000  -0.765000
+    H   1.017000   0.000000   1.164000
+    H  -0.508500   0.880750   1.164000
+    H  -0.508500  -0.880750   1.164000
+    H  -1.017000   0.000000  -1.164000
+    H   0.508500   0.880750  -1.164000
+    H   0.508500  -0.880750  -1.164000
+    symmetry c1
+    """)
+    psi4.set_options({"basis": "cc-pvdz", "df_basis_scf": "cc-pvdz-jkfit", "df_basis_cc": "cc-pvdz-ri",
+                      "scf_type": "df", "cc_type": "df", "mp2_type": "df", "qc_module": "occ",
+                      "reference": reference, "e_convergence": 10, "r_convergence": 9, "cc_diis_max_vecs": 4})
+
+    energies = {}
+    for storage, fp32 in [("core", False), ("disk", False), ("disk", True), ("core", True)]:
+        psi4.set_options({"cc_diis_storage": storage, "cc_diis_fp32": fp32})
+        energies[storage, fp32] = psi4.energy(method)
+
+    reference_energy = energies["core", False]
+    assert compare_values(reference_energy, energies["disk", False], 10, f"{reference.upper()} {method}, on-disk DIIS")
+    assert compare_values(reference_energy, energies["disk", True], 8, f"{reference.upper()} {method}, on-disk FP32 DIIS")
+    assert compare_values(reference_energy, energies["core", True], 8, f"{reference.upper()} {method}, in-core FP32 DIIS")
@@ -0,0 +1,55 @@
+"""
+Tests for the DFT collocation cache: screening, FP32 storage and reuse after the SCF
+"""
+
+import pytest
+import psi4
+from utils import *
+
+pytestmark = [pytest.mark.psi, pytest.mark.api, pytest.mark.quick]
+
+
+@pytest.fixture
+def water():
+    psi4.geometry("""
+    0 1
+    O
+    H 1 0.96
+    H 1 0.96 2 104.5
+    symmetry c1
+    """)
+    psi4.set_options({"basis": "cc-pvdz", "scf_type": "df", "d_convergence": 1.e-8})
+
+
+@pytest.mark.parametrize("reference", ["rks", "uks"])
+def test_collocation_cache_fp32(water, reference):
+    """DFT energies agree between FP64 and FP32 collocation caches"""
+
+    psi4.set_options({"reference": reference, "dft_collocation_reuse": True})
+    e_fp64, wfn = psi4.energy("b3lyp", return_wfn=True)
+    cache = wfn.V_potential().collocation_cache()
+    assert cache.ncached() > 0
+    assert cache.hits() > cache.ncached()
+    assert not cache.fp32()
+
+    psi4.set_options({"dft_collocation_fp32": True})
+    e_fp32, wfn = psi4.energy("b3lyp", return_wfn=True)
+    assert wfn.V_potential().collocation_cache().fp32()
+
+    assert compare_values(e_fp64, e_fp32, 6, f"{reference.upper()} energy, FP32 collocation cache")
+
+
+def test_collocation_cache_gradient(water):
+    """XC gradients agree whether or not they reuse the SCF collocation cache, which is released afterwards"""
+
+    g_reuse, wfn = psi4.gradient("pbe", return_wfn=True)
+    assert wfn.V_potential().collocation_cache().ncached() == 0
+    hits_reuse = wfn.V_potential().collocation_cache().hits()
+
+    e, wfn = psi4.energy("pbe", return_wfn=True)
+    assert wfn.V_potential().collocation_cache().ncached() == 0
+    # The gradient integration is served from the cache on top of the SCF iterations
+    assert hits_reuse > wfn.V_potential().collocation_cache().hits() > 0
+    g_fresh = psi4.gradient("pbe", ref_wfn=wfn)
+
+    assert compare_values(g_fresh, g_reuse, 8, "PBE gradient, reused collocation cache")
@@ -0,0 +1,61 @@
+"""
+Tests that screening basis functions per grid block in DFT potential builds does not change the energy
+"""
+
+import pytest
+import psi4
+from utils import *
+
+pytestmark = [pytest.mark.psi, pytest.mark.api, pytest.mark.quick]
+
+
+@pytest.mark.parametrize("reference, functional", [("rks", "svwn"), ("rks", "b3lyp"), ("rks", "tpss"),
+                                                   ("uks", "b3lyp")])
+def test_dft_function_screening(reference, functional, water_dimer):
+    """Energies with diffuse functions agree with and without DFT_FUNCTION_SCREENING, which drops functions"""
+
+    psi4.set_options({"basis": "aug-cc-pvdz", "scf_type": "df", "reference": reference, "e_convergence": 10,
+                      "d_convergence": 8})
+
+    e_dense, wfn = psi4.energy(functional, return_wfn=True)
+    stats = wfn.V_potential().function_screening_statistics()
+    assert stats["blocks"] > 0
+    assert stats["density functions"] == stats["local functions"]
+    assert stats["kept functions"] == stats["local functions"]
+    assert stats["screened blocks"] == 0
+
+    psi4.set_options({"dft_function_screening": 1.e-12})
+    e_screened, wfn = psi4.energy(functional, return_wfn=True)
+    stats = wfn.V_potential().function_screening_statistics()
+    assert 0 < stats["density functions"] < stats["local functions"]
+    assert 0 < stats["kept functions"] <= stats["local functions"]
+    assert stats["screened blocks"] > 0
+
+    assert compare_values(e_dense, e_screened, 8, f"{reference.upper()} {functional} energy, function screening")
+
+
+@pytest.mark.parametrize("reference", ["rks", "uks"])
+def test_dft_function_screening_loose(reference, water_dimer):
+    """A loose threshold only drops functions with small density weight from the density, never from the
+    Kohn-Sham matrix, so the converged energy with diffuse functions stays close to the unscreened one"""
+
+    psi4.set_options({"basis": "aug-cc-pvdz", "scf_type": "df", "reference": reference, "e_convergence": 10,
+                      "d_convergence": 8})
+
+    e_dense = psi4.energy("b3lyp")
+    psi4.set_options({"dft_function_screening": 1.e-8})
+    e_screened, wfn = psi4.energy("b3lyp", return_wfn=True)
+    stats = wfn.V_potential().function_screening_statistics()
+
+    assert stats["density functions"] < stats["local functions"]
+    assert compare_values(e_dense, e_screened, 6, f"{reference.upper()} B3LYP energy, loose function screening")
+
+
+def test_dft_function_screening_print(water_dimer):
+    """PRINT 2 reports the block sparsity of a screened V build"""
+
+    psi4.set_options({"basis": "aug-cc-pvdz", "scf_type": "df", "print": 2, "dft_function_screening": 1.e-12})
+    psi4.energy("svwn")
+
+    with open("pytest_output.dat") as fp:
+        assert "function screening" in fp.read().lower()
@@ -0,0 +1,61 @@
+"""
+Tests for parallel DFT grid construction and the geometry-keyed grid cache
+"""
+
+import pytest
+import psi4
+from utils import *
+
+pytestmark = [pytest.mark.psi, pytest.mark.api, pytest.mark.quick]
+
+
+def water():
+    return psi4.geometry("""
+    0 1
+    O
+    H 1 0.96
+    H 1 0.96 2 104.5
+    symmetry c1
+    """)
+
+
+@pytest.mark.parametrize("scheme", ["octree", "naive", "atomic"])
+def test_dft_grid_threads(scheme):
+    """Grids built on one and several threads are identical"""
+
+    mol = water()
+    psi4.set_options({"basis": "cc-pvdz", "dft_block_scheme": scheme, "dft_grid_cache_size": 0})
+    basis = psi4.core.BasisSet.build(mol, "ORBITAL", "cc-pvdz")
+
+    grids = {}
+    for nthread in [1, 4]:
+        psi4.set_num_threads(nthread)
+        grids[nthread] = psi4.core.DFTGrid.build(mol, basis)
+    psi4.set_num_threads(1)
+
+    assert compare(grids[1].npoints(), grids[4].npoints(), f"{scheme} grid points, 1 vs 4 threads")
+    assert compare(len(grids[1].blocks()), len(grids[4].blocks()), f"{scheme} grid blocks, 1 vs 4 threads")
+    for b1, b4 in zip(grids[1].blocks(), grids[4].blocks()):
+        assert b1.npoints() == b4.npoints()
+        assert b1.functions_local_to_global() == b4.functions_local_to_global()
+
+
+def test_dft_grid_cache():
+    """Cached grids are shared for identical geometries and reproduce uncached energies"""
+
+    mol = water()
+    psi4.set_options({"basis": "cc-pvdz", "scf_type": "df", "d_convergence": 1.e-8})
+    basis = psi4.core.BasisSet.build(mol, "ORBITAL", "cc-pvdz")
+    psi4.core.MolecularGrid.clear_cache()
+
+    grid1 = psi4.core.DFTGrid.build(mol, basis)
+    grid2 = psi4.core.DFTGrid.build(mol, basis)
+    assert compare(grid1.npoints(), grid2.npoints(), "Cached grid points")
+    assert grid1.blocks()[0].x().np[0] == grid2.blocks()[0].x().np[0]
+
+    e_cached = psi4.energy("b97m-v")
+    psi4.core.MolecularGrid.clear_cache()
+    psi4.set_options({"dft_grid_cache_size": 0})
+    e_uncached = psi4.energy("b97m-v")
+
+    assert compare_values(e_uncached, e_cached, 10, "B97M-V energy, grid cache")
@@ -0,0 +1,33 @@
+"""
+Tests that thread-private V accumulation matches the atomic fallback
+"""
+
+import pytest
+import psi4
+from utils import *
+
+pytestmark = [pytest.mark.psi, pytest.mark.api, pytest.mark.quick]
+
+
+@pytest.mark.parametrize("reference", ["rks", "uks"])
+def test_dft_v_buffers(reference):
+    """DFT energies agree between thread-private buffers and atomics"""
+
+    psi4.geometry("""
+    0 1
+    O
+    H 1 0.96
+    H 1 0.96 2 104.5
+    symmetry c1
+    """)
+    psi4.set_options({"basis": "cc-pvdz", "scf_type": "df", "reference": reference, "d_convergence": 1.e-8})
+    psi4.set_num_threads(4)
+
+    energies = {}
+    for memory in [-1, 1024, 0]:
+        psi4.set_options({"dft_v_buffer_memory": memory})
+        energies[memory] = psi4.energy("b3lyp")
+    psi4.set_num_threads(1)
+
+    assert compare_values(energies[0], energies[1024], 10, f"{reference.upper()} energy, thread-private V buffers")
+    assert compare_values(energies[0], energies[-1], 10, f"{reference.upper()} energy, V buffers from memory budget")
@@ -0,0 +1,35 @@
+"""
+Tests that batching trial densities in response Vx builds does not change the result
+"""
+
+import pytest
+import psi4
+from psi4.driver.procrouting.response.scf_response import tdscf_excitations
+from utils import *
+
+pytestmark = [pytest.mark.psi, pytest.mark.api, pytest.mark.quick]
+
+
+@pytest.mark.parametrize("reference, functional", [("rks", "svwn"), ("rks", "pbe0"), ("uks", "svwn"), ("uks", "pbe0")])
+def test_dft_vx_batch(reference, functional):
+    """TDDFT excitation energies agree between batched and one-at-a-time Vx builds"""
+
+    psi4.geometry("""
+    0 1
+    O
+    H 1 0.96
+    H 1 0.96 2 104.5
+    symmetry c1
+    """)
+    psi4.set_options({"basis": "cc-pvdz", "scf_type": "pk", "reference": reference, "save_jk": True,
+                      "e_convergence": 10, "d_convergence": 8})
+
+    excitations = {}
+    for memory in [256, 0]:
+        psi4.set_options({"dft_vx_batch_memory": memory})
+        _, wfn = psi4.energy(functional, return_wfn=True)
+        excitations[memory] = tdscf_excitations(wfn, states=6, r_convergence=1.e-6, tda=True)
+
+    for i, (batched, single) in enumerate(zip(excitations[256], excitations[0])):
+        assert compare_values(single["EXCITATION ENERGY"], batched["EXCITATION ENERGY"], 8,
+                              f"{reference.upper()} {functional} root {i + 1}, batched Vx")
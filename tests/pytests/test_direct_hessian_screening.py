@@ -0,0 +1,41 @@
+"""
+Tests that density-screened, threaded direct SCF Hessians match unscreened ones
+"""
+
+import re
+
+import pytest
+import psi4
+from utils import *
+
+pytestmark = [pytest.mark.psi, pytest.mark.api, pytest.mark.d2ints]
+
+
+def computed_hessian_quartets():
+    """Second derivative shell quartets computed by the last direct Hessian, as reported under BENCH"""
+
+    with open("pytest_output.dat") as fp:
+        counts = re.findall(r"DirectJKGrad: computed (\d+) second derivative shell quartets", fp.read())
+    return int(counts[-1])
+
+
+@pytest.mark.parametrize("reference", ["rhf", "uhf"])
+def test_direct_hessian_screening(reference, water_dimer):
+    """Hessians agree between the default and a zero integral tolerance, and between one and several threads"""
+
+    psi4.set_options({"basis": "6-31g*", "scf_type": "direct", "reference": reference, "df_scf_guess": False,
+                      "bench": 1, "e_convergence": 10, "d_convergence": 10})
+
+    psi4.set_options({"ints_tolerance": 0.0})
+    psi4.set_num_threads(1)
+    H_ref = psi4.hessian("scf").np
+    n_ref = computed_hessian_quartets()
+
+    psi4.set_options({"ints_tolerance": 1.e-12})
+    psi4.set_num_threads(4)
+    H_screened = psi4.hessian("scf").np
+    n_screened = computed_hessian_quartets()
+    psi4.set_num_threads(1)
+
+    assert 0 < n_screened < n_ref, f"Density screening computed {n_screened} of {n_ref} quartets"
+    assert compare_arrays(H_ref, H_screened, 7, f"{reference.upper()} direct Hessian, screened and threaded")
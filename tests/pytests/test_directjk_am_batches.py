@@ -0,0 +1,43 @@
+"""
+Tests that angular-momentum-class batching of DirectJK shell quartets does not change the result
+"""
+
+import pytest
+import psi4
+from utils import *
+
+pytestmark = [pytest.mark.psi, pytest.mark.api]
+
+
+@pytest.mark.parametrize("reference, method", [("rhf", "scf"), ("uhf", "scf"), ("rks", "pbe")])
+def test_directjk_am_batches(reference, method, water_dimer):
+    """Energies agree between batch sizes, and every batch size computes the same quartets in each class"""
+
+    psi4.set_options({"basis": "cc-pvdz", "scf_type": "direct", "reference": reference, "df_scf_guess": False,
+                      "screening": "schwarz", "incfock": False, "bench": 1, "e_convergence": 10,
+                      "d_convergence": 8})
+
+    energies = {}
+    stats = {}
+    for batch_quartets, threads in [(1, 1), (64, 1), (7, 4)]:
+        psi4.set_options({"directjk_batch_quartets": batch_quartets})
+        psi4.set_num_threads(threads)
+        energies[batch_quartets], wfn = psi4.energy(method, return_wfn=True)
+
+        # Schwarz screening without incremental builds keeps the same quartets in every build
+        builds = wfn.jk().computed_shells_per_iter("Quartets")
+        stats[batch_quartets] = {
+            label: (entry[0] // len(builds), entry[1] // len(builds))
+            for label, entry in wfn.jk().am_class_statistics().items()
+        }
+        assert compare(sum(builds), len(builds) * sum(s[0] for s in stats[batch_quartets].values()),
+                       f"Quartets over all classes, batches of {batch_quartets}")
+        assert "(DD|DD)" in stats[batch_quartets] and "(SS|SS)" in stats[batch_quartets]
+    psi4.set_num_threads(1)
+
+    # Batching regroups the quartets of a task but must neither drop nor add any
+    assert stats[1] == stats[64], "Quartets and integrals per class, batches of 1 vs 64 quartets"
+    assert stats[1] == stats[7], "Quartets and integrals per class, batches of 1 vs 7 quartets on 4 threads"
+
+    assert compare_values(energies[1], energies[64], 10, "Energy, batches of 1 vs 64 quartets")
+    assert compare_values(energies[1], energies[7], 10, "Energy, batches of 1 vs 7 quartets on 4 threads")
@@ -0,0 +1,39 @@
+"""
+Tests that integral objects reusing a cached, shared ERI sieve reproduce a freshly built one
+"""
+
+import pytest
+import psi4
+from utils import *
+
+pytestmark = [pytest.mark.psi, pytest.mark.api, pytest.mark.quick]
+
+
+@pytest.mark.parametrize("screening, method", [("schwarz", "scf"), ("csam", "scf"), ("density", "scf"),
+                                               ("schwarz", "wb97x")])
+def test_eri_sieve_sharing(screening, method, water_dimer):
+    """Gradients agree between fresh sieves and a cached sieve shared by threaded clones"""
+
+    psi4.set_options({"basis": "cc-pvdz", "scf_type": "direct", "screening": screening, "df_scf_guess": False,
+                      "e_convergence": 10, "d_convergence": 8})
+
+    psi4.core.clean()
+    psi4.set_num_threads(1)
+    g_fresh = psi4.gradient(method)
+
+    psi4.core.clean()
+    assert psi4.core.TwoBodyAOInt.sieve_cache_size() == 0
+    assert psi4.core.TwoBodyAOInt.sieve_cache_hits() == 0
+
+    _, wfn = psi4.energy(method, return_wfn=True)
+    nsieves = psi4.core.TwoBodyAOInt.sieve_cache_size()
+    nhits = psi4.core.TwoBodyAOInt.sieve_cache_hits()
+    assert nsieves > 0
+
+    # The gradient reuses the wavefunction's basis sets, so its integral objects take the sieve from the cache
+    psi4.set_num_threads(4)
+    g_cached = psi4.gradient(method, ref_wfn=wfn)
+    psi4.set_num_threads(1)
+    assert psi4.core.TwoBodyAOInt.sieve_cache_hits() > nhits
+
+    assert compare_matrices(g_fresh, g_cached, 8, f"{screening} {method} gradient, cached sieve shared by 4 threads")
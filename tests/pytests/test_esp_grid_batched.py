@@ -0,0 +1,52 @@
+"""
+Tests the batched, screened ESP evaluation on user grids against per-point potential integrals
+"""
+
+import numpy as np
+import pytest
+import psi4
+from utils import *
+
+pytestmark = [pytest.mark.psi, pytest.mark.api, pytest.mark.quick]
+
+
+@pytest.mark.parametrize("reference", ["rhf", "uhf"])
+def test_esp_grid_batched(reference):
+    """ESPs from OEProp match the contraction of per-point potential integrals, for any blocking and thread count"""
+
+    mol = psi4.geometry("""
+    0 1
+    O  -2.930978  -0.216409   0.000000
+    H  -3.655253   1.440954   0.000000
+    H  -1.133255   0.076932   0.000000
+    O   2.552325   0.210644   0.000000
+    H   3.175492  -0.706271  -1.433464
+    H   3.175492  -0.706271   1.433464
+    units bohr
+    symmetry c1
+    no_reorient
+    no_com
+    """)
+    psi4.set_options({"basis": "cc-pvdz", "scf_type": "pk", "reference": reference, "d_convergence": 1.e-8})
+    _, wfn = psi4.energy("scf", return_wfn=True)
+
+    rng = np.random.default_rng(7)
+    points = np.vstack([rng.uniform(-5.0, 5.0, (60, 3)), rng.uniform(-40.0, 40.0, (20, 3)), mol.geometry().np[:2] + 0.1])
+
+    mints = psi4.core.MintsHelper(wfn.basisset())
+    D = wfn.Da().np + wfn.Db().np
+    Z = [mol.Z(A) for A in range(mol.natom())]
+    ref = []
+    for point in points:
+        V = -np.vdot(D, mints.ao_multipole_potential(0, point.tolist())[0].np)
+        V += sum(Z[A] / np.linalg.norm(point - np.array([mol.x(A), mol.y(A), mol.z(A)])) for A in range(mol.natom()))
+        ref.append(V)
+
+    grid = psi4.core.Matrix.from_array(points)
+    oe = psi4.core.OEProp(wfn)
+    for block_points, threads in [(128, 1), (3, 4)]:
+        psi4.set_options({"grid_esp_block_max_points": block_points})
+        psi4.set_num_threads(threads)
+        esp = oe.compute_esp_over_grid_in_memory(grid).np
+        assert compare_arrays(np.array(ref), esp, 8, f"{reference.upper()} ESP, {block_points} points per block, {threads} threads")
+    psi4.set_num_threads(1)
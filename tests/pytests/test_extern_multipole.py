@@ -0,0 +1,50 @@
+"""
+Tests the far-field multipole treatment of external point charges against exact potential integrals
+"""
+
+import numpy as np
+import pytest
+import psi4
+from utils import *
+
+pytestmark = [pytest.mark.psi, pytest.mark.api]
+
+
+def test_extern_multipole(water_dimer):
+    """Energies, atomic gradients and gradients on the charges agree with the exact treatment of every charge"""
+
+    psi4.set_options({"basis": "cc-pvdz", "scf_type": "pk", "d_convergence": 1.e-10})
+
+    # Charges in a shell around the dimer, the nearest of which are integrated exactly
+    rng = np.random.default_rng(11)
+    directions = rng.normal(size=(800, 3))
+    directions /= np.linalg.norm(directions, axis=1)[:, None]
+    positions = directions * rng.uniform(6.0, 40.0, (800, 1))
+    charges = rng.uniform(-0.8, 0.8, 800)
+    external_potentials = [[q, pos] for q, pos in zip(charges, positions)]
+
+    results = {}
+    stats = {}
+    for order, threads in [(0, 1), (8, 1), (8, 4)]:
+        psi4.set_options({"extern_multipole_order": order, "extern_multipole_theta": 0.25})
+        psi4.set_num_threads(threads)
+        grad, wfn = psi4.gradient("scf", external_potentials=external_potentials, return_wfn=True)
+        results[order, threads] = (wfn.energy(), grad.np, wfn.external_pot().gradient_on_charges().np)
+        stats[order, threads] = wfn.external_pot().far_field_statistics()
+    psi4.set_num_threads(1)
+
+    # The exact path keeps no statistics, while the multipole path integrates only the nearest charges exactly
+    assert stats[0, 1] == {}
+    for threads in [1, 4]:
+        s = stats[8, threads]
+        assert s == stats[8, 1]
+        assert s["near charges"] > 0
+        assert s["far charges"] + s["far clusters"] > 0
+        assert s["near charges"] < 800 * s["blocks"]
+
+    E_ref, G_ref, GC_ref = results[0, 1]
+    for threads in [1, 4]:
+        E, G, GC = results[8, threads]
+        assert compare_values(E_ref, E, 8, f"Energy, multipole far field, {threads} threads")
+        assert compare_arrays(G_ref, G, 7, f"Gradient on atoms, multipole far field, {threads} threads")
+        assert compare_arrays(GC_ref, GC, 7, f"Gradient on charges, multipole far field, {threads} threads")
@@ -0,0 +1,29 @@
+"""
+Tests that load-balanced ERI task scheduling does not depend on the thread count
+"""
+
+import pytest
+import psi4
+from utils import *
+
+pytestmark = [pytest.mark.psi, pytest.mark.api, pytest.mark.quick]
+
+
+@pytest.mark.parametrize("scf_type, scf_subtype", [("direct", "auto"), ("dfdirj+link", "auto"), ("dfdirj+cosx", "auto"),
+                                                   ("pk", "yoshimine_out_of_core")])
+def test_task_scheduler_threads(scf_type, scf_subtype, water_dimer):
+    """Energies and computed shell quartets agree between one and several threads"""
+
+    psi4.set_options({"basis": "cc-pvdz", "scf_type": scf_type, "scf_subtype": scf_subtype, "df_scf_guess": False, "bench": 1})
+
+    psi4.set_num_threads(1)
+    e_serial, wfn_serial = psi4.energy("scf", return_wfn=True)
+    psi4.set_num_threads(4)
+    e_threaded, wfn_threaded = psi4.energy("scf", return_wfn=True)
+    psi4.set_num_threads(1)
+
+    assert compare_values(e_serial, e_threaded, 10, f"{scf_type.upper()} energy, 1 vs 4 threads")
+    if scf_type == "direct":
+        assert compare(wfn_serial.jk().computed_shells_per_iter("Quartets"),
+                       wfn_threaded.jk().computed_shells_per_iter("Quartets"),
+                       "DirectJK computed shell quartets, 1 vs 4 threads")
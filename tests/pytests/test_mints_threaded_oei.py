@@ -0,0 +1,51 @@
+"""
+Tests that threaded one-electron integral drivers do not depend on the thread count
+"""
+
+import numpy as np
+import pytest
+import psi4
+from utils import *
+
+pytestmark = [pytest.mark.psi, pytest.mark.api, pytest.mark.quick]
+
+
+def _integrals(basis):
+    mints = psi4.core.MintsHelper(basis)
+    ints = {
+        "multipoles": mints.ao_multipoles(3, [0.1, -0.2, 0.3]),
+        "angular momentum": mints.ao_angular_momentum(),
+        "nabla": mints.ao_nabla(),
+        "multipole potential": mints.ao_multipole_potential(2, [0.5, 0.5, -0.5]),
+        "potential erf": [mints.ao_potential_erf([0.0, 1.0, 0.0], 0.4)],
+    }
+    for oei in ["OVERLAP", "KINETIC", "POTENTIAL"]:
+        ints[oei + " deriv1"] = mints.ao_oei_deriv1(oei, 1)
+        ints[oei + " deriv2"] = mints.ao_oei_deriv2(oei, 0, 2) + mints.ao_oei_deriv2(oei, 2, 2)
+    return {label: [m.np.copy() for m in mats] for label, mats in ints.items()}
+
+
+def test_threaded_oei():
+    """Integrals and their derivatives agree between one and several threads"""
+
+    mol = psi4.geometry("""
+    0 1
+    O   0.000000   0.000000   0.117790
+    H   0.000000   0.755453  -0.471161
+    H   0.000000  -0.755453  -0.471161
+    symmetry c1
+    """)
+    basis = psi4.core.BasisSet.build(mol, "ORBITAL", "cc-pvdz")
+
+    psi4.set_num_threads(1)
+    serial = _integrals(basis)
+    psi4.set_num_threads(4)
+    threaded = _integrals(basis)
+    psi4.set_num_threads(1)
+
+    for label in serial:
+        for i, (ref, val) in enumerate(zip(serial[label], threaded[label])):
+            assert compare_arrays(ref, val, 12, f"{label} component {i}, 1 vs 4 threads")
+
+    for i, L in enumerate(serial["angular momentum"] + serial["nabla"]):
+        assert compare_arrays(-L.T, L, 12, f"antisymmetric operator component {i}")
@@ -0,0 +1,94 @@
+"""
+Tests for the libpsio storage backends
+"""
+
+import pytest
+import psi4
+from psi4.driver import psif
+from utils import *
+
+pytestmark = [pytest.mark.psi, pytest.mark.api, pytest.mark.quick]
+
+
+@pytest.fixture
+def water_dfmp2():
+    psi4.geometry("""
+    O
+    H 1 1.00
+    H 1 1.00 2 103.1
+    """)
+    psi4.set_options({"basis": "cc-pvdz", "scf_type": "df", "mp2_type": "df", "qc_module": "dfmp2"})
+
+
+def test_psio_mmap_dfmp2(water_dfmp2):
+    """DF-MP2 streams its three-index integrals through PSIO; mapped units must give identical energies"""
+
+    psio_manager = psi4.core.IOManager.shared_object()
+    units = [psif.PSIF_DFMP2_AIA, psif.PSIF_DFMP2_QIA]
+
+    e_rw = psi4.energy("mp2")
+
+    opens = [psio_manager.mmap_opens(unit) for unit in units]
+    for unit in units:
+        psio_manager.set_specific_mmap(unit, True)
+    try:
+        assert all(psio_manager.get_specific_mmap(unit) for unit in units)
+        e_mmap = psi4.energy("mp2")
+    finally:
+        for unit in units:
+            psio_manager.set_specific_mmap(unit, False)
+    # The mapped backend really served the units, it was not just requested
+    assert all(psio_manager.mmap_opens(unit) > n for unit, n in zip(units, opens))
+
+    assert compare_values(e_rw, e_mmap, 10, "DF-MP2 energy, mmap vs read/write backend")
+
+
+@pytest.mark.parametrize("tolerance,atol", [(0.0, 1.e-10), (1.e-10, 1.e-7)])
+def test_psio_compressed_dfmp2(water_dfmp2, tolerance, atol):
+    """Compressed DF-MP2 integral files: exact when lossless, within tolerance when lossy"""
+
+    psio_manager = psi4.core.IOManager.shared_object()
+    units = [psif.PSIF_DFMP2_AIA, psif.PSIF_DFMP2_QIA]
+
+    e_plain = psi4.energy("mp2")
+
+    opens = [psio_manager.compressed_opens(unit) for unit in units]
+    for unit in units:
+        psio_manager.set_specific_compression(unit, True, tolerance)
+    try:
+        e_zip = psi4.energy("mp2")
+    finally:
+        for unit in units:
+            psio_manager.set_specific_compression(unit, False)
+    # The compression layer really stored the units, it was not just requested
+    assert all(psio_manager.compressed_opens(unit) > n for unit, n in zip(units, opens))
+
+    assert compare_values(e_plain, e_zip, atol=atol, label="DF-MP2 energy, compressed vs plain")
+
+
+def test_psio_telemetry_dfmp2(water_dfmp2):
+    """I/O telemetry accounts the DF-MP2 integral traffic per unit and per TOC entry"""
+
+    psio_manager = psi4.core.IOManager.shared_object()
+    psio_manager.clear_telemetry()
+    psio_manager.set_telemetry(True)
+    try:
+        assert psi4.core.IOManager.telemetry_enabled()
+        psi4.energy("mp2")
+    finally:
+        psio_manager.set_telemetry(False)
+
+    stats = psio_manager.telemetry()[psif.PSIF_DFMP2_AIA]
+    assert stats["nwrite"] > 0 and stats["nread"] > 0
+    assert stats["read_bytes"] > 0 and stats["write_bytes"] > 0
+    assert sum(stats["latency"]) == stats["nread"] + stats["nwrite"]
+
+    entries = psio_manager.entry_telemetry()
+    aia = {key: val for (unit, key), val in entries.items() if unit == psif.PSIF_DFMP2_AIA}
+    assert aia
+    assert sum(val["read_bytes"] for val in aia.values()) == stats["read_bytes"]
+    assert sum(val["nwrite"] for val in aia.values()) == stats["nwrite"]
+
+    psio_manager.clear_telemetry()
+    assert psio_manager.telemetry() == {}
+    assert psio_manager.entry_telemetry() == {}
@@ -0,0 +1,52 @@
+"""
+Tests for single-precision J/K builds in early SCF iterations (MIXED_PRECISION)
+"""
+
+import pytest
+import psi4
+from utils import *
+
+pytestmark = [pytest.mark.psi, pytest.mark.api, pytest.mark.quick]
+
+
+@pytest.mark.parametrize("reference", ["rhf", "uhf"])
+def test_mixed_precision_mem_df(reference):
+    """MemDF SCF with single-precision early iterations converges to the double-precision energy"""
+
+    psi4.geometry("""
+    0 2
+    O
+    H 1 1.00
+    """ if reference == "uhf" else """
+    O
+    H 1 1.00
+    H 1 1.00 2 103.1
+    """)
+    psi4.set_options({"basis": "cc-pvdz", "scf_type": "mem_df", "reference": reference, "d_convergence": 1.e-8,
+                      "save_jk": True})
+
+    e_fp64, wfn = psi4.energy("scf", return_wfn=True)
+    assert wfn.jk().single_precision_builds() == 0
+    psi4.set_options({"mixed_precision": True})
+    e_mixed, wfn = psi4.energy("scf", return_wfn=True)
+    assert wfn.jk().single_precision_builds() > 0
+
+    assert compare_values(e_fp64, e_mixed, 9, f"MemDF {reference.upper()} energy, mixed precision")
+
+
+def test_mixed_precision_unsupported():
+    """JK algorithms without a single-precision path ignore MIXED_PRECISION"""
+
+    psi4.geometry("""
+    O
+    H 1 1.00
+    H 1 1.00 2 103.1
+    """)
+    psi4.set_options({"basis": "cc-pvdz", "scf_type": "direct", "save_jk": True})
+
+    e_fp64 = psi4.energy("scf")
+    psi4.set_options({"mixed_precision": True})
+    e_mixed, wfn = psi4.energy("scf", return_wfn=True)
+    assert wfn.jk().single_precision_builds() == 0
+
+    assert compare_values(e_fp64, e_mixed, 10, "Direct SCF energy, mixed precision ignored")
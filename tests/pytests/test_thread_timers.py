@@ -0,0 +1,37 @@
+"""
+Tests for the per-thread timers and their Chrome trace export
+"""
+
+import json
+
+import pytest
+import psi4
+from utils import *
+
+pytestmark = [pytest.mark.psi, pytest.mark.api, pytest.mark.quick]
+
+
+def test_thread_timer_trace(tmp_path):
+    """GGA Fock builds time their collocation kernels on every thread; the trace must hold those intervals"""
+
+    psi4.geometry("""
+    O
+    H 1 1.00
+    H 1 1.00 2 103.1
+    """)
+    psi4.set_options({"basis": "sto-3g", "scf_type": "df", "dft_radial_points": 30, "dft_spherical_points": 110})
+
+    trace = tmp_path / "trace.json"
+    psi4.core.thread_timer_trace(True)
+    try:
+        psi4.energy("pbe")
+    finally:
+        psi4.core.thread_timer_trace(False)
+    psi4.core.thread_timer_write_trace(str(trace))
+
+    events = json.loads(trace.read_text())["traceEvents"]
+    intervals = [ev for ev in events if ev["ph"] == "X"]
+    names = {ev["name"] for ev in intervals}
+    assert {"LSDA Phi_tmp", "GGA Phi_tmp"} <= names
+    assert all(ev["dur"] >= 0.0 for ev in intervals)
+    assert any(ev["ph"] == "M" and ev["name"] == "thread_name" for ev in events)
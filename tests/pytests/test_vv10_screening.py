@@ -0,0 +1,27 @@
+"""
+Tests that block-pair screening of the VV10 nonlocal kernel does not change energies
+"""
+
+import pytest
+import psi4
+from utils import *
+
+pytestmark = [pytest.mark.psi, pytest.mark.api, pytest.mark.quick]
+
+
+@pytest.mark.parametrize("functional", ["b97m-v", "wb97x-v"])
+def test_vv10_screening(functional, water_dimer):
+    """Screened and unscreened VV10 energies agree for a water dimer"""
+
+    psi4.set_options({"basis": "cc-pvdz", "scf_type": "df", "dft_vv10_screening": 0.0})
+    e_full, wfn = psi4.energy(functional, return_wfn=True)
+    stats = wfn.V_potential().vv10_screening_statistics()
+    assert stats["block pairs"] > 0
+    assert stats["skipped block pairs"] == 0
+
+    psi4.set_options({"dft_vv10_screening": 1.e-12})
+    e_screened, wfn = psi4.energy(functional, return_wfn=True)
+    stats = wfn.V_potential().vv10_screening_statistics()
+    assert 0 < stats["skipped block pairs"] < stats["block pairs"]
+
+    assert compare_values(e_full, e_screened, 7, f"{functional.upper()} energy, screened VV10 kernel")